@@ -33,21 +33,50 @@
 
 #include <QtCore/qstringlist.h>
 
+#include <algorithm>
+
+namespace {
+// The string table of an empty queue is dropped once it holds more strings than this
+const int maxInternedStrings = 65536;
+}
+
 ElementCommand::ElementCommand()
     : m_commandType(CommandType_Invalid)
+    , m_elementPath(0)
+    , m_stringValue(0)
+    , m_valueType(CommandValueType_None)
+    , m_valueOffset(0)
+    , m_valueLength(0)
+    , m_int64Value(0)
 {
 }
 
-QString ElementCommand::toString() const
+CommandQueue::CommandQueue()
 {
-    QString ret = QStringLiteral("ElementCommand - Type: %1 Path: '%2' StrVal: '%3' VarVal: '%4'");
-    return ret.arg(m_commandType).arg(m_elementPath)
-            .arg(m_stringValue).arg(m_variantValue.toString());
+    qRegisterMetaType<CommandType>();
+    resetStrings();
 }
 
-CommandQueue::CommandQueue()
+QVariant CommandQueue::value(const ElementCommand &command) const
 {
-    qRegisterMetaType<CommandType>();
+    switch (command.m_valueType) {
+    case CommandValueType_Float:
+        return QVariant(command.m_floatValue);
+    case CommandValueType_String:
+        return QVariant(QString(m_stringArena.constData() + command.m_valueOffset,
+                                command.m_valueLength));
+    case CommandValueType_Variant:
+        return m_variantArena.at(command.m_valueOffset);
+    default:
+        return QVariant();
+    }
+}
+
+QString CommandQueue::commandToString(const ElementCommand &command) const
+{
+    QString ret = QStringLiteral("ElementCommand - Type: %1 Path: '%2' StrVal: '%3' VarVal: '%4'");
+    return ret.arg(command.m_commandType).arg(elementPath(command))
+            .arg(stringValue(command)).arg(value(command).toString());
 }
 
 ElementCommand &CommandQueue::queueCommand(const QString &elementPath,
@@ -55,12 +84,42 @@ ElementCommand &CommandQueue::queueCommand(const QString &elementPath,
                                            const QString &attributeName,
                                            const QVariant &value)
 {
-    ElementCommand &cmd = nextFreeCommand();
+    const int pathId = intern(elementPath, m_pathCache);
+    const int attributeId = intern(attributeName, m_attributeCache);
+    bool continueAttributeRun = false;
+    if (commandType == CommandType_SetAttribute) {
+        // Only the last value written to an attribute matters, so coalesce repeated writes
+        // between other commands instead of queuing each one of them. The paths are not
+        // resolved here and different paths may name the same element, e.g. with a presentation
+        // id prefix. Such paths still end in the same element name, so a write is only merged
+        // if no later write went to an attribute of that name on an element of that name.
+        const int leafId = elementNameId(pathId);
+        if (leafId >= 0) {
+            const quint64 target = (quint64(pathId) << 32) | quint32(attributeId);
+            const quint64 group = (quint64(leafId) << 32)
+                    | quint32(attributeNameId(attributeId));
+            const auto it = m_attributeRun.constFind(target);
+            if (it != m_attributeRun.constEnd()
+                    && m_attributeRunLatest.value(group, -1) == it.value()) {
+                ElementCommand &cmd = m_elementCommands[it.value()];
+                setAttributeValue(cmd, value);
+                return cmd;
+            }
+            m_attributeRun.insert(target, m_size);
+            m_attributeRunLatest.insert(group, m_size);
+            continueAttributeRun = true;
+        }
+    }
+
+    ElementCommand &cmd = nextFreeCommand(continueAttributeRun);
 
     cmd.m_commandType = commandType;
-    cmd.m_elementPath = elementPath;
-    cmd.m_stringValue = attributeName;
-    cmd.m_variantValue = value;
+    cmd.m_elementPath = pathId;
+    cmd.m_stringValue = attributeId;
+    if (commandType == CommandType_SetAttribute)
+        setAttributeValue(cmd, value);
+    else
+        setValue(cmd, value);
 
     return cmd;
 }
@@ -74,9 +133,9 @@ ElementCommand &CommandQueue::queueCommand(const QString &elementPath,
     ElementCommand &cmd = nextFreeCommand();
 
     cmd.m_commandType = commandType;
-    cmd.m_elementPath = elementPath;
-    cmd.m_stringValue = attributeName;
-    cmd.m_variantValue = value;
+    cmd.m_elementPath = intern(elementPath, m_pathCache);
+    cmd.m_stringValue = intern(attributeName, m_attributeCache);
+    setValue(cmd, value);
     cmd.m_intValues[0] = intValue;
 
     return cmd;
@@ -88,8 +147,8 @@ ElementCommand &CommandQueue::queueCommand(const QString &elementPath, CommandTy
     ElementCommand &cmd = nextFreeCommand();
 
     cmd.m_commandType = commandType;
-    cmd.m_elementPath = elementPath;
-    cmd.m_stringValue = value;
+    cmd.m_elementPath = intern(elementPath, m_pathCache);
+    cmd.m_stringValue = intern(value, m_attributeCache);
 
     return cmd;
 }
@@ -100,7 +159,7 @@ ElementCommand &CommandQueue::queueCommand(const QString &elementPath,
     ElementCommand &cmd = nextFreeCommand();
 
     cmd.m_commandType = commandType;
-    cmd.m_elementPath = elementPath;
+    cmd.m_elementPath = intern(elementPath, m_pathCache);
     cmd.m_boolValue = value;
 
     return cmd;
@@ -112,7 +171,7 @@ ElementCommand &CommandQueue::queueCommand(const QString &elementPath,
     ElementCommand &cmd = nextFreeCommand();
 
     cmd.m_commandType = commandType;
-    cmd.m_elementPath = elementPath;
+    cmd.m_elementPath = intern(elementPath, m_pathCache);
     cmd.m_floatValue = value;
 
     return cmd;
@@ -124,7 +183,7 @@ ElementCommand &CommandQueue::queueCommand(const QString &elementPath, CommandTy
     ElementCommand &cmd = nextFreeCommand();
 
     cmd.m_commandType = commandType;
-    cmd.m_elementPath = elementPath;
+    cmd.m_elementPath = intern(elementPath, m_pathCache);
     cmd.m_longValue = value;
 
     return cmd;
@@ -137,7 +196,7 @@ ElementCommand &CommandQueue::queueCommand(const QString &elementPath,
     ElementCommand &cmd = nextFreeCommand();
 
     cmd.m_commandType = commandType;
-    cmd.m_elementPath = elementPath;
+    cmd.m_elementPath = intern(elementPath, m_pathCache);
     cmd.m_intValues[0] = value0;
     cmd.m_intValues[1] = value1;
     cmd.m_intValues[2] = value2;
@@ -152,8 +211,8 @@ ElementCommand &CommandQueue::queueCommand(const QString &elementPath, CommandTy
     ElementCommand &cmd = nextFreeCommand();
 
     cmd.m_commandType = commandType;
-    cmd.m_elementPath = elementPath;
-    cmd.m_stringValue = stringValue;
+    cmd.m_elementPath = intern(elementPath, m_pathCache);
+    cmd.m_stringValue = intern(stringValue, m_attributeCache);
     cmd.m_data = commandData;
 
     return cmd;
@@ -174,7 +233,7 @@ ElementCommand &CommandQueue::queueCommand(const QString &elementPath, CommandTy
     ElementCommand &cmd = nextFreeCommand();
 
     cmd.m_commandType = commandType;
-    cmd.m_elementPath = elementPath;
+    cmd.m_elementPath = intern(elementPath, m_pathCache);
 
     return cmd;
 }
@@ -185,7 +244,7 @@ ElementCommand &CommandQueue::queueCommand(const QString &elementPath, CommandTy
     ElementCommand &cmd = nextFreeCommand();
 
     cmd.m_commandType = commandType;
-    cmd.m_elementPath = elementPath;
+    cmd.m_elementPath = intern(elementPath, m_pathCache);
     cmd.m_data = commandData;
 
     return cmd;
@@ -210,6 +269,26 @@ ElementCommand &CommandQueue::queueCommand(CommandType commandType, bool value)
     return cmd;
 }
 
+void CommandQueue::queueAttributeHandleValues(const int *handles, const float *values, int count)
+{
+    AttributeHandleValues *data = nullptr;
+    if (m_size > 0) {
+        ElementCommand &lastCmd = m_elementCommands[m_size - 1];
+        if (lastCmd.m_commandType == CommandType_SetAttributeHandleValues && lastCmd.m_data)
+            data = static_cast<AttributeHandleValues *>(lastCmd.m_data);
+    }
+    if (!data) {
+        data = new AttributeHandleValues;
+        queueCommand(CommandType_SetAttributeHandleValues, data);
+    }
+
+    const int handleOffset = data->handles.size();
+    data->handles.resize(handleOffset + count);
+    data->values.resize((handleOffset + count) * 4);
+    std::copy(handles, handles + count, data->handles.begin() + handleOffset);
+    std::copy(values, values + count * 4, data->values.begin() + handleOffset * 4);
+}
+
 void CommandQueue::copyCommands(CommandQueue &fromQueue)
 {
     m_visibleChanged = m_visibleChanged || fromQueue.m_visibleChanged;
@@ -221,6 +300,7 @@ void CommandQueue::copyCommands(CommandQueue &fromQueue)
             = m_stereoProgressiveEnabledChanged || fromQueue.m_stereoProgressiveEnabledChanged;
     m_skipFramesIntervalChanged
             = m_skipFramesIntervalChanged || fromQueue.m_skipFramesIntervalChanged;
+    m_renderOnDemandChanged = m_renderOnDemandChanged || fromQueue.m_renderOnDemandChanged;
     m_shadeModeChanged = m_shadeModeChanged || fromQueue.m_shadeModeChanged;
     m_showRenderStatsChanged = m_showRenderStatsChanged || fromQueue.m_showRenderStatsChanged;
     m_matteColorChanged = m_matteColorChanged || fromQueue.m_matteColorChanged;
@@ -244,6 +324,8 @@ void CommandQueue::copyCommands(CommandQueue &fromQueue)
        m_stereoProgressiveEnabled = fromQueue.m_stereoProgressiveEnabled;
     if (fromQueue.m_skipFramesIntervalChanged)
        m_skipFramesInterval = fromQueue.m_skipFramesInterval;
+    if (fromQueue.m_renderOnDemandChanged)
+       m_renderOnDemand = fromQueue.m_renderOnDemand;
     if (fromQueue.m_shadeModeChanged)
        m_shadeMode = fromQueue.m_shadeMode;
     if (fromQueue.m_showRenderStatsChanged)
@@ -263,80 +345,36 @@ void CommandQueue::copyCommands(CommandQueue &fromQueue)
     if (fromQueue.m_shaderCacheFileChanged)
         m_shaderCacheFile = fromQueue.m_shaderCacheFile;
 
+    m_attributeRun.clear();
+    m_attributeRunLatest.clear();
+    fromQueue.m_attributeRun.clear();
+    fromQueue.m_attributeRunLatest.clear();
+
+    if (m_size == 0) {
+        // Usual case, the previous commands have been processed. Take over the storage instead
+        // of copying the commands one by one; fromQueue gets the processed slots to reuse.
+        swapStorage(fromQueue);
+        return;
+    }
+
     // Pending queue may be synchronized multiple times between queue processing, so let's append
-    // to the existing queue rather than clearing it.
+    // to the existing queue rather than clearing it. Strings and values move to this queue.
     for (int i = 0; i < fromQueue.m_size; i++) {
-        const ElementCommand &source = fromQueue.constCommandAt(i);
-        switch (source.m_commandType) {
-        case CommandType_SetDataInputValue:
-            queueCommand(source.m_elementPath, source.m_commandType, source.m_stringValue,
-                         source.m_variantValue, source.m_intValues[0]);
-            break;
-        case CommandType_SetDataInputBatch:
-            queueCommand(source.m_elementPath, source.m_commandType, source.m_stringValue,
-                         source.m_data);
-            fromQueue.commandAt(i).m_data = nullptr; // This queue takes ownership of data
-            break;
-        case CommandType_SetAttribute:
-            queueCommand(source.m_elementPath, source.m_commandType, source.m_stringValue,
-                         source.m_variantValue);
-            break;
-        case CommandType_GoToSlideByName:
-        case CommandType_FireEvent:
-            queueCommand(source.m_elementPath, source.m_commandType, source.m_stringValue);
-            break;
-        case CommandType_SetPresentationActive:
-            queueCommand(source.m_elementPath, source.m_commandType, source.m_boolValue);
-            break;
-        case CommandType_GoToTime:
-            queueCommand(source.m_elementPath, source.m_commandType, source.m_longValue);
-            break;
-        case CommandType_GoToSlide:
-        case CommandType_GoToSlideRelative:
-        case CommandType_MousePress:
-        case CommandType_MouseRelease:
-        case CommandType_MouseMove:
-        case CommandType_MouseWheel:
-        case CommandType_KeyPress:
-        case CommandType_KeyRelease:
-            queueCommand(source.m_elementPath, source.m_commandType,
-                         source.m_intValues[0], source.m_intValues[1],
-                         source.m_intValues[2], source.m_intValues[3]);
-            break;
-        case CommandType_CreateElements:
-            queueCommand(source.m_elementPath, source.m_commandType, source.m_stringValue,
-                         source.m_data);
-            fromQueue.commandAt(i).m_data = nullptr; // This queue takes ownership of data
-            break;
-        case CommandType_DeleteElements:
-        case CommandType_DeleteMaterials:
-        case CommandType_DeleteMeshes:
-        case CommandType_CreateMeshes:
-            queueCommand(source.m_commandType, source.m_data);
-            fromQueue.commandAt(i).m_data = nullptr; // This queue takes ownership of data
-            break;
-        case CommandType_CreateMaterials:
-            queueCommand(source.m_elementPath, source.m_commandType, source.m_data);
-            fromQueue.commandAt(i).m_data = nullptr; // This queue takes ownership of data
-            break;
-        case CommandType_AddImageProvider:
-            queueCommand(source.m_elementPath, source.m_commandType, source.m_data);
-            break;
-        case CommandType_RequestSlideInfo:
-        case CommandType_UnloadSlide:
-        case CommandType_PreloadSlide:
-            queueCommand(source.m_elementPath, source.m_commandType);
-            break;
-        case CommandType_RequestDataInputs:
-        case CommandType_RequestDataOutputs:
-        case CommandType_RequestExportShaderCache:
-            queueCommand(source.m_commandType, source.m_boolValue);
-            break;
-        default:
-            queueCommand(QString(), CommandType_Invalid, false);
-            break;
+        ElementCommand &source = fromQueue.commandAt(i);
+        ElementCommand &cmd = nextFreeCommand();
+        cmd = source;
+        cmd.m_elementPath = intern(fromQueue.elementPath(source), m_pathCache);
+        cmd.m_stringValue = intern(fromQueue.stringValue(source), m_attributeCache);
+        if (source.m_valueType == CommandValueType_String) {
+            setStringValue(cmd, fromQueue.m_stringArena.constData() + source.m_valueOffset,
+                           source.m_valueLength);
+        } else if (source.m_valueType == CommandValueType_Variant) {
+            setVariantValue(cmd, fromQueue.m_variantArena.at(source.m_valueOffset));
         }
+        source.m_data = nullptr; // This queue takes ownership of data
     }
+    fromQueue.m_size = 0;
+    fromQueue.clearArenas();
 }
 
 // Clears changed states and empties the queue
@@ -348,6 +386,7 @@ void CommandQueue::clear(bool deleteCommandData)
     m_stereoEyeSeparationChanged = false;
     m_stereoProgressiveEnabledChanged = false;
     m_skipFramesIntervalChanged = false;
+    m_renderOnDemandChanged = false;
     m_shadeModeChanged = false;
     m_showRenderStatsChanged = false;
     m_matteColorChanged = false;
@@ -380,6 +419,9 @@ void CommandQueue::clear(bool deleteCommandData)
                     delete static_cast<QVector<QPair<QString, QVariant>> *>(cmd.m_data);
                     break;
                 }
+                case CommandType_SetAttributeHandleValues:
+                    delete static_cast<AttributeHandleValues *>(cmd.m_data);
+                    break;
                 default:
                     Q_ASSERT(false); // Should never come here
                     break;
@@ -392,12 +434,161 @@ void CommandQueue::clear(bool deleteCommandData)
     // We do not clear the actual queued commands, those will be reused the next frame
     // To avoid a lot of unnecessary reallocations.
     m_size = 0;
+    m_attributeRun.clear();
+    m_attributeRunLatest.clear();
+    clearArenas();
+    if (m_strings.size() > maxInternedStrings)
+        resetStrings();
 }
 
-ElementCommand &CommandQueue::nextFreeCommand()
+ElementCommand &CommandQueue::nextFreeCommand(bool continueAttributeRun)
 {
+    if (!continueAttributeRun && !m_attributeRun.isEmpty()) {
+        m_attributeRun.clear();
+        m_attributeRunLatest.clear();
+    }
+
     m_size++;
     if (m_size > m_elementCommands.size())
         m_elementCommands.append(ElementCommand());
-    return m_elementCommands[m_size - 1];
+    ElementCommand &cmd = m_elementCommands[m_size - 1];
+    // Reused commands may still point to data that has been handled already
+    cmd = ElementCommand();
+    return cmd;
+}
+
+int CommandQueue::intern(const QString &string, InternCache &cache)
+{
+    if (!string.isSharedWith(cache.string)) {
+        cache.id = intern(string);
+        cache.string = string;
+    }
+    return cache.id;
+}
+
+int CommandQueue::intern(const QString &string)
+{
+    if (string.isEmpty())
+        return 0;
+    const auto it = m_stringIds.constFind(string);
+    if (it != m_stringIds.constEnd())
+        return it.value();
+    const int id = m_strings.size();
+    m_strings.append(string);
+    m_stringIds.insert(string, id);
+    m_elementNameIds.append(-2);
+    m_attributeNameIds.append(-2);
+    return id;
+}
+
+int CommandQueue::elementNameId(int pathId)
+{
+    if (m_elementNameIds.at(pathId) == -2) {
+        const QString &path = m_strings.at(pathId);
+        const int leafStart = qMax(path.lastIndexOf(QLatin1Char('.')),
+                                   path.lastIndexOf(QLatin1Char(':'))) + 1;
+        const QString leafName = path.mid(leafStart);
+        // "parent" and "this" name an element by its relation, which could be any of them
+        const int id = leafName == QLatin1String("parent") || leafName == QLatin1String("this")
+                ? -1 : intern(leafName);
+        m_elementNameIds[pathId] = id;
+    }
+    return m_elementNameIds.at(pathId);
+}
+
+int CommandQueue::attributeNameId(int attributeId)
+{
+    if (m_attributeNameIds.at(attributeId) == -2) {
+        const int id = intern(m_strings.at(attributeId).section(QLatin1Char('.'), 0, 0));
+        m_attributeNameIds[attributeId] = id;
+    }
+    return m_attributeNameIds.at(attributeId);
+}
+
+void CommandQueue::setValue(ElementCommand &command, const QVariant &value)
+{
+    if (value.isValid())
+        setVariantValue(command, value);
+    else
+        command.m_valueType = CommandValueType_None;
+}
+
+// Converts the value the same way Q3DSPresentation::setAttribute() does before handing it to
+// the runtime, so that only numbers and strings need to be stored
+void CommandQueue::setAttributeValue(ElementCommand &command, const QVariant &value)
+{
+    switch (static_cast<QMetaType::Type>(value.type())) {
+    case QMetaType::Bool:
+    case QMetaType::Int:
+    case QMetaType::Double:
+    case QMetaType::Float:
+        command.m_valueType = CommandValueType_Float;
+        command.m_floatValue = value.toFloat();
+        break;
+    case QMetaType::QString: {
+        const QString string = value.toString();
+        setStringValue(command, string.constData(), string.size());
+        break;
+    }
+    default:
+        setValue(command, value);
+        break;
+    }
+}
+
+void CommandQueue::setStringValue(ElementCommand &command, const QChar *data, int length)
+{
+    command.m_valueType = CommandValueType_String;
+    command.m_valueOffset = m_stringArena.size();
+    command.m_valueLength = length;
+    m_stringArena.resize(command.m_valueOffset + length);
+    std::copy(data, data + length, m_stringArena.begin() + command.m_valueOffset);
+}
+
+void CommandQueue::setVariantValue(ElementCommand &command, const QVariant &value)
+{
+    command.m_valueType = CommandValueType_Variant;
+    command.m_valueOffset = m_variantCount;
+    if (m_variantCount < m_variantArena.size())
+        m_variantArena[m_variantCount] = value;
+    else
+        m_variantArena.append(value);
+    ++m_variantCount;
+}
+
+void CommandQueue::clearArenas()
+{
+    m_stringArena.resize(0);
+    // Do not keep the values alive until their slots get reused
+    for (int i = 0; i < m_variantCount; ++i)
+        m_variantArena[i] = QVariant();
+    m_variantCount = 0;
+}
+
+void CommandQueue::swapStorage(CommandQueue &other)
+{
+    m_elementCommands.swap(other.m_elementCommands);
+    std::swap(m_size, other.m_size);
+    m_strings.swap(other.m_strings);
+    m_stringIds.swap(other.m_stringIds);
+    std::swap(m_pathCache, other.m_pathCache);
+    std::swap(m_attributeCache, other.m_attributeCache);
+    m_elementNameIds.swap(other.m_elementNameIds);
+    m_attributeNameIds.swap(other.m_attributeNameIds);
+    m_stringArena.swap(other.m_stringArena);
+    m_variantArena.swap(other.m_variantArena);
+    std::swap(m_variantCount, other.m_variantCount);
+}
+
+void CommandQueue::resetStrings()
+{
+    m_strings.clear();
+    m_stringIds.clear();
+    m_elementNameIds.clear();
+    m_attributeNameIds.clear();
+    m_pathCache = InternCache();
+    m_attributeCache = InternCache();
+    m_strings.append(QString());
+    m_elementNameIds.append(0);
+    m_attributeNameIds.append(0);
 }
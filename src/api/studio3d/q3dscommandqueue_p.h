@@ -48,6 +48,7 @@
 #include <QtCore/qvector.h>
 #include <QtCore/qurl.h>
 #include <QtCore/qvariant.h>
+#include <QtCore/qhash.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -78,6 +79,9 @@ enum CommandType {
     CommandType_PreloadSlide,
     CommandType_UnloadSlide,
     CommandType_AddImageProvider,
+    CommandType_RegisterAttributeHandle,
+    CommandType_ReleaseAttributeHandle,
+    CommandType_SetAttributeHandleValues,
 
     // Requests
     CommandType_RequestSlideInfo,
@@ -86,15 +90,31 @@ enum CommandType {
     CommandType_RequestExportShaderCache
 };
 
+enum CommandValueType {
+    CommandValueType_None = 0,
+    CommandValueType_Float,
+    CommandValueType_String,
+    CommandValueType_Variant
+};
+
+// Commands hold no strings or variants of their own. Strings are interned in the queue that
+// holds the command, values that do not fit the command go to the arenas of that queue, which
+// are emptied together with the queue.
 class Q_STUDIO3D_EXPORT ElementCommand
 {
 public:
     ElementCommand();
 
     CommandType m_commandType;
-    QString m_elementPath;
-    QString m_stringValue;
-    QVariant m_variantValue;
+    // Ids of strings interned in the queue, see CommandQueue::string(). 0 is the empty string.
+    int m_elementPath;
+    int m_stringValue;
+    // Where the value of the command is: the float of the union below, a string in the string
+    // arena at m_valueOffset with m_valueLength characters, or a variant in the variant arena at
+    // m_valueOffset. See CommandQueue::value().
+    CommandValueType m_valueType;
+    int m_valueOffset;
+    int m_valueLength;
     void *m_data = nullptr; // Data is owned by the queue and is deleted once command is handled
     union {
         bool m_boolValue;
@@ -103,12 +123,19 @@ public:
         int m_intValues[4];
         qint64 m_int64Value;
     };
-
-    QString toString() const;
 };
 
+Q_DECLARE_TYPEINFO(ElementCommand, Q_PRIMITIVE_TYPE);
+
 typedef QVector<ElementCommand> CommandList;
 
+// Data of CommandType_SetAttributeHandleValues, four values per handle
+struct AttributeHandleValues
+{
+    QVector<int> handles;
+    QVector<float> values;
+};
+
 class Q_STUDIO3D_EXPORT CommandQueue
 {
 public:
@@ -136,6 +163,8 @@ public:
                                  void *commandData);
     ElementCommand &queueCommand(CommandType commandType);
     ElementCommand &queueCommand(CommandType commandType, bool value);
+    // Appends to the previous command if that also sets attribute handle values
+    void queueAttributeHandleValues(const int *handles, const float *values, int count);
 
     void copyCommands(CommandQueue &fromQueue);
 
@@ -145,6 +174,7 @@ public:
     bool m_stereoEyeSeparationChanged = false;
     bool m_stereoProgressiveEnabledChanged = false;
     bool m_skipFramesIntervalChanged = false;
+    bool m_renderOnDemandChanged = false;
     bool m_shadeModeChanged = false;
     bool m_showRenderStatsChanged = false;
     bool m_matteColorChanged = false;
@@ -161,6 +191,7 @@ public:
     double m_stereoEyeSeparation = 0.4;
     bool m_stereoProgressiveEnabled = false;
     int m_skipFramesInterval = 0;
+    bool m_renderOnDemand = false;
     Q3DSViewerSettings::ShadeMode m_shadeMode = Q3DSViewerSettings::ShadeModeShaded;
     bool m_showRenderStats = false;
     QColor m_matteColor = QColor(Qt::black);
@@ -176,11 +207,67 @@ public:
     const ElementCommand &constCommandAt(int index) const { return m_elementCommands.at(index); }
     ElementCommand &commandAt(int index) { return m_elementCommands[index]; }
 
+    const QString &string(int id) const { return m_strings.at(id); }
+    const QString &elementPath(const ElementCommand &command) const
+    {
+        return m_strings.at(command.m_elementPath);
+    }
+    const QString &stringValue(const ElementCommand &command) const
+    {
+        return m_strings.at(command.m_stringValue);
+    }
+    QVariant value(const ElementCommand &command) const;
+    QString commandToString(const ElementCommand &command) const;
+
 private:
-    ElementCommand &nextFreeCommand();
+    // Single entry cache in front of the string table. Callers tend to pass the same string
+    // objects over and over, which are then recognized without hashing them.
+    struct InternCache
+    {
+        QString string;
+        int id = 0;
+    };
+
+    ElementCommand &nextFreeCommand(bool continueAttributeRun = false);
+    int intern(const QString &string, InternCache &cache);
+    int intern(const QString &string);
+    int elementNameId(int pathId);
+    int attributeNameId(int attributeId);
+    void setValue(ElementCommand &command, const QVariant &value);
+    void setAttributeValue(ElementCommand &command, const QVariant &value);
+    void setStringValue(ElementCommand &command, const QChar *data, int length);
+    void setVariantValue(ElementCommand &command, const QVariant &value);
+    void clearArenas();
+    void swapStorage(CommandQueue &other);
+    void resetStrings();
 
     CommandList m_elementCommands;
     int m_size = 0;
+
+    // Interned strings, ids index m_strings
+    QVector<QString> m_strings;
+    QHash<QString, int> m_stringIds;
+    InternCache m_pathCache;
+    InternCache m_attributeCache;
+    // Per string id, the id of the last element name of the path and of the attribute name
+    // without its component suffix. Filled in the first time a string is used for a SetAttribute,
+    // -1 for paths that name an element by relation and -2 for strings not looked at yet.
+    QVector<int> m_elementNameIds;
+    QVector<int> m_attributeNameIds;
+
+    // Per frame arenas for values that do not fit into a command
+    QVector<QChar> m_stringArena;
+    QVector<QVariant> m_variantArena;
+    int m_variantCount = 0;
+
+    // Indices of the SetAttribute commands queued since the last command of any other type,
+    // keyed by path and attribute id. A later write to the same attribute within such a run
+    // replaces the queued value.
+    QHash<quint64, int> m_attributeRun;
+    // Index of the latest SetAttribute command in the run per element name and attribute name
+    // without its component suffix. Different element paths may name the same element, so a
+    // write is only merged into its queued command if it is still the latest one of its group.
+    QHash<quint64, int> m_attributeRunLatest;
 };
 
 QT_END_NAMESPACE
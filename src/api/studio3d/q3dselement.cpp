@@ -208,6 +208,25 @@ void Q3DSElement::setAttribute(const QString &attributeName, const QVariant &val
         qWarning() << __FUNCTION__ << "Element is not registered to any presentation!";
 }
 
+/*!
+    \since Qt 3D Studio 2.8
+    Returns a handle to the attribute \a attributeName of the scene object specified
+    by elementPath, or \c 0 if the element is not registered to any presentation.
+
+    The handle is bound to the current elementPath and is used with
+    Q3DSPresentation::setAttributeValue() and Q3DSPresentation::setAttributeValues().
+
+    \sa Q3DSPresentation::attributeHandle()
+ */
+int Q3DSElement::attributeHandle(const QString &attributeName)
+{
+    if (d_ptr->m_presentation)
+        return d_ptr->m_presentation->q_ptr->attributeHandle(d_ptr->m_elementPath, attributeName);
+
+    qWarning() << __FUNCTION__ << "Element is not registered to any presentation!";
+    return 0;
+}
+
 /*!
     \qmlmethod void Element::fireEvent(string eventName)
 
@@ -53,6 +53,7 @@ public:
     virtual ~Q3DSElement();
 
     QString elementPath() const;
+    int attributeHandle(const QString &attributeName);
 
 public Q_SLOTS:
     void setElementPath(const QString &elementPath);
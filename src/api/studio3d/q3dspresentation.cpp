@@ -44,6 +44,10 @@
 #include <QtCore/qfileinfo.h>
 #include <QtCore/qdir.h>
 #include <QtGui/qevent.h>
+#include <QtGui/qcolor.h>
+#include <QtGui/qvector2d.h>
+#include <QtGui/qvector3d.h>
+#include <QtGui/qvector4d.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -1210,6 +1214,126 @@ uint Q3DSPresentation::textureId(const QString &elementPath, QSize &size, GLenum
     return 0;
 }
 
+/*!
+    \since Qt 3D Studio 2.8
+    Returns a handle to the attribute \a attributeName of the object specified by
+    \a elementPath. See setAttribute() for a description of \a elementPath.
+
+    The handle can be passed to setAttributeValue() and setAttributeValues() to write
+    float, vector and color attributes without looking up the element and the attribute
+    by name on every write. Vector and color attributes, such as \c position or
+    \c diffuse, are addressed by their base name.
+
+    The element and the attribute are resolved by the runtime on the first write and
+    again after elements have been created or deleted, so the handle can be requested
+    before the presentation has been loaded. A handle stays valid until it is released
+    with releaseAttributeHandle().
+
+    \sa setAttributeValue(), setAttributeValues()
+ */
+int Q3DSPresentation::attributeHandle(const QString &elementPath, const QString &attributeName)
+{
+    const int handle = d_ptr->m_nextAttributeHandle++;
+    d_ptr->registerAttributeHandle(handle, elementPath, attributeName);
+    if (!d_ptr->m_viewerApp && d_ptr->m_commandQueue) {
+        d_ptr->m_commandQueue->queueCommand(elementPath, CommandType_RegisterAttributeHandle,
+                                            attributeName, QVariant(), handle);
+    }
+    return handle;
+}
+
+/*!
+    \since Qt 3D Studio 2.8
+    Releases an attribute \a handle returned by attributeHandle().
+ */
+void Q3DSPresentation::releaseAttributeHandle(int handle)
+{
+    d_ptr->releaseAttributeHandle(handle);
+    if (!d_ptr->m_viewerApp && d_ptr->m_commandQueue)
+        d_ptr->m_commandQueue->queueCommand(QString(), CommandType_ReleaseAttributeHandle, handle);
+}
+
+/*!
+    \since Qt 3D Studio 2.8
+    Sets the \a value of the float attribute specified by \a handle.
+
+    \sa attributeHandle()
+ */
+void Q3DSPresentation::setAttributeValue(int handle, float value)
+{
+    const float values[4] = { value, 0.0f, 0.0f, 0.0f };
+    d_ptr->setAttributeHandleValues(&handle, values, 1);
+}
+
+/*!
+    \since Qt 3D Studio 2.8
+    \overload
+    Sets the \a value of the two component vector attribute specified by \a handle.
+ */
+void Q3DSPresentation::setAttributeValue(int handle, const QVector2D &value)
+{
+    const float values[4] = { value.x(), value.y(), 0.0f, 0.0f };
+    d_ptr->setAttributeHandleValues(&handle, values, 1);
+}
+
+/*!
+    \since Qt 3D Studio 2.8
+    \overload
+    Sets the \a value of the three component vector attribute specified by \a handle.
+ */
+void Q3DSPresentation::setAttributeValue(int handle, const QVector3D &value)
+{
+    const float values[4] = { value.x(), value.y(), value.z(), 0.0f };
+    d_ptr->setAttributeHandleValues(&handle, values, 1);
+}
+
+/*!
+    \since Qt 3D Studio 2.8
+    \overload
+    Sets the \a value of the four component vector attribute specified by \a handle.
+ */
+void Q3DSPresentation::setAttributeValue(int handle, const QVector4D &value)
+{
+    const float values[4] = { value.x(), value.y(), value.z(), value.w() };
+    d_ptr->setAttributeHandleValues(&handle, values, 1);
+}
+
+/*!
+    \since Qt 3D Studio 2.8
+    \overload
+    Sets the \a value of the color attribute specified by \a handle.
+ */
+void Q3DSPresentation::setAttributeValue(int handle, const QColor &value)
+{
+    const float values[4] = { float(value.redF()), float(value.greenF()), float(value.blueF()),
+                              float(value.alphaF()) };
+    d_ptr->setAttributeHandleValues(&handle, values, 1);
+}
+
+/*!
+    \since Qt 3D Studio 2.8
+    Sets the attributes specified by \a handles to the corresponding \a values in one go.
+    Only as many components of each value are used as the attribute has, so a float
+    attribute takes the \c x component and a color attribute takes all four.
+
+    When the presentation is shown in a Studio3D item, the whole batch is passed to the
+    render thread as a single command.
+
+    \sa attributeHandle()
+ */
+void Q3DSPresentation::setAttributeValues(const QVector<int> &handles,
+                                          const QVector<QVector4D> &values)
+{
+    Q_STATIC_ASSERT(sizeof(QVector4D) == 4 * sizeof(float));
+    if (handles.size() != values.size()) {
+        qWarning() << __FUNCTION__ << "Handle and value counts do not match";
+        return;
+    }
+    d_ptr->setAttributeHandleValues(handles.constData(),
+                                    reinterpret_cast<const float *>(values.constData()),
+                                    handles.size());
+}
+
 /*!
     Activate or deactivate the presentation identified by \a id depending
     on the value of \a active.
@@ -2002,6 +2126,11 @@ void Q3DSPresentationPrivate::setViewerApp(Q3DSViewer::Q3DSViewerApp *app, bool
             }
         }
         Q_EMIT q_ptr->dataInputsReady();
+
+        for (auto it = m_attributeHandles.cbegin(); it != m_attributeHandles.cend(); ++it) {
+            m_viewerApp->RegisterAttributeHandle(it.key(), it.value().first.toUtf8().constData(),
+                                                 it.value().second.toUtf8().constData());
+        }
     }
 
     if (connectApp) {
@@ -2487,6 +2616,33 @@ bool Q3DSPresentationPrivate::dataInputsChanged() const
     return m_dataInputsChanged;
 }
 
+void Q3DSPresentationPrivate::registerAttributeHandle(int handle, const QString &elementPath,
+                                                      const QString &attributeName)
+{
+    m_attributeHandles.insert(handle, {elementPath, attributeName});
+    if (m_viewerApp) {
+        m_viewerApp->RegisterAttributeHandle(handle, elementPath.toUtf8().constData(),
+                                             attributeName.toUtf8().constData());
+    }
+}
+
+void Q3DSPresentationPrivate::releaseAttributeHandle(int handle)
+{
+    m_attributeHandles.remove(handle);
+    if (m_viewerApp)
+        m_viewerApp->ReleaseAttributeHandle(handle);
+}
+
+// Values contains four floats per handle
+void Q3DSPresentationPrivate::setAttributeHandleValues(const int *handles, const float *values,
+                                                       int count)
+{
+    if (m_viewerApp)
+        m_viewerApp->SetAttributeHandleValues(handles, values, count);
+    else if (m_commandQueue)
+        m_commandQueue->queueAttributeHandleValues(handles, values, count);
+}
+
 void Q3DSPresentationPrivate::setDataInputValueBatch()
 {
     QVector<QPair<QString, QVariant>> *theProperties = new QVector<QPair<QString, QVariant>>();
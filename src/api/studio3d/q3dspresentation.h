@@ -49,6 +49,10 @@ class QMouseEvent;
 class QWheelEvent;
 class QKeyEvent;
 class QQmlImageProviderBase;
+class QVector2D;
+class QVector3D;
+class QVector4D;
+class QColor;
 
 class Q_STUDIO3D_EXPORT Q3DSPresentation : public QObject
 {
@@ -137,6 +141,15 @@ public:
     uint textureId(const QString &elementPath);
     uint textureId(const QString &elementPath, QSize &size, GLenum &format);
 
+    int attributeHandle(const QString &elementPath, const QString &attributeName);
+    void releaseAttributeHandle(int handle);
+    void setAttributeValue(int handle, float value);
+    void setAttributeValue(int handle, const QVector2D &value);
+    void setAttributeValue(int handle, const QVector3D &value);
+    void setAttributeValue(int handle, const QVector4D &value);
+    void setAttributeValue(int handle, const QColor &value);
+    void setAttributeValues(const QVector<int> &handles, const QVector<QVector4D> &values);
+
 public Q_SLOTS:
     void setSource(const QUrl &source);
     void setVariantList(const QStringList &variantList);
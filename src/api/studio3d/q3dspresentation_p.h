@@ -96,6 +96,11 @@ public:
 
     void setDataInputValueBatch();
 
+    void registerAttributeHandle(int handle, const QString &elementPath,
+                                 const QString &attributeName);
+    void releaseAttributeHandle(int handle);
+    void setAttributeHandleValues(const int *handles, const float *values, int count);
+
     ViewerQmlStreamProxy *streamProxy();
     Q3DStudio::EKeyCode getScanCode(QKeyEvent *e);
 
@@ -138,6 +143,9 @@ private:
     bool m_shaderCacheDumpPending = false;
     int m_shaderCacheCompression = -1;
     int m_dataInputCallIndex = 0;
+    // Attribute handles are kept so that they can be registered again with a new viewer app
+    QHash<int, QPair<QString, QString>> m_attributeHandles;
+    int m_nextAttributeHandle = 1;
 
     friend class Q3DSStudio3D;
 };
@@ -552,8 +552,11 @@ void Q3DSSurfaceViewerPrivate::update()
 
             const uint defaultFbo = m_context->defaultFramebufferObject();
 
-            if (m_surface->surfaceClass() == QSurface::Window && m_fboId == defaultFbo)
+            // Swapping after a skipped frame would show an undefined back buffer
+            if (m_surface->surfaceClass() == QSurface::Window && m_fboId == defaultFbo
+                    && !m_viewerApp->WasLastFrameSkipped()) {
                 m_context->swapBuffers(m_surface);
+            }
 
             Q_EMIT q_ptr->frameUpdate();
         }
@@ -587,6 +590,7 @@ QImage Q3DSSurfaceViewerPrivate::grab(const QRect &rect)
         // the surface has a non-preserved swap buffer
         if (m_autoSize)
             setSize(m_surface->size());
+        m_viewerApp->RequestRender();
         m_viewerApp->Render();
 
         m_context->functions()->glBindFramebuffer(GL_FRAMEBUFFER, m_fboId);
@@ -408,6 +408,48 @@ void Q3DSViewerSettings::setSkipFramesInterval(int interval)
     }
 }
 
+/*!
+    \qmlproperty bool ViewerSettings::renderOnDemand
+
+    \since QtStudio3D.OpenGL 2.8
+
+    Specifies if frames are rendered only when something changed. When
+    enabled, a frame is rendered only if the scene changed through animations,
+    slides, data inputs or scripts, input was received, a subpresentation
+    updated, images finished loading or a viewer setting changed. Otherwise
+    the previous frame is kept, decreasing the CPU/GPU usage of static
+    presentations.
+
+    The default value is \c false.
+ */
+/*!
+    \property Q3DSViewerSettings::renderOnDemand
+
+    \since Qt 3D Studio 2.8
+
+    Specifies if frames are rendered only when something changed. When
+    enabled, a frame is rendered only if the scene changed through animations,
+    slides, data inputs or scripts, input was received, a subpresentation
+    updated, images finished loading or a viewer setting changed. Otherwise
+    the previous frame is kept, decreasing the CPU/GPU usage of static
+    presentations.
+
+    The default value is \c false.
+ */
+
+bool Q3DSViewerSettings::renderOnDemand() const
+{
+    return d_ptr->m_renderOnDemand;
+}
+
+void Q3DSViewerSettings::setRenderOnDemand(bool enabled)
+{
+    if (d_ptr->m_renderOnDemand != enabled) {
+        d_ptr->setRenderOnDemand(enabled);
+        Q_EMIT renderOnDemandChanged(enabled);
+    }
+}
+
 /*!
     \qmlproperty bool ViewerSettings::matteEnabled
 
@@ -489,6 +531,7 @@ Q3DSViewerSettingsPrivate::Q3DSViewerSettingsPrivate(Q3DSViewerSettings *q)
     , m_stereoEyeSeparation(0.4)
     , m_stereoProgressiveEnabled(false)
     , m_skipFramesInterval(0)
+    , m_renderOnDemand(false)
     , m_savedSettings(nullptr)
 {
 }
@@ -510,6 +553,7 @@ void Q3DSViewerSettingsPrivate::setViewerApp(Q3DSViewer::Q3DSViewerApp *app)
         setStereoEyeSeparation(m_stereoEyeSeparation);
         setStereoProgressiveEnabled(m_stereoProgressiveEnabled);
         setSkipFramesInterval(m_skipFramesInterval);
+        setRenderOnDemand(m_renderOnDemand);
     }
 }
 
@@ -526,6 +570,7 @@ void Q3DSViewerSettingsPrivate::setCommandQueue(CommandQueue *queue)
         setStereoEyeSeparation(m_stereoEyeSeparation);
         setStereoProgressiveEnabled(m_stereoProgressiveEnabled);
         setSkipFramesInterval(m_skipFramesInterval);
+        setRenderOnDemand(m_renderOnDemand);
     }
 }
 
@@ -681,6 +726,17 @@ void Q3DSViewerSettingsPrivate::setSkipFramesInterval(int interval)
     }
 }
 
+void Q3DSViewerSettingsPrivate::setRenderOnDemand(bool enabled)
+{
+    m_renderOnDemand = enabled;
+    if (m_viewerApp) {
+        m_viewerApp->SetRenderOnDemand(enabled);
+    } else if (m_commandQueue) {
+        m_commandQueue->m_renderOnDemand = enabled;
+        m_commandQueue->m_renderOnDemandChanged = true;
+    }
+}
+
 void Q3DSViewerSettingsPrivate::initSettingsStore(const QString &group, const QString &organization,
                                                   const QString &application)
 {
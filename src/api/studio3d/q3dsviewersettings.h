@@ -54,6 +54,7 @@ class Q_STUDIO3D_EXPORT Q3DSViewerSettings : public QObject
     Q_PROPERTY(double stereoEyeSeparation READ stereoEyeSeparation WRITE setStereoEyeSeparation NOTIFY stereoEyeSeparationChanged REVISION 1)
     Q_PROPERTY(bool stereoProgressiveEnabled READ stereoProgressiveEnabled WRITE setStereoProgressiveEnabled NOTIFY stereoProgressiveEnabledChanged REVISION 2)
     Q_PROPERTY(int skipFramesInterval READ skipFramesInterval WRITE setSkipFramesInterval NOTIFY skipFramesIntervalChanged REVISION 2)
+    Q_PROPERTY(bool renderOnDemand READ renderOnDemand WRITE setRenderOnDemand NOTIFY renderOnDemandChanged REVISION 3)
 
 public:
     enum ShadeMode {
@@ -86,6 +87,7 @@ public:
     double stereoEyeSeparation() const;
     Q_REVISION(2) bool stereoProgressiveEnabled() const;
     Q_REVISION(2) int skipFramesInterval() const;
+    Q_REVISION(3) bool renderOnDemand() const;
 
     Q_INVOKABLE void save(const QString &group, const QString &organization = QString(),
                           const QString &application = QString());
@@ -101,6 +103,7 @@ public Q_SLOTS:
     void setStereoEyeSeparation(double separation);
     Q_REVISION(2) void setStereoProgressiveEnabled(bool enabled);
     Q_REVISION(2) void setSkipFramesInterval(int interval);
+    Q_REVISION(3) void setRenderOnDemand(bool enabled);
 
 Q_SIGNALS:
     void matteEnabledChanged(bool enabled);
@@ -112,6 +115,7 @@ Q_SIGNALS:
     void stereoEyeSeparationChanged(double separation);
     Q_REVISION(2) void stereoProgressiveEnabledChanged(bool enabled);
     Q_REVISION(2) void skipFramesIntervalChanged(int interval);
+    Q_REVISION(3) void renderOnDemandChanged(bool enabled);
 
 private:
     Q_DISABLE_COPY(Q3DSViewerSettings)
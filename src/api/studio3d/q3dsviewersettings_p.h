@@ -71,6 +71,7 @@ public:
     void setStereoEyeSeparation(double separation);
     void setStereoProgressiveEnabled(bool enabled);
     void setSkipFramesInterval(int interval);
+    void setRenderOnDemand(bool enabled);
 
 public:
     Q3DSViewerSettings *q_ptr;
@@ -90,6 +91,7 @@ private:
     double m_stereoEyeSeparation;
     bool m_stereoProgressiveEnabled;
     int m_skipFramesInterval;
+    bool m_renderOnDemand;
     QSettings *m_savedSettings;
 };
 
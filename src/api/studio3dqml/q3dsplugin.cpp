@@ -70,6 +70,9 @@ void Q3DSPlugin::registerTypes(const char *uri)
     qmlRegisterType<Q3DSViewerSettings, 2>(uri, 2, 7, "ViewerSettings");
     qmlRegisterRevision<Q3DSPresentation, 2>(uri, 2, 7);
 
+    // 2.8
+    qmlRegisterType<Q3DSViewerSettings, 3>(uri, 2, 8, "ViewerSettings");
+
     // Automatically register the latest version
     qmlRegisterModule(uri, ((QTSTUDIO3D_VERSION >> 16) & 0xff), ((QTSTUDIO3D_VERSION >> 8) & 0xff));
 }
@@ -331,6 +331,17 @@ void Q3DSRenderer::onUpdateHandler(void *userData)
 void Q3DSRenderer::processCommands()
 {
     if (!m_runtime) {
+        // Attribute handles must survive until the runtime is there to resolve them
+        for (int i = 0; i < m_commands.size(); i++) {
+            const ElementCommand &cmd = m_commands.constCommandAt(i);
+            if (cmd.m_commandType == CommandType_RegisterAttributeHandle) {
+                m_presentation->d_ptr->registerAttributeHandle(cmd.m_intValues[0],
+                                                               m_commands.elementPath(cmd),
+                                                               m_commands.stringValue(cmd));
+            } else if (cmd.m_commandType == CommandType_ReleaseAttributeHandle) {
+                m_presentation->d_ptr->releaseAttributeHandle(cmd.m_intValues[0]);
+            }
+        }
         m_commands.clear(true);
         return;
     }
@@ -355,6 +366,8 @@ void Q3DSRenderer::processCommands()
         m_settings->setStereoProgressiveEnabled(m_commands.m_stereoProgressiveEnabled);
     if (m_commands.m_skipFramesIntervalChanged)
         m_settings->setSkipFramesInterval(m_commands.m_skipFramesInterval);
+    if (m_commands.m_renderOnDemandChanged)
+        m_settings->setRenderOnDemand(m_commands.m_renderOnDemand);
     if (m_commands.m_shadeModeChanged)
         m_settings->setShadeMode(m_commands.m_shadeMode);
     if (m_commands.m_matteColorChanged)
@@ -374,26 +387,46 @@ void Q3DSRenderer::processCommands()
         const ElementCommand &cmd = m_commands.constCommandAt(i);
         switch (cmd.m_commandType) {
         case CommandType_SetAttribute:
-            m_presentation->setAttribute(cmd.m_elementPath, cmd.m_stringValue, cmd.m_variantValue);
+            m_presentation->setAttribute(m_commands.elementPath(cmd), m_commands.stringValue(cmd),
+                                         m_commands.value(cmd));
+            break;
+        case CommandType_RegisterAttributeHandle:
+            m_presentation->d_ptr->registerAttributeHandle(cmd.m_intValues[0],
+                                                           m_commands.elementPath(cmd),
+                                                           m_commands.stringValue(cmd));
             break;
+        case CommandType_ReleaseAttributeHandle:
+            m_presentation->d_ptr->releaseAttributeHandle(cmd.m_intValues[0]);
+            break;
+        case CommandType_SetAttributeHandleValues: {
+            const AttributeHandleValues *data = static_cast<AttributeHandleValues *>(cmd.m_data);
+            m_presentation->d_ptr->setAttributeHandleValues(data->handles.constData(),
+                                                            data->values.constData(),
+                                                            data->handles.size());
+            // No need for data after this, delete.
+            auto &command = m_commands.commandAt(i);
+            delete data;
+            command.m_data = nullptr;
+            break;
+        }
         case CommandType_SetPresentationActive:
-            m_presentation->setPresentationActive(cmd.m_elementPath, cmd.m_boolValue);
+            m_presentation->setPresentationActive(m_commands.elementPath(cmd), cmd.m_boolValue);
             break;
         case CommandType_GoToTime:
-            m_presentation->goToTime(cmd.m_elementPath, cmd.m_floatValue);
+            m_presentation->goToTime(m_commands.elementPath(cmd), cmd.m_floatValue);
             break;
         case CommandType_GoToSlide:
-            m_presentation->goToSlide(cmd.m_elementPath, quint32(cmd.m_intValues[0]));
+            m_presentation->goToSlide(m_commands.elementPath(cmd), quint32(cmd.m_intValues[0]));
             break;
         case CommandType_GoToSlideByName:
-            m_presentation->goToSlide(cmd.m_elementPath, cmd.m_stringValue);
+            m_presentation->goToSlide(m_commands.elementPath(cmd), m_commands.stringValue(cmd));
             break;
         case CommandType_GoToSlideRelative:
-            m_presentation->goToSlide(cmd.m_elementPath, bool(cmd.m_intValues[0]),
+            m_presentation->goToSlide(m_commands.elementPath(cmd), bool(cmd.m_intValues[0]),
                     bool(cmd.m_intValues[1]));
             break;
         case CommandType_FireEvent:
-            m_presentation->fireEvent(cmd.m_elementPath, cmd.m_stringValue);
+            m_presentation->fireEvent(m_commands.elementPath(cmd), m_commands.stringValue(cmd));
             break;
         case CommandType_MousePress:
             m_runtime->HandleMousePress(cmd.m_intValues[0],
@@ -418,7 +451,7 @@ void Q3DSRenderer::processCommands()
             break;
         case CommandType_SetDataInputValue:
             m_runtime->SetDataInputValue(
-                        cmd.m_stringValue, cmd.m_variantValue,
+                        m_commands.stringValue(cmd), m_commands.value(cmd),
                         static_cast<qt3ds::runtime::DataInputValueRole>(cmd.m_intValues[0]));
             break;
         case CommandType_SetDataInputBatch: {
@@ -436,7 +469,7 @@ void Q3DSRenderer::processCommands()
         }
         case CommandType_CreateElements: {
             m_runtime->createElements(
-                        cmd.m_elementPath, cmd.m_stringValue,
+                        m_commands.elementPath(cmd), m_commands.stringValue(cmd),
                         *static_cast<QVector<QHash<QString, QVariant>> *>(cmd.m_data));
             // Runtime makes copy of the data in its own format, so we can delete it now
             auto &command = m_commands.commandAt(i);
@@ -453,7 +486,8 @@ void Q3DSRenderer::processCommands()
             break;
         }
         case CommandType_CreateMaterials: {
-            m_runtime->createMaterials(cmd.m_elementPath, *static_cast<QStringList *>(cmd.m_data));
+            m_runtime->createMaterials(m_commands.elementPath(cmd),
+                                       *static_cast<QStringList *>(cmd.m_data));
             // Runtime makes copy of the data in its own format, so we can delete it now
             auto &command = m_commands.commandAt(i);
             delete reinterpret_cast<QStringList *>(command.m_data);
@@ -488,13 +522,13 @@ void Q3DSRenderer::processCommands()
             break;
         }
         case CommandType_PreloadSlide:
-            m_runtime->preloadSlide(cmd.m_elementPath);
+            m_runtime->preloadSlide(m_commands.elementPath(cmd));
             break;
         case CommandType_UnloadSlide:
-            m_runtime->unloadSlide(cmd.m_elementPath);
+            m_runtime->unloadSlide(m_commands.elementPath(cmd));
             break;
         case CommandType_AddImageProvider:
-            m_runtime->addImageProvider(cmd.m_elementPath,
+            m_runtime->addImageProvider(m_commands.elementPath(cmd),
                                         static_cast<QQmlImageProviderBase *>(cmd.m_data));
             break;
         case CommandType_RequestSlideInfo: {
@@ -502,7 +536,7 @@ void Q3DSRenderer::processCommands()
             int previous = 0;
             QString currentName;
             QString previousName;
-            const QByteArray path(cmd.m_elementPath.toUtf8());
+            const QByteArray path(m_commands.elementPath(cmd).toUtf8());
             m_runtime->GetSlideInfo(path, current, previous, currentName, previousName);
             QVariantList *requestData = new QVariantList();
             requestData->append(QVariant(current));
@@ -510,7 +544,7 @@ void Q3DSRenderer::processCommands()
             requestData->append(QVariant(currentName));
             requestData->append(QVariant(previousName));
 
-            Q_EMIT requestResponse(cmd.m_elementPath, cmd.m_commandType, requestData);
+            Q_EMIT requestResponse(m_commands.elementPath(cmd), cmd.m_commandType, requestData);
             break;
         }
         case CommandType_RequestDataInputs: {
@@ -527,7 +561,7 @@ void Q3DSRenderer::processCommands()
                 }
             }
 
-            Q_EMIT requestResponse(cmd.m_elementPath, cmd.m_commandType, requestData);
+            Q_EMIT requestResponse(m_commands.elementPath(cmd), cmd.m_commandType, requestData);
             break;
         }
         case CommandType_RequestDataOutputs: {
@@ -539,7 +573,7 @@ void Q3DSRenderer::processCommands()
                     requestData->append(QVariant::fromValue(it->name()));
             }
 
-            Q_EMIT requestResponse(cmd.m_elementPath, cmd.m_commandType, requestData);
+            Q_EMIT requestResponse(m_commands.elementPath(cmd), cmd.m_commandType, requestData);
             break;
         }
         case CommandType_RequestExportShaderCache: {
@@ -50,6 +50,7 @@
 #include "Qt3DSRenderShaderCache.h"
 #include "Qt3DSRenderImageBatchLoader.h"
 #include "Qt3DSPresentation.h"
+#include "Qt3DSSlideSystem.h"
 
 #include "Qt3DSDLLManager.h"
 #include "Qt3DSBasicPluginDLL.h"
@@ -196,6 +197,10 @@ struct Qt3DSRenderScene : public Q3DStudio::IScene
                 m_Context->GetRenderer().ReleaseLayerRenderResources(*theLayer, nullptr);
             }
         }
+        for (QT3DSU32 idx = 0, end = m_GraphObjectList.size(); idx < end; ++idx) {
+            if (m_GraphObjectList[idx]->m_Type == GraphObjectTypes::DefaultMaterial)
+                m_Context->GetRenderer().ReleaseMaterialRenderResources(*m_GraphObjectList[idx]);
+        }
     }
 
     qt3ds::NVAllocatorCallback &allocator() override { return m_LoadData->m_AutoAllocator; }
@@ -298,6 +303,75 @@ struct Qt3DSRenderScene : public Q3DStudio::IScene
         return false;
     }
 
+    typedef nvvector<eastl::pair<Q3DStudio::TElement *, bool>> TElementActivityList;
+    typedef nvvector<eastl::pair<SNode *, bool>> TNodeActivityList;
+
+    // Sets the activity a slide gives its elements on their render nodes, remembering the
+    // previous activity in ioSaved. Text nodes are left alone, activating them would rasterize
+    // their text.
+    static void ApplySlideActivity(const TElementActivityList &inElements,
+                                   TNodeActivityList &ioSaved)
+    {
+        for (QT3DSU32 idx = 0, end = inElements.size(); idx < end; ++idx) {
+            Qt3DSTranslator *theTranslator =
+                reinterpret_cast<Qt3DSTranslator *>(inElements[idx].first->GetAssociation());
+            if (!theTranslator || !theTranslator->m_RenderObject
+                || !GraphObjectTypes::IsNodeType(theTranslator->m_RenderObject->m_Type)
+                || theTranslator->m_RenderObject->m_Type == GraphObjectTypes::Text) {
+                continue;
+            }
+            SNode &theNode = static_cast<SNode &>(*theTranslator->m_RenderObject);
+            ioSaved.push_back(eastl::make_pair(&theNode, theNode.m_Flags.IsActive()));
+            theNode.m_Flags.SetActive(inElements[idx].second);
+        }
+    }
+
+    static void RestoreActivity(TNodeActivityList &ioSaved)
+    {
+        // Backwards so that nodes listed more than once end up with their first saved value.
+        for (QT3DSU32 idx = ioSaved.size(); idx > 0; --idx)
+            ioSaved[idx - 1].first->m_Flags.SetActive(ioSaved[idx - 1].second);
+        ioSaved.clear();
+    }
+
+    // Shader keys depend on which nodes and lights are active together, so the keys are
+    // collected for the current state and then for every slide of every component, with the
+    // rest of the presentation in its current state. A union of all slides would produce light
+    // counts and feature combinations that no slide ever renders.
+    void PrecompileShaders()
+    {
+        if (!m_Presentation || !m_Presentation->m_Scene || !m_Presentation->m_Scene->m_FirstChild)
+            return;
+        SLayer &theLayer = *m_Presentation->m_Scene->m_FirstChild;
+        const QT3DSVec2 theDimensions = m_Presentation->m_PresentationDimensions;
+        IQt3DSRenderer &theRenderer = m_Context->GetRenderer();
+        theRenderer.PrecompileShaders(theLayer, theDimensions);
+
+        qt3ds::runtime::ISlideSystem &theSlideSystem = m_RuntimePresentation->GetSlideSystem();
+        NVAllocatorCallback &theAllocator = m_Context->GetAllocator();
+        nvvector<Q3DStudio::TElement *> theComponents(theAllocator,
+                                                      "Qt3DSRenderScene::PrecompileShaders");
+        TElementActivityList theElements(theAllocator, "Qt3DSRenderScene::PrecompileShaders");
+        TNodeActivityList theSaved(theAllocator, "Qt3DSRenderScene::PrecompileShaders");
+        theSlideSystem.GetComponents(theComponents);
+        for (QT3DSU32 idx = 0, end = theComponents.size(); idx < end; ++idx) {
+            Q3DStudio::TElement &theComponent = *theComponents[idx];
+            // Slide 0 is the master slide, entering any other slide executes it first.
+            for (QT3DSU32 slideIdx = 1;; ++slideIdx) {
+                theElements.clear();
+                theSlideSystem.GetSlideElementActivity(
+                            qt3ds::runtime::SSlideKey(theComponent, 0), theElements);
+                if (!theSlideSystem.GetSlideElementActivity(
+                            qt3ds::runtime::SSlideKey(theComponent, slideIdx), theElements)) {
+                    break;
+                }
+                ApplySlideActivity(theElements, theSaved);
+                theRenderer.PrecompileShaders(theLayer, theDimensions);
+                RestoreActivity(theSaved);
+            }
+        }
+    }
+
     void Render()
     {
         if (m_Presentation && m_Presentation->m_Scene) {
@@ -808,13 +882,6 @@ struct Qt3DSRenderSceneManager : public Q3DStudio::ISceneManager,
 
     QT3DS_IMPLEMENT_REF_COUNT_ADDREF_RELEASE_OVERRIDE(m_Context->GetAllocator())
 
-    static QT3DSU32 GetFileTag()
-    {
-        const char *fileTag = "Qt3DSS";
-        const QT3DSU32 *theTagPtr = reinterpret_cast<const QT3DSU32 *>(fileTag);
-        return *theTagPtr;
-    }
-
     void FinalizeScene(Q3DStudio::IPresentation &inPresentation, Qt3DSRenderScene &inScene)
     {
         inPresentation.SetScene(&inScene);
@@ -932,6 +999,8 @@ struct Qt3DSRenderSceneManager : public Q3DStudio::ISceneManager,
             // List of image paths to be loaded in parallel at the end.
             eastl::vector<CRegisteredString> theSourcePathList;
             eastl::vector<CRegisteredString> iblList;
+            // Meshes are parsed in parallel and uploaded once they are all requested.
+            eastl::vector<CRegisteredString> theMeshList;
             for (QT3DSU32 idx = 0, end = theSourcePathData.size(); idx < end; ++idx) {
                 const eastl::string &theValue = theSourcePathData[idx];
                 CRegisteredString theSourcePath =
@@ -958,11 +1027,15 @@ struct Qt3DSRenderSceneManager : public Q3DStudio::ISceneManager,
 
                         }
                     } else if (theValue.find(".mesh") != eastl::string::npos) {
-                        theManager.LoadMesh(theObjectPath);
+                        theMeshList.push_back(theObjectPath);
                     }
                 }
             }
 
+            theManager.PreloadMeshes(toConstDataRef(theMeshList.data(), theMeshList.size()));
+            for (QT3DSU32 idx = 0, end = theMeshList.size(); idx < end; ++idx)
+                theManager.LoadMesh(theMeshList[idx]);
+
             // Fire off parallel loading of the source paths
             QT3DSU64 imageBatchId = m_Context->m_Context->GetImageBatchLoader().LoadImageBatch(
                 toConstDataRef(theSourcePathList.data(), theSourcePathList.size()),
@@ -1031,18 +1104,17 @@ struct Qt3DSRenderSceneManager : public Q3DStudio::ISceneManager,
     {
         QT3DS_PERF_SCOPED_TIMER(m_Context->m_CoreContext->GetPerfTimer(),
                                 "Binding: Load Scene Graph Stage 1")
+        // Pages of a mapped file are only read as the graph is fixed up, so the checksum is
+        // opt in rather than reading the whole file up front.
+        bool theVerifyChecksum = qEnvironmentVariableIsSet("QT3DS_VERIFY_BINARY_SCENES");
         NVDataRef<QT3DSU8> theLoadedData(inData.Data());
-        SDataReader theReader(theLoadedData.begin(), theLoadedData.end());
-
-        QT3DSU32 theFileSig = theReader.LoadRef<QT3DSU32>();
-        QT3DSU32 theBinaryVersion = theReader.LoadRef<QT3DSU32>();
-        QT3DSU32 theDataSectionSize = QT3DSU32(theReader.m_EndPtr - theReader.m_CurrentPtr);
-
-        if (theFileSig != GetFileTag()
-            || theBinaryVersion != SGraphObject::GetSceneGraphBinaryVersion()) {
-            QT3DS_ASSERT(false);
+        const SBinarySceneHeader *theHeader =
+            SBinarySceneHeader::Validate(theLoadedData, theVerifyChecksum, inData.Path().c_str());
+        if (!theHeader)
             return 0;
-        }
+        QT3DSU8 *theDataSection = theLoadedData.begin() + sizeof(SBinarySceneHeader);
+        QT3DSU32 theDataSectionSize = theHeader->m_DataSize;
+
         QT3DSU32 theLoadingSceneIndex = 0;
         SSceneLoadData *theScene;
         {
@@ -1055,11 +1127,11 @@ struct Qt3DSRenderSceneManager : public Q3DStudio::ISceneManager,
         // preserve the data buffer because we run directly from it; there isn't a memcopy.
         theScene->m_Data = inData;
 
-        QT3DSU32 theTranslatorOffset = theReader.LoadRef<QT3DSU32>();
+        QT3DSU32 theTranslatorOffset = theHeader->m_TranslatorOffset;
 
-        NVDataRef<QT3DSU8> theSGData = NVDataRef<QT3DSU8>(theReader.m_CurrentPtr, theTranslatorOffset);
+        NVDataRef<QT3DSU8> theSGData = NVDataRef<QT3DSU8>(theDataSection, theTranslatorOffset);
         NVDataRef<QT3DSU8> theTranslatorData = NVDataRef<QT3DSU8>(
-            theReader.m_CurrentPtr + theTranslatorOffset, theDataSectionSize - theTranslatorOffset);
+            theDataSection + theTranslatorOffset, theDataSectionSize - theTranslatorOffset);
 
         CStrTableOrDataRef theStrTableData(m_Context->m_CoreContext->GetStringTable());
         if (m_StrTableData.size())
@@ -1127,6 +1199,7 @@ struct Qt3DSRenderSceneManager : public Q3DStudio::ISceneManager,
                                                       "imagePathList");
         nvvector<CRegisteredString> iblImagePathList(m_Context->GetAllocator(),
                                                       "iblImagePathList");
+        nvvector<CRegisteredString> meshPathList(m_Context->GetAllocator(), "meshPathList");
         for (QT3DSU32 idx = 0, end = m_SourcePaths.size(); idx < end; ++idx) {
             theSourcePathStr.assign(m_SourcePaths[idx].first);
             bool hasTransparency = m_SourcePaths[idx].second.first;
@@ -1143,10 +1216,13 @@ struct Qt3DSRenderSceneManager : public Q3DStudio::ISceneManager,
                         imagePathList.push_back(theObjectPath);
                 } else {
                     if (theSourcePathStr.find(".mesh") != eastl::string::npos)
-                        theManager.LoadMesh(theObjectPath);
+                        meshPathList.push_back(theObjectPath);
                 }
             }
         }
+        theManager.PreloadMeshes(toConstDataRef(meshPathList.data(), meshPathList.size()));
+        for (QT3DSU32 idx = 0, end = meshPathList.size(); idx < end; ++idx)
+            theManager.LoadMesh(meshPathList[idx]);
 
         bool pktx = false;
         for (unsigned int i = 0; i < m_Scenes.size(); ++i) {
@@ -1248,13 +1324,11 @@ struct Qt3DSRenderSceneManager : public Q3DStudio::ISceneManager,
         Qt3DSRenderScene &theScene = static_cast<Qt3DSRenderScene &>(inScene);
         qt3ds::render::SWriteBuffer theWriteBuffer(m_Context->GetAllocator(), "BinarySaveBuffer");
         qt3ds::render::SPtrOffsetMap theSGOffsetMap(m_Context->GetAllocator(), "PointerOffsetMap");
-        // Start with some versioning and sanity checks.
-        theWriteBuffer.write(GetFileTag());
-        theWriteBuffer.write(SGraphObject::GetSceneGraphBinaryVersion());
-        QT3DSU32 theTranslatorOffsetAddress = theWriteBuffer.size();
-        // Now the data section starts.  Offsets should be relative to here, not the first
-        // 8 bytes.
-        theWriteBuffer.writeZeros(4); // offset where the translator data starts;
+        // Start with some versioning and sanity checks, filled in at the end.
+        SBinarySceneHeader theHeader;
+        memZero(&theHeader, sizeof(theHeader));
+        theWriteBuffer.write(theHeader);
+        // Now the data section starts.  Offsets should be relative to here, not the header.
         QT3DSU32 theDataSectionStart = theWriteBuffer.size();
 
         // These offsets are after we have read in the data section
@@ -1292,9 +1366,12 @@ struct Qt3DSRenderSceneManager : public Q3DStudio::ISceneManager,
         QT3DSU32 *theTranslatorCountPtr =
             reinterpret_cast<QT3DSU32 *>(theWriteBuffer.begin() + theTranslatorCountAddress);
         *theTranslatorCountPtr = theTranslatorCount;
-        QT3DSU32 *theTranslatorOffsetPtr =
-            reinterpret_cast<QT3DSU32 *>(theWriteBuffer.begin() + theTranslatorOffsetAddress);
-        *theTranslatorOffsetPtr = theTranslatorOffset;
+        SBinarySceneHeader *theHeaderPtr =
+            reinterpret_cast<SBinarySceneHeader *>(theWriteBuffer.begin());
+        theHeaderPtr->Finalize(
+            toConstDataRef(theWriteBuffer.begin() + theDataSectionStart,
+                           theWriteBuffer.size() - theDataSectionStart),
+            theTranslatorOffset);
 
         Q3DStudio::IPresentation &thePresentation = *theScene.m_RuntimePresentation;
         eastl::string theBinaryPath(thePresentation.GetFilePath().toLatin1().constData());
@@ -1526,6 +1603,15 @@ struct Qt3DSRenderSceneManager : public Q3DStudio::ISceneManager,
             m_Scenes[idx].second->TransferDirtyProperties();
         }
 
+        // Generate the default material shaders of all slides before the first frame so that
+        // slide changes do not stall on shader generation, and so that an exported shader
+        // cache covers the whole project.
+        static const bool precompileShaders = qEnvironmentVariableIsSet("QT3DS_PRECOMPILE_SHADERS");
+        if (firstFrame && precompileShaders) {
+            for (QT3DSU32 idx = 0, end = m_Scenes.size(); idx < end; ++idx)
+                m_Scenes[idx].second->PrecompileShaders();
+        }
+
         if (m_Context->m_Context->GetStereoView() != StereoViews::Right) {
             if (theFirstScene && theFirstScene->m_Presentation) {
                 m_LastRenderedScene = theFirstScene;
@@ -1810,10 +1896,16 @@ struct SRenderFactory : public IQt3DSRenderFactoryCore, public IQt3DSRenderFacto
                                                                  IStringTable &strt) override
         {
 #ifndef Qt3DS_NO_RENDER_SYMBOLS
+            // The NULL backend lets the runtime run without a GPU, for example to measure
+            // the CPU side of a frame in benchmarks.
+            static const bool nullBackend
+                    = qEnvironmentVariableIntValue("QT3DS_NULL_RENDER_BACKEND") > 0;
+            if (nullBackend)
+                return &NVRenderContext::CreateNULL(foundat, strt);
             qt3ds::render::NVRenderContext &retval = NVRenderContext::CreateGL(foundat, strt, format);
             return &retval;
 #else
-            qt3ds::render::NVRenderContext &retval = NVRenderContext::Createnullptr(foundat, strt);
+            qt3ds::render::NVRenderContext &retval = NVRenderContext::CreateNULL(foundat, strt);
             return &retval;
 #endif
         }
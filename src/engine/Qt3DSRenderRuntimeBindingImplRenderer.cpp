@@ -178,6 +178,12 @@ struct SRenderer : public Q3DStudio::ITegraApplicationRenderEngine
             m_BindingCore->m_Context->SetSkipFramesInterval(interval);
     }
 
+    void SetRenderOnDemand(bool enable) override
+    {
+        if (m_BindingCore && m_BindingCore->m_Context)
+            m_BindingCore->m_Context->SetRenderOnDemand(enable);
+    }
+
     void SetShadeMode(Q3DStudio::TegraRenderShadeModes::Enum inShade) override
     {
         if (m_BindingCore && m_BindingCore->m_Context) {
@@ -184,6 +184,8 @@ public:
     bool CanRender() override;
     bool Render() override;
     bool WasLastFrameDirty() override;
+    bool WasLastFrameSkipped() override;
+    void RequestRender() override;
 
     bool HandleMessage(const QEvent *inEvent) override;
 
@@ -198,6 +200,8 @@ public:
     CInputEngine *GetInputEngine() override;
     // Only valid after InitializeGraphics
     ITegraApplicationRenderEngine *GetTegraRenderEngine() override { return m_RenderEngine; }
+    // Only valid after InitializeGraphics
+    qt3ds::runtime::IApplication *GetApplication() override { return m_Application.mPtr; }
 
     void GoToSlideByName(const char *elementPath, const char *slideName) override;
     void GoToSlideByIndex(const char *elementPath, const int slideIndex) override;
@@ -235,6 +239,10 @@ public:
     void SetAttribute(const char *elementPath, const char *attributeName,
                       const char *value) override;
     bool GetAttribute(const char *elementPath, const char *attributeName, void *value) override;
+    void RegisterAttributeHandle(int handle, const char *elementPath,
+                                 const char *attributeName) override;
+    void ReleaseAttributeHandle(int handle) override;
+    void SetAttributeHandleValues(const int *handles, const float *values, int count) override;
     void FireEvent(const char *element, const char *evtName) override;
     bool PeekCustomAction(char *&outElementPath, char *&outActionName) override;
     bool RegisterScriptCallback(int callbackType, qml_Function func, void *inUserData) override;
@@ -427,7 +435,8 @@ bool CRuntimeView::Render()
         qCDebug(PERF_INFO, "Application startup time: %dms", m_startupTime);
     }
 
-    if (m_showOnScreenStats) {
+    // A skipped frame keeps the previous contents including the statistics
+    if (m_showOnScreenStats && !m_Application->WasLastFrameSkipped()) {
         ITegraRenderStateManager &manager
                 = GetTegraRenderEngine()->GetTegraRenderStateManager();
         manager.PushState();
@@ -454,6 +463,10 @@ bool CRuntimeView::Render()
             stream << QString::number(m_startupTime);
             stream << " ms";
         }
+        if (m_RuntimeFactory->GetQt3DSRenderContext().IsRenderOnDemand()) {
+            stream << ", skipped frames ";
+            stream << QString::number(m_Application->GetFrameSkipStatistics().m_SkippedFrames);
+        }
 
         // bottom left coordinates
         GetTegraRenderEngine()->RenderText2D(
@@ -474,6 +487,19 @@ bool CRuntimeView::WasLastFrameDirty()
     return false;
 }
 
+bool CRuntimeView::WasLastFrameSkipped()
+{
+    if (m_Application)
+        return m_Application->WasLastFrameSkipped();
+    return false;
+}
+
+void CRuntimeView::RequestRender()
+{
+    if (m_Application)
+        m_Application->MarkApplicationDirty();
+}
+
 //==============================================================================
 /**
  *	nv_main APP-SPECIFIC message call
@@ -825,6 +851,43 @@ bool CRuntimeView::GetAttribute(const char *elementPath, const char *attributeNa
     return false;
 }
 
+void CRuntimeView::RegisterAttributeHandle(int handle, const char *elementPath,
+                                           const char *attributeName)
+{
+    if (m_Application) {
+        if (!elementPath || !attributeName)
+            return;
+
+        Q3DStudio::CQmlEngine &theBridgeEngine
+                = static_cast<Q3DStudio::CQmlEngine &>(m_RuntimeFactoryCore->GetScriptEngineQml());
+
+        theBridgeEngine.RegisterAttributeHandle(handle, elementPath, attributeName);
+    }
+}
+
+void CRuntimeView::ReleaseAttributeHandle(int handle)
+{
+    if (m_Application) {
+        Q3DStudio::CQmlEngine &theBridgeEngine
+                = static_cast<Q3DStudio::CQmlEngine &>(m_RuntimeFactoryCore->GetScriptEngineQml());
+
+        theBridgeEngine.ReleaseAttributeHandle(handle);
+    }
+}
+
+void CRuntimeView::SetAttributeHandleValues(const int *handles, const float *values, int count)
+{
+    if (m_Application) {
+        if (!handles || !values || count <= 0)
+            return;
+
+        Q3DStudio::CQmlEngine &theBridgeEngine
+                = static_cast<Q3DStudio::CQmlEngine &>(m_RuntimeFactoryCore->GetScriptEngineQml());
+
+        theBridgeEngine.SetAttributeHandleValues(handles, values, count);
+    }
+}
+
 void CRuntimeView::FireEvent(const char *element, const char *evtName)
 {
     if (m_Application) {
@@ -149,6 +149,7 @@ public:
     virtual void SetStereoProgressiveEnabled(bool enabled) = 0;
     virtual bool GetStereoProgressiveEnabled() const = 0;
     virtual void SetSkipFramesInterval(int interval) = 0;
+    virtual void SetRenderOnDemand(bool enable) = 0;
 
     // TODO: To be removed, not used anywhere anymore
     void CycleScaleMode()
@@ -192,6 +193,12 @@ public: // loading
 
     virtual bool WasLastFrameDirty() = 0;
 
+    // True if the last Render call kept the previous frame in render on demand mode.
+    virtual bool WasLastFrameSkipped() = 0;
+
+    // Makes sure the next Render call renders even if nothing changed.
+    virtual void RequestRender() = 0;
+
     virtual bool HandleMessage(const QEvent *inEvent) = 0;
 
     virtual void Pause() = 0;
@@ -206,6 +213,8 @@ public: // Input engine access
     virtual CInputEngine *GetInputEngine() = 0;
     // Only valid after InitializeGraphics
     virtual ITegraApplicationRenderEngine *GetTegraRenderEngine() = 0;
+    // Only valid after InitializeGraphics
+    virtual qt3ds::runtime::IApplication *GetApplication() = 0;
 
 public:
     virtual void GoToSlideByName(const char *elementPath, const char *slideName) = 0;
@@ -237,6 +246,11 @@ public:
     virtual void SetAttribute(const char *elementPath, const char *attributeName,
                               const char *value) = 0;
     virtual bool GetAttribute(const char *elementPath, const char *attributeName, void *value) = 0;
+    virtual void RegisterAttributeHandle(int handle, const char *elementPath,
+                                         const char *attributeName) = 0;
+    virtual void ReleaseAttributeHandle(int handle) = 0;
+    virtual void SetAttributeHandleValues(const int *handles, const float *values,
+                                          int count) = 0;
     virtual void FireEvent(const char *element, const char *evtName) = 0;
     virtual bool PeekCustomAction(char *&outElementPath, char *&outActionName) = 0;
     virtual bool RegisterScriptCallback(int callbackType, qml_Function func, void *inUserData) = 0;
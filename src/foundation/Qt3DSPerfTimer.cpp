@@ -109,12 +109,18 @@ struct SPerfTimer : public IPerfTimer
     Mutex m_Mutex;
     QT3DSI32 mRefCount;
     QT3DSU64 m_startTime;
+    bool m_Enabled;
 
     SPerfTimer(NVFoundationBase &fnd)
         : m_Foundation(fnd)
         , m_StringTable(IStringTable::CreateStringTable(fnd.getAllocator()))
         , m_Mutex(fnd.getAllocator())
         , mRefCount(0)
+#ifdef QT3DS_ENABLE_PERF_LOGGING
+        , m_Enabled(true)
+#else
+        , m_Enabled(false)
+#endif
     {
     }
 
@@ -163,6 +169,15 @@ struct SPerfTimer : public IPerfTimer
         }
     }
 
+    double GetTotalDuration(const char *inTag) override
+    {
+        Mutex::ScopedLock __locker(m_Mutex);
+        THashMapType::iterator theFind = m_Entries.find(m_StringTable->RegisterStr(inTag));
+        if (theFind == m_Entries.end())
+            return 0.0;
+        return Time::sCounterFreq.toTensOfNanos(theFind->second.m_Total) / 100000.0;
+    }
+
     double CurrentDuration() override
     {
         QT3DSU64 duration = Time::getCurrentCounterValue() - m_startTime;
@@ -171,6 +186,10 @@ struct SPerfTimer : public IPerfTimer
         return durationMs;
     }
 
+    bool IsEnabled() const override { return m_Enabled; }
+
+    void SetEnabled(bool inEnabled) override { m_Enabled = inEnabled; }
+
     virtual void ClearPerfKeys()
     {
         Mutex::ScopedLock __locker(m_Mutex);
@@ -50,8 +50,14 @@ namespace foundation {
         // Dump current summation of timer data.
         virtual void OutputTimerData(QT3DSU32 inFrameCount = 0) = 0;
         virtual void ResetTimerData() = 0;
+        // Returns the summed duration in ms recorded for inTag since the last reset.
+        virtual double GetTotalDuration(const char *inTag) = 0;
         // Returns current duration in ms
         virtual double CurrentDuration() = 0;
+        // Scoped timers only measure while the timer is enabled. It is enabled by default in
+        // builds with QT3DS_ENABLE_PERF_LOGGING.
+        virtual bool IsEnabled() const = 0;
+        virtual void SetEnabled(bool inEnabled) = 0;
 
         static IPerfTimer &CreatePerfTimer(NVFoundationBase &inFoundation);
     };
@@ -79,15 +85,15 @@ namespace foundation {
         const char *m_Id;
 
         SStackPerfTimer(IPerfTimer &destination, const char *inId)
-            : m_Timer(&destination)
-            , m_Start(Time::getCurrentCounterValue())
+            : m_Timer(destination.IsEnabled() ? &destination : nullptr)
+            , m_Start(m_Timer ? Time::getCurrentCounterValue() : 0)
             , m_Id(inId)
         {
         }
 
         SStackPerfTimer(IPerfTimer *destination, const char *inId)
-            : m_Timer(destination)
-            , m_Start(Time::getCurrentCounterValue())
+            : m_Timer(destination && destination->IsEnabled() ? destination : nullptr)
+            , m_Start(m_Timer ? Time::getCurrentCounterValue() : 0)
             , m_Id(inId)
         {
         }
@@ -104,12 +110,8 @@ namespace foundation {
 }
 }
 
-#ifdef QT3DS_ENABLE_PERF_LOGGING
+// Always compiled in; a disabled timer costs one check per scope.
 #define QT3DS_PERF_SCOPED_TIMER(timer, name)                                             \
-    SStackPerfTimer __perfTimer(timer, name);
-#else
-/// Empty macro
-#define QT3DS_PERF_SCOPED_TIMER(timer, name)
-#endif
+    qt3ds::foundation::SStackPerfTimer __perfTimer(timer, name);
 
 #endif
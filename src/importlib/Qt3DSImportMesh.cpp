@@ -204,13 +204,24 @@ void Serialize(TSerializer &serializer, Mesh &mesh)
     serializer.align();
 }
 
+// Mappable (version 4) meshes align their data to this so vertex and index data can be
+// handed to the graphics api straight out of a memory mapped file.
+const QT3DSU32 g_MappableAlignment = 16;
+// The header and the mesh structure are padded to the mappable alignment in version 4.
+const QT3DSU32 g_MappableHeaderSize = ((sizeof(MeshDataHeader) + g_MappableAlignment - 1)
+                                       / g_MappableAlignment) * g_MappableAlignment;
+const QT3DSU32 g_MappableMeshSize = ((sizeof(Mesh) + g_MappableAlignment - 1)
+                                     / g_MappableAlignment) * g_MappableAlignment;
+
 struct TotallingSerializer
 {
     QT3DSU32 m_NumBytes;
     QT3DSU8 *m_BaseAddress;
-    TotallingSerializer(QT3DSU8 *inBaseAddr)
+    QT3DSU32 m_Alignment;
+    TotallingSerializer(QT3DSU8 *inBaseAddr, QT3DSU32 inAlignment = 4)
         : m_NumBytes(0)
         , m_BaseAddress(inBaseAddr)
+        , m_Alignment(inAlignment)
     {
     }
     template <typename TDataType>
@@ -235,7 +246,8 @@ struct TotallingSerializer
             streamify("");
     }
     bool needsAlignment() const { return getAlignmentAmount() > 0; }
-    QT3DSU32 getAlignmentAmount() const { return 4 - (m_NumBytes % 4); }
+    // Note that this pads even when already aligned; the version 3 format depends on it.
+    QT3DSU32 getAlignmentAmount() const { return m_Alignment - (m_NumBytes % m_Alignment); }
     void align()
     {
         if (needsAlignment())
@@ -248,9 +260,9 @@ struct ByteWritingSerializer
     IOutStream &m_Stream;
     TotallingSerializer m_ByteCounter;
     QT3DSU8 *m_BaseAddress;
-    ByteWritingSerializer(IOutStream &str, QT3DSU8 *inBaseAddress)
+    ByteWritingSerializer(IOutStream &str, QT3DSU8 *inBaseAddress, QT3DSU32 inAlignment = 4)
         : m_Stream(str)
-        , m_ByteCounter(inBaseAddress)
+        , m_ByteCounter(inBaseAddress, inAlignment)
         , m_BaseAddress(inBaseAddress)
     {
     }
@@ -279,7 +291,7 @@ struct ByteWritingSerializer
     void align()
     {
         if (m_ByteCounter.needsAlignment()) {
-            QT3DSU8 buffer[] = { 0, 0, 0, 0 };
+            QT3DSU8 buffer[g_MappableAlignment] = { 0 };
             m_Stream.Write(buffer, m_ByteCounter.getAlignmentAmount());
             m_ByteCounter.align();
         }
@@ -293,11 +305,12 @@ struct MemoryAssigningSerializer
     QT3DSU32 m_Size;
     TotallingSerializer m_ByteCounter;
     bool m_Failure;
-    MemoryAssigningSerializer(QT3DSU8 *data, QT3DSU32 size, QT3DSU32 startOffset)
+    MemoryAssigningSerializer(QT3DSU8 *data, QT3DSU32 size, QT3DSU32 startOffset,
+                              QT3DSU32 inAlignment = 4)
         : m_Memory(data + startOffset)
         , m_BaseAddress(data)
         , m_Size(size)
-        , m_ByteCounter(data)
+        , m_ByteCounter(data, inAlignment)
         , m_Failure(false)
     {
         // We expect 4 byte aligned memory to begin with
@@ -367,6 +380,106 @@ struct MemoryAssigningSerializer
     void updateMemoryBuffer(QT3DSU32 numBytes) { m_Memory += numBytes; }
 };
 
+// Walks a mappable mesh the same way the MemoryAssigningSerializer would, but instead of
+// assigning the offsets it checks the ones stored in the file.  The data may be read-only
+// mapped memory so nothing is ever written.
+struct OffsetValidatingSerializer
+{
+    const QT3DSU8 *m_Memory;
+    const QT3DSU8 *m_BaseAddress;
+    QT3DSU32 m_Size;
+    TotallingSerializer m_ByteCounter;
+    bool m_Failure;
+    OffsetValidatingSerializer(const QT3DSU8 *data, QT3DSU32 size, QT3DSU32 startOffset,
+                               QT3DSU32 inAlignment)
+        : m_Memory(data + startOffset)
+        , m_BaseAddress(data)
+        , m_Size(size)
+        , m_ByteCounter(const_cast<QT3DSU8 *>(data), inAlignment)
+        , m_Failure(false)
+    {
+    }
+
+    template <typename TDataType>
+    void streamify(const SOffsetDataRef<TDataType> &data)
+    {
+        if (m_Failure)
+            return;
+        QT3DSU64 numBytes = (QT3DSU64)data.size() * sizeof(TDataType);
+        if (m_ByteCounter.m_NumBytes + numBytes > m_Size) {
+            m_Failure = true;
+            return;
+        }
+        m_ByteCounter.m_NumBytes += (QT3DSU32)numBytes;
+        if (numBytes) {
+            if (data.m_Offset != (QT3DSU32)(m_Memory - m_BaseAddress)) {
+                m_Failure = true;
+                return;
+            }
+            m_Memory += numBytes;
+        }
+    }
+    void streamifyCharPointerOffset(QT3DSU32 inOffset)
+    {
+        if (m_Failure)
+            return;
+        QT3DSU32 len;
+        if (m_ByteCounter.m_NumBytes + 4 > m_Size) {
+            m_Failure = true;
+            return;
+        }
+        qt3ds::intrinsics::memCopy(&len, m_Memory, 4);
+        m_ByteCounter.m_NumBytes += 4;
+        m_Memory += 4;
+        // The string is used as a c string so it has to be terminated within the buffer.
+        if (len == 0 || (QT3DSU64)m_ByteCounter.m_NumBytes + len > m_Size
+            || m_Memory[len - 1] != 0 || inOffset != (QT3DSU32)(m_Memory - m_BaseAddress)) {
+            m_Failure = true;
+            return;
+        }
+        m_ByteCounter.m_NumBytes += len;
+        m_Memory += len;
+    }
+    void align()
+    {
+        if (m_ByteCounter.needsAlignment()) {
+            QT3DSU32 numBytes = m_ByteCounter.getAlignmentAmount();
+            m_ByteCounter.align();
+            m_Memory += numBytes;
+        }
+    }
+};
+
+template <typename TDataType>
+bool IsWithinBuffer(const SOffsetDataRef<TDataType> &data, QT3DSU32 inBufferSize)
+{
+    return (QT3DSU64)data.m_Offset + (QT3DSU64)data.m_Size * sizeof(TDataType) <= inBufferSize;
+}
+
+// Writes into a preallocated buffer; used to lay out a mappable mesh before it is saved.
+struct FixedBufferOutStream : public IOutStream
+{
+    QT3DSU8 *m_Begin;
+    QT3DSU8 *m_End;
+    bool m_Overflow;
+    FixedBufferOutStream(QT3DSU8 *inBegin, QT3DSU8 *inEnd)
+        : m_Begin(inBegin)
+        , m_End(inEnd)
+        , m_Overflow(false)
+    {
+    }
+    bool Write(NVConstDataRef<QT3DSU8> data) override
+    {
+        if (data.size() > (size_t)(m_End - m_Begin)) {
+            m_Overflow = true;
+            return false;
+        }
+        qt3ds::intrinsics::memCopy(m_Begin, data.begin(), data.size());
+        m_Begin += data.size();
+        return true;
+    }
+};
+
 inline QT3DSU32 GetMeshDataSize(Mesh &mesh)
 {
     TotallingSerializer s(reinterpret_cast<QT3DSU8 *>(&mesh));
@@ -429,11 +542,14 @@ inline QT3DSU32 NextIndex(NVConstDataRef<QT3DSU8> inData,
 
 template <typename TMeshType>
 // Not exposed to the outside world
-TMeshType *DoInitialize(MeshBufHeaderFlags /*meshFlags*/, NVDataRef<QT3DSU8> data)
+TMeshType *DoInitialize(MeshBufHeaderFlags /*meshFlags*/, NVDataRef<QT3DSU8> data,
+                        QT3DSU32 inStartOffset = sizeof(TMeshType), QT3DSU32 inAlignment = 4)
 {
     QT3DSU8 *newMem = data.begin();
-    QT3DSU32 amountLeft = data.size() - sizeof(TMeshType);
-    MemoryAssigningSerializer s(newMem, amountLeft, sizeof(TMeshType));
+    if (data.size() < inStartOffset)
+        return NULL;
+    QT3DSU32 amountLeft = data.size() - inStartOffset;
+    MemoryAssigningSerializer s(newMem, amountLeft, inStartOffset, inAlignment);
     TMeshType *retval = (TMeshType *)newMem;
     Serialize(s, *retval);
     if (s.m_Failure)
@@ -489,6 +605,41 @@ void Mesh::Save(IOutStream &outStream) const
     Serialize(writer, mesh);
 }
 
+bool Mesh::SaveMappable(NVAllocatorCallback &alloc, IOutStream &outStream) const
+{
+    Mesh &mesh(const_cast<Mesh &>(*this));
+    QT3DSU8 *baseAddress = reinterpret_cast<QT3DSU8 *>(&mesh);
+    TotallingSerializer counter(baseAddress, g_MappableAlignment);
+    Serialize(counter, mesh);
+    QT3DSU32 dataSize = counter.m_NumBytes;
+    QT3DSU32 numBytes = g_MappableMeshSize + dataSize;
+    // Lay the mesh out in memory first so the offsets stored in the file are the final ones;
+    // a mapped mesh is used in place and never fixed up.
+    QT3DSU8 *newMem = (QT3DSU8 *)alloc.allocate(numBytes, "MappableMesh", __FILE__, __LINE__);
+    if (newMem == NULL)
+        return false;
+    qt3ds::intrinsics::memZero(newMem, numBytes);
+    qt3ds::intrinsics::memCopy(newMem, this, sizeof(Mesh));
+    FixedBufferOutStream dataStream(newMem + g_MappableMeshSize, newMem + numBytes);
+    ByteWritingSerializer writer(dataStream, baseAddress, g_MappableAlignment);
+    Serialize(writer, mesh);
+    MemoryAssigningSerializer assigner(newMem, dataSize, g_MappableMeshSize, g_MappableAlignment);
+    Serialize(assigner, *reinterpret_cast<Mesh *>(newMem));
+    bool success = !dataStream.m_Overflow && !assigner.m_Failure;
+    if (success) {
+        MeshDataHeader header(numBytes);
+        header.m_FileVersion = MeshDataHeader::GetMappableFileVersion();
+        QT3DSU8 padding[g_MappableHeaderSize - sizeof(MeshDataHeader)] = { 0 };
+        outStream.Write(header);
+        outStream.Write(padding, g_MappableHeaderSize - sizeof(MeshDataHeader));
+        outStream.Write(newMem, numBytes);
+    } else {
+        QT3DS_ASSERT(false);
+    }
+    alloc.deallocate(newMem);
+    return success;
+}
+
 wchar_t g_DefaultName[] = { 0 };
 
 const wchar_t *Mesh::s_DefaultName = g_DefaultName;
@@ -636,16 +787,31 @@ Mesh *Mesh::Load(NVAllocatorCallback &alloc, IInStream &inStream)
     QT3DS_ASSERT(header.m_FileId == MeshDataHeader::GetFileId());
     if (header.m_FileId != MeshDataHeader::GetFileId())
         return NULL;
-    if (header.m_FileVersion < 1 || header.m_FileVersion > MeshDataHeader::GetCurrentFileVersion())
+    if (header.m_FileVersion < 1 || header.m_FileVersion > MeshDataHeader::GetMappableFileVersion())
         return NULL;
     if (header.m_SizeInBytes < sizeof(Mesh))
         return NULL;
+    if (header.m_FileVersion == MeshDataHeader::GetMappableFileVersion()) {
+        QT3DSU8 padding[g_MappableHeaderSize - sizeof(MeshDataHeader)];
+        if (inStream.Read(padding, g_MappableHeaderSize - sizeof(MeshDataHeader))
+            != g_MappableHeaderSize - sizeof(MeshDataHeader)) {
+            return NULL;
+        }
+    }
     QT3DSU8 *newMem = (QT3DSU8 *)alloc.allocate(header.m_SizeInBytes, "Mesh", __FILE__, __LINE__);
     QT3DSU32 amountRead = inStream.Read(NVDataRef<QT3DSU8>(newMem, header.m_SizeInBytes));
     if (amountRead != header.m_SizeInBytes)
         goto failure;
 
-    if (header.m_FileVersion == 1) {
+    if (header.m_FileVersion == MeshDataHeader::GetMappableFileVersion()) {
+        // Read through a stream the mappable layout is just a mesh with more padding.
+        Mesh *retval = DoInitialize<Mesh>(header.m_HeaderFlags,
+                                          NVDataRef<QT3DSU8>(newMem, header.m_SizeInBytes),
+                                          g_MappableMeshSize, g_MappableAlignment);
+        if (retval == NULL)
+            goto failure;
+        return retval;
+    } else if (header.m_FileVersion == 1) {
         MeshV1 *temp = DoInitialize<MeshV1>(header.m_HeaderFlags,
                                             NVDataRef<QT3DSU8>(newMem, header.m_SizeInBytes));
         if (temp == NULL)
@@ -681,7 +847,8 @@ Mesh *Mesh::Initialize(QT3DSU16 meshVersion, MeshBufHeaderFlags meshFlags, NVDat
 
 // Multimesh support where you have multiple meshes in a single file.
 // Save multi where you have overridden the allocator.
-QT3DSU32 Mesh::SaveMulti(NVAllocatorCallback &alloc, ISeekableIOStream &inStream, QT3DSU32 inId) const
+QT3DSU32 Mesh::SaveMulti(NVAllocatorCallback &alloc, ISeekableIOStream &inStream, QT3DSU32 inId,
+                         bool inMappable) const
 {
     QT3DSU32 nextId = 1;
     MeshMultiHeader tempHeader;
@@ -711,7 +878,22 @@ QT3DSU32 Mesh::SaveMulti(NVAllocatorCallback &alloc, ISeekableIOStream &inStream
     inStream.SetPosition(-newMeshStartPos, SeekPosition::End);
     QT3DSI64 meshOffset = inStream.GetPosition();
 
-    Save(inStream);
+    if (inMappable) {
+        // Mapped meshes are used in place so they have to start at an aligned file offset.
+        QT3DSU32 leftover = (QT3DSU32)(meshOffset % g_MappableAlignment);
+        if (leftover) {
+            QT3DSU8 padding[g_MappableAlignment] = { 0 };
+            inStream.Write(padding, g_MappableAlignment - leftover);
+            meshOffset += g_MappableAlignment - leftover;
+        }
+        if (!SaveMappable(alloc, inStream)) {
+            if (theHeader != NULL)
+                alloc.deallocate(theHeader);
+            return 0;
+        }
+    } else {
+        Save(inStream);
+    }
 
     if (inId != 0)
         nextId = inId;
@@ -764,6 +946,70 @@ endFunction:
     return SMultiLoadResult(retval, theId);
 }
 
+SMultiLoadResult Mesh::LoadMultiMapped(NVConstDataRef<QT3DSU8> inFileData, QT3DSU32 inId)
+{
+    const QT3DSU8 *fileData = inFileData.begin();
+    const QT3DSU64 fileSize = inFileData.size();
+    MeshMultiHeader theHeader;
+    if (fileSize < sizeof(MeshMultiHeader))
+        return SMultiLoadResult();
+    qt3ds::intrinsics::memCopy(&theHeader, fileData + fileSize - sizeof(MeshMultiHeader),
+                               sizeof(MeshMultiHeader));
+    if (theHeader.m_FileId != MeshMultiHeader::GetMultiStaticFileId()
+        || theHeader.m_Version > MeshMultiHeader::GetMultiStaticVersion()) {
+        return SMultiLoadResult();
+    }
+    const QT3DSU64 entrySize = (QT3DSU64)theHeader.m_Entries.m_Size * sizeof(MeshMultiEntry);
+    if (fileSize < sizeof(MeshMultiHeader) + entrySize)
+        return SMultiLoadResult();
+    const QT3DSU8 *entryData = fileData + fileSize - sizeof(MeshMultiHeader) - entrySize;
+
+    QT3DSU64 fileOffset = (QT3DSU64)-1;
+    QT3DSU32 theId = inId;
+    bool foundMesh = false;
+    for (QT3DSU32 idx = 0, end = theHeader.m_Entries.size(); idx < end && !foundMesh; ++idx) {
+        MeshMultiEntry theEntry;
+        qt3ds::intrinsics::memCopy(&theEntry, entryData + idx * sizeof(MeshMultiEntry),
+                                   sizeof(MeshMultiEntry));
+        if (theEntry.m_MeshId == inId || (inId == 0 && theEntry.m_MeshId > theId)) {
+            if (theEntry.m_MeshId == inId)
+                foundMesh = true;
+            theId = qMax(theId, (QT3DSU32)theEntry.m_MeshId);
+            fileOffset = theEntry.m_MeshOffset;
+        }
+    }
+    if (fileOffset == (QT3DSU64)-1 || fileOffset > fileSize
+        || fileSize - fileOffset < g_MappableHeaderSize) {
+        return SMultiLoadResult();
+    }
+
+    MeshDataHeader header;
+    qt3ds::intrinsics::memCopy(&header, fileData + fileOffset, sizeof(MeshDataHeader));
+    // Older versions need their offsets fixed up on load; those go through LoadMulti.
+    if (header.m_FileId != MeshDataHeader::GetFileId()
+        || header.m_FileVersion != MeshDataHeader::GetMappableFileVersion()
+        || header.m_SizeInBytes < g_MappableMeshSize
+        || fileSize - fileOffset - g_MappableHeaderSize < header.m_SizeInBytes) {
+        return SMultiLoadResult();
+    }
+    const QT3DSU8 *meshData = fileData + fileOffset + g_MappableHeaderSize;
+    if (((size_t)meshData) % g_MappableAlignment)
+        return SMultiLoadResult();
+
+    Mesh *retval = const_cast<Mesh *>(reinterpret_cast<const Mesh *>(meshData));
+    // Serialize walks the entry and subset arrays, so those have to be in range before it runs.
+    if (!IsWithinBuffer(retval->m_VertexBuffer.m_Entries, header.m_SizeInBytes)
+        || !IsWithinBuffer(retval->m_Subsets, header.m_SizeInBytes)) {
+        return SMultiLoadResult();
+    }
+    OffsetValidatingSerializer validator(meshData, header.m_SizeInBytes - g_MappableMeshSize,
+                                         g_MappableMeshSize, g_MappableAlignment);
+    Serialize(validator, *retval);
+    if (validator.m_Failure)
+        return SMultiLoadResult();
+    return SMultiLoadResult(retval, theId);
+}
+
 // Returns true if this is a multimesh (several meshes in one file).
 bool Mesh::IsMulti(ISeekableIOStream &inStream)
 {
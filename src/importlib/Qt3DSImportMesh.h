@@ -196,6 +196,9 @@ struct MeshDataHeader
 {
     static QT3DSU32 GetFileId() { return (QT3DSU32)-929005747; }
     static QT3DSU16 GetCurrentFileVersion() { return 3; }
+    // Version 4 stores the data 16 byte aligned with the offsets already resolved so a
+    // memory mapped file can be used in place.  See Mesh::SaveMappable.
+    static QT3DSU16 GetMappableFileVersion() { return 4; }
     QT3DSU32 m_FileId;
     QT3DSU16 m_FileVersion;
     MeshBufHeaderFlags m_HeaderFlags;
@@ -373,6 +376,13 @@ struct Mesh
     // Save a mesh using fopen and fwrite
     bool Save(const char *inFilePath) const;
 
+    // Format is:
+    // MeshDataHeader (version 4) padded to 16 bytes
+    // mesh padded to 16 bytes
+    // mesh data, each buffer 16 byte aligned, offsets already resolved.
+    // The allocator is used for a temporary copy of the mesh while laying it out.
+    bool SaveMappable(NVAllocatorCallback &alloc, IOutStream &outStream) const;
+
     // read the header, then read the object.
     // Object data is written in LE format for now.
     // Free the new mesh by calling:
@@ -392,7 +402,9 @@ struct Mesh
 
     // Multimesh support where you have multiple meshes in a single file.
     // Save multi where you have overridden the allocator.
-    QT3DSU32 SaveMulti(NVAllocatorCallback &alloc, ISeekableIOStream &inStream, QT3DSU32 inId = 0) const;
+    // inMappable saves the mesh in the mappable layout at an aligned offset.
+    QT3DSU32 SaveMulti(NVAllocatorCallback &alloc, ISeekableIOStream &inStream, QT3DSU32 inId = 0,
+                       bool inMappable = false) const;
     // You can save multiple meshes in a file.  Each mesh returns an incrementing
     // integer for the multi file.  The original meshes aren't changed, and the file
     // is appended to.
@@ -404,6 +416,11 @@ struct Mesh
                                       QT3DSU32 inId = 0);
     // Load a single mesh using c file API and malloc/free.
     static SMultiLoadResult LoadMulti(const char *inFilePath, QT3DSU32 inId);
+    // Find a mesh saved with SaveMappable in the complete contents of a multi file, usually a
+    // memory mapped file.  The returned mesh points into inFileData, nothing is copied and it
+    // must not be deallocated.  Returns a null mesh if the mesh is not in the mappable format
+    // or fails validation; use LoadMulti in that case.
+    static SMultiLoadResult LoadMultiMapped(NVConstDataRef<QT3DSU8> inFileData, QT3DSU32 inId = 0);
     // Returns true if this is a multimesh (several meshes in one file).
     static bool IsMulti(ISeekableIOStream &inStream);
     // Load a multi header from a stream.
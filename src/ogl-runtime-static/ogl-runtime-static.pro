@@ -87,6 +87,8 @@ SOURCES += \
     ../runtimerender/rendererimpl/Qt3DSRendererImplLayerRenderData.cpp \
     ../runtimerender/rendererimpl/Qt3DSRendererImplLayerRenderHelper.cpp \
     ../runtimerender/rendererimpl/Qt3DSRendererImplLayerRenderPreparationData.cpp \
+    ../runtimerender/rendererimpl/Qt3DSRendererImplPickBvh.cpp \
+    ../runtimerender/rendererimpl/Qt3DSRendererImplRenderableSort.cpp \
     ../runtimerender/rendererimpl/Qt3DSRendererImplShaders.cpp \
     ../runtimerender/resourcemanager/Qt3DSRenderBufferLoader.cpp \
     ../runtimerender/resourcemanager/Qt3DSRenderBufferManager.cpp \
@@ -116,6 +118,7 @@ SOURCES += \
     ../runtimerender/Qt3DSRenderGraphObjectSerializer.cpp \
     ../runtimerender/Qt3DSRenderImageScaler.cpp \
     ../runtimerender/Qt3DSRenderInputStreamFactory.cpp \
+    ../runtimerender/Qt3DSRenderJobSystem.cpp \
     ../runtimerender/Qt3DSRenderPathManager.cpp \
     ../runtimerender/Qt3DSRenderPixelGraphicsRenderer.cpp \
     ../runtimerender/Qt3DSRenderPixelGraphicsTypes.cpp \
@@ -310,12 +313,14 @@ HEADERS += \
     ../runtimerender/Qt3DSRenderImageScaler.h \
     ../runtimerender/Qt3DSRenderImageTextureData.h \
     ../runtimerender/Qt3DSRenderInputStreamFactory.h \
+    ../runtimerender/Qt3DSRenderJobSystem.h \
     ../runtimerender/Qt3DSRenderMaterialHelpers.h \
     ../runtimerender/Qt3DSRenderMaterialShaderGenerator.h \
     ../runtimerender/Qt3DSRenderMesh.h \
     ../runtimerender/Qt3DSRenderPathManager.h \
     ../runtimerender/Qt3DSRenderPathMath.h \
     ../runtimerender/Qt3DSRenderPathRenderContext.h \
+    ../runtimerender/Qt3DSRenderPerFrameAllocator.h \
     ../runtimerender/Qt3DSRenderPixelGraphicsRenderer.h \
     ../runtimerender/Qt3DSRenderPixelGraphicsTypes.h \
     ../runtimerender/Qt3DSRenderPlugin.h \
@@ -349,6 +354,9 @@ HEADERS += \
     ../runtimerender/rendererimpl/Qt3DSRendererImplLayerRenderData.h \
     ../runtimerender/rendererimpl/Qt3DSRendererImplLayerRenderHelper.h \
     ../runtimerender/rendererimpl/Qt3DSRendererImplLayerRenderPreparationData.h \
+    ../runtimerender/rendererimpl/Qt3DSRendererImplPickBvh.h \
+    ../runtimerender/rendererimpl/Qt3DSRendererImplRenderableSort.h \
+    ../runtimerender/rendererimpl/Qt3DSRendererImplShaderProgramTable.h \
     ../runtimerender/rendererimpl/Qt3DSRendererImplShaders.h \
     ../runtimerender/rendererimpl/Qt3DSVertexPipelineImpl.h \
     ../runtimerender/resourcemanager/Qt3DSRenderBufferLoader.h \
@@ -365,6 +373,7 @@ HEADERS += \
     ../system/Qt3DSAssert.h \
     ../system/Qt3DSAudioPlayer.h \
     ../system/Qt3DSBasicPluginDLL.h \
+    ../system/Qt3DSBezierBake.h \
     ../system/Qt3DSBezierEval.h \
     ../system/Qt3DSBoundingBox.h \
     ../system/Qt3DSCircularArray.h \
@@ -579,6 +588,7 @@ SOURCES += \
     ../render/backends/gl/Qt3DSRenderBackendGLBase.cpp \
     ../render/backends/gl/Qt3DSRenderContextGL.cpp \
     ../render/backends/software/Qt3DSRenderBackendNULL.cpp \
+    ../render/backends/recorder/Qt3DSRenderBackendRecorder.cpp \
     ../render/backends/gl/Q3DSRenderBackendGLES2.cpp
 
 HEADERS += \
@@ -593,6 +603,7 @@ HEADERS += \
     ../render/backends/gl/Qt3DSRenderBackendRenderStatesGL.h \
     ../render/backends/gl/Qt3DSRenderBackendShaderProgramGL.h \
     ../render/backends/software/Qt3DSRenderBackendNULL.h \
+    ../render/backends/recorder/Qt3DSRenderBackendRecorder.h \
     ../render/backends/gl/Q3DSRenderBackendGLES2.h
 
 # DataModel
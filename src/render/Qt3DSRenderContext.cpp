@@ -34,6 +34,7 @@
 #include "EASTL/set.h"
 #include "EASTL/utility.h"
 #include "render/Qt3DSRenderShaderProgram.h"
+#include "render/backends/recorder/Qt3DSRenderBackendRecorder.h"
 
 using namespace qt3ds;
 using namespace qt3ds::render;
@@ -901,6 +902,7 @@ namespace render {
     {
         QT3DSI32_4 values;
 
+        m_backend->InvalidateStateCache();
         m_backend->SetRenderState(m_HardwarePropertyContext.m_BlendingEnabled,
                                   NVRenderState::Blend);
         const NVRenderBlendFunctionArgument &theBlendArg(m_HardwarePropertyContext.m_BlendFunction);
@@ -914,6 +916,7 @@ namespace render {
         if (!m_PropertyStack.empty()) {
             SNVGLHardPropertyContext &theTopContext(m_PropertyStack.back());
             if (inForceSetProperties) {
+                m_backend->InvalidateStateCache();
 #define HANDLE_CONTEXT_HARDWARE_PROPERTY(setterName, propName)                                     \
     DoSet##setterName(theTopContext.m_##propName);
 
@@ -1035,6 +1038,22 @@ namespace render {
         OnPostDraw();
     }
 
+    void NVRenderContextImpl::DrawInstanced(NVRenderDrawMode::Enum drawMode, QT3DSU32 count,
+                                            QT3DSU32 offset, QT3DSU32 instanceCount)
+    {
+        if (!ApplyPreDrawProperties())
+            return;
+
+        NVRenderIndexBuffer *theIndexBuffer = const_cast<NVRenderIndexBuffer *>(
+            m_HardwarePropertyContext.m_InputAssembler->GetIndexBuffer());
+        if (theIndexBuffer == NULL)
+            m_backend->DrawInstanced(drawMode, offset, count, instanceCount);
+        else
+            theIndexBuffer->DrawInstanced(drawMode, count, offset, instanceCount);
+
+        OnPostDraw();
+    }
+
     QT3DSMat44
     NVRenderContext::ApplyVirtualViewportToProjectionMatrix(const QT3DSMat44 &inProjection,
                                                             const NVRenderRectF &inViewport,
@@ -1115,6 +1134,8 @@ namespace render {
         NVScopedRefCounted<IStringTable> theStringTable(inStringTable);
         NVScopedRefCounted<NVRenderBackend> theBackend =
             NVRenderBackendNULL::CreateBackend(foundation);
+        if (NVRenderBackendRecorder::IsEnabled())
+            theBackend = &NVRenderBackendRecorder::CreateRecorder(foundation, *theBackend);
         retval = QT3DS_NEW(foundation.getAllocator(), NVRenderContextImpl)(foundation, *theBackend,
                                                                         *theStringTable);
         return *retval;
@@ -127,6 +127,7 @@ namespace render {
         virtual bool GetConstantBufferSupport() const = 0;
         virtual void getMaxTextureSize(QT3DSU32 &oWidth, QT3DSU32 &oHeight) = 0;
         virtual const char *GetShadingLanguageVersion() = 0;
+        virtual QByteArray GetDriverDescription() = 0;
         // Get the bit depth of the currently bound depth buffer.
         virtual QT3DSU32 GetDepthBits() const = 0;
         virtual QT3DSU32 GetStencilBits() const = 0;
@@ -152,6 +153,7 @@ namespace render {
         virtual bool IsAdvancedBlendHwSupportedKHR() const = 0;
         virtual bool IsStandardDerivativesSupported() const = 0;
         virtual bool IsTextureLodSupported() const = 0;
+        virtual bool IsInstancingSupported() const = 0;
         virtual bool isBinaryProgramSupported() const = 0;
         virtual bool isSceneCameraView() const = 0;
 
@@ -413,6 +415,20 @@ namespace render {
          */
         virtual void DrawIndirect(NVRenderDrawMode::Enum drawMode, QT3DSU32 offset) = 0;
 
+        /**
+         * @brief Draw the current input assembler instanceCount times with a single call.
+         *		  Same as Draw otherwise. Requires IsInstancingSupported().
+         *
+         * @param[in] drawMode		Draw mode (Triangles, ....)
+         * @param[in] count			Vertex or index count
+         * @param[in] offset		Start vertex or index
+         * @param[in] instanceCount	Number of instances to draw
+         *
+         * @return no return.
+         */
+        virtual void DrawInstanced(NVRenderDrawMode::Enum drawMode, QT3DSU32 count, QT3DSU32 offset,
+                                   QT3DSU32 instanceCount) = 0;
+
         virtual NVFoundationBase &GetFoundation() = 0;
         virtual qt3ds::foundation::IStringTable &GetStringTable() = 0;
         virtual NVAllocatorCallback &GetAllocator() = 0;
@@ -655,6 +671,8 @@ namespace render {
             return m_backend->GetShadingLanguageVersion();
         }
 
+        QByteArray GetDriverDescription() override { return m_backend->GetDriverDescription(); }
+
         NVRenderContextType GetRenderContextType() const override
         {
             return m_backend->GetRenderContextType();
@@ -766,6 +784,10 @@ namespace render {
         {
             return GetRenderBackendCap(NVRenderBackend::NVRenderBackendCaps::PathRendering);
         }
+        bool IsInstancingSupported() const override
+        {
+            return GetRenderBackendCap(NVRenderBackend::NVRenderBackendCaps::Instancing);
+        }
         // Are blend modes really supported in HW?
         bool IsAdvancedBlendHwSupported() const override
         {
@@ -1069,6 +1091,8 @@ namespace render {
 
         void Draw(NVRenderDrawMode::Enum drawMode, QT3DSU32 count, QT3DSU32 offset) override;
         void DrawIndirect(NVRenderDrawMode::Enum drawMode, QT3DSU32 offset) override;
+        void DrawInstanced(NVRenderDrawMode::Enum drawMode, QT3DSU32 count, QT3DSU32 offset,
+                           QT3DSU32 instanceCount) override;
 
         NVFoundationBase &GetFoundation() override { return m_Foundation; }
         qt3ds::foundation::IStringTable &GetStringTable() override { return m_StringTable; }
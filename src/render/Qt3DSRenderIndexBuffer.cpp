@@ -60,6 +60,15 @@ namespace render {
             (const void *)(offset * NVRenderComponentTypes::getSizeofType(m_ComponentType)));
     }
 
+    void NVRenderIndexBuffer::DrawInstanced(NVRenderDrawMode::Enum drawMode, QT3DSU32 count,
+                                            QT3DSU32 offset, QT3DSU32 instanceCount)
+    {
+        m_Backend->DrawIndexedInstanced(
+            drawMode, count, m_ComponentType,
+            (const void *)(offset * NVRenderComponentTypes::getSizeofType(m_ComponentType)),
+            instanceCount);
+    }
+
     void NVRenderIndexBuffer::DrawIndirect(NVRenderDrawMode::Enum drawMode, QT3DSU32 offset)
     {
         m_Backend->DrawIndexedIndirect(drawMode, m_ComponentType, (const void *)offset);
@@ -108,6 +108,19 @@ namespace render {
          */
         virtual void DrawIndirect(NVRenderDrawMode::Enum drawMode, QT3DSU32 offset);
 
+        /**
+         * @brief draw the buffer several times with a single call
+         *
+         * @param[in] drawMode		draw mode (e.g Triangles...)
+         * @param[in] count			index count
+         * @param[in] offset		start offset in indices
+         * @param[in] instanceCount	number of instances
+         *
+         * @return no return.
+         */
+        void DrawInstanced(NVRenderDrawMode::Enum drawMode, QT3DSU32 count, QT3DSU32 offset,
+                           QT3DSU32 instanceCount);
+
         /**
          * @brief get the backend object handle
          *
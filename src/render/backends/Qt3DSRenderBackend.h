@@ -132,7 +132,8 @@ namespace render {
                 BinaryProgram,
                 CompressedTextureEtc1,
                 CompressedTextureEtc2,
-                CompressedTextureAstc
+                CompressedTextureAstc,
+                Instancing ///< Hardware supports instanced draw calls
             };
         } NVRenderBackendCaps;
 
@@ -164,6 +165,14 @@ namespace render {
          */
         virtual const char *GetShadingLanguageVersion() = 0;
 
+        /**
+         * @brief get a description of the driver, i.e. vendor, renderer and version.
+         *	Used to detect when data cached from a previous run was produced by another driver.
+         *
+         * @return driver description
+         */
+        virtual QByteArray GetDriverDescription() = 0;
+
         /**
          * @brief get maximum supported texture image units that
  *	can be used to access texture maps from the vertex shader and the fragment processor
@@ -1854,6 +1863,36 @@ namespace render {
         virtual void DrawIndexed(NVRenderDrawMode::Enum drawMode, QT3DSU32 count,
                                  NVRenderComponentTypes::Enum type, const void *indices) = 0;
 
+        /**
+         * @brief Draw the current active vertex buffer several times in one call
+         *		  The shader distinguishes the copies through gl_InstanceID
+         *
+         * @param[in] drawMode		Draw mode (Triangles, ....)
+         * @param[in] start			Start vertex
+         * @param[in] count			Vertex count
+         * @param[in] instanceCount	Number of instances to draw
+         *
+         * @return no return.
+         */
+        virtual void DrawInstanced(NVRenderDrawMode::Enum drawMode, QT3DSU32 start, QT3DSU32 count,
+                                   QT3DSU32 instanceCount) = 0;
+
+        /**
+         * @brief Draw the current active index buffer several times in one call
+         *		  The shader distinguishes the copies through gl_InstanceID
+         *
+         * @param[in] drawMode		Draw mode (Triangles, ....)
+         * @param[in] count			Index count
+         * @param[in] type			Index type (QT3DSU16, QT3DSU8)
+         * @param[in] indices		Offset into the active index buffer object
+         * @param[in] instanceCount	Number of instances to draw
+         *
+         * @return no return.
+         */
+        virtual void DrawIndexedInstanced(NVRenderDrawMode::Enum drawMode, QT3DSU32 count,
+                                          NVRenderComponentTypes::Enum type, const void *indices,
+                                          QT3DSU32 instanceCount) = 0;
+
         /**
          * @brief Draw the current active index buffer using an indirect buffer
           *		  This means the setup of the draw call is stored in a buffer bound to
@@ -2202,6 +2241,22 @@ namespace render {
         virtual void getProgramBinary(NVRenderBackendShaderProgramObject po, QT3DSU32 &outFormat,
                                       QByteArray &outBinary) = 0;
 
+        /**
+         * @brief Called by the context once all commands of a frame have been issued
+         *
+         * @return No return
+         */
+        virtual void EndFrame() {}
+
+        /**
+         * @brief Called when the context forces its state onto the backend because the
+         *        underlying API state may have been changed outside of the runtime.
+         *        Backends that skip redundant calls must forget what they have seen.
+         *
+         * @return No return
+         */
+        virtual void InvalidateStateCache() {}
+
     protected:
         /// struct for what the backend supports
         typedef struct NVRenderBackendSupport
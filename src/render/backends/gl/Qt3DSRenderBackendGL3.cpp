@@ -715,6 +715,27 @@ namespace render {
         GL_CALL_EXTRA_FUNCTION(glBindBufferBase(GL_UNIFORM_BUFFER, index, bufID));
     }
 
+    void NVRenderBackendGL3Impl::DrawInstanced(NVRenderDrawMode::Enum drawMode, QT3DSU32 start,
+                                               QT3DSU32 count, QT3DSU32 instanceCount)
+    {
+        GL_CALL_EXTRA_FUNCTION(glDrawArraysInstanced(
+            m_Conversion.fromDrawModeToGL(drawMode,
+                                          m_backendSupport.caps.bits.bTessellationSupported),
+            start, count, instanceCount));
+    }
+
+    void NVRenderBackendGL3Impl::DrawIndexedInstanced(NVRenderDrawMode::Enum drawMode,
+                                                      QT3DSU32 count,
+                                                      NVRenderComponentTypes::Enum type,
+                                                      const void *indices, QT3DSU32 instanceCount)
+    {
+        GL_CALL_EXTRA_FUNCTION(glDrawElementsInstanced(
+            m_Conversion.fromDrawModeToGL(drawMode,
+                                          m_backendSupport.caps.bits.bTessellationSupported),
+            count, m_Conversion.fromIndexBufferComponentsTypesToGL(type), indices,
+            instanceCount));
+    }
+
     NVRenderBackend::NVRenderBackendQueryObject NVRenderBackendGL3Impl::CreateQuery()
     {
         QT3DSU32 glQueryID = 0;
@@ -140,6 +140,12 @@ namespace render {
                                              QT3DSU32 blockIndex, QT3DSU32 binding) override;
         void ProgramSetConstantBuffer(QT3DSU32 index, NVRenderBackendBufferObject bo) override;
 
+        void DrawInstanced(NVRenderDrawMode::Enum drawMode, QT3DSU32 start, QT3DSU32 count,
+                           QT3DSU32 instanceCount) override;
+        void DrawIndexedInstanced(NVRenderDrawMode::Enum drawMode, QT3DSU32 count,
+                                  NVRenderComponentTypes::Enum type, const void *indices,
+                                  QT3DSU32 instanceCount) override;
+
         NVRenderBackendQueryObject CreateQuery() override;
         void ReleaseQuery(NVRenderBackendQueryObject qo) override;
         void BeginQuery(NVRenderBackendQueryObject qo, NVRenderQueryType::Enum type) override;
@@ -135,6 +135,15 @@ const char *NVRenderBackendGLBase::GetShadingLanguageVersion()
     return retval;
 }
 
+QByteArray NVRenderBackendGLBase::GetDriverDescription()
+{
+    QByteArray retval(getVendorString());
+    retval.append('|').append(getRendererString());
+    retval.append('|').append(getVersionString());
+    retval.append('|').append(GetShadingLanguageVersion());
+    return retval;
+}
+
 QT3DSU32
 NVRenderBackendGLBase::GetMaxCombinedTextureUnits()
 {
@@ -253,6 +262,13 @@ bool NVRenderBackendGLBase::GetRenderBackendCap(
     case NVRenderBackendCaps::CompressedTextureAstc:
         bSupported = m_backendSupport.caps.bits.bTextureAstcSupported;
         break;
+    case NVRenderBackendCaps::Instancing: {
+        // On the following context instanced draw calls are not supported
+        NVRenderContextType noInstancingSupportedContextFlags(NVRenderContextValues::GL2
+                                                              | NVRenderContextValues::GLES2);
+        NVRenderContextType ctxType = GetRenderContextType();
+        bSupported = !(ctxType & noInstancingSupportedContextFlags);
+    } break;
     default:
         QT3DS_ASSERT(false);
         bSupported = false;
@@ -2037,6 +2053,28 @@ void NVRenderBackendGLBase::DrawIndexedIndirect(NVRenderDrawMode::Enum drawMode,
     NVRENDER_BACKEND_UNUSED(indirect);
 }
 
+void NVRenderBackendGLBase::DrawInstanced(NVRenderDrawMode::Enum drawMode, QT3DSU32 start,
+                                          QT3DSU32 count, QT3DSU32 instanceCount)
+{
+    // needs GL3 and above
+    NVRENDER_BACKEND_UNUSED(drawMode);
+    NVRENDER_BACKEND_UNUSED(start);
+    NVRENDER_BACKEND_UNUSED(count);
+    NVRENDER_BACKEND_UNUSED(instanceCount);
+}
+
+void NVRenderBackendGLBase::DrawIndexedInstanced(NVRenderDrawMode::Enum drawMode, QT3DSU32 count,
+                                                 NVRenderComponentTypes::Enum type,
+                                                 const void *indices, QT3DSU32 instanceCount)
+{
+    // needs GL3 and above
+    NVRENDER_BACKEND_UNUSED(drawMode);
+    NVRENDER_BACKEND_UNUSED(count);
+    NVRENDER_BACKEND_UNUSED(type);
+    NVRENDER_BACKEND_UNUSED(indices);
+    NVRENDER_BACKEND_UNUSED(instanceCount);
+}
+
 void NVRenderBackendGLBase::ReadPixel(NVRenderBackendRenderTargetObject /* rto */, QT3DSI32 x,
                                       QT3DSI32 y, QT3DSI32 width, QT3DSI32 height,
                                       NVRenderReadPixelFormats::Enum inFormat, void *pixels)
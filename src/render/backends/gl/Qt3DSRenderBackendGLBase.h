@@ -76,6 +76,7 @@ namespace render {
         bool isESCompatible() const;
 
         const char *GetShadingLanguageVersion() override;
+        QByteArray GetDriverDescription() override;
         /// get implementation depended values
         QT3DSU32 GetMaxCombinedTextureUnits() override;
         bool GetRenderBackendCap(NVRenderBackendCaps::Enum inCap) const override;
@@ -402,6 +403,11 @@ namespace render {
                                  NVRenderComponentTypes::Enum type, const void *indices) override;
         void DrawIndexedIndirect(NVRenderDrawMode::Enum drawMode,
                                          NVRenderComponentTypes::Enum type, const void *indirect) override;
+        void DrawInstanced(NVRenderDrawMode::Enum drawMode, QT3DSU32 start, QT3DSU32 count,
+                           QT3DSU32 instanceCount) override;
+        void DrawIndexedInstanced(NVRenderDrawMode::Enum drawMode, QT3DSU32 count,
+                                  NVRenderComponentTypes::Enum type, const void *indices,
+                                  QT3DSU32 instanceCount) override;
 
         // read calls
         void ReadPixel(NVRenderBackendRenderTargetObject rto, QT3DSI32 x, QT3DSI32 y, QT3DSI32 width,
@@ -34,6 +34,7 @@
 #include "EASTL/set.h"
 #include "EASTL/utility.h"
 #include "render/Qt3DSRenderShaderProgram.h"
+#include "render/backends/recorder/Qt3DSRenderBackendRecorder.h"
 
 using namespace qt3ds;
 using namespace qt3ds::render;
@@ -90,6 +91,9 @@ NVRenderContext &NVRenderContext::CreateGL(NVFoundationBase &foundation,
         }
     }
 
+    if (NVRenderBackendRecorder::IsEnabled())
+        theBackend = &NVRenderBackendRecorder::CreateRecorder(foundation, *theBackend);
+
     retval = QT3DS_NEW(foundation.getAllocator(), NVRenderContextImpl)(foundation, *theBackend,
                                                                     *theStringTable);
 
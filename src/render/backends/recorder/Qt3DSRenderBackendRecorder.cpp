@@ -0,0 +1,1874 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qt 3D Studio.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "render/backends/recorder/Qt3DSRenderBackendRecorder.h"
+#include "foundation/Qt3DSFoundation.h"
+#include "foundation/Qt3DSBroadcastingAllocator.h"
+#include "foundation/Qt3DSAtomic.h"
+#include "foundation/Qt3DSContainers.h"
+#include "foundation/Qt3DSLogging.h"
+
+#include <QtCore/qfile.h>
+#include <string.h>
+
+using namespace qt3ds::render;
+using namespace qt3ds::foundation;
+using namespace qt3ds;
+
+namespace {
+
+typedef NVRenderBackendRecorder::SCommandHeader SCommandHeader;
+typedef NVRenderBackendRecorder::SFrameStatistics SFrameStatistics;
+
+QT3DS_COMPILE_TIME_ASSERT(sizeof(SCommandHeader) == 4);
+
+// Arguments of the commands that carry a payload. Handles are stored as 64 bit values and all
+// other members are 32 bit wide, so the structures have no padding and compare bytewise.
+struct SRenderStateCommand
+{
+    QT3DSU32 m_State;
+    QT3DSU32 m_Enable;
+};
+
+struct SValueCommand
+{
+    QT3DSU32 m_Value;
+};
+
+struct SColorWritesCommand
+{
+    QT3DSU32 m_Red;
+    QT3DSU32 m_Green;
+    QT3DSU32 m_Blue;
+    QT3DSU32 m_Alpha;
+};
+
+struct SBlendFuncCommand
+{
+    QT3DSU32 m_SrcRGB;
+    QT3DSU32 m_DstRGB;
+    QT3DSU32 m_SrcAlpha;
+    QT3DSU32 m_DstAlpha;
+};
+
+struct SBlendEquationCommand
+{
+    QT3DSU32 m_RGBEquation;
+    QT3DSU32 m_AlphaEquation;
+};
+
+struct SRectCommand
+{
+    QT3DSI32 m_X;
+    QT3DSI32 m_Y;
+    QT3DSI32 m_Width;
+    QT3DSI32 m_Height;
+};
+
+struct SColorCommand
+{
+    QT3DSF32 m_Red;
+    QT3DSF32 m_Green;
+    QT3DSF32 m_Blue;
+    QT3DSF32 m_Alpha;
+};
+
+struct SHandleCommand
+{
+    QT3DSU64 m_Handle;
+};
+
+struct SInputAssemblerCommand
+{
+    QT3DSU64 m_InputAssembler;
+    QT3DSU64 m_Program;
+};
+
+struct SBindTextureCommand
+{
+    QT3DSU64 m_Texture;
+    QT3DSU32 m_Target;
+    QT3DSU32 m_Unit;
+};
+
+// Followed by the constant value
+struct SConstantCommand
+{
+    QT3DSU64 m_Program;
+    QT3DSU32 m_Location;
+    QT3DSU32 m_Type;
+    QT3DSI32 m_Count;
+    QT3DSU32 m_Transpose;
+};
+
+// Shared by all draw variants. m_Offset is the index or indirect buffer offset.
+struct SDrawCommand
+{
+    QT3DSU32 m_Mode;
+    QT3DSU32 m_Start;
+    QT3DSU32 m_Count;
+    QT3DSU32 m_IndexType;
+    QT3DSU64 m_Offset;
+    QT3DSU32 m_InstanceCount;
+    QT3DSU32 m_Padding;
+};
+
+template <typename THandle>
+QT3DSU64 toHandleValue(THandle inHandle)
+{
+    return static_cast<QT3DSU64>(reinterpret_cast<size_t>(inHandle));
+}
+
+template <typename THandle>
+THandle fromHandleValue(QT3DSU64 inValue)
+{
+    return reinterpret_cast<THandle>(static_cast<size_t>(inValue));
+}
+
+// Last value forwarded for a piece of state. A slot starts out invalid so that the first set
+// after creation or invalidation always reaches the wrapped backend.
+template <typename TCommand>
+struct SShadowState
+{
+    TCommand m_Value;
+    bool m_Valid;
+
+    SShadowState()
+        : m_Valid(false)
+    {
+    }
+
+    bool Matches(const TCommand &inValue) const
+    {
+        return m_Valid && ::memcmp(&m_Value, &inValue, sizeof(TCommand)) == 0;
+    }
+    void Set(const TCommand &inValue)
+    {
+        m_Value = inValue;
+        m_Valid = true;
+    }
+    void Invalidate() { m_Valid = false; }
+};
+
+static const QT3DSU32 RenderStateCount = 1
+#define QT3DS_RENDER_HANDLE_RENDER_STATE(x) +1
+        QT3DS_RENDER_ITERATE_RENDER_STATE
+#undef QT3DS_RENDER_HANDLE_RENDER_STATE
+        ;
+static const QT3DSU32 MaxTextureUnits = 32;
+// Constants larger than this (arrays of matrices mostly) are always forwarded
+static const QT3DSU32 MaxShadowedConstantSize = 64;
+static const QT3DSU32 StatisticsLogInterval = 600;
+static const QT3DSU32 DumpMagic = 0x52423351; // 'Q3BR'
+
+QT3DSU32 getSizeofShaderDataType(NVRenderShaderDataTypes::Enum inType)
+{
+    switch (inType) {
+    case NVRenderShaderDataTypes::QT3DSI32:
+        return sizeof(QT3DSI32);
+    case NVRenderShaderDataTypes::QT3DSI32_2:
+        return sizeof(QT3DSI32_2);
+    case NVRenderShaderDataTypes::QT3DSI32_3:
+        return sizeof(QT3DSI32_3);
+    case NVRenderShaderDataTypes::QT3DSI32_4:
+        return sizeof(QT3DSI32_4);
+    case NVRenderShaderDataTypes::QT3DSRenderBool:
+        return sizeof(QT3DSRenderBool);
+    case NVRenderShaderDataTypes::bool_2:
+        return sizeof(bool_2);
+    case NVRenderShaderDataTypes::bool_3:
+        return sizeof(bool_3);
+    case NVRenderShaderDataTypes::bool_4:
+        return sizeof(bool_4);
+    case NVRenderShaderDataTypes::QT3DSF32:
+        return sizeof(QT3DSF32);
+    case NVRenderShaderDataTypes::QT3DSVec2:
+        return sizeof(QT3DSVec2);
+    case NVRenderShaderDataTypes::QT3DSVec3:
+        return sizeof(QT3DSVec3);
+    case NVRenderShaderDataTypes::QT3DSVec4:
+        return sizeof(QT3DSVec4);
+    case NVRenderShaderDataTypes::QT3DSU32:
+        return sizeof(QT3DSU32);
+    case NVRenderShaderDataTypes::QT3DSU32_2:
+        return sizeof(QT3DSU32_2);
+    case NVRenderShaderDataTypes::QT3DSU32_3:
+        return sizeof(QT3DSU32_3);
+    case NVRenderShaderDataTypes::QT3DSU32_4:
+        return sizeof(QT3DSU32_4);
+    case NVRenderShaderDataTypes::QT3DSMat33:
+        return sizeof(QT3DSMat33);
+    case NVRenderShaderDataTypes::QT3DSMat44:
+        return sizeof(QT3DSMat44);
+    default:
+        // samplers, images and buffers are set as texture or binding units
+        return sizeof(QT3DSI32);
+    }
+}
+
+QT3DSU64 getTextureDataSize(NVRenderTextureFormats::Enum inFormat, size_t inWidth,
+                            size_t inHeight, size_t inDepth, const void *inData)
+{
+    if (!inData || !NVRenderTextureFormats::isUncompressedTextureFormat(inFormat))
+        return 0;
+    return QT3DSU64(inWidth) * inHeight * inDepth
+            * NVRenderTextureFormats::getSizeofFormat(inFormat);
+}
+
+typedef eastl::pair<QT3DSU64, QT3DSU32> TConstantKey;
+
+struct SConstantKeyHash
+{
+    size_t operator()(const TConstantKey &inKey) const
+    {
+        return eastl::hash<QT3DSU64>()(inKey.first) ^ (size_t(inKey.second) * 2654435761u);
+    }
+};
+
+struct SConstantValue
+{
+    QT3DSU32 m_Size;
+    QT3DSU8 m_Data[MaxShadowedConstantSize];
+};
+
+typedef nvhash_map<TConstantKey, SConstantValue, SConstantKeyHash> TConstantMap;
+
+struct SBackendRecorder : public NVRenderBackendRecorder
+{
+    NVFoundationBase &m_Foundation;
+    NVScopedRefCounted<NVRenderBackend> m_Backend;
+    QT3DSI32 mRefCount;
+
+    nvvector<QT3DSU8> m_Commands;
+    nvvector<QT3DSU8> m_LastFrameCommands;
+    SFrameStatistics m_Statistics;
+    SFrameStatistics m_LastFrameStatistics;
+    SFrameStatistics m_LogStatistics;
+    QT3DSU32 m_Frame;
+    QFile m_DumpFile;
+
+    SShadowState<SValueCommand> m_RenderStates[RenderStateCount];
+    SShadowState<SValueCommand> m_DepthFunc;
+    SShadowState<SValueCommand> m_DepthWrite;
+    SShadowState<SValueCommand> m_Multisample;
+    SShadowState<SColorWritesCommand> m_ColorWrites;
+    SShadowState<SBlendFuncCommand> m_BlendFunc;
+    SShadowState<SBlendEquationCommand> m_BlendEquation;
+    SShadowState<SRectCommand> m_ScissorRect;
+    SShadowState<SRectCommand> m_ViewportRect;
+    SShadowState<SColorCommand> m_ClearColor;
+    SShadowState<SHandleCommand> m_DepthStencilState;
+    SShadowState<SHandleCommand> m_RasterizerState;
+    SShadowState<SHandleCommand> m_RenderTarget;
+    SShadowState<SHandleCommand> m_ReadTarget;
+    SShadowState<SHandleCommand> m_Program;
+    SShadowState<SInputAssemblerCommand> m_InputAssembler;
+    bool m_InputAssemblerResult;
+    SShadowState<SBindTextureCommand> m_Textures[MaxTextureUnits];
+    QT3DSI32 m_ActiveTextureUnit;
+    TConstantMap m_Constants;
+
+    SBackendRecorder(NVFoundationBase &fnd, NVRenderBackend &inBackend)
+        : m_Foundation(fnd)
+        , m_Backend(inBackend)
+        , mRefCount(0)
+        , m_Commands(fnd.getAllocator(), "SBackendRecorder::m_Commands")
+        , m_LastFrameCommands(fnd.getAllocator(), "SBackendRecorder::m_LastFrameCommands")
+        , m_Frame(0)
+        , m_InputAssemblerResult(false)
+        , m_ActiveTextureUnit(-1)
+        , m_Constants(fnd.getAllocator(), "SBackendRecorder::m_Constants")
+    {
+        const QString dumpFile = qEnvironmentVariable("QT3DS_BACKEND_RECORDER_DUMP");
+        if (!dumpFile.isEmpty()) {
+            m_DumpFile.setFileName(dumpFile);
+            if (!m_DumpFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+                qCWarning(WARNING) << "Backend recorder cannot write" << dumpFile << ":"
+                                   << m_DumpFile.errorString();
+            }
+        }
+    }
+
+    QT3DS_IMPLEMENT_REF_COUNT_ADDREF_RELEASE_OVERRIDE(m_Foundation.getAllocator())
+
+    QT3DSU8 *Append(NVRenderBackendCommands::Enum inCommand, QT3DSU32 inPayloadSize,
+                    QT3DSU8 inFlags = 0)
+    {
+        ++m_Statistics.m_Calls;
+        if (inFlags & SCommandHeader::Redundant)
+            ++m_Statistics.m_RedundantCalls;
+        if (inPayloadSize > 0xFFFF) {
+            inFlags |= SCommandHeader::Truncated;
+            inPayloadSize = 0;
+        }
+        SCommandHeader header;
+        header.m_Command = static_cast<QT3DSU8>(inCommand);
+        header.m_Flags = inFlags;
+        header.m_PayloadSize = static_cast<QT3DSU16>(inPayloadSize);
+
+        const size_t offset = m_Commands.size();
+        m_Commands.resize(offset + sizeof(header) + inPayloadSize);
+        ::memcpy(m_Commands.data() + offset, &header, sizeof(header));
+        return inPayloadSize ? m_Commands.data() + offset + sizeof(header) : nullptr;
+    }
+
+    void Record(NVRenderBackendCommands::Enum inCommand) { Append(inCommand, 0); }
+
+    template <typename TCommand>
+    void Record(NVRenderBackendCommands::Enum inCommand, const TCommand &inPayload,
+                bool inRedundant)
+    {
+        QT3DSU8 *payload = Append(inCommand, sizeof(TCommand),
+                                  inRedundant ? QT3DSU8(SCommandHeader::Redundant) : QT3DSU8(0));
+        ::memcpy(payload, &inPayload, sizeof(TCommand));
+    }
+
+    // Records the command and returns true if the wrapped backend already has this state
+    template <typename TCommand>
+    bool Filter(NVRenderBackendCommands::Enum inCommand, SShadowState<TCommand> &inShadow,
+                const TCommand &inPayload)
+    {
+        const bool redundant = inShadow.Matches(inPayload);
+        inShadow.Set(inPayload);
+        Record(inCommand, inPayload, redundant);
+        return redundant;
+    }
+
+    void RecordDraw(NVRenderBackendCommands::Enum inCommand, NVRenderDrawMode::Enum inMode,
+                    QT3DSU32 inStart, QT3DSU32 inCount, NVRenderComponentTypes::Enum inIndexType,
+                    const void *inOffset, QT3DSU32 inInstanceCount = 1)
+    {
+        SDrawCommand command = { QT3DSU32(inMode), inStart, inCount, QT3DSU32(inIndexType),
+                                 toHandleValue(inOffset), inInstanceCount, 0 };
+        Record(inCommand, command, false);
+        ++m_Statistics.m_DrawCalls;
+    }
+
+    void InvalidateFixedFunctionState()
+    {
+        for (QT3DSU32 idx = 0; idx < RenderStateCount; ++idx)
+            m_RenderStates[idx].Invalidate();
+        m_DepthFunc.Invalidate();
+        m_DepthWrite.Invalidate();
+        m_Multisample.Invalidate();
+        m_ColorWrites.Invalidate();
+        m_BlendFunc.Invalidate();
+        m_BlendEquation.Invalidate();
+        m_ScissorRect.Invalidate();
+        m_ViewportRect.Invalidate();
+        m_ClearColor.Invalidate();
+        m_DepthStencilState.Invalidate();
+        m_RasterizerState.Invalidate();
+    }
+
+    // Texture uploads bind the texture on unit 0 in the GL backends
+    void InvalidateTextureBindings()
+    {
+        for (QT3DSU32 idx = 0; idx < MaxTextureUnits; ++idx)
+            m_Textures[idx].Invalidate();
+        m_ActiveTextureUnit = -1;
+    }
+
+    // Buffer bindings are part of the vertex array object that is bound at the time
+    void InvalidateInputAssembler() { m_InputAssembler.Invalidate(); }
+
+    void InvalidateConstants(NVRenderBackendShaderProgramObject po)
+    {
+        const QT3DSU64 program = toHandleValue(po);
+        for (TConstantMap::iterator iter = m_Constants.begin(); iter != m_Constants.end();) {
+            if (iter->first.first == program)
+                iter = m_Constants.erase(iter);
+            else
+                ++iter;
+        }
+    }
+
+    // Constants are left alone, they are owned by the program objects
+    void InvalidateShadowState()
+    {
+        InvalidateFixedFunctionState();
+        InvalidateTextureBindings();
+        InvalidateInputAssembler();
+        m_RenderTarget.Invalidate();
+        m_ReadTarget.Invalidate();
+        m_Program.Invalidate();
+    }
+
+    void InvalidateStateCache() override
+    {
+        InvalidateShadowState();
+        m_Backend->InvalidateStateCache();
+    }
+
+    void EndFrame() override
+    {
+        m_Backend->EndFrame();
+
+        if (m_DumpFile.isOpen()) {
+            NVRenderBackendRecorder::SFrameHeader header;
+            header.m_Magic = DumpMagic;
+            header.m_Frame = m_Frame;
+            header.m_CommandBytes = static_cast<QT3DSU32>(m_Commands.size());
+            header.m_Calls = m_Statistics.m_Calls;
+            header.m_RedundantCalls = m_Statistics.m_RedundantCalls;
+            header.m_DrawCalls = m_Statistics.m_DrawCalls;
+            header.m_UploadedBytes = m_Statistics.m_UploadedBytes;
+            m_DumpFile.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            m_DumpFile.write(reinterpret_cast<const char *>(m_Commands.data()),
+                             qint64(m_Commands.size()));
+        }
+
+        m_LogStatistics.m_Calls += m_Statistics.m_Calls;
+        m_LogStatistics.m_RedundantCalls += m_Statistics.m_RedundantCalls;
+        m_LogStatistics.m_DrawCalls += m_Statistics.m_DrawCalls;
+        m_LogStatistics.m_UploadedBytes += m_Statistics.m_UploadedBytes;
+        if ((m_Frame + 1) % StatisticsLogInterval == 0) {
+            const QT3DSF32 frames = QT3DSF32(StatisticsLogInterval);
+            qCInfo(PERF_INFO, "Backend calls per frame: %.1f, redundant: %.1f, draws: %.1f, "
+                              "uploaded: %.1f KB",
+                   m_LogStatistics.m_Calls / frames, m_LogStatistics.m_RedundantCalls / frames,
+                   m_LogStatistics.m_DrawCalls / frames,
+                   m_LogStatistics.m_UploadedBytes / frames / 1024.0f);
+            m_LogStatistics = SFrameStatistics();
+        }
+
+        m_LastFrameStatistics = m_Statistics;
+        m_Statistics = SFrameStatistics();
+        m_LastFrameCommands.swap(m_Commands);
+        m_Commands.clear();
+        ++m_Frame;
+
+        // Anything outside of the runtime may touch the state between frames
+        InvalidateShadowState();
+    }
+
+    SFrameStatistics GetFrameStatistics() const override { return m_LastFrameStatistics; }
+    NVConstDataRef<QT3DSU8> GetFrameCommands() const override
+    {
+        return toConstDataRef(m_LastFrameCommands.data(),
+                              static_cast<QT3DSU32>(m_LastFrameCommands.size()));
+    }
+    NVRenderBackend &GetWrappedBackend() override { return *m_Backend; }
+
+    /// backend interface
+
+    void SetRenderState(bool bEnable, const NVRenderState::Enum value) override
+    {
+        SRenderStateCommand command = { QT3DSU32(value), QT3DSU32(bEnable) };
+        bool redundant = false;
+        if (command.m_State < RenderStateCount) {
+            SValueCommand enabled = { command.m_Enable };
+            redundant = m_RenderStates[value].Matches(enabled);
+            m_RenderStates[value].Set(enabled);
+        }
+        Record(NVRenderBackendCommands::SetRenderState, command, redundant);
+        if (!redundant) {
+            // depth and stencil test no longer match the bound depth stencil state
+            m_DepthStencilState.Invalidate();
+            m_Backend->SetRenderState(bEnable, value);
+        }
+    }
+    void SetDepthStencilState(NVRenderBackendDepthStencilStateObject depthStencilState) override
+    {
+        SHandleCommand command = { toHandleValue(depthStencilState) };
+        if (Filter(NVRenderBackendCommands::SetDepthStencilState, m_DepthStencilState, command))
+            return;
+        // sets depth test, mask, function and stencil state in one go
+        for (QT3DSU32 idx = 0; idx < RenderStateCount; ++idx)
+            m_RenderStates[idx].Invalidate();
+        m_DepthFunc.Invalidate();
+        m_DepthWrite.Invalidate();
+        m_Backend->SetDepthStencilState(depthStencilState);
+    }
+    void SetRasterizerState(NVRenderBackendRasterizerStateObject rasterizerState) override
+    {
+        SHandleCommand command = { toHandleValue(rasterizerState) };
+        if (Filter(NVRenderBackendCommands::SetRasterizerState, m_RasterizerState, command))
+            return;
+        for (QT3DSU32 idx = 0; idx < RenderStateCount; ++idx)
+            m_RenderStates[idx].Invalidate();
+        m_Backend->SetRasterizerState(rasterizerState);
+    }
+    void SetDepthFunc(const NVRenderBoolOp::Enum func) override
+    {
+        SValueCommand command = { QT3DSU32(func) };
+        if (!Filter(NVRenderBackendCommands::SetDepthFunc, m_DepthFunc, command)) {
+            m_DepthStencilState.Invalidate();
+            m_Backend->SetDepthFunc(func);
+        }
+    }
+    void SetDepthWrite(bool bEnable) override
+    {
+        SValueCommand command = { QT3DSU32(bEnable) };
+        if (!Filter(NVRenderBackendCommands::SetDepthWrite, m_DepthWrite, command)) {
+            m_DepthStencilState.Invalidate();
+            m_Backend->SetDepthWrite(bEnable);
+        }
+    }
+    void SetColorWrites(bool bRed, bool bGreen, bool bBlue, bool bAlpha) override
+    {
+        SColorWritesCommand command = { QT3DSU32(bRed), QT3DSU32(bGreen), QT3DSU32(bBlue),
+                                        QT3DSU32(bAlpha) };
+        if (!Filter(NVRenderBackendCommands::SetColorWrites, m_ColorWrites, command))
+            m_Backend->SetColorWrites(bRed, bGreen, bBlue, bAlpha);
+    }
+    void SetMultisample(bool bEnable) override
+    {
+        SValueCommand command = { QT3DSU32(bEnable) };
+        if (!Filter(NVRenderBackendCommands::SetMultisample, m_Multisample, command))
+            m_Backend->SetMultisample(bEnable);
+    }
+    void SetBlendFunc(const NVRenderBlendFunctionArgument &blendFuncArg) override
+    {
+        SBlendFuncCommand command = { QT3DSU32(blendFuncArg.m_SrcRGB),
+                                      QT3DSU32(blendFuncArg.m_DstRGB),
+                                      QT3DSU32(blendFuncArg.m_SrcAlpha),
+                                      QT3DSU32(blendFuncArg.m_DstAlpha) };
+        if (!Filter(NVRenderBackendCommands::SetBlendFunc, m_BlendFunc, command))
+            m_Backend->SetBlendFunc(blendFuncArg);
+    }
+    void SetBlendEquation(const NVRenderBlendEquationArgument &pBlendEquArg) override
+    {
+        SBlendEquationCommand command = { QT3DSU32(pBlendEquArg.m_RGBEquation),
+                                          QT3DSU32(pBlendEquArg.m_AlphaEquation) };
+        if (!Filter(NVRenderBackendCommands::SetBlendEquation, m_BlendEquation, command))
+            m_Backend->SetBlendEquation(pBlendEquArg);
+    }
+    void SetScissorRect(const NVRenderRect &rect) override
+    {
+        SRectCommand command = { rect.m_X, rect.m_Y, rect.m_Width, rect.m_Height };
+        if (!Filter(NVRenderBackendCommands::SetScissorRect, m_ScissorRect, command))
+            m_Backend->SetScissorRect(rect);
+    }
+    void SetViewportRect(const NVRenderRect &rect) override
+    {
+        SRectCommand command = { rect.m_X, rect.m_Y, rect.m_Width, rect.m_Height };
+        if (!Filter(NVRenderBackendCommands::SetViewportRect, m_ViewportRect, command))
+            m_Backend->SetViewportRect(rect);
+    }
+    void SetClearColor(const QT3DSVec4 *pClearColor) override
+    {
+        QT3DS_ASSERT(pClearColor);
+        SColorCommand command = { pClearColor->x, pClearColor->y, pClearColor->z,
+                                  pClearColor->w };
+        if (!Filter(NVRenderBackendCommands::SetClearColor, m_ClearColor, command))
+            m_Backend->SetClearColor(pClearColor);
+    }
+    void Clear(NVRenderClearFlags flags) override
+    {
+        SValueCommand command = { QT3DSU32(flags) };
+        Record(NVRenderBackendCommands::Clear, command, false);
+        m_Backend->Clear(flags);
+    }
+    NVRenderBackendBufferObject CreateBuffer(size_t size, NVRenderBufferBindFlags bindFlags,
+                                             NVRenderBufferUsageType::Enum usage,
+                                             const void *hostPtr) override
+    {
+        Record(NVRenderBackendCommands::CreateBuffer);
+        InvalidateInputAssembler();
+        if (hostPtr)
+            m_Statistics.m_UploadedBytes += size;
+        return m_Backend->CreateBuffer(size, bindFlags, usage, hostPtr);
+    }
+    void BindBuffer(NVRenderBackendBufferObject bo, NVRenderBufferBindFlags bindFlags) override
+    {
+        Record(NVRenderBackendCommands::BindBuffer);
+        InvalidateInputAssembler();
+        m_Backend->BindBuffer(bo, bindFlags);
+    }
+    void ReleaseBuffer(NVRenderBackendBufferObject bo) override
+    {
+        Record(NVRenderBackendCommands::ReleaseBuffer);
+        InvalidateInputAssembler();
+        m_Backend->ReleaseBuffer(bo);
+    }
+    void UpdateBuffer(NVRenderBackendBufferObject bo, NVRenderBufferBindFlags bindFlags,
+                      size_t size, NVRenderBufferUsageType::Enum usage,
+                      const void *data) override
+    {
+        Record(NVRenderBackendCommands::UpdateBuffer);
+        InvalidateInputAssembler();
+        if (data)
+            m_Statistics.m_UploadedBytes += size;
+        m_Backend->UpdateBuffer(bo, bindFlags, size, usage, data);
+    }
+    void UpdateBufferRange(NVRenderBackendBufferObject bo, NVRenderBufferBindFlags bindFlags,
+                           size_t offset, size_t size, const void *data) override
+    {
+        Record(NVRenderBackendCommands::UpdateBufferRange);
+        InvalidateInputAssembler();
+        if (data)
+            m_Statistics.m_UploadedBytes += size;
+        m_Backend->UpdateBufferRange(bo, bindFlags, offset, size, data);
+    }
+    void *MapBuffer(NVRenderBackendBufferObject bo, NVRenderBufferBindFlags bindFlags,
+                    size_t offset, size_t length, NVRenderBufferAccessFlags accessFlags) override
+    {
+        Record(NVRenderBackendCommands::MapBuffer);
+        InvalidateInputAssembler();
+        if (accessFlags & NVRenderBufferAccessTypeValues::Write)
+            m_Statistics.m_UploadedBytes += length;
+        return m_Backend->MapBuffer(bo, bindFlags, offset, length, accessFlags);
+    }
+    bool UnmapBuffer(NVRenderBackendBufferObject bo, NVRenderBufferBindFlags bindFlags) override
+    {
+        Record(NVRenderBackendCommands::UnmapBuffer);
+        InvalidateInputAssembler();
+        return m_Backend->UnmapBuffer(bo, bindFlags);
+    }
+    void ReleaseRenderTarget(NVRenderBackendRenderTargetObject rto) override
+    {
+        Record(NVRenderBackendCommands::ReleaseRenderTarget);
+        m_RenderTarget.Invalidate();
+        m_ReadTarget.Invalidate();
+        m_Backend->ReleaseRenderTarget(rto);
+    }
+    void SetRenderTarget(NVRenderBackendRenderTargetObject rto) override
+    {
+        SHandleCommand command = { toHandleValue(rto) };
+        if (Filter(NVRenderBackendCommands::SetRenderTarget, m_RenderTarget, command))
+            return;
+        // binds the read framebuffer as well
+        m_ReadTarget.Invalidate();
+        m_Backend->SetRenderTarget(rto);
+    }
+    void SetReadTarget(NVRenderBackendRenderTargetObject rto) override
+    {
+        SHandleCommand command = { toHandleValue(rto) };
+        if (!Filter(NVRenderBackendCommands::SetReadTarget, m_ReadTarget, command))
+            m_Backend->SetReadTarget(rto);
+    }
+    void SetTextureData2D(NVRenderBackendTextureObject to, NVRenderTextureTargetType::Enum target,
+                          QT3DSU32 level, NVRenderTextureFormats::Enum internalFormat,
+                          size_t width, size_t height, QT3DSI32 border,
+                          NVRenderTextureFormats::Enum format, const void *hostPtr) override
+    {
+        Record(NVRenderBackendCommands::SetTextureData2D);
+        InvalidateTextureBindings();
+        m_Statistics.m_UploadedBytes += getTextureDataSize(format, width, height, 1, hostPtr);
+        m_Backend->SetTextureData2D(to, target, level, internalFormat, width, height, border,
+                                    format, hostPtr);
+    }
+    void SetTextureDataCubeFace(NVRenderBackendTextureObject to,
+                                NVRenderTextureTargetType::Enum target, QT3DSU32 level,
+                                NVRenderTextureFormats::Enum internalFormat, size_t width,
+                                size_t height, QT3DSI32 border,
+                                NVRenderTextureFormats::Enum format, const void *hostPtr) override
+    {
+        Record(NVRenderBackendCommands::SetTextureDataCubeFace);
+        InvalidateTextureBindings();
+        m_Statistics.m_UploadedBytes += getTextureDataSize(format, width, height, 1, hostPtr);
+        m_Backend->SetTextureDataCubeFace(to, target, level, internalFormat, width, height,
+                                          border, format, hostPtr);
+    }
+    void CreateTextureStorage2D(NVRenderBackendTextureObject to,
+                                NVRenderTextureTargetType::Enum target, QT3DSU32 levels,
+                                NVRenderTextureFormats::Enum internalFormat, size_t width,
+                                size_t height) override
+    {
+        Record(NVRenderBackendCommands::CreateTextureStorage2D);
+        InvalidateTextureBindings();
+        m_Backend->CreateTextureStorage2D(to, target, levels, internalFormat, width, height);
+    }
+    void SetTextureSubData2D(NVRenderBackendTextureObject to,
+                             NVRenderTextureTargetType::Enum target, QT3DSU32 level,
+                             QT3DSI32 xOffset, QT3DSI32 yOffset, size_t width, size_t height,
+                             NVRenderTextureFormats::Enum format, const void *hostPtr) override
+    {
+        Record(NVRenderBackendCommands::SetTextureSubData2D);
+        InvalidateTextureBindings();
+        m_Statistics.m_UploadedBytes += getTextureDataSize(format, width, height, 1, hostPtr);
+        m_Backend->SetTextureSubData2D(to, target, level, xOffset, yOffset, width, height, format,
+                                       hostPtr);
+    }
+    void SetCompressedTextureData2D(NVRenderBackendTextureObject to,
+                                    NVRenderTextureTargetType::Enum target, QT3DSU32 level,
+                                    NVRenderTextureFormats::Enum internalFormat, size_t width,
+                                    size_t height, QT3DSI32 border, size_t imageSize,
+                                    const void *hostPtr) override
+    {
+        Record(NVRenderBackendCommands::SetCompressedTextureData2D);
+        InvalidateTextureBindings();
+        if (hostPtr)
+            m_Statistics.m_UploadedBytes += imageSize;
+        m_Backend->SetCompressedTextureData2D(to, target, level, internalFormat, width, height,
+                                              border, imageSize, hostPtr);
+    }
+    void SetCompressedTextureDataCubeFace(NVRenderBackendTextureObject to,
+                                          NVRenderTextureTargetType::Enum target, QT3DSU32 level,
+                                          NVRenderTextureFormats::Enum internalFormat,
+                                          size_t width, size_t height, QT3DSI32 border,
+                                          size_t imageSize, const void *hostPtr) override
+    {
+        Record(NVRenderBackendCommands::SetCompressedTextureDataCubeFace);
+        InvalidateTextureBindings();
+        if (hostPtr)
+            m_Statistics.m_UploadedBytes += imageSize;
+        m_Backend->SetCompressedTextureDataCubeFace(to, target, level, internalFormat, width,
+                                                    height, border, imageSize, hostPtr);
+    }
+    void SetCompressedTextureSubData2D(NVRenderBackendTextureObject to,
+                                       NVRenderTextureTargetType::Enum target, QT3DSU32 level,
+                                       QT3DSI32 xOffset, QT3DSI32 yOffset, size_t width,
+                                       size_t height, NVRenderTextureFormats::Enum format,
+                                       size_t imageSize, const void *hostPtr) override
+    {
+        Record(NVRenderBackendCommands::SetCompressedTextureSubData2D);
+        InvalidateTextureBindings();
+        if (hostPtr)
+            m_Statistics.m_UploadedBytes += imageSize;
+        m_Backend->SetCompressedTextureSubData2D(to, target, level, xOffset, yOffset, width,
+                                                 height, format, imageSize, hostPtr);
+    }
+    void SetMultisampledTextureData2D(NVRenderBackendTextureObject to,
+                                      NVRenderTextureTargetType::Enum target, size_t samples,
+                                      NVRenderTextureFormats::Enum internalFormat, size_t width,
+                                      size_t height, bool fixedsamplelocations) override
+    {
+        Record(NVRenderBackendCommands::SetMultisampledTextureData2D);
+        InvalidateTextureBindings();
+        m_Backend->SetMultisampledTextureData2D(to, target, samples, internalFormat, width,
+                                                height, fixedsamplelocations);
+    }
+    void SetTextureData3D(NVRenderBackendTextureObject to, NVRenderTextureTargetType::Enum target,
+                          QT3DSU32 level, NVRenderTextureFormats::Enum internalFormat,
+                          size_t width, size_t height, size_t depth, QT3DSI32 border,
+                          NVRenderTextureFormats::Enum format, const void *hostPtr) override
+    {
+        Record(NVRenderBackendCommands::SetTextureData3D);
+        InvalidateTextureBindings();
+        m_Statistics.m_UploadedBytes += getTextureDataSize(format, width, height, depth, hostPtr);
+        m_Backend->SetTextureData3D(to, target, level, internalFormat, width, height, depth,
+                                    border, format, hostPtr);
+    }
+    void GenerateMipMaps(NVRenderBackendTextureObject to, NVRenderTextureTargetType::Enum target,
+                         NVRenderHint::Enum genType) override
+    {
+        Record(NVRenderBackendCommands::GenerateMipMaps);
+        InvalidateTextureBindings();
+        m_Backend->GenerateMipMaps(to, target, genType);
+    }
+    void BindTexture(NVRenderBackendTextureObject to, NVRenderTextureTargetType::Enum target,
+                     QT3DSU32 unit) override
+    {
+        SBindTextureCommand command = { toHandleValue(to), QT3DSU32(target), unit };
+        bool redundant = false;
+        if (unit < MaxTextureUnits) {
+            // binding also makes the unit active
+            redundant = m_ActiveTextureUnit == QT3DSI32(unit) && m_Textures[unit].Matches(command);
+            m_Textures[unit].Set(command);
+            m_ActiveTextureUnit = QT3DSI32(unit);
+        } else {
+            m_ActiveTextureUnit = -1;
+        }
+        Record(NVRenderBackendCommands::BindTexture, command, redundant);
+        if (!redundant)
+            m_Backend->BindTexture(to, target, unit);
+    }
+    void ReleaseTexture(NVRenderBackendTextureObject to) override
+    {
+        Record(NVRenderBackendCommands::ReleaseTexture);
+        InvalidateTextureBindings();
+        m_Backend->ReleaseTexture(to);
+    }
+    NVRenderBackendInputAssemblerObject
+    CreateInputAssembler(NVRenderBackendAttribLayoutObject attribLayout,
+                         NVConstDataRef<NVRenderBackendBufferObject> buffers,
+                         const NVRenderBackendBufferObject indexBuffer,
+                         NVConstDataRef<QT3DSU32> strides, NVConstDataRef<QT3DSU32> offsets,
+                         QT3DSU32 patchVertexCount) override
+    {
+        Record(NVRenderBackendCommands::CreateInputAssembler);
+        InvalidateInputAssembler();
+        return m_Backend->CreateInputAssembler(attribLayout, buffers, indexBuffer, strides,
+                                               offsets, patchVertexCount);
+    }
+    void ReleaseInputAssembler(NVRenderBackendInputAssemblerObject iao) override
+    {
+        Record(NVRenderBackendCommands::ReleaseInputAssembler);
+        InvalidateInputAssembler();
+        m_Backend->ReleaseInputAssembler(iao);
+    }
+    bool SetInputAssembler(NVRenderBackendInputAssemblerObject iao,
+                           NVRenderBackendShaderProgramObject po) override
+    {
+        SInputAssemblerCommand command = { toHandleValue(iao), toHandleValue(po) };
+        if (Filter(NVRenderBackendCommands::SetInputAssembler, m_InputAssembler, command))
+            return m_InputAssemblerResult;
+        m_InputAssemblerResult = m_Backend->SetInputAssembler(iao, po);
+        return m_InputAssemblerResult;
+    }
+    void ReleaseShaderProgram(NVRenderBackendShaderProgramObject po) override
+    {
+        Record(NVRenderBackendCommands::ReleaseShaderProgram);
+        InvalidateConstants(po);
+        m_Program.Invalidate();
+        InvalidateInputAssembler();
+        m_Backend->ReleaseShaderProgram(po);
+    }
+    bool linkProgram(NVRenderBackendShaderProgramObject po, eastl::string &errorMessage,
+                     QT3DSU32 binaryFormat, const QByteArray *binary) override
+    {
+        Record(NVRenderBackendCommands::linkProgram);
+        // linking resets all constants of the program
+        InvalidateConstants(po);
+        return m_Backend->linkProgram(po, errorMessage, binaryFormat, binary);
+    }
+    void SetActiveProgram(NVRenderBackendShaderProgramObject po) override
+    {
+        SHandleCommand command = { toHandleValue(po) };
+        if (!Filter(NVRenderBackendCommands::SetActiveProgram, m_Program, command))
+            m_Backend->SetActiveProgram(po);
+    }
+    void SetActiveProgramPipeline(NVRenderBackendProgramPipeline ppo) override
+    {
+        Record(NVRenderBackendCommands::SetActiveProgramPipeline);
+        m_Program.Invalidate();
+        m_Backend->SetActiveProgramPipeline(ppo);
+    }
+    void DispatchCompute(NVRenderBackendShaderProgramObject po, QT3DSU32 numGroupsX,
+                         QT3DSU32 numGroupsY, QT3DSU32 numGroupsZ) override
+    {
+        Record(NVRenderBackendCommands::DispatchCompute);
+        m_Program.Invalidate();
+        m_Backend->DispatchCompute(po, numGroupsX, numGroupsY, numGroupsZ);
+    }
+    void SetConstantValue(NVRenderBackendShaderProgramObject po, QT3DSU32 id,
+                          NVRenderShaderDataTypes::Enum type, QT3DSI32 count, const void *value,
+                          bool transpose) override
+    {
+        const QT3DSU32 valueSize = getSizeofShaderDataType(type) * QT3DSU32(qMax(count, 1));
+        bool redundant = false;
+        if (valueSize <= MaxShadowedConstantSize && !transpose) {
+            eastl::pair<TConstantMap::iterator, bool> inserted =
+                    m_Constants.insert(eastl::make_pair(TConstantKey(toHandleValue(po), id),
+                                                        SConstantValue()));
+            SConstantValue &shadow = inserted.first->second;
+            redundant = !inserted.second && shadow.m_Size == valueSize
+                    && ::memcmp(shadow.m_Data, value, valueSize) == 0;
+            shadow.m_Size = valueSize;
+            ::memcpy(shadow.m_Data, value, valueSize);
+        }
+
+        SConstantCommand command = { toHandleValue(po), id, QT3DSU32(type), count,
+                                     QT3DSU32(transpose) };
+        QT3DSU8 *payload = Append(NVRenderBackendCommands::SetConstantValue,
+                                  sizeof(command) + valueSize,
+                                  redundant ? QT3DSU8(SCommandHeader::Redundant) : QT3DSU8(0));
+        if (payload) {
+            ::memcpy(payload, &command, sizeof(command));
+            ::memcpy(payload + sizeof(command), value, valueSize);
+        }
+        if (redundant)
+            return;
+
+        m_Statistics.m_UploadedBytes += valueSize;
+        m_Backend->SetConstantValue(po, id, type, count, value, transpose);
+    }
+    void Draw(NVRenderDrawMode::Enum drawMode, QT3DSU32 start, QT3DSU32 count) override
+    {
+        RecordDraw(NVRenderBackendCommands::Draw, drawMode, start, count,
+                   NVRenderComponentTypes::Unknown, nullptr);
+        m_Backend->Draw(drawMode, start, count);
+    }
+    void DrawIndirect(NVRenderDrawMode::Enum drawMode, const void *indirect) override
+    {
+        RecordDraw(NVRenderBackendCommands::DrawIndirect, drawMode, 0, 0,
+                   NVRenderComponentTypes::Unknown, indirect);
+        m_Backend->DrawIndirect(drawMode, indirect);
+    }
+    void DrawIndexed(NVRenderDrawMode::Enum drawMode, QT3DSU32 count,
+                     NVRenderComponentTypes::Enum type, const void *indices) override
+    {
+        RecordDraw(NVRenderBackendCommands::DrawIndexed, drawMode, 0, count, type, indices);
+        m_Backend->DrawIndexed(drawMode, count, type, indices);
+    }
+    void DrawIndexedIndirect(NVRenderDrawMode::Enum drawMode, NVRenderComponentTypes::Enum type,
+                             const void *indirect) override
+    {
+        RecordDraw(NVRenderBackendCommands::DrawIndexedIndirect, drawMode, 0, 0, type, indirect);
+        m_Backend->DrawIndexedIndirect(drawMode, type, indirect);
+    }
+    void DrawInstanced(NVRenderDrawMode::Enum drawMode, QT3DSU32 start, QT3DSU32 count,
+                       QT3DSU32 instanceCount) override
+    {
+        RecordDraw(NVRenderBackendCommands::DrawInstanced, drawMode, start, count,
+                   NVRenderComponentTypes::Unknown, nullptr, instanceCount);
+        m_Backend->DrawInstanced(drawMode, start, count, instanceCount);
+    }
+    void DrawIndexedInstanced(NVRenderDrawMode::Enum drawMode, QT3DSU32 count,
+                              NVRenderComponentTypes::Enum type, const void *indices,
+                              QT3DSU32 instanceCount) override
+    {
+        RecordDraw(NVRenderBackendCommands::DrawIndexedInstanced, drawMode, 0, count, type,
+                   indices, instanceCount);
+        m_Backend->DrawIndexedInstanced(drawMode, count, type, indices, instanceCount);
+    }
+
+    NVRenderContextType GetRenderContextType() const override
+    {
+        return m_Backend->GetRenderContextType();
+    }
+    const char *GetShadingLanguageVersion() override
+    {
+        Record(NVRenderBackendCommands::GetShadingLanguageVersion);
+        return m_Backend->GetShadingLanguageVersion();
+    }
+    QByteArray GetDriverDescription() override
+    {
+        Record(NVRenderBackendCommands::GetDriverDescription);
+        return m_Backend->GetDriverDescription();
+    }
+    QT3DSU32 GetMaxCombinedTextureUnits() override
+    {
+        Record(NVRenderBackendCommands::GetMaxCombinedTextureUnits);
+        return m_Backend->GetMaxCombinedTextureUnits();
+    }
+    bool GetRenderBackendCap(NVRenderBackendCaps::Enum inCap) const override
+    {
+        return m_Backend->GetRenderBackendCap(inCap);
+    }
+    void GetRenderBackendValue(NVRenderBackendQuery::Enum inQuery, QT3DSI32 *params) const override
+    {
+        m_Backend->GetRenderBackendValue(inQuery, params);
+    }
+    QT3DSU32 GetDepthBits() const override
+    {
+        return m_Backend->GetDepthBits();
+    }
+    QT3DSU32 GetStencilBits() const override
+    {
+        return m_Backend->GetStencilBits();
+    }
+    bool GetRenderState(const NVRenderState::Enum value) override
+    {
+        Record(NVRenderBackendCommands::GetRenderState);
+        return m_Backend->GetRenderState(value);
+    }
+    NVRenderBoolOp::Enum GetDepthFunc() override
+    {
+        Record(NVRenderBackendCommands::GetDepthFunc);
+        return m_Backend->GetDepthFunc();
+    }
+    NVRenderBackendDepthStencilStateObject
+    CreateDepthStencilState(bool enableDepth, bool depthMask, NVRenderBoolOp::Enum depthFunc,
+                            bool enableStencil, NVRenderStencilFunctionArgument &stencilFuncFront,
+                            NVRenderStencilFunctionArgument &stencilFuncBack,
+                            NVRenderStencilOperationArgument &depthStencilOpFront,
+                            NVRenderStencilOperationArgument &depthStencilOpBack) override
+    {
+        Record(NVRenderBackendCommands::CreateDepthStencilState);
+        return m_Backend->CreateDepthStencilState(enableDepth, depthMask, depthFunc, enableStencil,
+                                                  stencilFuncFront, stencilFuncBack,
+                                                  depthStencilOpFront, depthStencilOpBack);
+    }
+    void ReleaseDepthStencilState(NVRenderBackendDepthStencilStateObject depthStencilState) override
+    {
+        Record(NVRenderBackendCommands::ReleaseDepthStencilState);
+        // A new state object may reuse the released handle
+        SHandleCommand handle = { toHandleValue(depthStencilState) };
+        if (m_DepthStencilState.Matches(handle))
+            m_DepthStencilState.Invalidate();
+        m_Backend->ReleaseDepthStencilState(depthStencilState);
+    }
+    NVRenderBackendRasterizerStateObject
+    CreateRasterizerState(QT3DSF32 depthBias, QT3DSF32 depthScale,
+                          NVRenderFaces::Enum cullFace) override
+    {
+        Record(NVRenderBackendCommands::CreateRasterizerState);
+        return m_Backend->CreateRasterizerState(depthBias, depthScale, cullFace);
+    }
+    void ReleaseRasterizerState(NVRenderBackendRasterizerStateObject rasterizerState) override
+    {
+        Record(NVRenderBackendCommands::ReleaseRasterizerState);
+        SHandleCommand handle = { toHandleValue(rasterizerState) };
+        if (m_RasterizerState.Matches(handle))
+            m_RasterizerState.Invalidate();
+        m_Backend->ReleaseRasterizerState(rasterizerState);
+    }
+    bool GetDepthWrite() override
+    {
+        Record(NVRenderBackendCommands::GetDepthWrite);
+        return m_Backend->GetDepthWrite();
+    }
+    void GetBlendFunc(NVRenderBlendFunctionArgument *pBlendFuncArg) override
+    {
+        Record(NVRenderBackendCommands::GetBlendFunc);
+        m_Backend->GetBlendFunc(pBlendFuncArg);
+    }
+    void SetBlendBarrier() override
+    {
+        Record(NVRenderBackendCommands::SetBlendBarrier);
+        m_Backend->SetBlendBarrier();
+    }
+    void GetScissorRect(NVRenderRect *pRect) override
+    {
+        Record(NVRenderBackendCommands::GetScissorRect);
+        m_Backend->GetScissorRect(pRect);
+    }
+    void GetViewportRect(NVRenderRect *pRect) override
+    {
+        Record(NVRenderBackendCommands::GetViewportRect);
+        m_Backend->GetViewportRect(pRect);
+    }
+    void SetMemoryBarrier(NVRenderBufferBarrierFlags barriers) override
+    {
+        Record(NVRenderBackendCommands::SetMemoryBarrier);
+        m_Backend->SetMemoryBarrier(barriers);
+    }
+    NVRenderBackendQueryObject CreateQuery() override
+    {
+        Record(NVRenderBackendCommands::CreateQuery);
+        return m_Backend->CreateQuery();
+    }
+    void ReleaseQuery(NVRenderBackendQueryObject qo) override
+    {
+        Record(NVRenderBackendCommands::ReleaseQuery);
+        m_Backend->ReleaseQuery(qo);
+    }
+    void BeginQuery(NVRenderBackendQueryObject qo, NVRenderQueryType::Enum type) override
+    {
+        Record(NVRenderBackendCommands::BeginQuery);
+        m_Backend->BeginQuery(qo, type);
+    }
+    void EndQuery(NVRenderBackendQueryObject qo, NVRenderQueryType::Enum type) override
+    {
+        Record(NVRenderBackendCommands::EndQuery);
+        m_Backend->EndQuery(qo, type);
+    }
+    void GetQueryResult(NVRenderBackendQueryObject qo, NVRenderQueryResultType::Enum resultType,
+                        QT3DSU32 *params) override
+    {
+        Record(NVRenderBackendCommands::GetQueryResult);
+        m_Backend->GetQueryResult(qo, resultType, params);
+    }
+    void GetQueryResult(NVRenderBackendQueryObject qo, NVRenderQueryResultType::Enum resultType,
+                        QT3DSU64 *params) override
+    {
+        Record(NVRenderBackendCommands::GetQueryResult);
+        m_Backend->GetQueryResult(qo, resultType, params);
+    }
+    void SetQueryTimer(NVRenderBackendQueryObject qo) override
+    {
+        Record(NVRenderBackendCommands::SetQueryTimer);
+        m_Backend->SetQueryTimer(qo);
+    }
+    NVRenderBackendSyncObject CreateSync(NVRenderSyncType::Enum tpye,
+                                         NVRenderSyncFlags syncFlags) override
+    {
+        Record(NVRenderBackendCommands::CreateSync);
+        return m_Backend->CreateSync(tpye, syncFlags);
+    }
+    void ReleaseSync(NVRenderBackendSyncObject so) override
+    {
+        Record(NVRenderBackendCommands::ReleaseSync);
+        m_Backend->ReleaseSync(so);
+    }
+    void WaitSync(NVRenderBackendSyncObject so, NVRenderCommandFlushFlags syncFlags,
+                  QT3DSU64 timeout) override
+    {
+        Record(NVRenderBackendCommands::WaitSync);
+        m_Backend->WaitSync(so, syncFlags, timeout);
+    }
+    NVRenderBackendRenderTargetObject CreateRenderTarget() override
+    {
+        Record(NVRenderBackendCommands::CreateRenderTarget);
+        return m_Backend->CreateRenderTarget();
+    }
+    void RenderTargetAttach(NVRenderBackendRenderTargetObject rto,
+                            NVRenderFrameBufferAttachments::Enum attachment,
+                            NVRenderBackendRenderbufferObject rbo) override
+    {
+        Record(NVRenderBackendCommands::RenderTargetAttach);
+        m_Backend->RenderTargetAttach(rto, attachment, rbo);
+    }
+    void RenderTargetAttach(NVRenderBackendRenderTargetObject rto,
+                            NVRenderFrameBufferAttachments::Enum attachment,
+                            NVRenderBackendTextureObject to,
+                            NVRenderTextureTargetType::Enum target) override
+    {
+        Record(NVRenderBackendCommands::RenderTargetAttach);
+        m_Backend->RenderTargetAttach(rto, attachment, to, target);
+    }
+    void RenderTargetAttach(NVRenderBackendRenderTargetObject rto,
+                            NVRenderFrameBufferAttachments::Enum attachment,
+                            NVRenderBackendTextureObject to, QT3DSI32 level,
+                            QT3DSI32 layer) override
+    {
+        Record(NVRenderBackendCommands::RenderTargetAttach);
+        m_Backend->RenderTargetAttach(rto, attachment, to, level, layer);
+    }
+    bool RenderTargetIsValid(NVRenderBackendRenderTargetObject rto) override
+    {
+        Record(NVRenderBackendCommands::RenderTargetIsValid);
+        return m_Backend->RenderTargetIsValid(rto);
+    }
+    void SetDrawBuffers(NVRenderBackendRenderTargetObject rto,
+                        NVConstDataRef<QT3DSI32> inDrawBufferSet) override
+    {
+        Record(NVRenderBackendCommands::SetDrawBuffers);
+        m_Backend->SetDrawBuffers(rto, inDrawBufferSet);
+    }
+    void SetReadBuffer(NVRenderBackendRenderTargetObject rto, NVReadFaces::Enum inReadFace) override
+    {
+        Record(NVRenderBackendCommands::SetReadBuffer);
+        m_Backend->SetReadBuffer(rto, inReadFace);
+    }
+    void BlitFramebuffer(QT3DSI32 srcX0, QT3DSI32 srcY0, QT3DSI32 srcX1, QT3DSI32 srcY1,
+                         QT3DSI32 dstX0, QT3DSI32 dstY0, QT3DSI32 dstX1, QT3DSI32 dstY1,
+                         NVRenderClearFlags flags,
+                         NVRenderTextureMagnifyingOp::Enum filter) override
+    {
+        Record(NVRenderBackendCommands::BlitFramebuffer);
+        m_Backend->BlitFramebuffer(srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, flags,
+                                   filter);
+    }
+    NVRenderBackendRenderbufferObject
+    CreateRenderbuffer(NVRenderRenderBufferFormats::Enum storageFormat, size_t width,
+                       size_t height) override
+    {
+        Record(NVRenderBackendCommands::CreateRenderbuffer);
+        return m_Backend->CreateRenderbuffer(storageFormat, width, height);
+    }
+    void ReleaseRenderbuffer(NVRenderBackendRenderbufferObject rbo) override
+    {
+        Record(NVRenderBackendCommands::ReleaseRenderbuffer);
+        m_Backend->ReleaseRenderbuffer(rbo);
+    }
+    bool ResizeRenderbuffer(NVRenderBackendRenderbufferObject rbo,
+                            NVRenderRenderBufferFormats::Enum storageFormat, size_t width,
+                            size_t height) override
+    {
+        Record(NVRenderBackendCommands::ResizeRenderbuffer);
+        return m_Backend->ResizeRenderbuffer(rbo, storageFormat, width, height);
+    }
+    NVRenderBackendTextureObject CreateTexture() override
+    {
+        Record(NVRenderBackendCommands::CreateTexture);
+        return m_Backend->CreateTexture();
+    }
+    void BindImageTexture(NVRenderBackendTextureObject to, QT3DSU32 unit, QT3DSI32 level,
+                          bool layered, QT3DSI32 layer, NVRenderImageAccessType::Enum accessFlags,
+                          NVRenderTextureFormats::Enum format) override
+    {
+        Record(NVRenderBackendCommands::BindImageTexture);
+        m_Backend->BindImageTexture(to, unit, level, layered, layer, accessFlags, format);
+    }
+    NVRenderTextureSwizzleMode::Enum
+    GetTextureSwizzleMode(const NVRenderTextureFormats::Enum inFormat) const override
+    {
+        return m_Backend->GetTextureSwizzleMode(inFormat);
+    }
+    NVRenderBackendSamplerObject CreateSampler(NVRenderTextureMinifyingOp::Enum minFilter,
+                                               NVRenderTextureMagnifyingOp::Enum magFilter,
+                                               NVRenderTextureCoordOp::Enum wrapS,
+                                               NVRenderTextureCoordOp::Enum wrapT,
+                                               NVRenderTextureCoordOp::Enum wrapR, QT3DSI32 minLod,
+                                               QT3DSI32 maxLod, QT3DSF32 lodBias,
+                                               NVRenderTextureCompareMode::Enum compareMode,
+                                               NVRenderTextureCompareOp::Enum compareFunc,
+                                               QT3DSF32 anisotropy, QT3DSF32 *borderColor) override
+    {
+        Record(NVRenderBackendCommands::CreateSampler);
+        return m_Backend->CreateSampler(minFilter, magFilter, wrapS, wrapT, wrapR, minLod, maxLod,
+                                        lodBias, compareMode, compareFunc, anisotropy, borderColor);
+    }
+    void UpdateSampler(NVRenderBackendSamplerObject so, NVRenderTextureTargetType::Enum target,
+                       NVRenderTextureMinifyingOp::Enum minFilter,
+                       NVRenderTextureMagnifyingOp::Enum magFilter,
+                       NVRenderTextureCoordOp::Enum wrapS, NVRenderTextureCoordOp::Enum wrapT,
+                       NVRenderTextureCoordOp::Enum wrapR, QT3DSF32 minLod, QT3DSF32 maxLod,
+                       QT3DSF32 lodBias, NVRenderTextureCompareMode::Enum compareMode,
+                       NVRenderTextureCompareOp::Enum compareFunc, QT3DSF32 anisotropy,
+                       QT3DSF32 *borderColor) override
+    {
+        Record(NVRenderBackendCommands::UpdateSampler);
+        m_Backend->UpdateSampler(so, target, minFilter, magFilter, wrapS, wrapT, wrapR, minLod,
+                                 maxLod, lodBias, compareMode, compareFunc, anisotropy,
+                                 borderColor);
+    }
+    void UpdateTextureSwizzle(NVRenderBackendTextureObject to,
+                              NVRenderTextureTargetType::Enum target,
+                              NVRenderTextureSwizzleMode::Enum swizzleMode) override
+    {
+        Record(NVRenderBackendCommands::UpdateTextureSwizzle);
+        m_Backend->UpdateTextureSwizzle(to, target, swizzleMode);
+    }
+    void UpdateTextureObject(NVRenderBackendTextureObject to,
+                             NVRenderTextureTargetType::Enum target, QT3DSI32 baseLevel,
+                             QT3DSI32 maxLevel) override
+    {
+        Record(NVRenderBackendCommands::UpdateTextureObject);
+        m_Backend->UpdateTextureObject(to, target, baseLevel, maxLevel);
+    }
+    void ReleaseSampler(NVRenderBackendSamplerObject so) override
+    {
+        Record(NVRenderBackendCommands::ReleaseSampler);
+        m_Backend->ReleaseSampler(so);
+    }
+    NVRenderBackendAttribLayoutObject
+    CreateAttribLayout(NVConstDataRef<NVRenderVertexBufferEntry> attribs) override
+    {
+        Record(NVRenderBackendCommands::CreateAttribLayout);
+        return m_Backend->CreateAttribLayout(attribs);
+    }
+    void ReleaseAttribLayout(NVRenderBackendAttribLayoutObject ao) override
+    {
+        Record(NVRenderBackendCommands::ReleaseAttribLayout);
+        m_Backend->ReleaseAttribLayout(ao);
+    }
+    void SetPatchVertexCount(NVRenderBackendInputAssemblerObject iao, QT3DSU32 count) override
+    {
+        Record(NVRenderBackendCommands::SetPatchVertexCount);
+        m_Backend->SetPatchVertexCount(iao, count);
+    }
+    NVRenderBackendVertexShaderObject
+    CreateVertexShader(NVConstDataRef<QT3DSI8> source, eastl::string &errorMessage,
+                       bool binary) override
+    {
+        Record(NVRenderBackendCommands::CreateVertexShader);
+        return m_Backend->CreateVertexShader(source, errorMessage, binary);
+    }
+    void ReleaseVertexShader(NVRenderBackendVertexShaderObject vso) override
+    {
+        Record(NVRenderBackendCommands::ReleaseVertexShader);
+        m_Backend->ReleaseVertexShader(vso);
+    }
+    NVRenderBackendFragmentShaderObject
+    CreateFragmentShader(NVConstDataRef<QT3DSI8> source, eastl::string &errorMessage,
+                         bool binary) override
+    {
+        Record(NVRenderBackendCommands::CreateFragmentShader);
+        return m_Backend->CreateFragmentShader(source, errorMessage, binary);
+    }
+    void ReleaseFragmentShader(NVRenderBackendFragmentShaderObject fso) override
+    {
+        Record(NVRenderBackendCommands::ReleaseFragmentShader);
+        m_Backend->ReleaseFragmentShader(fso);
+    }
+    NVRenderBackendTessControlShaderObject
+    CreateTessControlShader(NVConstDataRef<QT3DSI8> source, eastl::string &errorMessage,
+                            bool binary) override
+    {
+        Record(NVRenderBackendCommands::CreateTessControlShader);
+        return m_Backend->CreateTessControlShader(source, errorMessage, binary);
+    }
+    void ReleaseTessControlShader(NVRenderBackendTessControlShaderObject tcso) override
+    {
+        Record(NVRenderBackendCommands::ReleaseTessControlShader);
+        m_Backend->ReleaseTessControlShader(tcso);
+    }
+    NVRenderBackendTessEvaluationShaderObject
+    CreateTessEvaluationShader(NVConstDataRef<QT3DSI8> source, eastl::string &errorMessage,
+                               bool binary) override
+    {
+        Record(NVRenderBackendCommands::CreateTessEvaluationShader);
+        return m_Backend->CreateTessEvaluationShader(source, errorMessage, binary);
+    }
+    void ReleaseTessEvaluationShader(NVRenderBackendTessEvaluationShaderObject teso) override
+    {
+        Record(NVRenderBackendCommands::ReleaseTessEvaluationShader);
+        m_Backend->ReleaseTessEvaluationShader(teso);
+    }
+    NVRenderBackendGeometryShaderObject
+    CreateGeometryShader(NVConstDataRef<QT3DSI8> source, eastl::string &errorMessage,
+                         bool binary) override
+    {
+        Record(NVRenderBackendCommands::CreateGeometryShader);
+        return m_Backend->CreateGeometryShader(source, errorMessage, binary);
+    }
+    void ReleaseGeometryShader(NVRenderBackendGeometryShaderObject gso) override
+    {
+        Record(NVRenderBackendCommands::ReleaseGeometryShader);
+        m_Backend->ReleaseGeometryShader(gso);
+    }
+    NVRenderBackendComputeShaderObject
+    CreateComputeShader(NVConstDataRef<QT3DSI8> source, eastl::string &errorMessage,
+                        bool binary) override
+    {
+        Record(NVRenderBackendCommands::CreateComputeShader);
+        return m_Backend->CreateComputeShader(source, errorMessage, binary);
+    }
+    void ReleaseComputeShader(NVRenderBackendComputeShaderObject cso) override
+    {
+        Record(NVRenderBackendCommands::ReleaseComputeShader);
+        m_Backend->ReleaseComputeShader(cso);
+    }
+    void AttachShader(NVRenderBackendShaderProgramObject po,
+                      NVRenderBackendVertexShaderObject vso) override
+    {
+        Record(NVRenderBackendCommands::AttachShader);
+        m_Backend->AttachShader(po, vso);
+    }
+    void DetachShader(NVRenderBackendShaderProgramObject po,
+                      NVRenderBackendVertexShaderObject vso) override
+    {
+        Record(NVRenderBackendCommands::DetachShader);
+        m_Backend->DetachShader(po, vso);
+    }
+    void AttachShader(NVRenderBackendShaderProgramObject po,
+                      NVRenderBackendFragmentShaderObject fso) override
+    {
+        Record(NVRenderBackendCommands::AttachShader);
+        m_Backend->AttachShader(po, fso);
+    }
+    void DetachShader(NVRenderBackendShaderProgramObject po,
+                      NVRenderBackendFragmentShaderObject fso) override
+    {
+        Record(NVRenderBackendCommands::DetachShader);
+        m_Backend->DetachShader(po, fso);
+    }
+    void AttachShader(NVRenderBackendShaderProgramObject po,
+                      NVRenderBackendTessControlShaderObject tcso) override
+    {
+        Record(NVRenderBackendCommands::AttachShader);
+        m_Backend->AttachShader(po, tcso);
+    }
+    void DetachShader(NVRenderBackendShaderProgramObject po,
+                      NVRenderBackendTessControlShaderObject tcso) override
+    {
+        Record(NVRenderBackendCommands::DetachShader);
+        m_Backend->DetachShader(po, tcso);
+    }
+    void AttachShader(NVRenderBackendShaderProgramObject po,
+                      NVRenderBackendTessEvaluationShaderObject teso) override
+    {
+        Record(NVRenderBackendCommands::AttachShader);
+        m_Backend->AttachShader(po, teso);
+    }
+    void DetachShader(NVRenderBackendShaderProgramObject po,
+                      NVRenderBackendTessEvaluationShaderObject teso) override
+    {
+        Record(NVRenderBackendCommands::DetachShader);
+        m_Backend->DetachShader(po, teso);
+    }
+    void AttachShader(NVRenderBackendShaderProgramObject po,
+                      NVRenderBackendGeometryShaderObject gso) override
+    {
+        Record(NVRenderBackendCommands::AttachShader);
+        m_Backend->AttachShader(po, gso);
+    }
+    void DetachShader(NVRenderBackendShaderProgramObject po,
+                      NVRenderBackendGeometryShaderObject gso) override
+    {
+        Record(NVRenderBackendCommands::DetachShader);
+        m_Backend->DetachShader(po, gso);
+    }
+    void AttachShader(NVRenderBackendShaderProgramObject po,
+                      NVRenderBackendComputeShaderObject cso) override
+    {
+        Record(NVRenderBackendCommands::AttachShader);
+        m_Backend->AttachShader(po, cso);
+    }
+    void DetachShader(NVRenderBackendShaderProgramObject po,
+                      NVRenderBackendComputeShaderObject cso) override
+    {
+        Record(NVRenderBackendCommands::DetachShader);
+        m_Backend->DetachShader(po, cso);
+    }
+    NVRenderBackendShaderProgramObject CreateShaderProgram(bool isSeparable) override
+    {
+        Record(NVRenderBackendCommands::CreateShaderProgram);
+        return m_Backend->CreateShaderProgram(isSeparable);
+    }
+    NVRenderBackendProgramPipeline CreateProgramPipeline() override
+    {
+        Record(NVRenderBackendCommands::CreateProgramPipeline);
+        return m_Backend->CreateProgramPipeline();
+    }
+    void ReleaseProgramPipeline(NVRenderBackendProgramPipeline ppo) override
+    {
+        Record(NVRenderBackendCommands::ReleaseProgramPipeline);
+        m_Backend->ReleaseProgramPipeline(ppo);
+    }
+    void SetProgramStages(NVRenderBackendProgramPipeline ppo, NVRenderShaderTypeFlags flags,
+                          NVRenderBackendShaderProgramObject po) override
+    {
+        Record(NVRenderBackendCommands::SetProgramStages);
+        m_Backend->SetProgramStages(ppo, flags, po);
+    }
+    QT3DSI32 GetConstantCount(NVRenderBackendShaderProgramObject po) override
+    {
+        Record(NVRenderBackendCommands::GetConstantCount);
+        return m_Backend->GetConstantCount(po);
+    }
+    QT3DSI32 GetConstantBufferCount(NVRenderBackendShaderProgramObject po) override
+    {
+        Record(NVRenderBackendCommands::GetConstantBufferCount);
+        return m_Backend->GetConstantBufferCount(po);
+    }
+    QT3DSI32 GetConstantInfoByID(NVRenderBackendShaderProgramObject po, QT3DSU32 id,
+                                 QT3DSU32 bufSize, QT3DSI32 *numElem,
+                                 NVRenderShaderDataTypes::Enum *type, QT3DSI32 *binding,
+                                 char *nameBuf) override
+    {
+        Record(NVRenderBackendCommands::GetConstantInfoByID);
+        return m_Backend->GetConstantInfoByID(po, id, bufSize, numElem, type, binding, nameBuf);
+    }
+    QT3DSI32 GetConstantBufferInfoByID(NVRenderBackendShaderProgramObject po, QT3DSU32 id,
+                                       QT3DSU32 nameBufSize, QT3DSI32 *paramCount,
+                                       QT3DSI32 *bufferSize, QT3DSI32 *length,
+                                       char *nameBuf) override
+    {
+        Record(NVRenderBackendCommands::GetConstantBufferInfoByID);
+        return m_Backend->GetConstantBufferInfoByID(po, id, nameBufSize, paramCount, bufferSize,
+                length, nameBuf);
+    }
+    void GetConstantBufferParamIndices(NVRenderBackendShaderProgramObject po, QT3DSU32 id,
+                                       QT3DSI32 *indices) override
+    {
+        Record(NVRenderBackendCommands::GetConstantBufferParamIndices);
+        m_Backend->GetConstantBufferParamIndices(po, id, indices);
+    }
+    void GetConstantBufferParamInfoByIndices(NVRenderBackendShaderProgramObject po, QT3DSU32 count,
+                                             QT3DSU32 *indices, QT3DSI32 *type, QT3DSI32 *size,
+                                             QT3DSI32 *offset) override
+    {
+        Record(NVRenderBackendCommands::GetConstantBufferParamInfoByIndices);
+        m_Backend->GetConstantBufferParamInfoByIndices(po, count, indices, type, size, offset);
+    }
+    void ProgramSetConstantBlock(NVRenderBackendShaderProgramObject po, QT3DSU32 blockIndex,
+                                 QT3DSU32 binding) override
+    {
+        Record(NVRenderBackendCommands::ProgramSetConstantBlock);
+        m_Backend->ProgramSetConstantBlock(po, blockIndex, binding);
+    }
+    void ProgramSetConstantBuffer(QT3DSU32 index, NVRenderBackendBufferObject bo) override
+    {
+        Record(NVRenderBackendCommands::ProgramSetConstantBuffer);
+        m_Backend->ProgramSetConstantBuffer(index, bo);
+    }
+    QT3DSI32 GetStorageBufferCount(NVRenderBackendShaderProgramObject po) override
+    {
+        Record(NVRenderBackendCommands::GetStorageBufferCount);
+        return m_Backend->GetStorageBufferCount(po);
+    }
+    QT3DSI32 GetStorageBufferInfoByID(NVRenderBackendShaderProgramObject po, QT3DSU32 id,
+                                      QT3DSU32 nameBufSize, QT3DSI32 *paramCount,
+                                      QT3DSI32 *bufferSize, QT3DSI32 *length,
+                                      char *nameBuf) override
+    {
+        Record(NVRenderBackendCommands::GetStorageBufferInfoByID);
+        return m_Backend->GetStorageBufferInfoByID(po, id, nameBufSize, paramCount, bufferSize,
+                length, nameBuf);
+    }
+    void ProgramSetStorageBuffer(QT3DSU32 index, NVRenderBackendBufferObject bo) override
+    {
+        Record(NVRenderBackendCommands::ProgramSetStorageBuffer);
+        m_Backend->ProgramSetStorageBuffer(index, bo);
+    }
+    QT3DSI32 GetAtomicCounterBufferCount(NVRenderBackendShaderProgramObject po) override
+    {
+        Record(NVRenderBackendCommands::GetAtomicCounterBufferCount);
+        return m_Backend->GetAtomicCounterBufferCount(po);
+    }
+    QT3DSI32 GetAtomicCounterBufferInfoByID(NVRenderBackendShaderProgramObject po, QT3DSU32 id,
+                                            QT3DSU32 nameBufSize, QT3DSI32 *paramCount,
+                                            QT3DSI32 *bufferSize, QT3DSI32 *length,
+                                            char *nameBuf) override
+    {
+        Record(NVRenderBackendCommands::GetAtomicCounterBufferInfoByID);
+        return m_Backend->GetAtomicCounterBufferInfoByID(po, id, nameBufSize, paramCount,
+                bufferSize, length, nameBuf);
+    }
+    void ProgramSetAtomicCounterBuffer(QT3DSU32 index, NVRenderBackendBufferObject bo) override
+    {
+        Record(NVRenderBackendCommands::ProgramSetAtomicCounterBuffer);
+        m_Backend->ProgramSetAtomicCounterBuffer(index, bo);
+    }
+    void ReadPixel(NVRenderBackendRenderTargetObject rto, QT3DSI32 x, QT3DSI32 y, QT3DSI32 width,
+                   QT3DSI32 height, NVRenderReadPixelFormats::Enum inFormat, void *pixels) override
+    {
+        Record(NVRenderBackendCommands::ReadPixel);
+        m_Backend->ReadPixel(rto, x, y, width, height, inFormat, pixels);
+    }
+    NVRenderBackendPathObject CreatePathNVObject(size_t range) override
+    {
+        Record(NVRenderBackendCommands::CreatePathNVObject);
+        return m_Backend->CreatePathNVObject(range);
+    }
+    void ReleasePathNVObject(NVRenderBackendPathObject po, size_t range) override
+    {
+        Record(NVRenderBackendCommands::ReleasePathNVObject);
+        m_Backend->ReleasePathNVObject(po, range);
+    }
+    void SetPathSpecification(NVRenderBackendPathObject inPathObject,
+                              NVConstDataRef<QT3DSU8> inPathCommands,
+                              NVConstDataRef<QT3DSF32> inPathCoords) override
+    {
+        Record(NVRenderBackendCommands::SetPathSpecification);
+        m_Backend->SetPathSpecification(inPathObject, inPathCommands, inPathCoords);
+    }
+    NVBounds3 GetPathObjectBoundingBox(NVRenderBackendPathObject inPathObject) override
+    {
+        Record(NVRenderBackendCommands::GetPathObjectBoundingBox);
+        return m_Backend->GetPathObjectBoundingBox(inPathObject);
+    }
+    NVBounds3 GetPathObjectFillBox(NVRenderBackendPathObject inPathObject) override
+    {
+        Record(NVRenderBackendCommands::GetPathObjectFillBox);
+        return m_Backend->GetPathObjectFillBox(inPathObject);
+    }
+    NVBounds3 GetPathObjectStrokeBox(NVRenderBackendPathObject inPathObject) override
+    {
+        Record(NVRenderBackendCommands::GetPathObjectStrokeBox);
+        return m_Backend->GetPathObjectStrokeBox(inPathObject);
+    }
+    void SetStrokeWidth(NVRenderBackendPathObject inPathObject, QT3DSF32 inStrokeWidth) override
+    {
+        Record(NVRenderBackendCommands::SetStrokeWidth);
+        m_Backend->SetStrokeWidth(inPathObject, inStrokeWidth);
+    }
+    void SetPathProjectionMatrix(const QT3DSMat44 inPathProjection) override
+    {
+        Record(NVRenderBackendCommands::SetPathProjectionMatrix);
+        m_Backend->SetPathProjectionMatrix(inPathProjection);
+    }
+    void SetPathModelViewMatrix(const QT3DSMat44 inPathModelview) override
+    {
+        Record(NVRenderBackendCommands::SetPathModelViewMatrix);
+        m_Backend->SetPathModelViewMatrix(inPathModelview);
+    }
+    void StencilStrokePath(NVRenderBackendPathObject inPathObject) override
+    {
+        Record(NVRenderBackendCommands::StencilStrokePath);
+        m_Backend->StencilStrokePath(inPathObject);
+    }
+    void StencilFillPath(NVRenderBackendPathObject inPathObject) override
+    {
+        Record(NVRenderBackendCommands::StencilFillPath);
+        m_Backend->StencilFillPath(inPathObject);
+    }
+    void StencilFillPathInstanced(NVRenderBackendPathObject po, size_t numPaths,
+                                  NVRenderPathFormatType::Enum type, const void *charCodes,
+                                  NVRenderPathFillMode::Enum fillMode, QT3DSU32 stencilMask,
+                                  NVRenderPathTransformType::Enum transformType,
+                                  const QT3DSF32 *transformValues) override
+    {
+        Record(NVRenderBackendCommands::StencilFillPathInstanced);
+        m_Backend->StencilFillPathInstanced(po, numPaths, type, charCodes, fillMode, stencilMask,
+                                            transformType, transformValues);
+    }
+    void StencilStrokePathInstancedN(NVRenderBackendPathObject po, size_t numPaths,
+                                     NVRenderPathFormatType::Enum type, const void *charCodes,
+                                     QT3DSI32 stencilRef, QT3DSU32 stencilMask,
+                                     NVRenderPathTransformType::Enum transformType,
+                                     const QT3DSF32 *transformValues) override
+    {
+        Record(NVRenderBackendCommands::StencilStrokePathInstancedN);
+        m_Backend->StencilStrokePathInstancedN(po, numPaths, type, charCodes, stencilRef,
+                                               stencilMask, transformType, transformValues);
+    }
+    void CoverFillPathInstanced(NVRenderBackendPathObject po, size_t numPaths,
+                                NVRenderPathFormatType::Enum type, const void *charCodes,
+                                NVRenderPathCoverMode::Enum coverMode,
+                                NVRenderPathTransformType::Enum transformType,
+                                const QT3DSF32 *transformValues) override
+    {
+        Record(NVRenderBackendCommands::CoverFillPathInstanced);
+        m_Backend->CoverFillPathInstanced(po, numPaths, type, charCodes, coverMode, transformType,
+                                          transformValues);
+    }
+    void CoverStrokePathInstanced(NVRenderBackendPathObject po, size_t numPaths,
+                                  NVRenderPathFormatType::Enum type, const void *charCodes,
+                                  NVRenderPathCoverMode::Enum coverMode,
+                                  NVRenderPathTransformType::Enum transformType,
+                                  const QT3DSF32 *transformValues) override
+    {
+        Record(NVRenderBackendCommands::CoverStrokePathInstanced);
+        m_Backend->CoverStrokePathInstanced(po, numPaths, type, charCodes, coverMode, transformType,
+                                            transformValues);
+    }
+    void SetPathStencilDepthOffset(QT3DSF32 inSlope, QT3DSF32 inBias) override
+    {
+        Record(NVRenderBackendCommands::SetPathStencilDepthOffset);
+        m_Backend->SetPathStencilDepthOffset(inSlope, inBias);
+    }
+    void SetPathCoverDepthFunc(NVRenderBoolOp::Enum inDepthFunction) override
+    {
+        Record(NVRenderBackendCommands::SetPathCoverDepthFunc);
+        m_Backend->SetPathCoverDepthFunc(inDepthFunction);
+    }
+    void LoadPathGlyphs(NVRenderBackendPathObject po, NVRenderPathFontTarget::Enum fontTarget,
+                        const void *fontName, NVRenderPathFontStyleFlags fontStyle,
+                        size_t numGlyphs, NVRenderPathFormatType::Enum type, const void *charCodes,
+                        NVRenderPathMissingGlyphs::Enum handleMissingGlyphs,
+                        NVRenderBackendPathObject pathParameterTemplate, QT3DSF32 emScale) override
+    {
+        Record(NVRenderBackendCommands::LoadPathGlyphs);
+        m_Backend->LoadPathGlyphs(po, fontTarget, fontName, fontStyle, numGlyphs, type, charCodes,
+                                  handleMissingGlyphs, pathParameterTemplate, emScale);
+    }
+    NVRenderPathReturnValues::Enum
+    LoadPathGlyphsIndexed(NVRenderBackendPathObject po, NVRenderPathFontTarget::Enum fontTarget,
+                          const void *fontName, NVRenderPathFontStyleFlags fontStyle,
+                          QT3DSU32 firstGlyphIndex, size_t numGlyphs,
+                          NVRenderBackendPathObject pathParameterTemplate,
+                          QT3DSF32 emScale) override
+    {
+        Record(NVRenderBackendCommands::LoadPathGlyphsIndexed);
+        return m_Backend->LoadPathGlyphsIndexed(po, fontTarget, fontName, fontStyle,
+                                                firstGlyphIndex, numGlyphs, pathParameterTemplate,
+                                                emScale);
+    }
+    NVRenderBackendPathObject
+    LoadPathGlyphsIndexedRange(NVRenderPathFontTarget::Enum fontTarget, const void *fontName,
+                               NVRenderPathFontStyleFlags fontStyle,
+                               NVRenderBackendPathObject pathParameterTemplate, QT3DSF32 emScale,
+                               QT3DSU32 *count) override
+    {
+        Record(NVRenderBackendCommands::LoadPathGlyphsIndexedRange);
+        return m_Backend->LoadPathGlyphsIndexedRange(fontTarget, fontName, fontStyle,
+                pathParameterTemplate, emScale, count);
+    }
+    void LoadPathGlyphRange(NVRenderBackendPathObject po, NVRenderPathFontTarget::Enum fontTarget,
+                            const void *fontName, NVRenderPathFontStyleFlags fontStyle,
+                            QT3DSU32 firstGlyph, size_t numGlyphs,
+                            NVRenderPathMissingGlyphs::Enum handleMissingGlyphs,
+                            NVRenderBackendPathObject pathParameterTemplate,
+                            QT3DSF32 emScale) override
+    {
+        Record(NVRenderBackendCommands::LoadPathGlyphRange);
+        m_Backend->LoadPathGlyphRange(po, fontTarget, fontName, fontStyle, firstGlyph, numGlyphs,
+                                      handleMissingGlyphs, pathParameterTemplate, emScale);
+    }
+    void GetPathMetrics(NVRenderBackendPathObject po, size_t numPaths,
+                        NVRenderPathGlyphFontMetricFlags metricQueryMask,
+                        NVRenderPathFormatType::Enum type, const void *charCodes, size_t stride,
+                        QT3DSF32 *metrics) override
+    {
+        Record(NVRenderBackendCommands::GetPathMetrics);
+        m_Backend->GetPathMetrics(po, numPaths, metricQueryMask, type, charCodes, stride, metrics);
+    }
+    void GetPathMetricsRange(NVRenderBackendPathObject po, size_t numPaths,
+                             NVRenderPathGlyphFontMetricFlags metricQueryMask, size_t stride,
+                             QT3DSF32 *metrics) override
+    {
+        Record(NVRenderBackendCommands::GetPathMetricsRange);
+        m_Backend->GetPathMetricsRange(po, numPaths, metricQueryMask, stride, metrics);
+    }
+    void GetPathSpacing(NVRenderBackendPathObject po, size_t numPaths,
+                        NVRenderPathListMode::Enum pathListMode, NVRenderPathFormatType::Enum type,
+                        const void *charCodes, QT3DSF32 advanceScale, QT3DSF32 kerningScale,
+                        NVRenderPathTransformType::Enum transformType, QT3DSF32 *spacing) override
+    {
+        Record(NVRenderBackendCommands::GetPathSpacing);
+        m_Backend->GetPathSpacing(po, numPaths, pathListMode, type, charCodes, advanceScale,
+                                  kerningScale, transformType, spacing);
+    }
+    QSurfaceFormat format() const override
+    {
+        return m_Backend->format();
+    }
+    void getProgramBinary(NVRenderBackendShaderProgramObject po, QT3DSU32 &outFormat,
+                          QByteArray &outBinary) override
+    {
+        Record(NVRenderBackendCommands::getProgramBinary);
+        m_Backend->getProgramBinary(po, outFormat, outBinary);
+    }
+};
+
+template <typename TCommand>
+TCommand readCommand(const QT3DSU8 *inPayload)
+{
+    TCommand command;
+    ::memcpy(&command, inPayload, sizeof(TCommand));
+    return command;
+}
+}
+
+QT3DSU32 NVRenderBackendRecorder::Replay(NVRenderBackend &inBackend,
+                                         NVConstDataRef<QT3DSU8> inCommands)
+{
+    QT3DSU32 issued = 0;
+    QT3DSU32 offset = 0;
+    while (offset + sizeof(SCommandHeader) <= inCommands.size()) {
+        SCommandHeader header;
+        ::memcpy(&header, inCommands.begin() + offset, sizeof(header));
+        const QT3DSU8 *payload = inCommands.begin() + offset + sizeof(header);
+        offset += sizeof(header) + header.m_PayloadSize;
+        if (offset > inCommands.size()) {
+            qCWarning(INVALID_PARAMETER) << "Backend command stream is truncated";
+            break;
+        }
+        if (header.m_Flags & (SCommandHeader::Redundant | SCommandHeader::Truncated))
+            continue;
+
+        bool handled = true;
+        switch (header.m_Command) {
+        case NVRenderBackendCommands::SetRenderState: {
+            SRenderStateCommand command = readCommand<SRenderStateCommand>(payload);
+            inBackend.SetRenderState(command.m_Enable != 0,
+                                     NVRenderState::Enum(command.m_State));
+        } break;
+        case NVRenderBackendCommands::SetDepthStencilState:
+            inBackend.SetDepthStencilState(
+                    fromHandleValue<NVRenderBackendDepthStencilStateObject>(
+                        readCommand<SHandleCommand>(payload).m_Handle));
+            break;
+        case NVRenderBackendCommands::SetRasterizerState:
+            inBackend.SetRasterizerState(fromHandleValue<NVRenderBackendRasterizerStateObject>(
+                                             readCommand<SHandleCommand>(payload).m_Handle));
+            break;
+        case NVRenderBackendCommands::SetDepthFunc:
+            inBackend.SetDepthFunc(
+                    NVRenderBoolOp::Enum(readCommand<SValueCommand>(payload).m_Value));
+            break;
+        case NVRenderBackendCommands::SetDepthWrite:
+            inBackend.SetDepthWrite(readCommand<SValueCommand>(payload).m_Value != 0);
+            break;
+        case NVRenderBackendCommands::SetColorWrites: {
+            SColorWritesCommand command = readCommand<SColorWritesCommand>(payload);
+            inBackend.SetColorWrites(command.m_Red != 0, command.m_Green != 0,
+                                     command.m_Blue != 0, command.m_Alpha != 0);
+        } break;
+        case NVRenderBackendCommands::SetMultisample:
+            inBackend.SetMultisample(readCommand<SValueCommand>(payload).m_Value != 0);
+            break;
+        case NVRenderBackendCommands::SetBlendFunc: {
+            SBlendFuncCommand command = readCommand<SBlendFuncCommand>(payload);
+            inBackend.SetBlendFunc(NVRenderBlendFunctionArgument(
+                                       NVRenderSrcBlendFunc::Enum(command.m_SrcRGB),
+                                       NVRenderDstBlendFunc::Enum(command.m_DstRGB),
+                                       NVRenderSrcBlendFunc::Enum(command.m_SrcAlpha),
+                                       NVRenderDstBlendFunc::Enum(command.m_DstAlpha)));
+        } break;
+        case NVRenderBackendCommands::SetBlendEquation: {
+            SBlendEquationCommand command = readCommand<SBlendEquationCommand>(payload);
+            inBackend.SetBlendEquation(NVRenderBlendEquationArgument(
+                                           NVRenderBlendEquation::Enum(command.m_RGBEquation),
+                                           NVRenderBlendEquation::Enum(command.m_AlphaEquation)));
+        } break;
+        case NVRenderBackendCommands::SetScissorRect: {
+            SRectCommand command = readCommand<SRectCommand>(payload);
+            inBackend.SetScissorRect(NVRenderRect(command.m_X, command.m_Y, command.m_Width,
+                                                  command.m_Height));
+        } break;
+        case NVRenderBackendCommands::SetViewportRect: {
+            SRectCommand command = readCommand<SRectCommand>(payload);
+            inBackend.SetViewportRect(NVRenderRect(command.m_X, command.m_Y, command.m_Width,
+                                                   command.m_Height));
+        } break;
+        case NVRenderBackendCommands::SetClearColor: {
+            SColorCommand command = readCommand<SColorCommand>(payload);
+            QT3DSVec4 color(command.m_Red, command.m_Green, command.m_Blue, command.m_Alpha);
+            inBackend.SetClearColor(&color);
+        } break;
+        case NVRenderBackendCommands::Clear:
+            inBackend.Clear(NVRenderClearFlags(readCommand<SValueCommand>(payload).m_Value));
+            break;
+        case NVRenderBackendCommands::SetRenderTarget:
+            inBackend.SetRenderTarget(fromHandleValue<NVRenderBackendRenderTargetObject>(
+                                          readCommand<SHandleCommand>(payload).m_Handle));
+            break;
+        case NVRenderBackendCommands::SetReadTarget:
+            inBackend.SetReadTarget(fromHandleValue<NVRenderBackendRenderTargetObject>(
+                                        readCommand<SHandleCommand>(payload).m_Handle));
+            break;
+        case NVRenderBackendCommands::BindTexture: {
+            SBindTextureCommand command = readCommand<SBindTextureCommand>(payload);
+            inBackend.BindTexture(fromHandleValue<NVRenderBackendTextureObject>(command.m_Texture),
+                                  NVRenderTextureTargetType::Enum(command.m_Target),
+                                  command.m_Unit);
+        } break;
+        case NVRenderBackendCommands::SetInputAssembler: {
+            SInputAssemblerCommand command = readCommand<SInputAssemblerCommand>(payload);
+            inBackend.SetInputAssembler(
+                        fromHandleValue<NVRenderBackendInputAssemblerObject>(
+                            command.m_InputAssembler),
+                        fromHandleValue<NVRenderBackendShaderProgramObject>(command.m_Program));
+        } break;
+        case NVRenderBackendCommands::SetActiveProgram:
+            inBackend.SetActiveProgram(fromHandleValue<NVRenderBackendShaderProgramObject>(
+                                           readCommand<SHandleCommand>(payload).m_Handle));
+            break;
+        case NVRenderBackendCommands::SetConstantValue: {
+            SConstantCommand command = readCommand<SConstantCommand>(payload);
+            inBackend.SetConstantValue(
+                        fromHandleValue<NVRenderBackendShaderProgramObject>(command.m_Program),
+                        command.m_Location, NVRenderShaderDataTypes::Enum(command.m_Type),
+                        command.m_Count, payload + sizeof(command), command.m_Transpose != 0);
+        } break;
+        case NVRenderBackendCommands::Draw: {
+            SDrawCommand command = readCommand<SDrawCommand>(payload);
+            inBackend.Draw(NVRenderDrawMode::Enum(command.m_Mode), command.m_Start,
+                           command.m_Count);
+        } break;
+        case NVRenderBackendCommands::DrawIndirect: {
+            SDrawCommand command = readCommand<SDrawCommand>(payload);
+            inBackend.DrawIndirect(NVRenderDrawMode::Enum(command.m_Mode),
+                                   fromHandleValue<const void *>(command.m_Offset));
+        } break;
+        case NVRenderBackendCommands::DrawIndexed: {
+            SDrawCommand command = readCommand<SDrawCommand>(payload);
+            inBackend.DrawIndexed(NVRenderDrawMode::Enum(command.m_Mode), command.m_Count,
+                                  NVRenderComponentTypes::Enum(command.m_IndexType),
+                                  fromHandleValue<const void *>(command.m_Offset));
+        } break;
+        case NVRenderBackendCommands::DrawIndexedIndirect: {
+            SDrawCommand command = readCommand<SDrawCommand>(payload);
+            inBackend.DrawIndexedIndirect(NVRenderDrawMode::Enum(command.m_Mode),
+                                          NVRenderComponentTypes::Enum(command.m_IndexType),
+                                          fromHandleValue<const void *>(command.m_Offset));
+        } break;
+        case NVRenderBackendCommands::DrawInstanced: {
+            SDrawCommand command = readCommand<SDrawCommand>(payload);
+            inBackend.DrawInstanced(NVRenderDrawMode::Enum(command.m_Mode), command.m_Start,
+                                    command.m_Count, command.m_InstanceCount);
+        } break;
+        case NVRenderBackendCommands::DrawIndexedInstanced: {
+            SDrawCommand command = readCommand<SDrawCommand>(payload);
+            inBackend.DrawIndexedInstanced(NVRenderDrawMode::Enum(command.m_Mode),
+                                           command.m_Count,
+                                           NVRenderComponentTypes::Enum(command.m_IndexType),
+                                           fromHandleValue<const void *>(command.m_Offset),
+                                           command.m_InstanceCount);
+        } break;
+        default:
+            // recorded without arguments
+            handled = false;
+            break;
+        }
+        if (handled)
+            ++issued;
+    }
+    return issued;
+}
+
+bool NVRenderBackendRecorder::IsEnabled()
+{
+    static const bool enabled = qEnvironmentVariableIntValue("QT3DS_BACKEND_RECORDER") > 0;
+    return enabled;
+}
+
+NVRenderBackendRecorder &NVRenderBackendRecorder::CreateRecorder(NVFoundationBase &foundation,
+                                                                 NVRenderBackend &inBackend)
+{
+    return *QT3DS_NEW(foundation.getAllocator(), SBackendRecorder)(foundation, inBackend);
+}
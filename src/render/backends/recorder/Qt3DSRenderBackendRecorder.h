@@ -0,0 +1,300 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qt 3D Studio.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#pragma once
+#ifndef QT3DS_RENDER_BACKEND_RECORDER_H
+#define QT3DS_RENDER_BACKEND_RECORDER_H
+#include "render/backends/Qt3DSRenderBackend.h"
+
+namespace qt3ds {
+namespace render {
+
+#define QT3DS_RENDER_ITERATE_BACKEND_COMMANDS                                                      \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(GetRenderContextType)                                      \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(GetShadingLanguageVersion)                                 \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(GetDriverDescription)                                      \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(GetMaxCombinedTextureUnits)                                \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(GetRenderBackendCap)                                       \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(GetRenderBackendValue)                                     \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(GetDepthBits)                                              \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(GetStencilBits)                                            \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(SetRenderState)                                            \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(GetRenderState)                                            \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(GetDepthFunc)                                              \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(CreateDepthStencilState)                                   \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(ReleaseDepthStencilState)                                  \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(CreateRasterizerState)                                     \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(ReleaseRasterizerState)                                    \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(SetDepthStencilState)                                      \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(SetRasterizerState)                                        \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(SetDepthFunc)                                              \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(GetDepthWrite)                                             \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(SetDepthWrite)                                             \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(SetColorWrites)                                            \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(SetMultisample)                                            \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(GetBlendFunc)                                              \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(SetBlendFunc)                                              \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(SetBlendEquation)                                          \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(SetBlendBarrier)                                           \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(GetScissorRect)                                            \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(SetScissorRect)                                            \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(GetViewportRect)                                           \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(SetViewportRect)                                           \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(SetClearColor)                                             \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(Clear)                                                     \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(CreateBuffer)                                              \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(BindBuffer)                                                \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(ReleaseBuffer)                                             \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(UpdateBuffer)                                              \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(UpdateBufferRange)                                         \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(MapBuffer)                                                 \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(UnmapBuffer)                                               \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(SetMemoryBarrier)                                          \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(CreateQuery)                                               \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(ReleaseQuery)                                              \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(BeginQuery)                                                \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(EndQuery)                                                  \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(GetQueryResult)                                            \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(SetQueryTimer)                                             \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(CreateSync)                                                \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(ReleaseSync)                                               \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(WaitSync)                                                  \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(CreateRenderTarget)                                        \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(ReleaseRenderTarget)                                       \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(RenderTargetAttach)                                        \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(SetRenderTarget)                                           \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(RenderTargetIsValid)                                       \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(SetReadTarget)                                             \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(SetDrawBuffers)                                            \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(SetReadBuffer)                                             \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(BlitFramebuffer)                                           \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(CreateRenderbuffer)                                        \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(ReleaseRenderbuffer)                                       \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(ResizeRenderbuffer)                                        \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(CreateTexture)                                             \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(SetTextureData2D)                                          \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(SetTextureDataCubeFace)                                    \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(CreateTextureStorage2D)                                    \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(SetTextureSubData2D)                                       \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(SetCompressedTextureData2D)                                \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(SetCompressedTextureDataCubeFace)                          \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(SetCompressedTextureSubData2D)                             \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(SetMultisampledTextureData2D)                              \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(SetTextureData3D)                                          \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(GenerateMipMaps)                                           \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(BindTexture)                                               \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(BindImageTexture)                                          \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(ReleaseTexture)                                            \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(GetTextureSwizzleMode)                                     \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(CreateSampler)                                             \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(UpdateSampler)                                             \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(UpdateTextureSwizzle)                                      \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(UpdateTextureObject)                                       \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(ReleaseSampler)                                            \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(CreateAttribLayout)                                        \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(ReleaseAttribLayout)                                       \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(CreateInputAssembler)                                      \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(ReleaseInputAssembler)                                     \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(SetInputAssembler)                                         \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(SetPatchVertexCount)                                       \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(CreateVertexShader)                                        \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(ReleaseVertexShader)                                       \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(CreateFragmentShader)                                      \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(ReleaseFragmentShader)                                     \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(CreateTessControlShader)                                   \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(ReleaseTessControlShader)                                  \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(CreateTessEvaluationShader)                                \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(ReleaseTessEvaluationShader)                               \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(CreateGeometryShader)                                      \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(ReleaseGeometryShader)                                     \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(CreateComputeShader)                                       \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(ReleaseComputeShader)                                      \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(AttachShader)                                              \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(DetachShader)                                              \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(CreateShaderProgram)                                       \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(ReleaseShaderProgram)                                      \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(linkProgram)                                               \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(SetActiveProgram)                                          \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(CreateProgramPipeline)                                     \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(ReleaseProgramPipeline)                                    \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(SetActiveProgramPipeline)                                  \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(SetProgramStages)                                          \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(DispatchCompute)                                           \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(GetConstantCount)                                          \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(GetConstantBufferCount)                                    \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(GetConstantInfoByID)                                       \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(GetConstantBufferInfoByID)                                 \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(GetConstantBufferParamIndices)                             \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(GetConstantBufferParamInfoByIndices)                       \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(ProgramSetConstantBlock)                                   \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(ProgramSetConstantBuffer)                                  \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(GetStorageBufferCount)                                     \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(GetStorageBufferInfoByID)                                  \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(ProgramSetStorageBuffer)                                   \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(GetAtomicCounterBufferCount)                               \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(GetAtomicCounterBufferInfoByID)                            \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(ProgramSetAtomicCounterBuffer)                             \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(SetConstantValue)                                          \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(Draw)                                                      \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(DrawIndirect)                                              \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(DrawIndexed)                                               \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(DrawIndexedIndirect)                                       \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(DrawInstanced)                                             \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(DrawIndexedInstanced)                                      \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(ReadPixel)                                                 \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(CreatePathNVObject)                                        \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(ReleasePathNVObject)                                       \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(SetPathSpecification)                                      \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(GetPathObjectBoundingBox)                                  \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(GetPathObjectFillBox)                                      \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(GetPathObjectStrokeBox)                                    \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(SetStrokeWidth)                                            \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(SetPathProjectionMatrix)                                   \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(SetPathModelViewMatrix)                                    \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(StencilStrokePath)                                         \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(StencilFillPath)                                           \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(StencilFillPathInstanced)                                  \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(StencilStrokePathInstancedN)                               \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(CoverFillPathInstanced)                                    \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(CoverStrokePathInstanced)                                  \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(SetPathStencilDepthOffset)                                 \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(SetPathCoverDepthFunc)                                     \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(LoadPathGlyphs)                                            \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(LoadPathGlyphsIndexed)                                     \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(LoadPathGlyphsIndexedRange)                                \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(LoadPathGlyphRange)                                        \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(GetPathMetrics)                                            \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(GetPathMetricsRange)                                       \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(GetPathSpacing)                                            \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(format)                                                    \
+    QT3DS_RENDER_HANDLE_BACKEND_COMMAND(getProgramBinary)
+
+    struct NVRenderBackendCommands
+    {
+        enum Enum {
+            Unknown = 0,
+#define QT3DS_RENDER_HANDLE_BACKEND_COMMAND(x) x,
+            QT3DS_RENDER_ITERATE_BACKEND_COMMANDS
+#undef QT3DS_RENDER_HANDLE_BACKEND_COMMAND
+        };
+        static const char *toString(const Enum value)
+        {
+            switch (value) {
+#define QT3DS_RENDER_HANDLE_BACKEND_COMMAND(x)                                                     \
+            case x:                                                                                \
+                return #x;
+            QT3DS_RENDER_ITERATE_BACKEND_COMMANDS
+#undef QT3DS_RENDER_HANDLE_BACKEND_COMMAND
+            default:
+                break;
+            }
+            return "Unknown";
+        }
+    };
+
+    /**
+     * A backend that sits in front of another one. Every call is appended to a compact
+     * per frame command stream before it is forwarded. State changes, bindings and constant
+     * writes that would not change anything on the wrapped backend are dropped and marked as
+     * redundant in the stream.
+     *
+     * Every record starts with a SCommandHeader, followed by m_PayloadSize bytes of arguments.
+     * Arguments are kept for state, binding, constant and draw commands, other commands are
+     * recorded without payload.
+     *
+     * Enabled with QT3DS_BACKEND_RECORDER=1. QT3DS_BACKEND_RECORDER_DUMP=<file> additionally
+     * appends the command stream of every frame to the given file.
+     */
+    class NVRenderBackendRecorder : public NVRenderBackend
+    {
+    public:
+        struct SCommandHeader
+        {
+            enum Flags {
+                Redundant = 1 << 0, ///< dropped, not forwarded to the wrapped backend
+                Truncated = 1 << 1, ///< payload did not fit and was left out
+            };
+            QT3DSU8 m_Command; ///< NVRenderBackendCommands::Enum
+            QT3DSU8 m_Flags;
+            QT3DSU16 m_PayloadSize;
+        };
+
+        /// Header written in front of every frame in the dump file
+        struct SFrameHeader
+        {
+            QT3DSU32 m_Magic; ///< 'Q3BR'
+            QT3DSU32 m_Frame;
+            QT3DSU32 m_CommandBytes;
+            QT3DSU32 m_Calls;
+            QT3DSU32 m_RedundantCalls;
+            QT3DSU32 m_DrawCalls;
+            QT3DSU64 m_UploadedBytes;
+        };
+
+        struct SFrameStatistics
+        {
+            QT3DSU32 m_Calls;
+            QT3DSU32 m_RedundantCalls;
+            QT3DSU32 m_DrawCalls;
+            QT3DSU64 m_UploadedBytes; ///< buffer, texture and constant data
+
+            SFrameStatistics()
+                : m_Calls(0)
+                , m_RedundantCalls(0)
+                , m_DrawCalls(0)
+                , m_UploadedBytes(0)
+            {
+            }
+        };
+
+        /// Statistics of the last finished frame
+        virtual SFrameStatistics GetFrameStatistics() const = 0;
+        /// Command stream of the last finished frame
+        virtual NVConstDataRef<QT3DSU8> GetFrameCommands() const = 0;
+        virtual NVRenderBackend &GetWrappedBackend() = 0;
+
+        /**
+         * @brief Replay the state, binding, constant and draw commands of a recorded stream.
+         *        Redundant and truncated records are skipped. Object handles are passed
+         *        through unchanged, so the target has to own the objects the stream refers to.
+         *
+         * @param[in] inBackend     Backend the commands are issued on
+         * @param[in] inCommands    Stream as returned by GetFrameCommands
+         *
+         * @return number of commands issued
+         */
+        static QT3DSU32 Replay(NVRenderBackend &inBackend, NVConstDataRef<QT3DSU8> inCommands);
+
+        static bool IsEnabled();
+        static NVRenderBackendRecorder &CreateRecorder(NVFoundationBase &foundation,
+                                                       NVRenderBackend &inBackend);
+    };
+}
+}
+
+#endif
@@ -59,8 +59,14 @@ struct SNullBackend : public NVRenderBackend
         return NVRenderContextValues::NullContext;
     }
     const char *GetShadingLanguageVersion() override { return ""; }
+    QByteArray GetDriverDescription() override { return QByteArrayLiteral("NULL"); }
     QT3DSU32 GetMaxCombinedTextureUnits() override { return 32; }
-    bool GetRenderBackendCap(NVRenderBackendCaps::Enum) const override { return false; }
+    // Binary programs are supported with a stand-in binary, so that the persistent shader cache
+    // can be exercised without a GPU.
+    bool GetRenderBackendCap(NVRenderBackendCaps::Enum inCap) const override
+    {
+        return inCap == NVRenderBackendCaps::BinaryProgram;
+    }
     void GetRenderBackendValue(NVRenderBackendQuery::Enum inQuery, QT3DSI32 *params) const override
     {
         if (params) {
@@ -409,8 +415,12 @@ struct SNullBackend : public NVRenderBackend
     }
     void ReleaseProgramPipeline(NVRenderBackendProgramPipeline) override {}
 
+    // Linking succeeds so that the renderer submits draws exactly as it would on a GPU.
     bool linkProgram(NVRenderBackendShaderProgramObject, eastl::string &,
-                     QT3DSU32, const QByteArray *) override { return false; }
+                     QT3DSU32, const QByteArray *binary) override
+    {
+        return !binary || *binary == programBinary();
+    }
     void SetActiveProgram(NVRenderBackendShaderProgramObject) override {}
     void SetActiveProgramPipeline(NVRenderBackendProgramPipeline) override {}
     void SetProgramStages(NVRenderBackendProgramPipeline, NVRenderShaderTypeFlags,
@@ -470,6 +480,11 @@ struct SNullBackend : public NVRenderBackend
                                      const void *) override
     {
     }
+    void DrawInstanced(NVRenderDrawMode::Enum, QT3DSU32, QT3DSU32, QT3DSU32) override {}
+    void DrawIndexedInstanced(NVRenderDrawMode::Enum, QT3DSU32, NVRenderComponentTypes::Enum,
+                              const void *, QT3DSU32) override
+    {
+    }
 
     void ReadPixel(NVRenderBackendRenderTargetObject, QT3DSI32, QT3DSI32, QT3DSI32, QT3DSI32,
                            NVRenderReadPixelFormats::Enum, void *) override
@@ -580,8 +595,12 @@ struct SNullBackend : public NVRenderBackend
     {
         return QSurfaceFormat();
     }
-    void getProgramBinary(NVRenderBackendShaderProgramObject, QT3DSU32 &, QByteArray &) override
+    static QByteArray programBinary() { return QByteArrayLiteral("NULL program"); }
+    void getProgramBinary(NVRenderBackendShaderProgramObject, QT3DSU32 &outFormat,
+                          QByteArray &outBinary) override
     {
+        outFormat = 0;
+        outBinary = programBinary();
     }
 };
 }
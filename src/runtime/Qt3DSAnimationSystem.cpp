@@ -38,6 +38,7 @@
 #include "foundation/Qt3DSPool.h"
 #include "Qt3DSElementSystem.h"
 #include "Qt3DSBezierEval.h"
+#include "Qt3DSBezierBake.h"
 #include "foundation/SerializationTypes.h"
 #include "foundation/IOStreams.h"
 #include "EASTL/sort.h"
@@ -104,6 +105,8 @@ struct SAnimationTrack
     QT3DSU32 m_KeyCount;
     SAnimationKeyNode *m_Keys;
     QT3DSU32 m_ActiveSetIndex;
+    QT3DSU32 m_BakedSegmentStart; ///< First baked segment, QT3DS_MAX_U32 if not baked
+    QT3DSU32 m_BakedCursor; ///< Segment used by the previous baked evaluation
     bool m_Dynamic;
 
     SAnimationTrack()
@@ -113,6 +116,8 @@ struct SAnimationTrack
         , m_KeyCount(0)
         , m_Keys(NULL)
         , m_ActiveSetIndex(QT3DS_MAX_U32)
+        , m_BakedSegmentStart(QT3DS_MAX_U32)
+        , m_BakedCursor(0)
         , m_Dynamic(false)
     {
     }
@@ -123,9 +128,42 @@ struct SAnimationTrack
         , m_KeyCount(0)
         , m_Keys(NULL)
         , m_ActiveSetIndex(QT3DS_MAX_U32)
+        , m_BakedSegmentStart(QT3DS_MAX_U32)
+        , m_BakedCursor(0)
         , m_Dynamic(inIsDynamic)
     {
     }
+    bool IsBaked() const { return m_BakedSegmentStart != QT3DS_MAX_U32; }
+};
+
+// Segment between two keys of a baked track. The samples are stored in
+// SAnimSystem::m_BakedSamples, m_IntervalCount + 1 of them starting at m_FirstSample.
+struct SBakedSegment
+{
+    QT3DSF32 m_StartTime;
+    QT3DSF32 m_EndTime;
+    QT3DSF32 m_SamplesPerTime;
+    QT3DSU32 m_FirstSample;
+    QT3DSU32 m_IntervalCount;
+
+    SBakedSegment()
+        : m_StartTime(0)
+        , m_EndTime(0)
+        , m_SamplesPerTime(0)
+        , m_FirstSample(0)
+        , m_IntervalCount(0)
+    {
+    }
+    SBakedSegment(QT3DSF32 inStartTime, QT3DSF32 inEndTime, QT3DSU32 inFirstSample,
+                  QT3DSU32 inIntervalCount)
+        : m_StartTime(inStartTime)
+        , m_EndTime(inEndTime)
+        , m_SamplesPerTime(inEndTime > inStartTime
+                           ? inIntervalCount / (inEndTime - inStartTime) : 0.0f)
+        , m_FirstSample(inFirstSample)
+        , m_IntervalCount(inIntervalCount)
+    {
+    }
 };
 
 struct GetAnimationTrackActiveSetIndex
@@ -168,6 +206,12 @@ struct SAnimSystem : public IAnimationSystem
     // so we can utilise nvhash_map and allocators without needing to implement multimap,
     // or resort to Qt containers. (Single element can have several animation tracks associated.)
     nvhash_map<QT3DSI64, SAnimationTrack *> m_ElemPropsToActiveTracks;
+    nvvector<SBakedSegment> m_BakedSegments;
+    nvvector<QT3DSF32> m_BakedSamples;
+    // Storage of released bakes that is still in m_BakedSegments and m_BakedSamples
+    QT3DSU32 m_ReleasedBakedSegments;
+    QT3DSU32 m_ReleasedBakedSamples;
+    bool m_BakedTracksEnabled;
 
     SAnimSystem(NVFoundationBase &inFoundation)
         : m_Foundation(inFoundation)
@@ -181,6 +225,11 @@ struct SAnimSystem : public IAnimationSystem
         , m_NextTrackId(1)
         , m_RefCount(0)
         , m_ElemPropsToActiveTracks(inFoundation.getAllocator(), "m_ElemPropsToActiveTracks")
+        , m_BakedSegments(inFoundation.getAllocator(), "m_BakedSegments")
+        , m_BakedSamples(inFoundation.getAllocator(), "m_BakedSamples")
+        , m_ReleasedBakedSegments(0)
+        , m_ReleasedBakedSamples(0)
+        , m_BakedTracksEnabled(qEnvironmentVariableIntValue("QT3DS_BAKE_ANIMATIONS") > 0)
     {
     }
 
@@ -262,6 +311,8 @@ struct SAnimSystem : public IAnimationSystem
             QT3DS_ASSERT(false);
             return;
         }
+        // Keys are only added while loading, but make sure a stale bake is never used.
+        ReleaseBake(*m_LastInsertedTrack);
         SAnimationKey &theNewKey =
             GetOrCreateKeyByIndex(m_LastInsertedTrack->m_KeyCount, *m_LastInsertedTrack);
         theNewKey = SAnimationKey(inTime, inValue, inC1Time, inC1Value, inC2Time, inC2Value);
@@ -360,8 +411,185 @@ struct SAnimSystem : public IAnimationSystem
         return theKeyData.m_End->m_Value;
     }
 
+    void BakeSegment(const SBakedSegment &inSegment, const SAnimationKey &inStart,
+                     const SAnimationKey &inEnd)
+    {
+        Q3DStudio::BakeBezierKeyframe(m_BakedSamples.data() + inSegment.m_FirstSample,
+                                      inSegment.m_IntervalCount, inStart.m_Time, inStart.m_Value,
+                                      inStart.m_C1Time, inStart.m_C1Value, inStart.m_C2Time,
+                                      inStart.m_C2Value, inEnd.m_Time, inEnd.m_Value);
+    }
+
+    // Has to be called before the key count of inTrack changes, a baked track has one
+    // segment less than it has keys. Storage at the end of the arrays is dropped right away,
+    // the rest is reclaimed by CompactBakes once it makes up half of the samples.
+    void ReleaseBake(SAnimationTrack &inTrack)
+    {
+        if (!inTrack.IsBaked())
+            return;
+        const QT3DSU32 theSegmentStart = inTrack.m_BakedSegmentStart;
+        const QT3DSU32 theSegmentEnd = theSegmentStart + inTrack.m_KeyCount - 1;
+        const SBakedSegment &theLastSegment = m_BakedSegments[theSegmentEnd - 1];
+        const QT3DSU32 theSampleStart = m_BakedSegments[theSegmentStart].m_FirstSample;
+        const QT3DSU32 theSampleEnd =
+            theLastSegment.m_FirstSample + theLastSegment.m_IntervalCount + 1;
+        inTrack.m_BakedSegmentStart = QT3DS_MAX_U32;
+
+        if (theSegmentEnd == m_BakedSegments.size()) {
+            m_BakedSegments.resize(theSegmentStart);
+            m_BakedSamples.resize(theSampleStart);
+        } else {
+            m_ReleasedBakedSegments += theSegmentEnd - theSegmentStart;
+            m_ReleasedBakedSamples += theSampleEnd - theSampleStart;
+        }
+        if (m_ReleasedBakedSamples * 2 > m_BakedSamples.size())
+            CompactBakes();
+    }
+
+    // Moves the bakes of all baked tracks together, dropping the released storage.
+    void CompactBakes()
+    {
+        nvvector<SBakedSegment> theSegments(m_Foundation.getAllocator(), "m_BakedSegments");
+        nvvector<QT3DSF32> theSamples(m_Foundation.getAllocator(), "m_BakedSamples");
+        theSegments.reserve(m_BakedSegments.size() - m_ReleasedBakedSegments);
+        theSamples.reserve(m_BakedSamples.size() - m_ReleasedBakedSamples);
+        for (TAnimationTrackHash::iterator iter = m_Tracks.begin(), end = m_Tracks.end();
+             iter != end; ++iter) {
+            SAnimationTrack &theTrack = *iter->second;
+            if (!theTrack.IsBaked())
+                continue;
+            const QT3DSU32 theSegmentStart = theTrack.m_BakedSegmentStart;
+            theTrack.m_BakedSegmentStart = QT3DSU32(theSegments.size());
+            for (QT3DSU32 idx = 0, segmentCount = theTrack.m_KeyCount - 1; idx < segmentCount;
+                 ++idx) {
+                SBakedSegment theSegment = m_BakedSegments[theSegmentStart + idx];
+                const QT3DSF32 *theSource = m_BakedSamples.data() + theSegment.m_FirstSample;
+                theSegment.m_FirstSample = QT3DSU32(theSamples.size());
+                theSamples.insert(theSamples.end(), theSource,
+                                  theSource + theSegment.m_IntervalCount + 1);
+                theSegments.push_back(theSegment);
+            }
+        }
+        m_BakedSegments.swap(theSegments);
+        m_BakedSamples.swap(theSamples);
+        m_ReleasedBakedSegments = 0;
+        m_ReleasedBakedSamples = 0;
+    }
+
+    void ReleaseAllBakes()
+    {
+        for (TAnimationTrackHash::iterator iter = m_Tracks.begin(), end = m_Tracks.end();
+             iter != end; ++iter) {
+            iter->second->m_BakedSegmentStart = QT3DS_MAX_U32;
+        }
+        nvvector<SBakedSegment>(m_Foundation.getAllocator(), "m_BakedSegments")
+            .swap(m_BakedSegments);
+        nvvector<QT3DSF32>(m_Foundation.getAllocator(), "m_BakedSamples").swap(m_BakedSamples);
+        m_ReleasedBakedSegments = 0;
+        m_ReleasedBakedSamples = 0;
+    }
+
+    void BakeTrack(SAnimationTrack &inTrack)
+    {
+        ReleaseBake(inTrack);
+        inTrack.m_BakedCursor = 0;
+        if (inTrack.m_KeyCount < 2)
+            return;
+
+        inTrack.m_BakedSegmentStart = QT3DSU32(m_BakedSegments.size());
+        TAnimationKeyNodeList::iterator iter =
+            TAnimationKeyNodeList::begin(inTrack.m_Keys, inTrack.m_KeyCount);
+        TAnimationKeyNodeList::iterator next = iter;
+        for (++next; next != TAnimationKeyNodeList::end(inTrack.m_Keys, inTrack.m_KeyCount);
+             ++iter, ++next) {
+            SAnimationKey &theStart = *iter;
+            SAnimationKey &theEnd = *next;
+            QT3DSU32 theIntervals =
+                Q3DStudio::GetBakedIntervalCount(theStart.m_Time, theEnd.m_Time);
+            SBakedSegment theSegment(theStart.m_Time, theEnd.m_Time,
+                                     QT3DSU32(m_BakedSamples.size()), theIntervals);
+            m_BakedSamples.resize(m_BakedSamples.size() + theIntervals + 1);
+            m_BakedSegments.push_back(theSegment);
+            BakeSegment(theSegment, theStart, theEnd);
+        }
+    }
+
+    // Finds the two baked samples surrounding inTime and the fraction between them.
+    void LookupBaked(SAnimationTrack &inTrack, QT3DSF32 inTime, QT3DSF32 &outLow,
+                     QT3DSF32 &outHigh, QT3DSF32 &outFraction)
+    {
+        outFraction = 0.0f;
+        if (inTrack.m_KeyCount < 2) {
+            outLow = outHigh = inTrack.m_KeyCount == 1 ? GetKeyByIndex(0, inTrack)->m_Value : 0.0f;
+            return;
+        }
+        if (!inTrack.IsBaked())
+            BakeTrack(inTrack);
+
+        const SBakedSegment *theSegments = m_BakedSegments.data() + inTrack.m_BakedSegmentStart;
+        const QT3DSU32 theLastSegment = inTrack.m_KeyCount - 2;
+        // Time usually moves by less than a segment per frame, so start from the previous one.
+        QT3DSU32 &theCursor = inTrack.m_BakedCursor;
+        while (theCursor > 0 && inTime <= theSegments[theCursor].m_StartTime)
+            --theCursor;
+        while (theCursor < theLastSegment && inTime > theSegments[theCursor].m_EndTime)
+            ++theCursor;
+
+        const SBakedSegment &theSegment = theSegments[theCursor];
+        const QT3DSF32 *theSamples = m_BakedSamples.data() + theSegment.m_FirstSample;
+        if (inTime <= theSegment.m_StartTime) {
+            outLow = outHigh = theSamples[0];
+        } else if (inTime >= theSegment.m_EndTime) {
+            outLow = outHigh = theSamples[theSegment.m_IntervalCount];
+        } else {
+            QT3DSF32 thePosition = (inTime - theSegment.m_StartTime) * theSegment.m_SamplesPerTime;
+            QT3DSU32 theIndex = NVMin(QT3DSU32(thePosition), theSegment.m_IntervalCount - 1);
+            outLow = theSamples[theIndex];
+            outHigh = theSamples[theIndex + 1];
+            outFraction = thePosition - QT3DSF32(theIndex);
+        }
+    }
+
+    static void SetTrackValue(SAnimationTrack &inTrack, QT3DSF32 inValue)
+    {
+        SElement &theElement = *inTrack.m_Element;
+        Q3DStudio::UVariant &theValue(
+            *theElement.GetPropertyByIndex(inTrack.m_PropertyIndex)->second);
+        if (fabs(theValue.m_FLOAT - inValue) > SElement::SmallestDifference()) {
+            theValue.m_FLOAT = inValue;
+            theElement.SetDirty();
+        }
+    }
+
+    // Evaluates the active set as structure of arrays batches: gather the baked samples
+    // for every track, interpolate the whole batch at once and scatter the results.
+    void UpdateBaked()
+    {
+        QT3DSF32 theLow[Q3DStudio::BAKED_BATCH_SIZE];
+        QT3DSF32 theHigh[Q3DStudio::BAKED_BATCH_SIZE];
+        QT3DSF32 theFraction[Q3DStudio::BAKED_BATCH_SIZE];
+        QT3DSF32 theResult[Q3DStudio::BAKED_BATCH_SIZE];
+
+        for (QT3DSU32 start = 0, end = m_ActiveSet.size(); start < end;
+             start += Q3DStudio::BAKED_BATCH_SIZE) {
+            QT3DSU32 theCount = NVMin(end - start, Q3DStudio::BAKED_BATCH_SIZE);
+            for (QT3DSU32 idx = 0; idx < theCount; ++idx) {
+                SAnimationTrack &theTrack = *m_ActiveSet[start + idx];
+                QT3DSF32 theTime = static_cast<QT3DSF32>(theTrack.m_Element->GetOuterTime());
+                LookupBaked(theTrack, theTime, theLow[idx], theHigh[idx], theFraction[idx]);
+            }
+            Q3DStudio::EvaluateBakedBatch(theLow, theHigh, theFraction, theResult, theCount);
+            for (QT3DSU32 idx = 0; idx < theCount; ++idx)
+                SetTrackValue(*m_ActiveSet[start + idx], theResult[idx]);
+        }
+    }
+
     void Update() override
     {
+        if (m_BakedTracksEnabled) {
+            UpdateBaked();
+            return;
+        }
         for (QT3DSU32 idx = 0, end = m_ActiveSet.size(); idx < end; ++idx) {
             SAnimationTrack &theTrack = *m_ActiveSet[idx];
             SElement &theElement = *theTrack.m_Element;
@@ -381,13 +609,26 @@ struct SAnimSystem : public IAnimationSystem
     {
         SAnimationTrack *theTrack = GetAnimationTrack(inTrackId);
         if (theTrack) {
-            if (inActive)
+            if (inActive) {
+                if (m_BakedTracksEnabled && !theTrack->IsBaked())
+                    BakeTrack(*theTrack);
                 m_ActiveSet.insert(*theTrack);
+            }
             else
                 m_ActiveSet.remove(*theTrack);
         }
     }
 
+    void SetBakedTracksEnabled(bool inEnabled) override
+    {
+        // Tracks are baked again when they are evaluated, so the samples aren't kept around
+        if (m_BakedTracksEnabled && !inEnabled)
+            ReleaseAllBakes();
+        m_BakedTracksEnabled = inEnabled;
+    }
+
+    bool AreBakedTracksEnabled() const override { return m_BakedTracksEnabled; }
+
     QT3DSI32 getActiveTrackForElemProp(
             element::SElement *inElement, QT3DSU32 inPropertyHash) override
     {
@@ -447,6 +688,12 @@ struct SAnimSystem : public IAnimationSystem
 
                 // Update start value
                 theFirstKey->m_Value = thePropData->m_FLOAT;
+
+                // The key times are unchanged, so the first segment can be rebaked in place
+                if (theTrack->IsBaked()) {
+                    BakeSegment(m_BakedSegments[theTrack->m_BakedSegmentStart], *theFirstKey,
+                                *GetKeyByIndex(1, *theTrack));
+                }
             }
         }
     }
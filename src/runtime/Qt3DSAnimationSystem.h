@@ -61,6 +61,11 @@ namespace runtime {
         virtual void UpdateDynamicKey(QT3DSI32 inTrackId) = 0;
         virtual QT3DSI32 getActiveTrackForElemProp(element::SElement *inElement,
                                                    QT3DSU32 inPropertyName) = 0;
+        // Baked tracks are sampled into lookup tables when first activated and are then
+        // evaluated in batches instead of solving the bezier curve for every frame.
+        // Enabled by default when the QT3DS_BAKE_ANIMATIONS environment variable is set.
+        virtual void SetBakedTracksEnabled(bool inEnabled) = 0;
+        virtual bool AreBakedTracksEnabled() const = 0;
 
         static IAnimationSystem &CreateAnimationSystem(NVFoundationBase &inFoundation);
     };
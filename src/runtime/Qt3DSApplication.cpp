@@ -66,6 +66,7 @@
 #include "foundation/Qt3DSSync.h"
 #include "Qt3DSTextRenderer.h"
 #include "Qt3DSRenderThreadPool.h"
+#include "Qt3DSRenderJobSystem.h"
 #include "foundation/StringConversionImpl.h"
 #include "Qt3DSRenderLoadedTexture.h"
 #include "render/Qt3DSRenderContext.h"
@@ -80,6 +81,7 @@
 #include "Qt3DSRenderBufferManager.h"
 #include "Qt3DSRenderRenderList.h"
 #include "Qt3DSRenderImageBatchLoader.h"
+#include "Qt3DSOffscreenRenderManager.h"
 #include <QtCore/qlibraryinfo.h>
 #include <QtCore/qpair.h>
 #include <QtCore/qdir.h>
@@ -120,6 +122,13 @@ bool qt3ds::runtime::isImagePath(const QString &path)
             || ext == QLatin1String("dds") || ext == QLatin1String("ktx"));
 }
 
+const char *FrameRenderReasons::GetName(QT3DSU32 inIndex)
+{
+    static const char *theNames[Count] = { "initial", "scene", "renderer", "offscreen",
+                                           "loading", "view", "requested" };
+    return inIndex < Count ? theNames[inIndex] : "unknown";
+}
+
 struct SFrameTimer
 {
     int m_FrameCount;
@@ -596,6 +605,44 @@ public:
     }
 };
 
+// Reads and parses the uip file of a presentation on the job system. Building the element and
+// scene graphs from the parsed file writes to the meta data, the element allocator and the render
+// context, none of which are thread safe, so that stays in LoadUIP.
+struct SUIPParseJob
+{
+    IRuntimeMetaData &m_MetaData;
+    IInputStreamFactory &m_InputStreamFactory;
+    qt3ds::foundation::IStringTable &m_StringTable;
+    IPerfTimer &m_PerfTimer;
+    QString m_File;
+    QByteArray m_TimerTag;
+    SJobGroup m_Group;
+    IUIPParser *m_Parser;
+
+    SUIPParseJob(IRuntimeMetaData &inMetaData, IInputStreamFactory &inInputStreamFactory,
+                 qt3ds::foundation::IStringTable &inStringTable, IPerfTimer &inPerfTimer,
+                 const QString &inFile, const QByteArray &inTimerTag)
+        : m_MetaData(inMetaData)
+        , m_InputStreamFactory(inInputStreamFactory)
+        , m_StringTable(inStringTable)
+        , m_PerfTimer(inPerfTimer)
+        , m_File(inFile)
+        , m_TimerTag(inTimerTag)
+        , m_Parser(nullptr)
+    {
+    }
+
+    static void Parse(void *inUserData)
+    {
+        SUIPParseJob &theJob(*reinterpret_cast<SUIPParseJob *>(inUserData));
+        QT3DS_PERF_SCOPED_TIMER(theJob.m_PerfTimer, theJob.m_TimerTag.constData())
+        theJob.m_Parser = &IUIPParser::Create(theJob.m_File, theJob.m_MetaData,
+                                              theJob.m_InputStreamFactory, theJob.m_StringTable);
+    }
+};
+
+typedef nvhash_map<CRegisteredString, SUIPParseJob *> TUIPParseJobMap;
+
 struct SApp : public IApplication
 {
     NVScopedRefCounted<Q3DStudio::IRuntimeFactoryCore> m_CoreFactory;
@@ -659,8 +706,18 @@ struct SApp : public IApplication
 
     bool m_initialFrame = true;
     int m_skipFrameCount = 0;
+    // Render on demand state. Reasons accumulate until a frame is actually rendered so that
+    // frames dropped by the skip interval are not lost.
+    QT3DSU32 m_PendingFrameReasons = 0;
+    QT3DSU32 m_LastViewSettingsRevision = 0;
+    bool m_RenderRequested = false;
+    bool m_LastFrameSkipped = false;
+    SFrameSkipStatistics m_FrameSkipStatistics;
+    SFrameSkipStatistics m_ReportedFrameSkipStatistics;
     SSlideResourceCounter m_resourceCounter;
     QSet<QString> m_createSet;
+    // Presentations whose uip files are being parsed on the job system, see StartUIPParse.
+    TUIPParseJobMap m_UIPParseJobs;
 
     QT3DSI32 mRefCount;
     SApp(Q3DStudio::IRuntimeFactoryCore &inFactory, const char8_t *inAppDir)
@@ -696,6 +753,7 @@ struct SApp : public IApplication
         , m_DirtyCountdown(5)
         , m_visitor(nullptr)
         , m_createSuccessful(false)
+        , m_UIPParseJobs(inFactory.GetFoundation().getAllocator(), "SApp::m_UIPParseJobs")
         , mRefCount(0)
     {
         m_PresentationId.append("__initial");
@@ -727,6 +785,13 @@ struct SApp : public IApplication
         HasCompletedLoading();
         m_AppLoadContext = NULL;
 
+        // Presentations that were never loaded can still have their uip files being parsed.
+        while (!m_UIPParseJobs.empty()) {
+            IUIPParser *theParser = FinishUIPParse(m_UIPParseJobs.begin()->first);
+            if (theParser)
+                theParser->release();
+        }
+
         for (QT3DSU32 idx = 0, end = m_OrderedAssets.size(); idx < end; ++idx) {
             SAssetValue &theAsset = *m_OrderedAssets[idx].second;
             if (theAsset.getType() == AssetValueTypes::Presentation) {
@@ -936,12 +1001,16 @@ struct SApp : public IApplication
     void UpdatePresentations()
     {
         QT3DS_PERF_SCOPED_TIMER(m_RuntimeFactory->GetPerfTimer(), "UpdatePresentations: Total")
-        // Transfer the input frame to the kernel for pick processing
-        // the scene manager now handles the picking on each of its scenes
-        SetPickFrame(m_RuntimeFactory->GetSceneManager().AdvancePickFrame(
-                         m_InputEnginePtr->GetInputFrame()));
-        // clear up mouse flag for horizontal and vertical scroll
-        m_InputEnginePtr->GetInputFrame().m_MouseFlags &= !(HSCROLLWHEEL | VSCROLLWHEEL);
+        {
+            QT3DS_PERF_SCOPED_TIMER(m_RuntimeFactory->GetPerfTimer(),
+                                    "UpdatePresentations: Input")
+            // Transfer the input frame to the kernel for pick processing
+            // the scene manager now handles the picking on each of its scenes
+            SetPickFrame(m_RuntimeFactory->GetSceneManager().AdvancePickFrame(
+                             m_InputEnginePtr->GetInputFrame()));
+            // clear up mouse flag for horizontal and vertical scroll
+            m_InputEnginePtr->GetInputFrame().m_MouseFlags &= !(HSCROLLWHEEL | VSCROLLWHEEL);
+        }
 
         // Update all the presentations.
         // Animations are advanced based on m_Timer by default, but this can be overridden via
@@ -1033,7 +1102,11 @@ struct SApp : public IApplication
         } // End QT3DS_PERF_SCOPED_TIMER scope
     }
 
-    bool UpdateScenes() { return m_RuntimeFactory->GetSceneManager().Update(); }
+    bool UpdateScenes()
+    {
+        QT3DS_PERF_SCOPED_TIMER(m_RuntimeFactory->GetPerfTimer(), "Application: UpdateScenes")
+        return m_RuntimeFactory->GetSceneManager().Update();
+    }
 
     bool LazyLoadSubPresentations()
     {
@@ -1136,6 +1209,66 @@ struct SApp : public IApplication
         return true;
     }
 
+    // Returns the FrameRenderReasons that apply to the current frame.
+    QT3DSU32 GetFrameRenderReasons(bool inScenesDirty)
+    {
+        auto &rc = m_RuntimeFactory->GetQt3DSRenderContext();
+        QT3DSU32 theReasons = 0;
+        if (m_initialFrame)
+            theReasons |= FrameRenderReasons::InitialFrame;
+        if (inScenesDirty)
+            theReasons |= FrameRenderReasons::SceneChanged;
+        if (m_LastRenderWasDirty
+                || (rc.IsStereoscopic() && rc.GetStereoProgressiveEnabled()
+                    && !m_ProgressiveLeftFrame)) {
+            theReasons |= FrameRenderReasons::RendererDirty;
+        }
+        if (rc.GetOffscreenRenderManager().IsUpdateRequested())
+            theReasons |= FrameRenderReasons::OffscreenUpdate;
+        if (rc.GetImageBatchLoader().HasPendingLoads()
+                || rc.GetBufferManager().HasPendingMeshLoads()) {
+            theReasons |= FrameRenderReasons::ResourcesLoading;
+        }
+        if (rc.GetViewSettingsRevision() != m_LastViewSettingsRevision)
+            theReasons |= FrameRenderReasons::ViewSettingsChanged;
+        if (m_RenderRequested)
+            theReasons |= FrameRenderReasons::Requested;
+        return theReasons;
+    }
+
+    void RecordRenderedFrame(QT3DSU32 inReasons)
+    {
+        ++m_FrameSkipStatistics.m_RenderedFrames;
+        m_FrameSkipStatistics.m_LastFrameReasons = inReasons;
+        for (QT3DSU32 idx = 0; idx < FrameRenderReasons::Count; ++idx) {
+            if (inReasons & (1 << idx))
+                ++m_FrameSkipStatistics.m_ReasonCounts[idx];
+        }
+        m_LastViewSettingsRevision =
+                m_RuntimeFactory->GetQt3DSRenderContext().GetViewSettingsRevision();
+        m_RenderRequested = false;
+    }
+
+    // Logs the frames rendered and skipped since the previous report.
+    void ReportFrameSkipStatistics()
+    {
+        const SFrameSkipStatistics &theTotal(m_FrameSkipStatistics);
+        SFrameSkipStatistics &theLast(m_ReportedFrameSkipStatistics);
+        QString theReasons;
+        for (QT3DSU32 idx = 0; idx < FrameRenderReasons::Count; ++idx) {
+            QT3DSU32 theCount = theTotal.m_ReasonCounts[idx] - theLast.m_ReasonCounts[idx];
+            if (theCount) {
+                theReasons += QStringLiteral(" %1 %2")
+                        .arg(QLatin1String(FrameRenderReasons::GetName(idx))).arg(theCount);
+            }
+        }
+        qCInfo(PERF_INFO, "Render on demand: rendered %d, skipped %d, reasons:%s",
+               theTotal.m_RenderedFrames - theLast.m_RenderedFrames,
+               theTotal.m_SkippedFrames - theLast.m_SkippedFrames,
+               qPrintable(theReasons));
+        theLast = theTotal;
+    }
+
     // Update all the presentations and render them.
     bool UpdateAndRender() override
     {
@@ -1152,22 +1285,26 @@ struct SApp : public IApplication
 
         ++m_FrameCount;
 
-        // First off, update any application level behaviors.
-        IScriptBridge &theScriptEngine = m_CoreFactory->GetScriptEngineQml();
-        for (QT3DSU32 idx = 0, end = m_Behaviors.size(); idx < end; ++idx) {
-            eastl::pair<SBehaviorAsset, bool> &entry(m_Behaviors[idx]);
-            if (!entry.second) {
-                entry.second = true;
-                theScriptEngine.ExecuteApplicationScriptFunction(entry.first.m_Handle,
-                                                                 "onInitialize");
+        {
+            QT3DS_PERF_SCOPED_TIMER(m_RuntimeFactory->GetPerfTimer(), "Application: Behaviors")
+            // First off, update any application level behaviors.
+            IScriptBridge &theScriptEngine = m_CoreFactory->GetScriptEngineQml();
+            for (QT3DSU32 idx = 0, end = m_Behaviors.size(); idx < end; ++idx) {
+                eastl::pair<SBehaviorAsset, bool> &entry(m_Behaviors[idx]);
+                if (!entry.second) {
+                    entry.second = true;
+                    theScriptEngine.ExecuteApplicationScriptFunction(entry.first.m_Handle,
+                                                                     "onInitialize");
+                }
             }
-        }
 
-        // TODO: Initialize presentations
+            // TODO: Initialize presentations
 
-        for (QT3DSU32 idx = 0, end = m_Behaviors.size(); idx < end; ++idx) {
-            eastl::pair<SBehaviorAsset, bool> &entry(m_Behaviors[idx]);
-            theScriptEngine.ExecuteApplicationScriptFunction(entry.first.m_Handle, "onUpdate");
+            for (QT3DSU32 idx = 0, end = m_Behaviors.size(); idx < end; ++idx) {
+                eastl::pair<SBehaviorAsset, bool> &entry(m_Behaviors[idx]);
+                theScriptEngine.ExecuteApplicationScriptFunction(entry.first.m_Handle,
+                                                                 "onUpdate");
+            }
         }
 
         UpdatePresentations();
@@ -1183,11 +1320,28 @@ struct SApp : public IApplication
         if (m_LastRenderWasDirty || dirty || m_initialFrame)
             renderNextFrame = true;
 
+        auto &rc = m_RuntimeFactory->GetQt3DSRenderContext();
+        bool renderOnDemand = rc.IsRenderOnDemand();
+        if (renderOnDemand)
+            m_PendingFrameReasons |= GetFrameRenderReasons(dirty);
+
         bool skip = checkSkipFrame();
         // If we skip rendering this frame, mark next frame to be rendered
         renderNextFrame |= skip;
-        if (!skip)
-            Render();
+        m_LastFrameSkipped = false;
+        if (!skip) {
+            if (!renderOnDemand) {
+                Render();
+            } else if (m_PendingFrameReasons) {
+                RecordRenderedFrame(m_PendingFrameReasons);
+                m_PendingFrameReasons = 0;
+                Render();
+            } else {
+                // Nothing changed, keep the previous frame
+                m_LastFrameSkipped = true;
+                ++m_FrameSkipStatistics.m_SkippedFrames;
+            }
+        }
 
         m_InputEnginePtr->ClearInputFrame();
 
@@ -1207,6 +1361,8 @@ struct SApp : public IApplication
             if (m_ProfileLogging) {
                 qCInfo(PERF_INFO, "Render Statistics: %3.2ffps, frame count %d",
                        fps.first, fps.second);
+                if (renderOnDemand)
+                    ReportFrameSkipStatistics();
             }
         }
 
@@ -1228,7 +1384,18 @@ struct SApp : public IApplication
 
     double GetMillisecondsSinceLastFrame() override { return m_MillisecondsSinceLastFrame; }
 
-    void MarkApplicationDirty() override { ResetDirtyCounter(); }
+    void MarkApplicationDirty() override
+    {
+        ResetDirtyCounter();
+        m_RenderRequested = true;
+    }
+
+    bool WasLastFrameSkipped() const override { return m_LastFrameSkipped; }
+
+    const SFrameSkipStatistics &GetFrameSkipStatistics() const override
+    {
+        return m_FrameSkipStatistics;
+    }
 
     Q3DStudio::IAudioPlayer &GetAudioPlayer() override { return m_AudioPlayer; }
     ////////////////////////////////////////////////////////////////////////////////
@@ -1345,12 +1512,72 @@ struct SApp : public IApplication
         }
     }
 
+    static QByteArray LoadPhaseTimerTag(const SPresentationAsset &inAsset, const char *inPhase)
+    {
+        return QByteArray("Application: LoadUIP ") + inAsset.m_Id.c_str() + ' ' + inPhase;
+    }
+
+    // Start reading and parsing the uip file of a presentation on the job system. LoadUIP picks
+    // up the parsed file, so independent presentations are parsed concurrently while the element
+    // and scene graphs are built one after the other.
+    void StartUIPParse(SPresentationAsset &inAsset)
+    {
+        if (!inAsset.m_Id.IsValid() || inAsset.m_Presentation
+                || m_UIPParseJobs.find(inAsset.m_Id) != m_UIPParseJobs.end()) {
+            return;
+        }
+        GetMetaData();
+        eastl::string theFile;
+        CFileTools::CombineBaseAndRelative(GetProjectDirectory().c_str(), inAsset.m_Src.c_str(),
+                                           theFile);
+        // The parser registers the strings of the file in the meta data string table.
+        if (m_UIPParseJobs.empty())
+            m_MetaData->GetStringTable()->GetRenderStringTable().EnableMultithreadedAccess();
+        SUIPParseJob *theJob = QT3DS_NEW(m_CoreFactory->GetFoundation().getAllocator(),
+                                         SUIPParseJob)(*m_MetaData,
+                                                       m_CoreFactory->GetInputStreamFactory(),
+                                                       m_CoreFactory->GetStringTable(),
+                                                       m_CoreFactory->GetPerfTimer(),
+                                                       QString::fromUtf8(theFile.c_str()),
+                                                       LoadPhaseTimerTag(inAsset, "parse"));
+        m_UIPParseJobs.insert(eastl::make_pair(inAsset.m_Id, theJob));
+        IJobSystem &theJobSystem(m_CoreFactory->GetRenderContextCore().GetJobSystem());
+        theJobSystem.Run(&theJob->m_Group, theJob, SUIPParseJob::Parse);
+        theJobSystem.Then(theJob->m_Group, nullptr, nullptr);
+    }
+
+    // Returns the parser of a presentation started with StartUIPParse once it has finished, or
+    // null if no parse was started.
+    IUIPParser *FinishUIPParse(CRegisteredString inId)
+    {
+        TUIPParseJobMap::iterator theFind = m_UIPParseJobs.find(inId);
+        if (theFind == m_UIPParseJobs.end())
+            return nullptr;
+        SUIPParseJob *theJob = theFind->second;
+        m_UIPParseJobs.erase(theFind);
+        m_CoreFactory->GetRenderContextCore().GetJobSystem().Wait(theJob->m_Group);
+        IUIPParser *theParser = theJob->m_Parser;
+        NVDelete(m_CoreFactory->GetFoundation().getAllocator(), theJob);
+        if (m_UIPParseJobs.empty())
+            m_MetaData->GetStringTable()->GetRenderStringTable().DisableMultithreadedAccess();
+        return theParser;
+    }
+
     bool LoadUIP(SPresentationAsset &inAsset,
                  NVConstDataRef<SElementAttributeReference> inExternalReferences,
                  bool initInRenderThread)
     {
         QT3DS_PERF_SCOPED_TIMER(m_CoreFactory->GetPerfTimer(), "Application: LoadUIP")
         GetMetaData();
+        // A parse started by StartUIPParse is finished before anything else so that no loader
+        // thread outlives a failed load.
+        IUIPParser *theParsedUIP = nullptr;
+        if (m_UIPParseJobs.find(inAsset.m_Id) != m_UIPParseJobs.end()) {
+            const QByteArray theTimerTag(LoadPhaseTimerTag(inAsset, "parse wait"));
+            QT3DS_PERF_SCOPED_TIMER(m_CoreFactory->GetPerfTimer(), theTimerTag.constData())
+            theParsedUIP = FinishUIPParse(inAsset.m_Id);
+        }
+        NVScopedReleasable<IUIPParser> theUIPParser(theParsedUIP);
         eastl::string theFile;
         CFileTools::CombineBaseAndRelative(GetProjectDirectory().c_str(), inAsset.m_Src.c_str(),
                                            theFile);
@@ -1366,13 +1593,25 @@ struct SApp : public IApplication
                                                                  this);
             inAsset.m_Presentation = thePresentation;
             thePresentation->SetFilePath(theFile.c_str());
-            NVScopedReleasable<IUIPParser> theUIPParser(IUIPParser::Create(
-                                                            theFile.c_str(), *m_MetaData,
-                                                            m_CoreFactory->GetInputStreamFactory(),
-                                                            m_CoreFactory->GetStringTable()));
+            if (!theUIPParser) {
+                const QByteArray theTimerTag(LoadPhaseTimerTag(inAsset, "parse"));
+                QT3DS_PERF_SCOPED_TIMER(m_CoreFactory->GetPerfTimer(), theTimerTag.constData())
+                theUIPParser = &IUIPParser::Create(theFile.c_str(), *m_MetaData,
+                                                   m_CoreFactory->GetInputStreamFactory(),
+                                                   m_CoreFactory->GetStringTable());
+            }
             Q3DStudio::IScene *newScene = nullptr;
-            if (theUIPParser->Load(*thePresentation, inExternalReferences, initInRenderThread)) {
+            bool theElementsLoaded = false;
+            {
+                const QByteArray theTimerTag(LoadPhaseTimerTag(inAsset, "elements"));
+                QT3DS_PERF_SCOPED_TIMER(m_CoreFactory->GetPerfTimer(), theTimerTag.constData())
+                theElementsLoaded = theUIPParser->Load(*thePresentation, inExternalReferences,
+                                                       initInRenderThread);
+            }
+            if (theElementsLoaded) {
                 // Load the scene graph portion of the scene.
+                const QByteArray theTimerTag(LoadPhaseTimerTag(inAsset, "scene"));
+                QT3DS_PERF_SCOPED_TIMER(m_CoreFactory->GetPerfTimer(), theTimerTag.constData())
                 newScene = m_RuntimeFactory->GetSceneManager().LoadScene(
                             thePresentation, theUIPParser.mPtr,
                             m_CoreFactory->GetScriptEngineQml(),
@@ -1386,6 +1625,8 @@ struct SApp : public IApplication
                 inAsset.m_Presentation = NULL;
                 return false;
             } else {
+                const QByteArray theTimerTag(LoadPhaseTimerTag(inAsset, "register"));
+                QT3DS_PERF_SCOPED_TIMER(m_CoreFactory->GetPerfTimer(), theTimerTag.constData())
                 if (inAsset.m_Id.IsValid() && m_PresentationId.empty())
                     m_PresentationId.assign(inAsset.m_Id);
 
@@ -2154,6 +2395,16 @@ struct SXMLLoader : public IAppLoadContext
         if (initial.empty())
             return false;
 
+        // Without delayed loading every presentation is loaded here, so all of them are parsed
+        // on the job system while the initial presentation is being built.
+        if (!delayedLoading) {
+            for (QT3DSU32 idx = 0, end = m_App.m_OrderedAssets.size(); idx < end; ++idx) {
+                SAssetValue &theAsset = *m_App.m_OrderedAssets[idx].second;
+                if (theAsset.getType() == AssetValueTypes::Presentation)
+                    m_App.StartUIPParse(*theAsset.getDataPtr<SPresentationAsset>());
+            }
+        }
+
         // Load it
         for (QT3DSU32 idx = 0, end = m_App.m_OrderedAssets.size(); idx < end; ++idx) {
             if (m_App.m_OrderedAssets[idx].first == initialStr) {
@@ -2177,26 +2428,36 @@ struct SXMLLoader : public IAppLoadContext
         }
 
         if (!delayedLoading || (m_App.m_OrderedAssets.size() > 1 && initialAssets.size() > 0)) {
+            QVector<QT3DSU32> loadAssets;
             for (QT3DSU32 idx = 0, end = m_App.m_OrderedAssets.size(); idx < end; ++idx) {
                 QString assetId = QString::fromUtf8(m_App.m_OrderedAssets[idx].first.c_str());
                 if (!m_App.GetPresentationById(qPrintable(assetId))
                         && (m_App.m_OrderedAssets[idx].first != initialStr
                         && (initialAssets.contains(assetId) || !delayedLoading))) {
-                    SAssetValue &theAsset = *m_App.m_OrderedAssets[idx].second;
-                    switch (theAsset.getType()) {
-                    case AssetValueTypes::Presentation:
-                        AssetHandlers::handlePresentation(m_App, theAsset);
-                        break;
-                    case AssetValueTypes::Behavior:
-                        AssetHandlers::handleBehavior(m_App, theAsset);
-                        break;
-                    case AssetValueTypes::QmlPresentation:
-                        AssetHandlers::handleQmlPresentation(inFactory, theAsset);
-                        break;
-                        // SCXML, NoAssetValue do not need processing here
-                    default:
-                        break;
-                    }
+                    loadAssets.append(idx);
+                }
+            }
+            // Parse the presentations concurrently, then build and register them in uia order.
+            for (QT3DSU32 idx : qAsConst(loadAssets)) {
+                SAssetValue &theAsset = *m_App.m_OrderedAssets[idx].second;
+                if (theAsset.getType() == AssetValueTypes::Presentation)
+                    m_App.StartUIPParse(*theAsset.getDataPtr<SPresentationAsset>());
+            }
+            for (QT3DSU32 idx : qAsConst(loadAssets)) {
+                SAssetValue &theAsset = *m_App.m_OrderedAssets[idx].second;
+                switch (theAsset.getType()) {
+                case AssetValueTypes::Presentation:
+                    AssetHandlers::handlePresentation(m_App, theAsset);
+                    break;
+                case AssetValueTypes::Behavior:
+                    AssetHandlers::handleBehavior(m_App, theAsset);
+                    break;
+                case AssetValueTypes::QmlPresentation:
+                    AssetHandlers::handleQmlPresentation(inFactory, theAsset);
+                    break;
+                    // SCXML, NoAssetValue do not need processing here
+                default:
+                    break;
                 }
             }
         }
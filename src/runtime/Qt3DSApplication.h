@@ -140,6 +140,50 @@ struct DataOutputDef
 typedef QMap<QString, DataInputDef> DataInputMap;
 typedef QMap<QString, DataOutputDef> DataOutputMap;
 
+// Why a frame was rendered in render on demand mode. When none of these apply the frame is
+// skipped and the render target keeps its previous contents.
+struct FrameRenderReasons
+{
+    enum Enum {
+        InitialFrame = 1,
+        // Elements on a presentation dirty list. Animations, slide changes, data inputs and
+        // scripts all end up there.
+        SceneChanged = 1 << 1,
+        // The last rendered frame did not settle, e.g. progressive AA or the second eye of
+        // progressive stereo rendering.
+        RendererDirty = 1 << 2,
+        // An offscreen renderer such as a QML subpresentation has new content.
+        OffscreenUpdate = 1 << 3,
+        // Images or meshes are loading and have to be uploaded on the render thread.
+        ResourcesLoading = 1 << 4,
+        // Window size, scale mode, matte or another view setting changed.
+        ViewSettingsChanged = 1 << 5,
+        // MarkApplicationDirty was called, e.g. by input handling.
+        Requested = 1 << 6,
+        Count = 7,
+    };
+    static const char *GetName(QT3DSU32 inIndex);
+};
+
+struct SFrameSkipStatistics
+{
+    QT3DSU32 m_RenderedFrames;
+    QT3DSU32 m_SkippedFrames;
+    // FrameRenderReasons of the last rendered frame.
+    QT3DSU32 m_LastFrameReasons;
+    // Number of rendered frames that had each reason, indexed by the bit of the reason.
+    QT3DSU32 m_ReasonCounts[FrameRenderReasons::Count];
+
+    SFrameSkipStatistics()
+        : m_RenderedFrames(0)
+        , m_SkippedFrames(0)
+        , m_LastFrameReasons(0)
+    {
+        for (QT3DSU32 idx = 0; idx < FrameRenderReasons::Count; ++idx)
+            m_ReasonCounts[idx] = 0;
+    }
+};
+
 class QT3DS_AUTOTEST_EXPORT IApplication : public NVRefCounted
 {
 public:
@@ -168,12 +212,17 @@ public:
     virtual QList<Q3DStudio::CPresentation *> GetPresentationList() = 0;
 
     // Update all the presentations and render them.  Called exactly once per frame.
+    // In render on demand mode the rendering is skipped when nothing changed.
     virtual bool UpdateAndRender() = 0;
 
     virtual bool IsApplicationDirty() = 0;
 
     virtual void MarkApplicationDirty() = 0;
 
+    // True if the last UpdateAndRender did not render anything in render on demand mode.
+    virtual bool WasLastFrameSkipped() const = 0;
+    virtual const SFrameSkipStatistics &GetFrameSkipStatistics() const = 0;
+
     virtual Q3DStudio::IAudioPlayer &GetAudioPlayer() = 0;
 
     virtual bool createSuccessful() = 0;
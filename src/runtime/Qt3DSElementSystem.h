@@ -298,6 +298,8 @@ namespace runtime {
             QHash<QT3DSU32, SElement *> m_children;
         public:
             bool m_OnMaster = false;
+            // Set when a data output observes a property of this element.
+            bool m_DataOutputObserved = false;
             void *m_Association; ///< Link to associated asset in scene
             Q3DStudio::IPresentation *m_BelongedPresentation;
             SActivationManagerNode m_ActivationManagerNode;
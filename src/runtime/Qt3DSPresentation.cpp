@@ -44,12 +44,15 @@
 #include "Qt3DSLogicSystem.h"
 #include "Qt3DSParametersSystem.h"
 #include "Qt3DSApplication.h"
+#include "foundation/Qt3DSPerfTimer.h"
 
 #include <QtCore/qfileinfo.h>
 #include <QtGui/qvector4d.h>
 #include <QtGui/qvector3d.h>
 #include <QtGui/qvector2d.h>
 
+using qt3ds::foundation::SStackPerfTimer;
+
 namespace Q3DStudio {
 
 // Maximum number of Event/Command that can be queued in an Update cycle
@@ -207,6 +210,8 @@ void CPresentation::EndUpdate()
 
     if (!m_Paused) {
         // Animation Track Evaluation Stage
+        QT3DS_PERF_SCOPED_TIMER(m_Application->GetRuntimeFactory().GetPerfTimer(),
+                                "Presentation: Animation")
         m_AnimationSystem->Update();
     }
     // Presentation is considered ready to accept external commands when the first frame property
@@ -229,77 +234,156 @@ void CPresentation::PostUpdate(const TTimeUnit inGlobalTime)
     m_ComponentManager.ClearGotoTimeQueue();
 }
 
+// Observed properties of one data output on an element, resolved when the presentation loads.
+struct CPresentation::SDataOutputObserver
+{
+    qt3ds::runtime::DataOutputDef m_Def;
+    // Vectors expanded to their components observe one property per component.
+    QT3DSU32 m_PropertyIndices[4];
+    QT3DSU32 m_PropertyCount = 0;
+    // Raw value last seen, compared before any QVariant is built.
+    UVariant m_LastValue;
+    bool m_HasLastValue = false;
+};
+
 void CPresentation::NotifyDataOutputs()
 {
-    if (m_pathToDataOutMap.size() == 0)
+    if (m_DataOutputObservers.isEmpty())
         return;
 
     // Based on the dirty list, check if we need to fire DataOutput notifications
     Q3DStudio::TElementList &dirtyList = GetFrameData().GetDirtyList();
     for (int idx = 0, end = dirtyList.GetCount(); idx < end; ++idx) {
         Q3DStudio::TElement &element = *dirtyList[idx];
-        if (m_pathToDataOutMap.contains(element.path())) {
-            auto outDefIter = m_pathToDataOutMap.find(element.path());
-
-            while (outDefIter != m_pathToDataOutMap.end() && outDefIter.key() == element.path()) {
-                qt3ds::runtime::DataOutputDef &outDef = outDefIter.value();
-
-                // Get current value
-                Q3DStudio::UVariant value;
-                qt3ds::QT3DSU32 attribHash = CHash::HashAttribute(
-                            outDef.observedAttribute.attributeName[0].constData());
-                element.GetAttribute(attribHash, value);
-                QVariant qvar;
-                switch (outDef.observedAttribute.propertyType) {
-                case ATTRIBUTETYPE_INT32:
-                    qvar.setValue(value.m_INT32);
-                    break;
-                case ATTRIBUTETYPE_FLOAT:
-                    qvar.setValue(value.m_FLOAT);
-                    break;
-                case ATTRIBUTETYPE_BOOL:
-                    qvar.setValue(value.m_INT32);
-                    break;
-                case ATTRIBUTETYPE_STRING:
-                    qvar.setValue(QString::fromUtf8(
-                                      GetStringTable().HandleToStr(value.m_StringHandle).c_str()));
-                    break;
-                case ATTRIBUTETYPE_FLOAT4: {
-                    QVector4D qvalue(value.m_FLOAT4[0], value.m_FLOAT4[1],
-                                     value.m_FLOAT4[2], value.m_FLOAT4[3]);
-                    qvar.setValue(qvalue);
-                }
-                    break;
-                case ATTRIBUTETYPE_FLOAT3: {
-                    QVector3D qvalue(value.m_FLOAT3[0], value.m_FLOAT3[1], value.m_FLOAT3[2]);
-                    qvar.setValue(qvalue);
-                }
-                    break;
-                case ATTRIBUTETYPE_FLOAT2: {
-                    QVector2D qvalue(value.m_FLOAT3[0], value.m_FLOAT3[1]);
-                    qvar.setValue(qvalue);
-                }
-                    break;
-                default:
-                    break;
-                }
-
-                if (qvar.isValid() && (outDef.value != qvar)) {
-                    outDef.value.setValue(qvar);
-                    m_SignalProxy.SigDataOutputValueUpdated(outDef.name, outDef.value);
-                }
-
-                ++outDefIter;
-            }
-        }
+        if (!element.m_DataOutputObserved)
+            continue;
+        auto observers = m_DataOutputObservers.find(&element);
+        if (observers == m_DataOutputObservers.end())
+            continue;
+        for (SDataOutputObserver &observer : observers.value())
+            NotifyDataOutput(element, observer);
     }
 }
 
-void CPresentation::AddToDataOutputMap(const QHash<qt3ds::foundation::CRegisteredString,
+void CPresentation::NotifyDataOutput(TElement &inElement, SDataOutputObserver &inObserver)
+{
+    qt3ds::runtime::DataOutputDef &outDef = inObserver.m_Def;
+    QT3DSU32 valueSize = 0;
+    switch (outDef.observedAttribute.propertyType) {
+    case ATTRIBUTETYPE_INT32:
+    case ATTRIBUTETYPE_FLOAT:
+    case ATTRIBUTETYPE_BOOL:
+    case ATTRIBUTETYPE_STRING:
+        valueSize = sizeof(INT32);
+        break;
+    case ATTRIBUTETYPE_FLOAT4:
+        valueSize = 4 * sizeof(FLOAT);
+        break;
+    case ATTRIBUTETYPE_FLOAT3:
+        valueSize = 3 * sizeof(FLOAT);
+        break;
+    case ATTRIBUTETYPE_FLOAT2:
+        valueSize = 2 * sizeof(FLOAT);
+        break;
+    default:
+        return;
+    }
+
+    // Get current value
+    UVariant value;
+    memset(&value, 0, sizeof(UVariant));
+    for (QT3DSU32 idx = 0; idx < inObserver.m_PropertyCount; ++idx) {
+        qt3ds::foundation::Option<qt3ds::runtime::element::TPropertyDescAndValuePtr> property =
+                inElement.GetPropertyByIndex(inObserver.m_PropertyIndices[idx]);
+        if (!property.hasValue())
+            return;
+        if (inObserver.m_PropertyCount == 1)
+            value = *property->second;
+        else
+            value.m_FLOAT4[idx] = property->second->m_FLOAT;
+    }
+    if (inObserver.m_HasLastValue && memcmp(&value, &inObserver.m_LastValue, valueSize) == 0)
+        return;
+    inObserver.m_LastValue = value;
+    inObserver.m_HasLastValue = true;
+
+    QVariant qvar;
+    switch (outDef.observedAttribute.propertyType) {
+    case ATTRIBUTETYPE_INT32:
+        qvar.setValue(value.m_INT32);
+        break;
+    case ATTRIBUTETYPE_FLOAT:
+        qvar.setValue(value.m_FLOAT);
+        break;
+    case ATTRIBUTETYPE_BOOL:
+        qvar.setValue(value.m_INT32);
+        break;
+    case ATTRIBUTETYPE_STRING:
+        qvar.setValue(QString::fromUtf8(
+                          GetStringTable().HandleToStr(value.m_StringHandle).c_str()));
+        break;
+    case ATTRIBUTETYPE_FLOAT4: {
+        QVector4D qvalue(value.m_FLOAT4[0], value.m_FLOAT4[1],
+                         value.m_FLOAT4[2], value.m_FLOAT4[3]);
+        qvar.setValue(qvalue);
+    }
+        break;
+    case ATTRIBUTETYPE_FLOAT3: {
+        QVector3D qvalue(value.m_FLOAT3[0], value.m_FLOAT3[1], value.m_FLOAT3[2]);
+        qvar.setValue(qvalue);
+    }
+        break;
+    case ATTRIBUTETYPE_FLOAT2: {
+        QVector2D qvalue(value.m_FLOAT3[0], value.m_FLOAT3[1]);
+        qvar.setValue(qvalue);
+    }
+        break;
+    default:
+        break;
+    }
+
+    if (qvar.isValid() && (outDef.value != qvar)) {
+        outDef.value.setValue(qvar);
+        m_SignalProxy.SigDataOutputValueUpdated(outDef.name, outDef.value);
+    }
+}
+
+void CPresentation::AddToDataOutputMap(const QHash<TElement *,
                                        qt3ds::runtime::DataOutputDef> &doMap)
 {
-    if (doMap.size() > 0)
-        m_pathToDataOutMap.unite(doMap);
+    for (auto iter = doMap.constBegin(), end = doMap.constEnd(); iter != end; ++iter) {
+        TElement *element = iter.key();
+        SDataOutputObserver observer;
+        observer.m_Def = iter.value();
+        const QVector<QByteArray> &attributeNames = observer.m_Def.observedAttribute.attributeName;
+        if (attributeNames.isEmpty() || attributeNames.size() > 4)
+            continue;
+        for (const QByteArray &attributeName : attributeNames) {
+            qt3ds::foundation::Option<QT3DSU32> propertyIndex =
+                    element->FindPropertyIndex(CHash::HashAttribute(attributeName.constData()));
+            if (!propertyIndex.hasValue())
+                break;
+            observer.m_PropertyIndices[observer.m_PropertyCount++] = *propertyIndex;
+        }
+        // Missing properties were already reported when the data output was parsed.
+        if (observer.m_PropertyCount != QT3DSU32(attributeNames.size()))
+            continue;
+        element->m_DataOutputObserved = true;
+        m_DataOutputObservers[element].append(observer);
+    }
+}
+
+void CPresentation::RemoveDataOutputObservers(TElement &inElement)
+{
+    if (m_DataOutputObservers.isEmpty())
+        return;
+    if (inElement.m_DataOutputObserved) {
+        m_DataOutputObservers.remove(&inElement);
+        inElement.m_DataOutputObserved = false;
+    }
+    const auto children = inElement.children();
+    for (TElement *child : children)
+        RemoveDataOutputObservers(*child);
 }
 
 /**
@@ -42,6 +42,7 @@
 #include "Qt3DSComponentManager.h"
 
 #include <QObject>
+#include <QVector>
 
 class QPresentationSignalProxy : public QObject
 {
@@ -164,8 +165,11 @@ public: // Commands and Events
     QPresentationSignalProxy *signalProxy() { return &m_SignalProxy; }
 
 public: // Data Output
-    void AddToDataOutputMap(const QHash<qt3ds::foundation::CRegisteredString,
-                            qt3ds::runtime::DataOutputDef> &doMap);
+    // Resolves the observed attributes of each element once so notifying only has to look
+    // at the dirty elements that are actually observed.
+    void AddToDataOutputMap(const QHash<TElement *, qt3ds::runtime::DataOutputDef> &doMap);
+    // Drops the observers of this element and its descendants before they are released.
+    void RemoveDataOutputObservers(TElement &inElement);
 
 public: // Event Callbacks
     void RegisterEventCallback(TElement *inElement, const TEventCommandHash inEventHash,
@@ -224,8 +228,11 @@ private: // Disabled Copy Construction
     CPresentation(CPresentation &);
     CPresentation &operator=(const CPresentation &);
 private:
+    struct SDataOutputObserver;
+    void NotifyDataOutput(TElement &inElement, SDataOutputObserver &inObserver);
+
     QPresentationSignalProxy m_SignalProxy;
-    QHash<qt3ds::foundation::CRegisteredString, qt3ds::runtime::DataOutputDef> m_pathToDataOutMap;
+    QHash<TElement *, QVector<SDataOutputObserver>> m_DataOutputObservers;
 };
 
 } // namespace Q3DStudio
@@ -85,6 +85,7 @@
 #include <QtQml/qjsengine.h>
 #include <QtCore/qnumeric.h>
 #include <QtCore/qfileinfo.h>
+#include <QtCore/qmath.h>
 
 //==============================================================================
 //	Namespace
@@ -393,6 +394,37 @@ private:
     QHash<TElement *, int> m_elementIdMap;
     QVector<QPair<TElement *, QString>> m_deferredScriptLoads;
 
+    // Resolved target of a datainput controlled attribute or an attribute handle. Bindings are
+    // compiled once so that writes do not have to look up element paths or hash attribute names.
+    struct SAttributeBinding
+    {
+        static const int MAX_COMPONENTS = 4;
+
+        TElement *m_Element = nullptr;
+        // Time parent that decides if attribute changes need to be queued, if any
+        TComponent *m_TimeParent = nullptr;
+        // Type of the written values, ATTRIBUTETYPE_FLOAT or ATTRIBUTETYPE_BOOL
+        EAttributeType m_ValueType = ATTRIBUTETYPE_NONE;
+        int m_ComponentCount = 0;
+        QByteArray m_Names[MAX_COMPONENTS];
+        TAttributeHash m_Hashes[MAX_COMPONENTS] = {};
+        // Static property index of each component, or -1 if the generic path must be used
+        int m_PropertyIndices[MAX_COMPONENTS] = { -1, -1, -1, -1 };
+        bool m_ToRadians[MAX_COMPONENTS] = {};
+    };
+    struct SAttributeHandle
+    {
+        QByteArray m_ElementPath;
+        QByteArray m_AttributeName;
+        SAttributeBinding m_Binding;
+        bool m_Resolved = false;
+        // A missing element is only reported on the first failed write
+        bool m_Warned = false;
+    };
+    // Bindings per datainput name, parallel to DataInputDef::controlledAttributes
+    QHash<QString, QVector<SAttributeBinding>> m_dataInputBindings;
+    QHash<QT3DSI32, SAttributeHandle> m_attributeHandles;
+
 public:
     CQmlEngineImpl(NVFoundationBase &fnd, ITimeProvider &inTimeProvider);
 
@@ -432,6 +464,11 @@ public:
     void SetAttribute(const QString &element, const QString &attName, const char *value) override;
     bool GetAttribute(TElement *target, const char *attName, char *value) override;
     bool GetAttribute(const char *element, const char *attName, char *value) override;
+    void RegisterAttributeHandle(QT3DSI32 handle, const char *element,
+                                 const char *attName) override;
+    void ReleaseAttributeHandle(QT3DSI32 handle) override;
+    void SetAttributeHandleValues(const QT3DSI32 *handles, const float *values,
+                                  int count) override;
     void FireEvent(const char *element, const char *evtName) override;
     void SetDataInputValue(const QString &name, const QVariant &value,
                            qt3ds::runtime::DataInputValueRole valueRole) override;
@@ -484,6 +521,16 @@ private:
     TElement *createMaterialContainer(TElement *parent, CPresentation *presentation);
     void createComponent(QQmlComponent *component, TElement *element);
     TElement *getTarget(const QString &component);
+    void setAttribute(TElement *target, const char *attName, TAttributeHash attrHash,
+                      const char *value);
+    void gotoTime(TElement *component, const Q3DStudio::FLOAT time);
+    void bindAttribute(SAttributeBinding &binding, TElement *element,
+                       const QVector<QByteArray> &attNames, EAttributeType valueType);
+    void setBoundAttribute(const SAttributeBinding &binding, int component, const char *value);
+    void invalidateAttributeBindings();
+    QVector<SAttributeBinding> dataInputBindings(const QString &name,
+                                                 const qt3ds::runtime::DataInputDef &diDef);
+    void resolveAttributeHandle(QT3DSI32 handle, SAttributeHandle &attributeHandle);
     void listAllElements(TElement *root, QList<TElement *> &elements);
     void initializeDataInputsInPresentation(CPresentation &presentation, bool isPrimary,
                                             bool isDynamicAdd = false,
@@ -621,17 +668,7 @@ void CQmlEngineImpl::SetAttribute(TElement *target, const QString &attName, cons
 
     if (target) {
         QByteArray att = attName.toUtf8();
-        auto attrHash = CHash::HashAttribute(attName);
-        if (!queueAttributeChange(target, att.constData(), value, attrHash)) {
-            bool success = CQmlElementHelper::SetAttribute(target, att.constData(), value,
-                                                           attrHash);
-            if (!success) {
-                qCCritical(qt3ds::INVALID_OPERATION)
-                        << "CQmlEngineImpl::SetAttribute: "
-                        << "failed to set attribute on element"
-                        << target->path().c_str() << ":" << attName << ":" << value;
-            }
-        }
+        setAttribute(target, att.constData(), CHash::HashAttribute(attName), value);
     }
 }
 
@@ -642,16 +679,20 @@ void CQmlEngineImpl::SetAttribute(const QString &element, const QString &attName
     TElement *theTarget = getTarget(element);
     if (theTarget) {
         QByteArray att = attName.toUtf8();
-        auto attrHash = CHash::HashAttribute(attName);
-        if (!queueAttributeChange(theTarget, att.constData(), value, attrHash)) {
-            bool success = CQmlElementHelper::SetAttribute(theTarget, att.constData(), value,
-                                                           attrHash);
-            if (!success) {
-                qCCritical(qt3ds::INVALID_OPERATION)
-                        << "CQmlEngineImpl::SetAttribute: "
-                        << "failed to set attribute on element"
-                        << element << ":" << attName << ":" << value;
-            }
+        setAttribute(theTarget, att.constData(), CHash::HashAttribute(attName), value);
+    }
+}
+
+void CQmlEngineImpl::setAttribute(TElement *target, const char *attName, TAttributeHash attrHash,
+                                  const char *value)
+{
+    if (!queueAttributeChange(target, attName, value, attrHash)) {
+        bool success = CQmlElementHelper::SetAttribute(target, attName, value, attrHash);
+        if (!success) {
+            qCCritical(qt3ds::INVALID_OPERATION)
+                    << "CQmlEngineImpl::SetAttribute: "
+                    << "failed to set attribute on element"
+                    << target->path().c_str() << ":" << attName << ":" << value;
         }
     }
 }
@@ -766,10 +807,55 @@ void CQmlEngineImpl::FireEvent(const char *element, const char *evtName)
     }
 }
 
+void CQmlEngineImpl::RegisterAttributeHandle(QT3DSI32 handle, const char *element,
+                                             const char *attName)
+{
+    QML_ENGINE_MULTITHREAD_PROTECT_METHOD;
+
+    // Resolved lazily, the element may not exist yet
+    SAttributeHandle &attributeHandle = m_attributeHandles[handle];
+    attributeHandle = SAttributeHandle();
+    attributeHandle.m_ElementPath = element;
+    attributeHandle.m_AttributeName = attName;
+}
+
+void CQmlEngineImpl::ReleaseAttributeHandle(QT3DSI32 handle)
+{
+    QML_ENGINE_MULTITHREAD_PROTECT_METHOD;
+
+    m_attributeHandles.remove(handle);
+}
+
+void CQmlEngineImpl::SetAttributeHandleValues(const QT3DSI32 *handles, const float *values,
+                                              int count)
+{
+    QML_ENGINE_MULTITHREAD_PROTECT_METHOD;
+
+    for (int i = 0; i < count; ++i) {
+        auto it = m_attributeHandles.find(handles[i]);
+        if (it == m_attributeHandles.end()) {
+            qCWarning(qt3ds::INVALID_OPERATION)
+                    << "CQmlEngineImpl::SetAttributeHandleValues: Invalid handle" << handles[i];
+            continue;
+        }
+        if (!it->m_Resolved)
+            resolveAttributeHandle(handles[i], *it);
+
+        const SAttributeBinding &binding = it->m_Binding;
+        if (!binding.m_Element)
+            continue;
+        const float *handleValues = values + i * SAttributeBinding::MAX_COMPONENTS;
+        for (int c = 0; c < binding.m_ComponentCount; ++c)
+            setBoundAttribute(binding, c, reinterpret_cast<const char *>(handleValues + c));
+    }
+}
+
 void CQmlEngineImpl::SetDataInputValue(
         const QString &name, const QVariant &value,
         qt3ds::runtime::DataInputValueRole valueRole = qt3ds::runtime::DataInputValueRole::Value)
 {
+    QML_ENGINE_MULTITHREAD_PROTECT_METHOD;
+
     qt3ds::runtime::DataInputMap &diMap = m_Application->dataInputMap();
     if (diMap.contains(name)) {
         qt3ds::runtime::DataInputDef &diDef = diMap[name];
@@ -778,20 +864,23 @@ void CQmlEngineImpl::SetDataInputValue(
             diDef.value = value;
             const QVector<qt3ds::runtime::DataInOutAttribute> &ctrlAtt
                     = diDef.controlledAttributes;
-            for (const qt3ds::runtime::DataInOutAttribute &ctrlElem : ctrlAtt) {
+            const QVector<SAttributeBinding> bindings = dataInputBindings(name, diDef);
+            for (int attIdx = 0; attIdx < ctrlAtt.size(); ++attIdx) {
+                const qt3ds::runtime::DataInOutAttribute &ctrlElem = ctrlAtt[attIdx];
+                const SAttributeBinding &binding = bindings[attIdx];
+                if (!binding.m_Element)
+                    continue;
                 switch (ctrlElem.propertyType) {
                 case ATTRIBUTETYPE_DATAINPUT_TIMELINE: {
                     // Quietly ignore other than number type data inputs when adjusting timeline
                     if (diDef.type == qt3ds::runtime::DataInOutTypeRangedNumber) {
-                        TTimeUnit endTime = 0;
-                        TElement *element = getTarget(ctrlElem.elementPath.constData());
-                        TComponent *component = static_cast<TComponent *>(element);
-                        endTime = component->GetTimePolicy().GetLoopingDuration();
+                        TComponent *component = static_cast<TComponent *>(binding.m_Element);
+                        TTimeUnit endTime = component->GetTimePolicy().GetLoopingDuration();
 
                         // Normalize the value to dataInput range
                         qreal newTime = qreal(endTime) * (qreal(value.toFloat() - diDef.min)
                                                           / qreal(diDef.max - diDef.min));
-                        GotoTime(ctrlElem.elementPath.constData(), float(newTime / 1000.0));
+                        gotoTime(binding.m_Element, float(newTime / 1000.0));
                     }
                     break;
                 }
@@ -799,8 +888,9 @@ void CQmlEngineImpl::SetDataInputValue(
                     // Quietly ignore other than string type when adjusting slide
                     if (diDef.type == qt3ds::runtime::DataInOutTypeString) {
                         const QByteArray valueStr = value.toString().toUtf8();
-                        GotoSlide(ctrlElem.elementPath.constData(), valueStr.constData(),
-                                  SScriptEngineGotoSlideArgs());
+                        CQmlCommandHelper::SetupGotoSlideCommand(*binding.m_Element,
+                                                                 valueStr.constData(),
+                                                                 SScriptEngineGotoSlideArgs());
                     }
                     break;
                 }
@@ -827,9 +917,7 @@ void CQmlEngineImpl::SetDataInputValue(
                         break;
                     }
 
-                    SetAttribute(ctrlElem.elementPath.constData(),
-                                 ctrlElem.attributeName.first().constData(),
-                                 reinterpret_cast<const char *>(&valueFloat));
+                    setBoundAttribute(binding, 0, reinterpret_cast<const char *>(&valueFloat));
                     break;
                 }
                 case ATTRIBUTETYPE_FLOAT4: {
@@ -847,9 +935,7 @@ void CQmlEngineImpl::SetDataInputValue(
                     // Set the values of vector attribute components separately
                     for (int i = 0; i < 4; i++) {
                         const float val = valueVec[i];
-                        SetAttribute(ctrlElem.elementPath.constData(),
-                                     ctrlElem.attributeName[i].constData(),
-                                     reinterpret_cast<const char *>(&val));
+                        setBoundAttribute(binding, i, reinterpret_cast<const char *>(&val));
                     }
                     break;
                 }
@@ -869,9 +955,7 @@ void CQmlEngineImpl::SetDataInputValue(
                     // Set the values of vector attribute components separately
                     for (int i = 0; i < 3; i++) {
                         const float val = valueVec[i];
-                        SetAttribute(ctrlElem.elementPath.constData(),
-                                     ctrlElem.attributeName[i].constData(),
-                                     reinterpret_cast<const char *>(&val));
+                        setBoundAttribute(binding, i, reinterpret_cast<const char *>(&val));
                     }
                     break;
                 }
@@ -892,9 +976,7 @@ void CQmlEngineImpl::SetDataInputValue(
                     // Set the values of vector attribute components separately
                     for (int i = 0; i < 2; i++) {
                         const float val = valueVec[i];
-                        SetAttribute(ctrlElem.elementPath.constData(),
-                                     ctrlElem.attributeName[i].constData(),
-                                     reinterpret_cast<const char *>(&val));
+                        setBoundAttribute(binding, i, reinterpret_cast<const char *>(&val));
                     }
                     break;
                 }
@@ -911,17 +993,14 @@ void CQmlEngineImpl::SetDataInputValue(
                                    << diDef.type;
                         break;
                     }
-                    SetAttribute(ctrlElem.elementPath.constData(),
-                                 ctrlElem.attributeName.first().constData(),
-                                 reinterpret_cast<const char *>(&valueBool));
+                    setBoundAttribute(binding, 0, reinterpret_cast<const char *>(&valueBool));
 
                     // Special case for eyeball (visibility) controller that targets elements
                     // on master slide, and whose visibility setting must be persistent over
                     // slide changes.
-                    TElement *element = getTarget(ctrlElem.elementPath.constData());
-                    auto hash = CHash::HashAttribute(QString(ctrlElem.attributeName.first()));
-
-                    if (element && hash == Q3DStudio::ATTRIBUTE_EYEBALL && element->m_OnMaster) {
+                    TElement *element = binding.m_Element;
+                    if (binding.m_Hashes[0] == Q3DStudio::ATTRIBUTE_EYEBALL
+                            && element->m_OnMaster) {
                         element->GetActivityZone().setControlled(*element);
                         element->SetControlledActive(valueBool);
                     }
@@ -945,9 +1024,7 @@ void CQmlEngineImpl::SetDataInputValue(
                         break;
                     }
 
-                    SetAttribute(ctrlElem.elementPath.constData(),
-                                 ctrlElem.attributeName.first().constData(),
-                                 valueStr.constData());
+                    setBoundAttribute(binding, 0, valueStr.constData());
                     break;
                 }
                 default:
@@ -1987,7 +2064,13 @@ bool CQmlEngineImpl::GetSlideInfo(const char *element, int &currentIndex, int &p
 void CQmlEngineImpl::GotoTime(const char *component, const Q3DStudio::FLOAT time)
 {
     TElement *theTarget = getTarget(component);
-    if (theTarget && (theTarget->GetActive() || theTarget->AboutToActivate())) {
+    if (theTarget)
+        gotoTime(theTarget, time);
+}
+
+void CQmlEngineImpl::gotoTime(TElement *theTarget, const Q3DStudio::FLOAT time)
+{
+    if (theTarget->GetActive() || theTarget->AboutToActivate()) {
         UVariant theArg1;
         UVariant theArg2;
 
@@ -2143,6 +2226,170 @@ TElement *CQmlEngineImpl::getTarget(const QString &component) {
     return target;
 }
 
+// Resolves attNames of element into binding. Property indices are only resolved for static
+// properties matching valueType; everything else is written through the generic attribute path.
+void CQmlEngineImpl::bindAttribute(SAttributeBinding &binding, TElement *element,
+                                   const QVector<QByteArray> &attNames, EAttributeType valueType)
+{
+    binding.m_Element = element;
+    binding.m_ValueType = valueType;
+    if (element->GetBelongedPresentation()->GetActivityZone()) {
+        binding.m_TimeParent = static_cast<TComponent *>(
+                    element->GetActivityZone().GetItemTimeParent(*element));
+    }
+
+    binding.m_ComponentCount = qMin(attNames.size(), int(SAttributeBinding::MAX_COMPONENTS));
+    for (int i = 0; i < binding.m_ComponentCount; ++i) {
+        const TAttributeHash hash = CHash::HashAttribute(attNames[i].constData());
+        binding.m_Names[i] = attNames[i];
+        binding.m_Hashes[i] = hash;
+        // Eyeball and subpresentation have side effects handled by CQmlElementHelper
+        if (valueType == ATTRIBUTETYPE_NONE || hash == Q3DStudio::ATTRIBUTE_EYEBALL
+                || hash == Q3DStudio::ATTRIBUTE_URI
+                || hash == Q3DStudio::ATTRIBUTE_SUBPRESENTATION) {
+            continue;
+        }
+        Option<QT3DSU32> propertyIndex = element->FindPropertyIndex(hash);
+        if (!propertyIndex.hasValue())
+            continue;
+        Option<qt3ds::runtime::element::TPropertyDescAndValuePtr> property
+                = element->GetPropertyByIndex(*propertyIndex);
+        const EAttributeType propertyType = property->first.type();
+        if (propertyType != valueType
+                && !(valueType == ATTRIBUTETYPE_BOOL && propertyType == ATTRIBUTETYPE_INT32)) {
+            continue;
+        }
+        binding.m_PropertyIndices[i] = int(*propertyIndex);
+        binding.m_ToRadians[i] = propertyType == ATTRIBUTETYPE_FLOAT
+                && QByteArray(property->first.name().c_str()).startsWith("rotation.");
+    }
+}
+
+// Writes a single attribute component of a binding. Resolved static properties are set
+// directly, unless the change needs to be queued for a component that has not been
+// activated yet.
+void CQmlEngineImpl::setBoundAttribute(const SAttributeBinding &binding, int component,
+                                       const char *value)
+{
+    const int propertyIndex = binding.m_PropertyIndices[component];
+    if (propertyIndex >= 0
+            && (!binding.m_TimeParent || binding.m_TimeParent->GetCurrentSlide() != 0)) {
+        UVariant theNewValue;
+        if (binding.m_ValueType == ATTRIBUTETYPE_BOOL) {
+            theNewValue.m_INT32 = *reinterpret_cast<const INT32 *>(value);
+        } else {
+            theNewValue.m_FLOAT = *reinterpret_cast<const FLOAT *>(value);
+            if (binding.m_ToRadians[component])
+                theNewValue.m_FLOAT = qDegreesToRadians(theNewValue.m_FLOAT);
+        }
+        binding.m_Element->SetAttribute(
+                    *binding.m_Element->GetPropertyByIndex(QT3DSU32(propertyIndex)), theNewValue);
+        return;
+    }
+    setAttribute(binding.m_Element, binding.m_Names[component].constData(),
+                 binding.m_Hashes[component], value);
+}
+
+// Drops everything resolved against the element graph. Called whenever elements are created or
+// deleted; datainput bindings and attribute handles are resolved again on their next write.
+void CQmlEngineImpl::invalidateAttributeBindings()
+{
+    m_dataInputBindings.clear();
+    for (auto &attributeHandle : m_attributeHandles) {
+        attributeHandle.m_Binding = SAttributeBinding();
+        attributeHandle.m_Resolved = false;
+    }
+}
+
+// Returns the bindings of the named datainput, compiling them first if the controlled attributes
+// have changed since the last call.
+QVector<CQmlEngineImpl::SAttributeBinding> CQmlEngineImpl::dataInputBindings(
+        const QString &name, const qt3ds::runtime::DataInputDef &diDef)
+{
+    const QVector<qt3ds::runtime::DataInOutAttribute> &ctrlAtt = diDef.controlledAttributes;
+    auto it = m_dataInputBindings.constFind(name);
+    if (it != m_dataInputBindings.constEnd() && it->size() == ctrlAtt.size())
+        return *it;
+
+    QVector<SAttributeBinding> bindings(ctrlAtt.size());
+    for (int attIdx = 0; attIdx < ctrlAtt.size(); ++attIdx) {
+        const qt3ds::runtime::DataInOutAttribute &ctrlElem = ctrlAtt[attIdx];
+        TElement *element = getTarget(ctrlElem.elementPath.constData());
+        if (!element) {
+            qCWarning(qt3ds::INVALID_OPERATION)
+                    << "CQmlEngineImpl::SetDataInputValue: Unable to find element"
+                    << ctrlElem.elementPath << "controlled by datainput" << name;
+            continue;
+        }
+
+        EAttributeType valueType = ATTRIBUTETYPE_FLOAT;
+        switch (ctrlElem.propertyType) {
+        case ATTRIBUTETYPE_FLOAT:
+        case ATTRIBUTETYPE_FLOAT2:
+        case ATTRIBUTETYPE_FLOAT3:
+        case ATTRIBUTETYPE_FLOAT4:
+            break;
+        case ATTRIBUTETYPE_BOOL:
+            valueType = ATTRIBUTETYPE_BOOL;
+            break;
+        default:
+            valueType = ATTRIBUTETYPE_NONE;
+            break;
+        }
+        bindAttribute(bindings[attIdx], element, ctrlElem.attributeName, valueType);
+    }
+    m_dataInputBindings.insert(name, bindings);
+    return bindings;
+}
+
+// Resolves the element and attribute components of an attribute handle. Vector and color
+// attributes are expanded to their scalar components, as the runtime only has those.
+// A handle whose element does not exist yet stays unresolved and is tried again on the next write.
+void CQmlEngineImpl::resolveAttributeHandle(QT3DSI32 handle, SAttributeHandle &attributeHandle)
+{
+    TElement *element = getTarget(attributeHandle.m_ElementPath.constData());
+    if (!element) {
+        if (!attributeHandle.m_Warned) {
+            qCWarning(qt3ds::INVALID_OPERATION)
+                    << "CQmlEngineImpl::SetAttributeHandleValues: Unable to find element"
+                    << attributeHandle.m_ElementPath << "of attribute handle" << handle;
+            attributeHandle.m_Warned = true;
+        }
+        return;
+    }
+    attributeHandle.m_Resolved = true;
+
+    static const char *componentSuffixes[] = { ".x.y.z.w", ".r.g.b.a", ".u.v" };
+    const QByteArray &attName = attributeHandle.m_AttributeName;
+    QVector<QByteArray> attNames;
+    for (const char *suffixes : componentSuffixes) {
+        for (const char *suffix = suffixes; *suffix; suffix += 2) {
+            const QByteArray componentName = attName + QByteArray(suffix, 2);
+            if (element->FindProperty(CHash::HashAttribute(componentName.constData())).isEmpty())
+                break;
+            attNames.append(componentName);
+        }
+        if (!attNames.isEmpty())
+            break;
+    }
+    if (attNames.isEmpty())
+        attNames.append(attName);
+
+    // Only float components can be written through a handle
+    for (const QByteArray &componentName : qAsConst(attNames)) {
+        Option<qt3ds::runtime::element::TPropertyDescAndValuePtr> property
+                = element->FindProperty(CHash::HashAttribute(componentName.constData()));
+        if (property.hasValue() && property->first.type() != ATTRIBUTETYPE_FLOAT) {
+            qCWarning(qt3ds::INVALID_OPERATION)
+                    << "CQmlEngineImpl::SetAttributeHandleValues: Attribute"
+                    << componentName << "of element" << attributeHandle.m_ElementPath
+                    << "is not a float attribute";
+            return;
+        }
+    }
+    bindAttribute(attributeHandle.m_Binding, element, attNames, ATTRIBUTETYPE_FLOAT);
+}
+
 void CQmlEngineImpl::listAllElements(TElement *root, QList<TElement *> &elements)
 {
     elements.append(root);
@@ -2160,6 +2407,8 @@ void CQmlEngineImpl::initializeDataInputsInPresentation(CPresentation &presentat
     if (!m_Application)
         return;
 
+    invalidateAttributeBindings();
+
     QList<TElement *> elements;
     if (!inElements.empty()) {
         elements = inElements;
@@ -2174,7 +2423,7 @@ void CQmlEngineImpl::initializeDataInputsInPresentation(CPresentation &presentat
 // #TODO: Remove above once QT3DS-3510 has been implemented in the editor
 
     qt3ds::foundation::IStringTable &strTable(presentation.GetStringTable());
-    QHash<CRegisteredString, qt3ds::runtime::DataOutputDef> elementPathToDataOutputDefMap;
+    QHash<TElement *, qt3ds::runtime::DataOutputDef> elementToDataOutputDefMap;
     for (TElement *element : qAsConst(elements)) {
         Option<QT3DSU32> ctrlIndex = element->FindPropertyIndex(ATTRIBUTE_CONTROLLEDPROPERTY);
         if (ctrlIndex.hasValue()) {
@@ -2314,9 +2563,7 @@ void CQmlEngineImpl::initializeDataInputsInPresentation(CPresentation &presentat
                                 // No need to process
                             } else {
                                 // Other than slide or timeline are handled by CPresentation
-                                CRegisteredString rString = strTable.RegisterStr(
-                                            ctrlElem.elementPath);
-                                elementPathToDataOutputDefMap.insertMulti(rString, doDef);
+                                elementToDataOutputDefMap.insertMulti(element, doDef);
                             }
                         }
 // #TODO: Remove above once QT3DS-3510 has been implemented in the editor
@@ -2328,7 +2575,7 @@ void CQmlEngineImpl::initializeDataInputsInPresentation(CPresentation &presentat
 
 // #TODO: Remove below once QT3DS-3510 has been implemented in the editor
     if (!isDynamicAdd)
-        presentation.AddToDataOutputMap(elementPathToDataOutputDefMap);
+        presentation.AddToDataOutputMap(elementToDataOutputDefMap);
 // #TODO: Remove above once QT3DS-3510 has been implemented in the editor
 }
 
@@ -2344,7 +2591,7 @@ void CQmlEngineImpl::initializeDataOutputsInPresentation(CPresentation &presenta
     qt3ds::runtime::DataOutputMap &doMap = m_Application->dataOutputMap();
 
     qt3ds::foundation::IStringTable &strTable(presentation.GetStringTable());
-    QHash<CRegisteredString, qt3ds::runtime::DataOutputDef> elementPathToDataOutputDefMap;
+    QHash<TElement *, qt3ds::runtime::DataOutputDef> elementToDataOutputDefMap;
     for (TElement *element : qAsConst(elements)) {
         Option<QT3DSU32> ctrlIndex = element->FindPropertyIndex(ATTRIBUTE_OBSERVEDPROPERTY);
         if (ctrlIndex.hasValue()) {
@@ -2415,8 +2662,7 @@ void CQmlEngineImpl::initializeDataOutputsInPresentation(CPresentation &presenta
                         }
 
                         doDef.observedAttribute = obsElem;
-                        CRegisteredString rString = strTable.RegisterStr(obsElem.elementPath);
-                        elementPathToDataOutputDefMap.insertMulti(rString, doDef);
+                        elementToDataOutputDefMap.insertMulti(element, doDef);
                     }
                 }
             }
@@ -2424,7 +2670,7 @@ void CQmlEngineImpl::initializeDataOutputsInPresentation(CPresentation &presenta
     }
 
     // Inform the presentation of the ready data output defs
-    presentation.AddToDataOutputMap(elementPathToDataOutputDefMap);
+    presentation.AddToDataOutputMap(elementToDataOutputDefMap);
 }
 
 // Remove datainput control from listed elements and update internal control map. Should be used
@@ -2451,6 +2697,7 @@ void CQmlEngineImpl::removeDataInputControl(const QVector<TElement *> &inElement
 
     for (const auto &attr : qAsConst(elemAttrsToRemove))
         m_Application->dataInputMap()[attr.first].controlledAttributes.removeAll(attr.second);
+    invalidateAttributeBindings();
 }
 
 // Bit clumsy way of getting from "position" to "position .x .y .z" and enabling datainput
@@ -2674,6 +2921,9 @@ void CQmlEngineImpl::notifyMaterialCreation(const QStringList &materialNames, co
 void CQmlEngineImpl::deleteElements(const QVector<TElement *> &elements,
                                     IQt3DSRenderer *renderer)
 {
+    // Bindings may point to the deleted elements or their descendants
+    invalidateAttributeBindings();
+
     TElement *lastParent = nullptr;
     IPresentation *presentation = nullptr;
     TElement *component = nullptr;
@@ -2719,6 +2969,8 @@ void CQmlEngineImpl::deleteElements(const QVector<TElement *> &elements,
                     auto image = static_cast<qt3ds::render::SImage *>(&translator->RenderObject());
                     if (image->m_LoadedTextureData)
                         image->m_LoadedTextureData->m_callbacks.removeOne(image);
+                } else if (type == qt3ds::render::GraphObjectTypes::DefaultMaterial) {
+                    renderer->ReleaseMaterialRenderResources(translator->RenderObject());
                 }
                 QT3DS_FREE(allocator, &translator->RenderObject());
                 QT3DS_FREE(allocator, translator);
@@ -2745,6 +2997,8 @@ void CQmlEngineImpl::deleteElements(const QVector<TElement *> &elements,
             deleteRenderObjects(element);
         }
 
+        static_cast<CPresentation *>(presentation)->RemoveDataOutputObservers(*element);
+
         // Remove element recursively
         m_Application->GetElementAllocator().ReleaseElement(*element, true);
     }
@@ -184,6 +184,33 @@ public: // Public functions but not functions on the script bridge
     virtual bool GetAttribute(const char *element, const char *attName, char *value) = 0;
     virtual bool GetAttribute(TElement *target, const char *attName, char *value) = 0;
 
+    /**
+    * @brief Register a handle for writing an attribute without path or name lookups
+    *
+    * @param[in] handle		    Handle id, chosen by the caller
+    * @param[in] element		Element Name
+    * @param[in] attName		Attribute name, vector and color attributes are expanded
+    *                           to their components
+    *
+    * @return none
+    */
+    virtual void RegisterAttributeHandle(QT3DSI32 handle, const char *element,
+                                         const char *attName) = 0;
+    virtual void ReleaseAttributeHandle(QT3DSI32 handle) = 0;
+
+    /**
+    * @brief Write float values through attribute handles
+    *
+    * @param[in] handles		Handles registered with RegisterAttributeHandle
+    * @param[in] values		    Four floats per handle, only the components of the
+    *                           attribute are used
+    * @param[in] count		    Number of handles
+    *
+    * @return none
+    */
+    virtual void SetAttributeHandleValues(const QT3DSI32 *handles, const float *values,
+                                          int count) = 0;
+
     /**
     * @brief Register a callback
     *
@@ -90,6 +90,8 @@ public:
 
     // threadsafe
     // returns a handle to the loaded object. Return value of zero means error.
+    // Only the header is validated unless QT3DS_VERIFY_BINARY_SCENES is set, which verifies the
+    // checksum of the whole data section too.
     virtual qt3ds::QT3DSU32 LoadSceneStage1(qt3ds::foundation::CRegisteredString inPresentationDirectory,
                                       qt3ds::render::ILoadedBuffer &inData) = 0;
 
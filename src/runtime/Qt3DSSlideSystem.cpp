@@ -713,6 +713,29 @@ struct SSlideSystem : public ISlideSystem
         }
         return false;
     }
+
+    void GetComponents(nvvector<SElement *> &outComponents) const override
+    {
+        for (TComponentSlideHash::const_iterator iter = m_Slides.begin(), end = m_Slides.end();
+             iter != end; ++iter) {
+            outComponents.push_back(iter->first);
+        }
+    }
+
+    bool GetSlideElementActivity(SSlideKey inKey,
+                                 nvvector<eastl::pair<SElement *, bool>> &outElements) const override
+    {
+        const SSlide *theSlide = FindSlide(inKey);
+        if (!theSlide)
+            return false;
+        for (const SSlideElement *theElement = theSlide->m_FirstElement; theElement;
+             theElement = theElement->m_NextElement) {
+            SElement *theElem = m_ElementSystem.FindElementByHandle(theElement->m_ElementHandle);
+            if (theElem)
+                outElements.push_back(eastl::make_pair(theElem, bool(theElement->m_Active)));
+        }
+        return true;
+    }
 };
 }
 
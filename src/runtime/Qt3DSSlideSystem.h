@@ -31,6 +31,7 @@
 #pragma once
 
 #include "Qt3DSElementSystem.h"
+#include "foundation/Qt3DSContainers.h"
 
 namespace Q3DStudio {
 class ILogicManager;
@@ -159,6 +160,13 @@ namespace runtime {
         virtual bool isElementInSlide(const element::SElement &element,
                                       element::SElement &component,
                                       int slideIndex) const = 0;
+        // Components that own slides, including the scene.
+        virtual void GetComponents(nvvector<element::SElement *> &outComponents) const = 0;
+        // Elements listed by the slide together with the explicit activity the slide gives
+        // them. Returns false if there is no such slide.
+        virtual bool GetSlideElementActivity(
+                SSlideKey inKey,
+                nvvector<eastl::pair<element::SElement *, bool>> &outElements) const = 0;
 
         static ISlideSystem &CreateSlideSystem(NVFoundationBase &inFnd, IStringTable &inStrTable,
                                                IElementAllocator &inElemAllocator);
@@ -228,6 +228,17 @@ struct SOffscreenRenderManager : public IOffscreenRenderManager
         m_Renderers.erase(inKey);
     }
 
+    bool IsUpdateRequested() override
+    {
+        for (TRendererMap::iterator theIter = m_Renderers.begin(), theEnd = m_Renderers.end();
+             theIter != theEnd; ++theIter) {
+            SRendererData &theData = *theIter->second.mPtr;
+            if (theData.m_Renderer && theData.m_Renderer->IsUpdateRequested())
+                return true;
+        }
+        return false;
+    }
+
     void RenderItem(SRendererData &theData, SOffscreenRendererEnvironment theDesiredEnvironment)
     {
         NVRenderContext &theContext = m_ResourceManager->GetRenderContext();
@@ -187,6 +187,11 @@ namespace render {
         // else we will assume you did not and will continue the picking algorithm.
         virtual bool Pick(const QT3DSVec2 &inMouseCoords, const QT3DSVec2 &inViewportDimensions,
                           const SRenderInstanceId instanceId) = 0;
+
+        // Returns true if the renderer has new content that does not come from a presentation
+        // change, so a frame cannot be skipped in render on demand mode. Unlike NeedsRender this
+        // is called outside of rendering and must not have side effects.
+        virtual bool IsUpdateRequested() { return false; }
     };
 
     struct SOffscreenRenderResult
@@ -242,6 +247,9 @@ namespace render {
         // Thus rendering is deffered until the graph is run but we promise to render to this
         // resource.
         virtual SOffscreenRenderResult GetRenderedItem(const SOffscreenRendererKey &inKey) = 0;
+        // True if any registered renderer requests an update, see
+        // IOffscreenRenderer::IsUpdateRequested.
+        virtual bool IsUpdateRequested() = 0;
         // Called by the UICRenderContext, clients don't need to call this.
         virtual void BeginFrame() = 0;
         virtual void EndFrame() = 0;
@@ -87,6 +87,7 @@ namespace render {
             Q_UNUSED(instanceId);
             return false;
         }
+        bool IsUpdateRequested() override { return true; }
         void addCallback(IOffscreenRendererCallback *cb) override
         {
 
@@ -53,6 +53,7 @@
 #include <QGuiApplication>
 #include <QtMath>
 #include <QRawFont>
+#include <QMutex>
 
 using namespace qt3ds::render;
 
@@ -113,6 +114,8 @@ struct Qt3DSQtTextRenderer : public ITextRenderer
     nvvector<SRendererFontEntry> m_installedFonts;
 
     Sync m_PreloadSync;
+    // Guards the font info hashes, which are also read by text rasterized on worker threads.
+    QMutex m_fontMutex;
 
     TStringSet m_systemFontDirs;
     TStringSet m_projectFontDirs;
@@ -172,6 +175,7 @@ struct Qt3DSQtTextRenderer : public ITextRenderer
 
     void unregisterProjectFonts()
     {
+        QMutexLocker locker(&m_fontMutex);
         for (FontInfo &fi : m_projectFontInfos.values())
             QFontDatabase::removeApplicationFont(fi.fontId);
         m_projectFontsInitialized = false;
@@ -291,6 +295,7 @@ struct Qt3DSQtTextRenderer : public ITextRenderer
 
     void PreloadFonts() override
     {
+        QMutexLocker locker(&m_fontMutex);
         if (!m_systemFontsInitialized) {
             m_systemFontsInitialized = true;
             registerFonts(m_systemFontDirs, &m_systemFontInfos);
@@ -381,7 +386,6 @@ struct Qt3DSQtTextRenderer : public ITextRenderer
 
     FontInfo &fontInfoForName(const CRegisteredString &fontName)
     {
-        PreloadFonts();
         QString qtFontName = stringToQString(fontName);
         if (m_projectFontInfos.contains(qtFontName))
             return m_projectFontInfos[qtFontName];
@@ -396,12 +400,17 @@ struct Qt3DSQtTextRenderer : public ITextRenderer
         return m_systemFontInfos[qtFontName];
     }
 
-    void updateFontInfo(FontInfo &fi, const STextRenderInfo &inText,
-                        QT3DSF32 inTextScaleFactor = 1.0f)
+    // Returns a copy of the font so that the shared font infos are never modified while
+    // another thread is rasterizing text with them.
+    QFont fontForText(const STextRenderInfo &inText, QT3DSF32 inTextScaleFactor = 1.0f)
     {
+        PreloadFonts();
+        QMutexLocker locker(&m_fontMutex);
+        QFont font(fontInfoForName(inText.m_Font).font);
         qreal pixelSize = inText.m_FontSize;
-        fi.font.setPixelSize(pixelSize * inTextScaleFactor);
-        fi.font.setLetterSpacing(QFont::AbsoluteSpacing, qreal(inText.m_Tracking));
+        font.setPixelSize(pixelSize * inTextScaleFactor);
+        font.setLetterSpacing(QFont::AbsoluteSpacing, qreal(inText.m_Tracking));
+        return font;
     }
 
     QStringList splitText(const char8_t *theText)
@@ -468,9 +477,7 @@ struct Qt3DSQtTextRenderer : public ITextRenderer
     STextDimensions MeasureText(const STextRenderInfo &inText, QT3DSF32 inTextScaleFactor,
                                 const char8_t *inTextOverride) override
     {
-        FontInfo &fi = fontInfoForName(inText.m_Font);
-        updateFontInfo(fi, inText, inTextScaleFactor);
-        QFontMetricsF fm(fi.font);
+        QFontMetricsF fm(fontForText(inText, inTextScaleFactor));
         QStringList dummyList;
         QVector<qreal> dummyWidth;
         QRectF boundingBox = textBoundingBox(inText, fm, dummyList, dummyWidth, inTextOverride);
@@ -497,9 +504,17 @@ struct Qt3DSQtTextRenderer : public ITextRenderer
     STextTextureDetails RenderText(const STextRenderInfo &inSrcText,
                                    NVRenderTexture2D &inTexture) override
     {
-        FontInfo &fi = fontInfoForName(inSrcText.m_Font);
-        updateFontInfo(fi, inSrcText);
-        QFontMetricsF fm(fi.font);
+        STextRaster theRaster;
+        RasterizeText(inSrcText, theRaster);
+        return ITextRenderer::UploadRaster(theRaster, inTexture);
+    }
+
+    bool SupportsRasterizeText() const override { return true; }
+
+    void RasterizeText(const STextRenderInfo &inSrcText, STextRaster &outRaster) override
+    {
+        const QFont font(fontForText(inSrcText));
+        QFontMetricsF fm(font);
         int horizontalAlignmentFlag = Qt::AlignLeft;
 
         int shadowRgb = int(2.55f * (100 - int(inSrcText.m_DropShadowStrength)));
@@ -517,19 +532,21 @@ struct Qt3DSQtTextRenderer : public ITextRenderer
         }
 
         if (boundingBox.width() <= 0 || boundingBox.height() <= 0) {
-            return ITextRenderer::UploadData(toU8DataRef((char *)nullptr, 0), inTexture, 4, 4,
-                                             0, 0,
-                                             NVRenderTextureFormats::RGBA8, true);
+            outRaster = STextRaster();
+            return;
         }
 
         int finalWidth = NextMultipleOf4(boundingBox.width());
         int finalHeight = NextMultipleOf4(boundingBox.height());
 
-        QImage image(finalWidth, finalHeight, QImage::Format_ARGB32);
+        outRaster.m_Image = QImage(finalWidth, finalHeight, QImage::Format_ARGB32);
+        outRaster.m_TextWidth = finalWidth;
+        outRaster.m_TextHeight = finalHeight;
+        QImage &image(outRaster.m_Image);
         image.fill(0);
         QPainter painter(&image);
         painter.setPen(Qt::white);
-        painter.setFont(fi.font);
+        painter.setFont(font);
 
         // Translate painter to remove the extra spacing of the last letter
         qreal tracking = 0.0;
@@ -600,11 +617,6 @@ struct Qt3DSQtTextRenderer : public ITextRenderer
 
             nextHeight += QT3DSF32(lineHeight) + inSrcText.m_Leading;
         }
-
-        return ITextRenderer::UploadData(toU8DataRef(image.bits(), image.byteCount()), inTexture,
-                                         image.width(), image.height(),
-                                         image.width(), image.height(),
-                                         NVRenderTextureFormats::RGBA8, true);
     }
 
     STextTextureDetails RenderText(const STextRenderInfo &inText,
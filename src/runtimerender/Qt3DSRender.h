@@ -208,6 +208,7 @@ namespace render {
     struct SShaderVertexCodeGenerator;
     struct SShaderFragmentCodeGenerator;
     class IThreadPool;
+    class IJobSystem;
     struct SRenderMesh;
     struct SLoadedTexture;
     class IImageBatchLoader;
@@ -29,6 +29,14 @@
 ****************************************************************************/
 #include "Qt3DSRenderClippingFrustum.h"
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define QT3DS_CLIPPING_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define QT3DS_CLIPPING_NEON
+#endif
+
 using namespace qt3ds::render;
 
 SClippingFrustum::SClippingFrustum(const QT3DSMat44 &modelviewprojection, SClipPlane nearPlane)
@@ -83,3 +91,102 @@ SClippingFrustum::SClippingFrustum(const QT3DSMat44 &modelviewprojection, SClipP
         _cullingPlanes[idx].calculateBBoxEdges();
     }
 }
+
+void SClippingFrustum::intersect4(const NVBounds3 *const inBounds[4], QT3DSU32 &outOutside,
+                                  QT3DSU32 &outInside) const
+{
+    // Boxes in structure of arrays layout, one lane per box.
+    QT3DSF32 theMin[3][4];
+    QT3DSF32 theMax[3][4];
+    for (QT3DSU32 box = 0; box < 4; ++box) {
+        for (QT3DSU32 axis = 0; axis < 3; ++axis) {
+            theMin[axis][box] = inBounds[box]->minimum[axis];
+            theMax[axis][box] = inBounds[box]->maximum[axis];
+        }
+    }
+
+#if defined(QT3DS_CLIPPING_SSE)
+    const __m128 theZero = _mm_setzero_ps();
+    __m128 theOutside = _mm_setzero_ps();
+    __m128 theInside = _mm_cmpeq_ps(theZero, theZero);
+#elif defined(QT3DS_CLIPPING_NEON)
+    uint32x4_t theOutside = vdupq_n_u32(0);
+    uint32x4_t theInside = vdupq_n_u32(~0u);
+#else
+    QT3DSU32 theOutside = 0;
+    QT3DSU32 theInside = 0xf;
+#endif
+    for (QT3DSU32 idx = 0; idx < 6; ++idx) {
+        const SClipPlane &thePlane(mPlanes[idx]);
+        // The nearest and furthest corners only depend on the plane, the same for every lane.
+        const QT3DSF32 *theUpper[3];
+        const QT3DSF32 *theLower[3];
+        for (QT3DSU32 axis = 0; axis < 3; ++axis) {
+            QT3DSU8 theUpperEdge = static_cast<QT3DSU8>(thePlane.mEdges.upperEdge);
+            bool upperIsMax = (theUpperEdge & (1 << axis)) != 0;
+            theUpper[axis] = upperIsMax ? theMax[axis] : theMin[axis];
+            theLower[axis] = upperIsMax ? theMin[axis] : theMax[axis];
+        }
+#if defined(QT3DS_CLIPPING_SSE)
+        const __m128 nx = _mm_set1_ps(thePlane.normal.x);
+        const __m128 ny = _mm_set1_ps(thePlane.normal.y);
+        const __m128 nz = _mm_set1_ps(thePlane.normal.z);
+        const __m128 d = _mm_set1_ps(thePlane.d);
+        __m128 theUpperDist = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(nx, _mm_loadu_ps(theUpper[0])),
+                       _mm_mul_ps(ny, _mm_loadu_ps(theUpper[1]))),
+            _mm_add_ps(_mm_mul_ps(nz, _mm_loadu_ps(theUpper[2])), d));
+        __m128 theLowerDist = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(nx, _mm_loadu_ps(theLower[0])),
+                       _mm_mul_ps(ny, _mm_loadu_ps(theLower[1]))),
+            _mm_add_ps(_mm_mul_ps(nz, _mm_loadu_ps(theLower[2])), d));
+        theOutside = _mm_or_ps(theOutside, _mm_cmplt_ps(theUpperDist, theZero));
+        theInside = _mm_and_ps(theInside, _mm_cmpgt_ps(theLowerDist, theZero));
+#elif defined(QT3DS_CLIPPING_NEON)
+        float32x4_t theUpperDist = vdupq_n_f32(thePlane.d);
+        theUpperDist = vmlaq_n_f32(theUpperDist, vld1q_f32(theUpper[0]), thePlane.normal.x);
+        theUpperDist = vmlaq_n_f32(theUpperDist, vld1q_f32(theUpper[1]), thePlane.normal.y);
+        theUpperDist = vmlaq_n_f32(theUpperDist, vld1q_f32(theUpper[2]), thePlane.normal.z);
+        float32x4_t theLowerDist = vdupq_n_f32(thePlane.d);
+        theLowerDist = vmlaq_n_f32(theLowerDist, vld1q_f32(theLower[0]), thePlane.normal.x);
+        theLowerDist = vmlaq_n_f32(theLowerDist, vld1q_f32(theLower[1]), thePlane.normal.y);
+        theLowerDist = vmlaq_n_f32(theLowerDist, vld1q_f32(theLower[2]), thePlane.normal.z);
+        theOutside = vorrq_u32(theOutside, vcltq_f32(theUpperDist, vdupq_n_f32(0.0f)));
+        theInside = vandq_u32(theInside, vcgtq_f32(theLowerDist, vdupq_n_f32(0.0f)));
+#else
+        for (QT3DSU32 box = 0; box < 4; ++box) {
+            QT3DSF32 theUpperDist = thePlane.normal.x * theUpper[0][box]
+                + thePlane.normal.y * theUpper[1][box] + thePlane.normal.z * theUpper[2][box]
+                + thePlane.d;
+            QT3DSF32 theLowerDist = thePlane.normal.x * theLower[0][box]
+                + thePlane.normal.y * theLower[1][box] + thePlane.normal.z * theLower[2][box]
+                + thePlane.d;
+            if (theUpperDist < 0.0f)
+                theOutside |= 1 << box;
+            if (!(theLowerDist > 0.0f))
+                theInside &= ~(1 << box);
+        }
+#endif
+    }
+
+#if defined(QT3DS_CLIPPING_SSE)
+    outOutside = QT3DSU32(_mm_movemask_ps(theOutside));
+    outInside = QT3DSU32(_mm_movemask_ps(theInside));
+#elif defined(QT3DS_CLIPPING_NEON)
+    QT3DSU32 theOutsideLanes[4];
+    QT3DSU32 theInsideLanes[4];
+    vst1q_u32(theOutsideLanes, theOutside);
+    vst1q_u32(theInsideLanes, theInside);
+    outOutside = 0;
+    outInside = 0;
+    for (QT3DSU32 box = 0; box < 4; ++box) {
+        outOutside |= (theOutsideLanes[box] & 1) << box;
+        outInside |= (theInsideLanes[box] & 1) << box;
+    }
+#else
+    outOutside = theOutside;
+    outInside = theInside;
+#endif
+    // A box outside of one plane is not inside the frustum.
+    outInside &= ~outOutside;
+}
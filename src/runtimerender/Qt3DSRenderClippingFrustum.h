@@ -154,6 +154,12 @@ namespace render {
                     return false;
             return true;
         }
+
+        // Classifies four boxes against all planes at once. Bit i of outOutside is set when
+        // inBounds[i] is completely outside of the frustum and bit i of outInside when it is
+        // completely inside of it. Boxes crossing a plane set neither bit.
+        void intersect4(const NVBounds3 *const inBounds[4], QT3DSU32 &outOutside,
+                        QT3DSU32 &outInside) const;
     };
 }
 }
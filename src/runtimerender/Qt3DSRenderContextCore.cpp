@@ -49,6 +49,7 @@
 #include "Qt3DSRenderCamera.h"
 #include "foundation/Qt3DSContainers.h"
 #include "Qt3DSRenderThreadPool.h"
+#include "Qt3DSRenderJobSystem.h"
 #include "Qt3DSRenderImageBatchLoader.h"
 #include "Qt3DSRenderTextTextureCache.h"
 #include "Qt3DSRenderTextTextureAtlas.h"
@@ -58,8 +59,7 @@
 #include "Qt3DSRenderPixelGraphicsRenderer.h"
 #include "foundation/Qt3DSPerfTimer.h"
 #include "Qt3DSRenderBufferLoader.h"
-#include "foundation/FastAllocator.h"
-#include "foundation/AutoDeallocatorAllocator.h"
+#include "Qt3DSRenderPerFrameAllocator.h"
 #include "Qt3DSRenderRenderList.h"
 #include "Qt3DSRenderPathManager.h"
 #include "Qt3DSRenderShaderCodeGeneratorV2.h"
@@ -77,6 +77,7 @@ struct SRenderContextCore : public IQt3DSRenderContextCore
     NVScopedRefCounted<IStringTable> m_StringTable;
     NVScopedRefCounted<IPerfTimer> m_PerfTimer;
     NVScopedRefCounted<IInputStreamFactory> m_InputStreamFactory;
+    NVScopedRefCounted<IJobSystem> m_JobSystem;
     NVScopedRefCounted<IThreadPool> m_ThreadPool;
     NVScopedRefCounted<IDynamicObjectSystemCore> m_DynamicObjectSystem;
     NVScopedRefCounted<ICustomMaterialSystemCore> m_MaterialSystem;
@@ -94,7 +95,8 @@ struct SRenderContextCore : public IQt3DSRenderContextCore
         , m_StringTable(strTable)
         , m_PerfTimer(IPerfTimer::CreatePerfTimer(fnd))
         , m_InputStreamFactory(IInputStreamFactory::Create(fnd))
-        , m_ThreadPool(IThreadPool::CreateThreadPool(fnd, 4))
+        , m_JobSystem(IJobSystem::CreateJobSystem(fnd))
+        , m_ThreadPool(IThreadPool::CreateThreadPool(fnd, *m_JobSystem))
         , mRefCount(0)
     {
         m_DynamicObjectSystem = IDynamicObjectSystemCore::CreateDynamicSystemCore(*this);
@@ -115,6 +117,7 @@ struct SRenderContextCore : public IQt3DSRenderContextCore
     NVAllocatorCallback &GetAllocator() override { return m_Foundation.getAllocator(); }
     IInputStreamFactory &GetInputStreamFactory() override { return *m_InputStreamFactory; }
     IThreadPool &GetThreadPool() override { return *m_ThreadPool; }
+    IJobSystem &GetJobSystem() override { return *m_JobSystem; }
     IDynamicObjectSystemCore &GetDynamicObjectSystemCore() override
     {
         return *m_DynamicObjectSystem;
@@ -151,64 +154,6 @@ inline float Clamp(float val, float inMin = 0.0f, float inMax = 1.0f)
     return val;
 }
 
-struct SPerFrameAllocator : public NVAllocatorCallback
-{
-    SFastAllocator<> m_FastAllocator;
-    SSAutoDeallocatorAllocator m_LargeAllocator;
-
-    SPerFrameAllocator(NVAllocatorCallback &baseAllocator)
-        : m_FastAllocator(baseAllocator, "PerFrameAllocation")
-        , m_LargeAllocator(baseAllocator)
-    {
-    }
-
-    inline void *allocate(size_t inSize, const char *inFile, int inLine)
-    {
-        if (inSize < 8192)
-            return m_FastAllocator.allocate(inSize, "PerFrameAllocation", inFile, inLine, 0);
-        else
-            return m_LargeAllocator.allocate(inSize, "PerFrameAllocation", inFile, inLine, 0);
-    }
-
-    inline void *allocate(size_t inSize, const char *inFile, int inLine, int, int)
-    {
-        if (inSize < 8192)
-            return m_FastAllocator.allocate(inSize, "PerFrameAllocation", inFile, inLine, 0);
-        else
-            return m_LargeAllocator.allocate(inSize, "PerFrameAllocation", inFile, inLine, 0);
-    }
-
-    inline void deallocate(void *, size_t) {}
-
-    void reset()
-    {
-        m_FastAllocator.reset();
-        m_LargeAllocator.deallocateAllAllocations();
-    }
-
-    void *allocate(size_t inSize, const char *typeName, const char *inFile, int inLine,
-                           int flags = 0) override
-    {
-        if (inSize < SFastAllocator<>::SlabSize)
-            return m_FastAllocator.allocate(inSize, typeName, inFile, inLine, flags);
-        else
-            return m_LargeAllocator.allocate(inSize, typeName, inFile, inLine, flags);
-    }
-
-    void *allocate(size_t inSize, const char *typeName, const char *inFile, int inLine,
-                           size_t alignment, size_t alignmentOffset) override
-    {
-        if (inSize < SFastAllocator<>::SlabSize)
-            return m_FastAllocator.allocate(inSize, typeName, inFile, inLine, alignment,
-                                            alignmentOffset);
-        else
-            return m_LargeAllocator.allocate(inSize, typeName, inFile, inLine, alignment,
-                                             alignmentOffset);
-    }
-
-    void deallocate(void *) override {}
-};
-
 struct SRenderContext : public IQt3DSRenderContext
 {
     NVScopedRefCounted<NVRenderContext> m_RenderContext;
@@ -249,6 +194,9 @@ struct SRenderContext : public IQt3DSRenderContext
     double m_StereoEyeSeparation;
     bool m_StereoProgressiveEnabled;
     int m_SkipFramesInterval;
+    bool m_RenderOnDemand;
+    bool m_ForceRenderOnDemand;
+    QT3DSU32 m_ViewSettingsRevision;
     bool m_WireframeMode;
     bool m_subPresentationRenderInLayer;
     Option<QT3DSVec4> m_SceneColor;
@@ -277,7 +225,8 @@ struct SRenderContext : public IQt3DSRenderContext
         , m_PerfTimer(inCore.GetPerfTimer())
         , m_InputStreamFactory(inCore.GetInputStreamFactory())
         , m_BufferManager(
-              IBufferManager::Create(ctx, *m_StringTable, *m_InputStreamFactory, *m_PerfTimer))
+              IBufferManager::Create(ctx, *m_StringTable, *m_InputStreamFactory, *m_PerfTimer,
+                                     &inCore.GetJobSystem()))
         , m_ResourceManager(IResourceManager::CreateResourceManager(ctx))
         , m_ShaderCache(IShaderCache::CreateShaderCache(ctx, *m_InputStreamFactory, *m_PerfTimer))
         , m_ThreadPool(inCore.GetThreadPool())
@@ -292,6 +241,9 @@ struct SRenderContext : public IQt3DSRenderContext
         , m_StereoEyeSeparation(0.4)
         , m_StereoProgressiveEnabled(false)
         , m_SkipFramesInterval(0)
+        , m_RenderOnDemand(false)
+        , m_ForceRenderOnDemand(qEnvironmentVariableIntValue("QT3DS_RENDER_ON_DEMAND") != 0)
+        , m_ViewSettingsRevision(0)
         , m_WireframeMode(false)
         , m_subPresentationRenderInLayer(false)
         , m_matteEnabled(false)
@@ -326,7 +278,8 @@ struct SRenderContext : public IQt3DSRenderContext
         if (theTextCore) {
             m_TextRenderer = theTextCore->GetTextRenderer(ctx);
             m_TextTextureCache = ITextTextureCache::CreateTextureCache(
-                m_RenderContext->GetFoundation(), *m_TextRenderer, *m_RenderContext);
+                m_RenderContext->GetFoundation(), *m_TextRenderer, *m_RenderContext,
+                &inCore.GetJobSystem());
         }
 
 #if QT_VERSION >= QT_VERSION_CHECK(5,12,2)
@@ -376,6 +329,7 @@ struct SRenderContext : public IQt3DSRenderContext
     IEffectSystem &GetEffectSystem() override { return *m_EffectSystem; }
     IShaderCache &GetShaderCache() override { return *m_ShaderCache; }
     IThreadPool &GetThreadPool() override { return *m_ThreadPool; }
+    IJobSystem &GetJobSystem() override { return m_CoreContext->GetJobSystem(); }
     IImageBatchLoader &GetImageBatchLoader() override { return *m_ImageBatchLoader; }
     ITextTextureCache *GetTextureCache() override { return m_TextTextureCache.mPtr; }
     ITextTextureAtlas *GetTextureAtlas() override { return m_TextTextureAtlas.mPtr; }
@@ -436,20 +390,33 @@ struct SRenderContext : public IQt3DSRenderContext
     ITextRenderer *GetOnscreenTextRenderer() override { return m_OnscreenTextRenderer; }
 
     void SetSceneColor(Option<QT3DSVec4> inSceneColor) override { m_SceneColor = inSceneColor; }
-    void SetMatteColor(Option<QT3DSVec4> inMatteColor) override { m_MatteColor = inMatteColor; }
+    void SetMatteColor(Option<QT3DSVec4> inMatteColor) override
+    {
+        m_MatteColor = inMatteColor;
+        ++m_ViewSettingsRevision;
+    }
     void setMatteEnabled(bool enable) override
     {
+        if (m_matteEnabled != enable)
+            ++m_ViewSettingsRevision;
         m_matteEnabled = enable;
     }
 
     void SetWindowDimensions(const QSize &inWindowDimensions) override
     {
+        if (m_WindowDimensions != inWindowDimensions)
+            ++m_ViewSettingsRevision;
         m_WindowDimensions = inWindowDimensions;
     }
 
     QSize GetWindowDimensions() override { return m_WindowDimensions; }
 
-    void SetScaleMode(ScaleModes::Enum inMode) override { m_ScaleMode = inMode; }
+    void SetScaleMode(ScaleModes::Enum inMode) override
+    {
+        if (m_ScaleMode != inMode)
+            ++m_ViewSettingsRevision;
+        m_ScaleMode = inMode;
+    }
 
     ScaleModes::Enum GetScaleMode() override { return m_ScaleMode; }
 
@@ -458,6 +425,8 @@ struct SRenderContext : public IQt3DSRenderContext
     }
 
     void SetStereoMode(StereoModes::Enum inMode) override {
+        if (m_StereoMode != inMode)
+            ++m_ViewSettingsRevision;
         m_StereoMode = inMode;
     }
 
@@ -472,6 +441,8 @@ struct SRenderContext : public IQt3DSRenderContext
 
     void SetStereoEyeSeparation(double separation) override
     {
+        if (m_StereoEyeSeparation != separation)
+            ++m_ViewSettingsRevision;
         m_StereoEyeSeparation = separation;
     }
 
@@ -479,6 +450,8 @@ struct SRenderContext : public IQt3DSRenderContext
 
     void SetStereoProgressiveEnabled(bool enabled) override
     {
+        if (m_StereoProgressiveEnabled != enabled)
+            ++m_ViewSettingsRevision;
         m_StereoProgressiveEnabled = enabled;
     }
 
@@ -496,7 +469,27 @@ struct SRenderContext : public IQt3DSRenderContext
         return m_SkipFramesInterval;
     }
 
-    void SetWireframeMode(bool inEnable) override { m_WireframeMode = inEnable; }
+    void SetRenderOnDemand(bool inEnable) override
+    {
+        // Make sure the first frame after switching modes is rendered.
+        if (m_RenderOnDemand != inEnable)
+            ++m_ViewSettingsRevision;
+        m_RenderOnDemand = inEnable;
+    }
+
+    bool IsRenderOnDemand() const override
+    {
+        return m_RenderOnDemand || m_ForceRenderOnDemand;
+    }
+
+    QT3DSU32 GetViewSettingsRevision() const override { return m_ViewSettingsRevision; }
+
+    void SetWireframeMode(bool inEnable) override
+    {
+        if (m_WireframeMode != inEnable)
+            ++m_ViewSettingsRevision;
+        m_WireframeMode = inEnable;
+    }
 
     bool GetWireframeMode() override { return m_WireframeMode; }
 
@@ -955,6 +948,7 @@ struct SRenderContext : public IQt3DSRenderContext
         m_OffscreenRenderManager->EndFrame();
         m_Renderer->EndFrame();
         m_CustomMaterialSystem->EndFrame();
+        m_RenderContext->GetBackend()->EndFrame();
         m_PresentationDimensions = m_PreRenderPresentationDimensions;
         ++m_FrameCount;
     }
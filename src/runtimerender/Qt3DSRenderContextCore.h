@@ -82,6 +82,7 @@ namespace render {
         virtual NVAllocatorCallback &GetAllocator() = 0;
         virtual IInputStreamFactory &GetInputStreamFactory() = 0;
         virtual IThreadPool &GetThreadPool() = 0;
+        virtual IJobSystem &GetJobSystem() = 0;
         virtual IDynamicObjectSystemCore &GetDynamicObjectSystemCore() = 0;
         virtual ICustomMaterialSystemCore &GetMaterialSystemCore() = 0;
         virtual IEffectSystemCore &GetEffectSystemCore() = 0;
@@ -124,6 +125,7 @@ namespace render {
         virtual IEffectSystem &GetEffectSystem() = 0;
         virtual IShaderCache &GetShaderCache() = 0;
         virtual IThreadPool &GetThreadPool() = 0;
+        virtual IJobSystem &GetJobSystem() = 0;
         virtual IImageBatchLoader &GetImageBatchLoader() = 0;
         virtual IRenderPluginManager &GetRenderPluginManager() = 0;
         virtual IDynamicObjectSystem &GetDynamicObjectSystem() = 0;
@@ -202,6 +204,13 @@ namespace render {
         virtual bool GetStereoProgressiveEnabled() const = 0;
         virtual void SetSkipFramesInterval(int interval) = 0;
         virtual int GetSkipFramesInterval() const = 0;
+        // In render on demand mode frames are only rendered when something changed, see
+        // IApplication::UpdateAndRender. The QT3DS_RENDER_ON_DEMAND env variable forces it on.
+        virtual void SetRenderOnDemand(bool inEnable) = 0;
+        virtual bool IsRenderOnDemand() const = 0;
+        // Incremented whenever a setting that changes the rendered image without touching the
+        // scene changes, e.g. the window size, scale mode or matte color.
+        virtual QT3DSU32 GetViewSettingsRevision() const = 0;
 
         virtual void SetWireframeMode(bool inEnable) = 0;
         virtual bool GetWireframeMode() = 0;
@@ -29,6 +29,7 @@
 ****************************************************************************/
 #include "Qt3DSRenderDefaultMaterialShaderGenerator.h"
 #include "foundation/Qt3DSAtomic.h"
+#include "foundation/Qt3DSUtilities.h"
 #include "Qt3DSRenderContextCore.h"
 #include "Qt3DSRenderShaderCodeGeneratorV2.h"
 #include "Qt3DSRenderableImage.h"
@@ -129,6 +130,74 @@ struct SShadowMapProperties
     }
 };
 
+/**
+ *	CPU side of the cbMaterial uniform block in std140 layout. Member order and types must
+ *	match MaterialBlockMembers. Only properties of the material itself go here, values that
+ *	change per draw or per layer such as the opacity in material_diffuse and
+ *	light_ambient_total stay plain uniforms.
+ */
+struct SMaterialBlock
+{
+    QT3DSVec4 m_MaterialProperties;
+    QT3DSVec4 m_MaterialSpecular;
+    QT3DSVec3 m_DiffuseColor;
+    QT3DSF32 m_FresnelPower;
+    QT3DSF32 m_BumpAmount;
+    QT3DSF32 m_DisplaceAmount;
+    QT3DSF32 m_TranslucentFalloff;
+    QT3DSF32 m_DiffuseLightWrap;
+
+    SMaterialBlock() { memset(this, 0, sizeof(SMaterialBlock)); }
+};
+
+QT3DS_COMPILE_TIME_ASSERT(sizeof(SMaterialBlock) == 64);
+
+const char8_t *MaterialBlockName = "cbMaterial";
+const char8_t *MaterialBlockMembers[][2] = {
+    { "material_properties", "vec4" },  { "material_specular", "vec4" },
+    { "diffuse_color", "vec3" },        { "fresnelPower", "float" },
+    { "bumpAmount", "float" },          { "displaceAmount", "float" },
+    { "translucentFalloff", "float" },  { "diffuseLightWrap", "float" },
+};
+
+/**
+ *	Persistent cbMaterial buffer of one material.  The last uploaded contents are kept so the
+ *	buffer is only uploaded again when one of the material properties changes.
+ */
+struct SMaterialConstantBuffer
+{
+    NVScopedRefCounted<NVRenderConstantBuffer> m_Buffer;
+    SMaterialBlock m_Contents;
+};
+
+/**
+ *	CPU side of the cbView uniform block declared by viewProperties.glsllib when
+ *	QT3DS_VIEW_UNIFORM_BLOCK is defined, in std140 layout. Everything in it only depends on
+ *	the camera, so one buffer per camera is shared by all draws of a layer.
+ */
+struct SViewBlock
+{
+    QT3DSMat44 m_ViewProjection;
+    QT3DSMat44 m_View;
+    QT3DSVec3 m_CameraPosition;
+    QT3DSF32 m_Padding0;
+    QT3DSVec2 m_CameraProperties;
+    QT3DSF32 m_Padding1[2];
+
+    SViewBlock() { memset(this, 0, sizeof(SViewBlock)); }
+};
+
+QT3DS_COMPILE_TIME_ASSERT(sizeof(SViewBlock) == 160);
+
+const char8_t *ViewBlockName = "cbView";
+const char8_t *ViewBlockFeature = "QT3DS_VIEW_UNIFORM_BLOCK";
+
+struct SViewConstantBuffer
+{
+    NVScopedRefCounted<NVRenderConstantBuffer> m_Buffer;
+    SViewBlock m_Contents;
+};
+
 /**
  *	The results of generating a shader.  Caches all possible variable names into
  *	typesafe objects.
@@ -174,6 +243,8 @@ struct SShaderGeneratorGeneratedShader
 
     NVRenderCachedShaderBuffer<qt3ds::render::NVRenderShaderConstantBuffer *> m_AoShadowParams;
     NVRenderCachedShaderBuffer<qt3ds::render::NVRenderShaderConstantBuffer *> m_LightsBuffer;
+    NVRenderCachedShaderBuffer<qt3ds::render::NVRenderShaderConstantBuffer *> m_MaterialBlock;
+    NVRenderCachedShaderBuffer<qt3ds::render::NVRenderShaderConstantBuffer *> m_ViewBlock;
 
     SLightConstantProperties<SShaderGeneratorGeneratedShader> *m_lightConstantProperties;
 
@@ -220,6 +291,8 @@ struct SShaderGeneratorGeneratedShader
         , m_alphaTestOp("alphaOpRef", inShader)
         , m_AoShadowParams("cbAoShadow", inShader)
         , m_LightsBuffer("cbBufferLights", inShader)
+        , m_MaterialBlock(MaterialBlockName, inShader)
+        , m_ViewBlock(ViewBlockName, inShader)
         , m_lightConstantProperties(nullptr)
         , m_Images(inContext.GetAllocator(), "SShaderGeneratorGeneratedShader::m_Images")
         , m_Lights(inContext.GetAllocator(), "SShaderGeneratorGeneratedShader::m_Lights")
@@ -259,6 +332,9 @@ struct SShaderGenerator : public IDefaultMaterialShaderGenerator
     typedef qt3ds::foundation::nvhash_map<CRegisteredString,
                                        NVScopedRefCounted<qt3ds::render::NVRenderConstantBuffer>>
         TStrConstanBufMap;
+    typedef nvhash_map<const SDefaultMaterial *, SMaterialConstantBuffer>
+        TMaterialConstantBufferMap;
+    typedef nvhash_map<const SCamera *, SViewConstantBuffer> TViewConstantBufferMap;
 
     IQt3DSRenderContext &m_RenderContext;
     IShaderProgramGenerator &m_ProgramGenerator;
@@ -272,6 +348,7 @@ struct SShaderGenerator : public IDefaultMaterialShaderGenerator
     SRenderableImage *m_FirstImage;
     bool m_HasTransparency;
     bool m_LightsAsSeparateUniforms;
+    bool m_MaterialUniformBlock;
 
     TStrType m_ImageStem;
     TStrType m_ImageSampler;
@@ -312,6 +389,11 @@ struct SShaderGenerator : public IDefaultMaterialShaderGenerator
     TProgramToShaderMap m_ProgramToShaderMap;
 
     TStrConstanBufMap m_ConstantBuffers; ///< store all constants buffers
+    TMaterialConstantBufferMap m_MaterialConstantBuffers; ///< cbMaterial buffer per material
+    QT3DSU32 m_NextMaterialBufferId;
+    TViewConstantBufferMap m_ViewConstantBuffers; ///< cbView buffer per camera
+    QT3DSU32 m_NextViewBufferId;
+    nvvector<SShaderPreprocessorFeature> m_ViewBlockFeatures;
 
     QT3DSI32 m_RefCount;
 
@@ -324,8 +406,14 @@ struct SShaderGenerator : public IDefaultMaterialShaderGenerator
         , m_CurrentPipeline(nullptr)
         , m_FirstImage(nullptr)
         , m_LightsAsSeparateUniforms(false)
+        , m_MaterialUniformBlock(false)
         , m_ProgramToShaderMap(inRc.GetAllocator(), "m_ProgramToShaderMap")
         , m_ConstantBuffers(inRc.GetAllocator(), "m_ConstantBuffers")
+        , m_MaterialConstantBuffers(inRc.GetAllocator(), "m_MaterialConstantBuffers")
+        , m_NextMaterialBufferId(0)
+        , m_ViewConstantBuffers(inRc.GetAllocator(), "m_ViewConstantBuffers")
+        , m_NextViewBufferId(0)
+        , m_ViewBlockFeatures(inRc.GetAllocator(), "m_ViewBlockFeatures")
         , m_RefCount(0)
     {
     }
@@ -336,6 +424,8 @@ struct SShaderGenerator : public IDefaultMaterialShaderGenerator
         atomicDecrement(&m_RefCount);
         if (m_RefCount <= 0) {
             m_ConstantBuffers.clear();
+            m_MaterialConstantBuffers.clear();
+            m_ViewConstantBuffers.clear();
             NVDelete(m_RenderContext.GetAllocator(), this);
         }
     }
@@ -349,6 +439,13 @@ struct SShaderGenerator : public IDefaultMaterialShaderGenerator
     const SDefaultMaterial &Material() { return *m_CurrentMaterial; }
     TShaderFeatureSet FeatureSet() { return m_CurrentFeatureSet; }
     bool HasTransparency() { return m_HasTransparency; }
+    // The tessellation libraries declare camera_position themselves, so the view block is only
+    // used without them. Valid once the vertex pipeline has begun the program.
+    bool ViewUniformBlock()
+    {
+        return m_MaterialUniformBlock
+                && !(ProgramGenerator().GetEnabledStages() & ShaderGeneratorStages::TessEval);
+    }
 
     void addFunction(IShaderStageGenerator &generator, QString functionName)
     {
@@ -655,7 +752,10 @@ struct SShaderGenerator : public IDefaultMaterialShaderGenerator
             SetupImageVariableNames(displacementImageIdx);
             inGenerator.AddInclude("defaultMaterialFileDisplacementTexture.glsllib");
             inGenerator.AddUniform("model_matrix", "mat4");
-            inGenerator.AddUniform("camera_position", "vec3");
+            if (ViewUniformBlock())
+                inGenerator.AddInclude("viewProperties.glsllib");
+            else
+                inGenerator.AddUniform("camera_position", "vec3");
             inGenerator.AddUniform("displaceAmount", "float");
             inGenerator.AddUniform(m_ImageSampler, "sampler2D");
         }
@@ -907,6 +1007,15 @@ struct SShaderGenerator : public IDefaultMaterialShaderGenerator
 
         // the pipeline opens/closes up the shaders stages
         VertexGenerator().BeginVertexGeneration(displacementImageIdx, displacementImage);
+
+        // the per material constants are grouped into one uniform block when supported
+        if (m_MaterialUniformBlock) {
+            for (QT3DSU32 idx = 0; idx < QT3DS_ARRAY_SIZE(MaterialBlockMembers); ++idx) {
+                ProgramGenerator().AddUniformBlockMember(MaterialBlockName,
+                                                         MaterialBlockMembers[idx][0],
+                                                         MaterialBlockMembers[idx][1]);
+            }
+        }
     }
 
     void GenerateFragmentShader(SShaderDefaultMaterialKey &inKey)
@@ -1876,6 +1985,8 @@ struct SShaderGenerator : public IDefaultMaterialShaderGenerator
                         SShaderDefaultMaterialKeyProperties::DefaultKey);
 
         m_LightsAsSeparateUniforms = !m_RenderContext.GetRenderContext().GetConstantBufferSupport();
+        m_MaterialUniformBlock = !m_LightsAsSeparateUniforms
+                && !qEnvironmentVariableIsSet("QT3DS_DISABLE_MATERIAL_UNIFORM_BLOCK");
 
         GenerateVertexShader();
         GenerateFragmentShader(theKey);
@@ -1883,8 +1994,18 @@ struct SShaderGenerator : public IDefaultMaterialShaderGenerator
         VertexGenerator().EndVertexGeneration(false);
         VertexGenerator().EndFragmentGeneration(false);
 
+        // viewProperties.glsllib declares the camera uniforms as the cbView block instead
+        TShaderFeatureSet theFeatures(FeatureSet());
+        if (ViewUniformBlock()) {
+            m_ViewBlockFeatures.assign(theFeatures.begin(), theFeatures.end());
+            m_ViewBlockFeatures.push_back(SShaderPreprocessorFeature(
+                m_RenderContext.GetStringTable().RegisterStr(ViewBlockFeature), true));
+            theFeatures = toConstDataRef(m_ViewBlockFeatures.data(),
+                                         (QT3DSU32)m_ViewBlockFeatures.size());
+        }
+
         return ProgramGenerator().CompileGeneratedShader(m_GeneratedShaderString.c_str(),
-                                                         SShaderCacheProgramFlags(), FeatureSet());
+                                                         SShaderCacheProgramFlags(), theFeatures);
     }
 
     virtual NVRenderShaderProgram *
@@ -1945,18 +2066,28 @@ struct SShaderGenerator : public IDefaultMaterialShaderGenerator
         m_ShadowMapManager = inShadowMapManager;
 
         SCamera &theCamera(inCamera);
-        shader.m_CameraPosition.Set(theCamera.GetGlobalPos());
         shader.m_CameraDirection.Set(inCameraDirection);
 
-        QT3DSMat44 viewProj;
-        if (shader.m_ViewProj.IsValid()) {
-            theCamera.CalculateViewProjectionMatrix(viewProj);
-            shader.m_ViewProj.Set(viewProj);
-        }
+        if (shader.m_ViewBlock.IsValid()) {
+            SViewBlock theBlock;
+            theCamera.CalculateViewProjectionMatrix(theBlock.m_ViewProjection);
+            theBlock.m_View = theCamera.m_GlobalTransform.getInverse();
+            theBlock.m_CameraPosition = theCamera.GetGlobalPos();
+            theBlock.m_CameraProperties = QT3DSVec2(theCamera.m_ClipNear, theCamera.m_ClipFar);
+            SetViewBlock(shader, theCamera, theBlock);
+        } else {
+            shader.m_CameraPosition.Set(theCamera.GetGlobalPos());
+
+            QT3DSMat44 viewProj;
+            if (shader.m_ViewProj.IsValid()) {
+                theCamera.CalculateViewProjectionMatrix(viewProj);
+                shader.m_ViewProj.Set(viewProj);
+            }
 
-        if (shader.m_ViewMatrix.IsValid()) {
-            viewProj = theCamera.m_GlobalTransform.getInverse();
-            shader.m_ViewMatrix.Set(viewProj);
+            if (shader.m_ViewMatrix.IsValid()) {
+                viewProj = theCamera.m_GlobalTransform.getInverse();
+                shader.m_ViewMatrix.Set(viewProj);
+            }
         }
 
         // update the constant buffer
@@ -2042,6 +2173,84 @@ struct SShaderGenerator : public IDefaultMaterialShaderGenerator
         shader.m_LightAmbientTotal = theLightAmbientTotal.getXYZ();
     }
 
+    void ReleaseMaterial(const SGraphObject &inMaterial) override
+    {
+        if (inMaterial.m_Type == GraphObjectTypes::DefaultMaterial)
+            m_MaterialConstantBuffers.erase(static_cast<const SDefaultMaterial *>(&inMaterial));
+    }
+
+    ///< upload the cbMaterial contents of a material if they changed and bind them to the shader
+    void SetMaterialBlock(SShaderGeneratorGeneratedShader &shader,
+                          const SDefaultMaterial &inMaterial, const SMaterialBlock &inBlock)
+    {
+        NVRenderContext &theContext(m_RenderContext.GetRenderContext());
+        eastl::pair<TMaterialConstantBufferMap::iterator, bool> inserter =
+            m_MaterialConstantBuffers.insert(
+                eastl::make_pair(&inMaterial, SMaterialConstantBuffer()));
+        SMaterialConstantBuffer &theEntry(inserter.first->second);
+
+        if (!theEntry.m_Buffer) {
+            // Every material owns a buffer, so the name only has to be unique.
+            char theName[32];
+            _snprintf(theName, 32, "%s%u", MaterialBlockName, m_NextMaterialBufferId++);
+            NVDataRef<QT3DSU8> theData((QT3DSU8 *)&inBlock, sizeof(SMaterialBlock));
+            theEntry.m_Buffer = theContext.CreateConstantBuffer(
+                theName, qt3ds::render::NVRenderBufferUsageType::Static, sizeof(SMaterialBlock),
+                theData);
+            if (!theEntry.m_Buffer) {
+                QT3DS_ASSERT(false);
+                return;
+            }
+            theEntry.m_Contents = inBlock;
+            theEntry.m_Buffer->UpdateRaw(0, theData);
+            theEntry.m_Buffer->Update();
+        } else if (memcmp(&theEntry.m_Contents, &inBlock, sizeof(SMaterialBlock))) {
+            theEntry.m_Contents = inBlock;
+            theEntry.m_Buffer->UpdateRaw(
+                0, NVDataRef<QT3DSU8>((QT3DSU8 *)&theEntry.m_Contents, sizeof(SMaterialBlock)));
+            theEntry.m_Buffer->Update();
+        }
+
+        NVRenderShaderConstantBuffer *theBlock = shader.m_MaterialBlock.m_ShaderBuffer;
+        theEntry.m_Buffer->BindToShaderProgram(&shader.m_Shader, theBlock->m_Location,
+                                               theBlock->m_Binding);
+    }
+
+    ///< upload the cbView contents of a camera if they changed and bind them to the shader
+    void SetViewBlock(SShaderGeneratorGeneratedShader &shader, const SCamera &inCamera,
+                      const SViewBlock &inBlock)
+    {
+        NVRenderContext &theContext(m_RenderContext.GetRenderContext());
+        eastl::pair<TViewConstantBufferMap::iterator, bool> inserter =
+            m_ViewConstantBuffers.insert(eastl::make_pair(&inCamera, SViewConstantBuffer()));
+        SViewConstantBuffer &theEntry(inserter.first->second);
+
+        if (!theEntry.m_Buffer) {
+            char theName[32];
+            _snprintf(theName, 32, "%s%u", ViewBlockName, m_NextViewBufferId++);
+            NVDataRef<QT3DSU8> theData((QT3DSU8 *)&inBlock, sizeof(SViewBlock));
+            theEntry.m_Buffer = theContext.CreateConstantBuffer(
+                theName, qt3ds::render::NVRenderBufferUsageType::Dynamic, sizeof(SViewBlock),
+                theData);
+            if (!theEntry.m_Buffer) {
+                QT3DS_ASSERT(false);
+                return;
+            }
+            theEntry.m_Contents = inBlock;
+            theEntry.m_Buffer->UpdateRaw(0, theData);
+            theEntry.m_Buffer->Update();
+        } else if (memcmp(&theEntry.m_Contents, &inBlock, sizeof(SViewBlock))) {
+            theEntry.m_Contents = inBlock;
+            theEntry.m_Buffer->UpdateRaw(
+                0, NVDataRef<QT3DSU8>((QT3DSU8 *)&theEntry.m_Contents, sizeof(SViewBlock)));
+            theEntry.m_Buffer->Update();
+        }
+
+        NVRenderShaderConstantBuffer *theBlock = shader.m_ViewBlock.m_ShaderBuffer;
+        theEntry.m_Buffer->BindToShaderProgram(&shader.m_Shader, theBlock->m_Location,
+                                               theBlock->m_Binding);
+    }
+
     // Also sets the blend function on the render context.
     void SetMaterialProperties(NVRenderShaderProgram &inProgram, const SDefaultMaterial &inMaterial,
                                const QT3DSVec2 &inCameraVec, const QT3DSMat44 &inModelViewProjection,
@@ -2148,14 +2357,11 @@ struct SShaderGenerator : public IDefaultMaterialShaderGenerator
         QT3DSVec4 material_diffuse = QT3DSVec4(inMaterial.m_EmissiveColor[0] * emissivePower,
                                          inMaterial.m_EmissiveColor[1] * emissivePower,
                                          inMaterial.m_EmissiveColor[2] * emissivePower, inOpacity);
-        shader.m_MaterialDiffuse.Set(material_diffuse);
-        shader.m_DiffuseColor.Set(inMaterial.m_DiffuseColor.getXYZ());
         QT3DSVec4 material_specular =
             QT3DSVec4(inMaterial.m_SpecularTint[0], inMaterial.m_SpecularTint[1],
                    inMaterial.m_SpecularTint[2], inMaterial.m_IOR);
-        shader.m_MaterialSpecular.Set(material_specular);
-        shader.m_CameraProperties.Set(inCameraVec);
-        shader.m_FresnelPower.Set(inMaterial.m_FresnelPower);
+        if (!shader.m_ViewBlock.IsValid())
+            shader.m_CameraProperties.Set(inCameraVec);
         shader.m_alphaTestOp.Set(alphaOpRef);
 
         if (context.GetConstantBufferSupport()) {
@@ -2199,17 +2405,35 @@ struct SShaderGenerator : public IDefaultMaterialShaderGenerator
                 pLightConstants->updateLights(shader);
         }
 
-        shader.m_MaterialDiffuseLightAmbientTotal.Set(
-            QT3DSVec3(shader.m_LightAmbientTotal.x * inMaterial.m_DiffuseColor[0],
-                   shader.m_LightAmbientTotal.y * inMaterial.m_DiffuseColor[1],
-                   shader.m_LightAmbientTotal.z * inMaterial.m_DiffuseColor[2]));
-
-        shader.m_MaterialProperties.Set(QT3DSVec4(
-            inMaterial.m_SpecularAmount, inMaterial.m_SpecularRoughness, emissivePower, 0.0f));
-        shader.m_BumpAmount.Set(inMaterial.m_BumpAmount);
-        shader.m_DisplaceAmount.Set(inMaterial.m_DisplaceAmount);
-        shader.m_TranslucentFalloff.Set(inMaterial.m_TranslucentFalloff);
-        shader.m_DiffuseLightWrap.Set(inMaterial.m_DiffuseLightWrap);
+        QT3DSVec3 lightAmbientTotal(shader.m_LightAmbientTotal.x * inMaterial.m_DiffuseColor[0],
+                                    shader.m_LightAmbientTotal.y * inMaterial.m_DiffuseColor[1],
+                                    shader.m_LightAmbientTotal.z * inMaterial.m_DiffuseColor[2]);
+        QT3DSVec4 material_properties(inMaterial.m_SpecularAmount, inMaterial.m_SpecularRoughness,
+                                      emissivePower, 0.0f);
+
+        shader.m_MaterialDiffuse.Set(material_diffuse);
+        shader.m_MaterialDiffuseLightAmbientTotal.Set(lightAmbientTotal);
+        if (shader.m_MaterialBlock.IsValid()) {
+            SMaterialBlock theBlock;
+            theBlock.m_MaterialProperties = material_properties;
+            theBlock.m_MaterialSpecular = material_specular;
+            theBlock.m_DiffuseColor = inMaterial.m_DiffuseColor.getXYZ();
+            theBlock.m_FresnelPower = inMaterial.m_FresnelPower;
+            theBlock.m_BumpAmount = inMaterial.m_BumpAmount;
+            theBlock.m_DisplaceAmount = inMaterial.m_DisplaceAmount;
+            theBlock.m_TranslucentFalloff = inMaterial.m_TranslucentFalloff;
+            theBlock.m_DiffuseLightWrap = inMaterial.m_DiffuseLightWrap;
+            SetMaterialBlock(shader, inMaterial, theBlock);
+        } else {
+            shader.m_DiffuseColor.Set(inMaterial.m_DiffuseColor.getXYZ());
+            shader.m_MaterialSpecular.Set(material_specular);
+            shader.m_FresnelPower.Set(inMaterial.m_FresnelPower);
+            shader.m_MaterialProperties.Set(material_properties);
+            shader.m_BumpAmount.Set(inMaterial.m_BumpAmount);
+            shader.m_DisplaceAmount.Set(inMaterial.m_DisplaceAmount);
+            shader.m_TranslucentFalloff.Set(inMaterial.m_TranslucentFalloff);
+            shader.m_DiffuseLightWrap.Set(inMaterial.m_DiffuseLightWrap);
+        }
         QT3DSU32 imageIdx = 0;
         for (SRenderableImage *theImage = inFirstImage; theImage;
              theImage = theImage->m_NextImage, ++imageIdx)
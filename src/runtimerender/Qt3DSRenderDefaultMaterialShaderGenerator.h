@@ -141,6 +141,10 @@ namespace render {
                               SLayerGlobalRenderProperties inRenderProperties,
                               const QT3DSVec2 &alphaOpRef) override = 0;
 
+        // Releases the per material resources, such as the cbMaterial buffer, of a material
+        // that is about to be freed.
+        virtual void ReleaseMaterial(const SGraphObject &inMaterial) = 0;
+
         static IDefaultMaterialShaderGenerator &
         CreateDefaultMaterialShaderGenerator(IQt3DSRenderContext &inRenderContext);
 
@@ -668,3 +668,63 @@ SPresentation *SGraphObjectSerializer::Load(NVDataRef<QT3DSU8> inData, NVDataRef
     }
     return retval;
 }
+
+QT3DSU32 SBinarySceneHeader::GetFileTag()
+{
+    const char *fileTag = "Qt3DSS";
+    const QT3DSU32 *theTagPtr = reinterpret_cast<const QT3DSU32 *>(fileTag);
+    return *theTagPtr;
+}
+
+// FNV-1a, catches truncated or partially written files.
+QT3DSU32 SBinarySceneHeader::ComputeChecksum(NVConstDataRef<QT3DSU8> inData)
+{
+    QT3DSU32 theHash = 2166136261u;
+    for (const QT3DSU8 *theData = inData.begin(), *theEnd = inData.end(); theData < theEnd;
+         ++theData) {
+        theHash ^= *theData;
+        theHash *= 16777619u;
+    }
+    return theHash;
+}
+
+void SBinarySceneHeader::Finalize(NVConstDataRef<QT3DSU8> inDataSection,
+                                  QT3DSU32 inTranslatorOffset)
+{
+    m_FileTag = GetFileTag();
+    m_BinaryVersion = SGraphObject::GetSceneGraphBinaryVersion();
+    m_HeaderVersion = GetHeaderVersion();
+    m_DataSize = inDataSection.size();
+    m_Checksum = ComputeChecksum(inDataSection);
+    m_TranslatorOffset = inTranslatorOffset;
+}
+
+const SBinarySceneHeader *SBinarySceneHeader::Validate(NVConstDataRef<QT3DSU8> inFile,
+                                                       bool inVerifyChecksum,
+                                                       const char8_t *inPath)
+{
+    if (inFile.size() < sizeof(SBinarySceneHeader)) {
+        qCWarning(WARNING) << "Binary scene graph is truncated:" << inPath;
+        return NULL;
+    }
+    const SBinarySceneHeader *theHeader =
+        reinterpret_cast<const SBinarySceneHeader *>(inFile.begin());
+    NVConstDataRef<QT3DSU8> theDataSection(inFile.begin() + sizeof(SBinarySceneHeader),
+                                           inFile.size() - QT3DSU32(sizeof(SBinarySceneHeader)));
+    if (theHeader->m_FileTag != GetFileTag()
+        || theHeader->m_BinaryVersion != SGraphObject::GetSceneGraphBinaryVersion()
+        || theHeader->m_HeaderVersion != GetHeaderVersion()) {
+        qCWarning(WARNING) << "Binary scene graph version mismatch:" << inPath;
+        return NULL;
+    }
+    if (theHeader->m_DataSize != theDataSection.size()
+        || theHeader->m_TranslatorOffset > theDataSection.size()) {
+        qCWarning(WARNING) << "Binary scene graph is truncated:" << inPath;
+        return NULL;
+    }
+    if (inVerifyChecksum && theHeader->m_Checksum != ComputeChecksum(theDataSection)) {
+        qCWarning(WARNING) << "Binary scene graph checksum mismatch:" << inPath;
+        return NULL;
+    }
+    return theHeader;
+}
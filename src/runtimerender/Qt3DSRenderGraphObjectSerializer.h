@@ -43,7 +43,34 @@ namespace render {
     struct SPresentation;
     class IEffectSystem;
 
-    struct SGraphObjectSerializer
+    // Binary scene graph files start with this header, followed by the data section holding
+    // the serialized graph and the translators. The data section starts 8 byte aligned so that
+    // it can be used directly from a mapping.
+    struct QT3DS_AUTOTEST_EXPORT SBinarySceneHeader
+    {
+        QT3DSU32 m_FileTag;
+        QT3DSU32 m_BinaryVersion; // scene graph binary version
+        QT3DSU32 m_HeaderVersion;
+        QT3DSU32 m_DataSize; // size of the data section
+        QT3DSU32 m_Checksum; // checksum of the data section
+        QT3DSU32 m_TranslatorOffset; // offset of the translators from the data section start
+
+        static QT3DSU32 GetFileTag();
+        static QT3DSU32 GetHeaderVersion() { return 1; }
+        static QT3DSU32 ComputeChecksum(NVConstDataRef<QT3DSU8> inData);
+
+        // Fills in every field for the data section that follows this header.
+        void Finalize(NVConstDataRef<QT3DSU8> inDataSection, QT3DSU32 inTranslatorOffset);
+
+        // Returns the header of inFile if the tag, the versions and the sizes match, else null.
+        // The checksum reads the whole data section, which pages in all of a mapped file, so it
+        // is only verified when asked for.
+        static const SBinarySceneHeader *Validate(NVConstDataRef<QT3DSU8> inFile,
+                                                  bool inVerifyChecksum,
+                                                  const char8_t *inPath);
+    };
+
+    struct QT3DS_AUTOTEST_EXPORT SGraphObjectSerializer
     {
         // This will save the tree as it exists but clients may wish to save out extra objects in
         // addtion
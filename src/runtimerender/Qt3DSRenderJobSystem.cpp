@@ -0,0 +1,574 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qt 3D Studio.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "Qt3DSRenderJobSystem.h"
+#include "foundation/Qt3DSThread.h"
+#include "foundation/Qt3DSMutex.h"
+#include "foundation/Qt3DSSemaphore.h"
+#include "foundation/Qt3DSContainers.h"
+#include "foundation/Qt3DSFoundation.h"
+#include "foundation/Qt3DSBroadcastingAllocator.h"
+#include <QtCore/qmutex.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qwaitcondition.h>
+
+using namespace qt3ds::render;
+
+namespace {
+
+inline QT3DSU32 NextRandom(QT3DSU32 &ioState)
+{
+    // xorshift32, only used to spread victim selection.
+    ioState ^= ioState << 13;
+    ioState ^= ioState >> 17;
+    ioState ^= ioState << 5;
+    return ioState;
+}
+}
+
+namespace qt3ds {
+namespace render {
+
+struct SJob
+{
+    TJobFunction m_Function;
+    TRangeJobFunction m_RangeFunction;
+    void *m_UserData;
+    SJobGroup *m_Group;
+    QT3DSU32 m_Begin;
+    QT3DSU32 m_End;
+    QT3DSU32 m_GrainSize;
+    // Jobs are taken from a ring owned by the starting worker. Jobs started by other
+    // threads, or while the ring slot is still in flight, come from the heap.
+    bool m_HeapAllocated;
+    std::atomic<bool> m_InUse;
+
+    SJob()
+        : m_Function(NULL)
+        , m_RangeFunction(NULL)
+        , m_UserData(NULL)
+        , m_Group(NULL)
+        , m_Begin(0)
+        , m_End(0)
+        , m_GrainSize(1)
+        , m_HeapAllocated(false)
+        , m_InUse(false)
+    {
+    }
+};
+
+struct SJobSystem;
+
+// Chase-Lev deque. The owning worker pushes and pops at the bottom, any other thread may
+// steal from the top. Indices only grow so they are kept 64 bit.
+struct SJobDeque
+{
+    enum { Capacity = 4096, Mask = Capacity - 1 };
+
+    std::atomic<QT3DSI64> m_Top;
+    std::atomic<QT3DSI64> m_Bottom;
+    std::atomic<SJob *> m_Buffer[Capacity];
+
+    SJobDeque()
+        : m_Top(0)
+        , m_Bottom(0)
+    {
+        for (QT3DSU32 idx = 0; idx < Capacity; ++idx)
+            m_Buffer[idx].store(NULL, std::memory_order_relaxed);
+    }
+
+    bool Push(SJob *inJob)
+    {
+        QT3DSI64 bottom = m_Bottom.load(std::memory_order_relaxed);
+        QT3DSI64 top = m_Top.load(std::memory_order_acquire);
+        if (bottom - top >= Capacity)
+            return false;
+        m_Buffer[bottom & Mask].store(inJob, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    SJob *Pop()
+    {
+        QT3DSI64 bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+        m_Bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        QT3DSI64 top = m_Top.load(std::memory_order_relaxed);
+        SJob *retval = NULL;
+        if (top <= bottom) {
+            retval = m_Buffer[bottom & Mask].load(std::memory_order_relaxed);
+            if (top == bottom) {
+                // Last item, race the thieves for it.
+                if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                   std::memory_order_relaxed))
+                    retval = NULL;
+                m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+            }
+        } else {
+            m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return retval;
+    }
+
+    SJob *Steal()
+    {
+        QT3DSI64 top = m_Top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        QT3DSI64 bottom = m_Bottom.load(std::memory_order_acquire);
+        if (top < bottom) {
+            SJob *retval = m_Buffer[top & Mask].load(std::memory_order_relaxed);
+            if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                               std::memory_order_relaxed))
+                return NULL;
+            return retval;
+        }
+        return NULL;
+    }
+};
+
+struct SJobWorker : public Thread
+{
+    enum { JobRingSize = 1024, JobRingMask = JobRingSize - 1 };
+
+    SJobSystem &m_System;
+    QT3DSU32 m_Index;
+    QT3DSU32 m_RandomState;
+    QT3DSU32 m_NextJob;
+    SJobDeque m_Deque;
+    SJob m_Jobs[JobRingSize];
+
+    SJobWorker(NVFoundationBase &inFoundation, SJobSystem &inSystem, QT3DSU32 inIndex)
+        : Thread(inFoundation)
+        , m_System(inSystem)
+        , m_Index(inIndex)
+        , m_RandomState(0x9e3779b9u ^ (inIndex * 0x85ebca6bu))
+        , m_NextJob(0)
+    {
+    }
+
+    void execute(void) override;
+};
+
+struct SJobSystem : public IJobSystem
+{
+    typedef Mutex::ScopedLock TLockType;
+
+    NVFoundationBase &m_Foundation;
+    volatile QT3DSI32 mRefCount;
+    nvvector<SJobWorker *> m_Workers;
+    QT3DSU32 m_TlsIndex;
+
+    // Jobs started from threads that are not workers, or that overflowed a deque.
+    Mutex m_InjectedMutex;
+    nvvector<SJob *> m_Injected;
+    QT3DSU32 m_InjectedHead;
+    std::atomic<QT3DSI32> m_InjectedCount;
+
+    Semaphore m_WakeSemaphore;
+    std::atomic<QT3DSI32> m_Sleepers;
+
+    // Threads blocked in Wait, woken when a group finishes or a job is submitted.
+    QMutex m_WaitMutex;
+    QWaitCondition m_WaitCondition;
+    std::atomic<QT3DSI32> m_BlockedWaiters;
+
+    SJobSystem(NVFoundationBase &inFoundation, QT3DSU32 inNumWorkers)
+        : m_Foundation(inFoundation)
+        , mRefCount(0)
+        , m_Workers(inFoundation.getAllocator(), "SJobSystem::m_Workers")
+        , m_TlsIndex(TlsAlloc())
+        , m_InjectedMutex(inFoundation.getAllocator())
+        , m_Injected(inFoundation.getAllocator(), "SJobSystem::m_Injected")
+        , m_InjectedHead(0)
+        , m_InjectedCount(0)
+        , m_WakeSemaphore(inFoundation.getAllocator(), 0, NVMax(inNumWorkers, QT3DSU32(1)))
+        , m_Sleepers(0)
+        , m_BlockedWaiters(0)
+    {
+        for (QT3DSU32 idx = 0; idx < inNumWorkers; ++idx) {
+            m_Workers.push_back(QT3DS_NEW(m_Foundation.getAllocator(),
+                                          SJobWorker)(m_Foundation, *this, idx));
+        }
+        // Start only once the worker list is complete since workers steal from it.
+        for (QT3DSU32 idx = 0; idx < inNumWorkers; ++idx)
+            m_Workers[idx]->start(Thread::DEFAULT_STACK_SIZE);
+    }
+
+    virtual ~SJobSystem()
+    {
+        for (QT3DSU32 idx = 0, end = m_Workers.size(); idx < end; ++idx)
+            m_Workers[idx]->signalQuit();
+        for (QT3DSU32 idx = 0, end = m_Workers.size(); idx < end; ++idx)
+            m_WakeSemaphore.post();
+        for (QT3DSU32 idx = 0, end = m_Workers.size(); idx < end; ++idx)
+            m_Workers[idx]->waitForQuit();
+
+        // Nothing may be left waiting on a group, so finish whatever is still queued.
+        QT3DSU32 randomState = 1;
+        for (SJob *theJob = FindJob(NULL, randomState); theJob;
+             theJob = FindJob(NULL, randomState)) {
+            Execute(theJob, NULL);
+        }
+
+        for (QT3DSU32 idx = 0, end = m_Workers.size(); idx < end; ++idx)
+            NVDelete(m_Foundation.getAllocator(), m_Workers[idx]);
+        m_Workers.clear();
+        TlsFree(m_TlsIndex);
+    }
+
+    QT3DS_IMPLEMENT_REF_COUNT_ADDREF_RELEASE(m_Foundation.getAllocator())
+
+    QT3DSU32 GetWorkerCount() const override { return m_Workers.size(); }
+
+    SJobWorker *CurrentWorker()
+    {
+        SJobWorker *theWorker = reinterpret_cast<SJobWorker *>(TlsGet(m_TlsIndex));
+        QT3DS_ASSERT(theWorker == NULL || &theWorker->m_System == this);
+        return theWorker;
+    }
+
+    SJob *AllocateJob(SJobWorker *inWorker)
+    {
+        if (inWorker) {
+            SJob &theJob = inWorker->m_Jobs[inWorker->m_NextJob & SJobWorker::JobRingMask];
+            ++inWorker->m_NextJob;
+            if (!theJob.m_InUse.load(std::memory_order_acquire)) {
+                theJob.m_InUse.store(true, std::memory_order_relaxed);
+                theJob.m_HeapAllocated = false;
+                return &theJob;
+            }
+        }
+        SJob *theJob = QT3DS_NEW(m_Foundation.getAllocator(), SJob)();
+        theJob->m_HeapAllocated = true;
+        return theJob;
+    }
+
+    void FreeJob(SJob *inJob)
+    {
+        if (inJob->m_HeapAllocated)
+            NVDelete(m_Foundation.getAllocator(), inJob);
+        else
+            inJob->m_InUse.store(false, std::memory_order_release);
+    }
+
+    void Wake()
+    {
+        // Pairs with the fence in SJobDeque::Steal so a worker going to sleep either
+        // sees the new job or is counted here.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_Sleepers.load(std::memory_order_relaxed) > 0)
+            m_WakeSemaphore.post();
+        WakeWaiters();
+    }
+
+    void WakeWaiters()
+    {
+        // Pairs with the increment in BlockWaiter so a waiter going to block either sees
+        // the progress or is woken here.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_BlockedWaiters.load(std::memory_order_relaxed) > 0) {
+            QMutexLocker locker(&m_WaitMutex);
+            m_WaitCondition.wakeAll();
+        }
+    }
+
+    void Submit(SJob *inJob, SJobWorker *inWorker)
+    {
+        if (inWorker == NULL || !inWorker->m_Deque.Push(inJob)) {
+            TLockType __injectedLocker(m_InjectedMutex);
+            m_Injected.push_back(inJob);
+            m_InjectedCount.fetch_add(1, std::memory_order_seq_cst);
+        }
+        Wake();
+    }
+
+    // Pops the oldest injected job, or the oldest one of inGroup if that is not null.
+    SJob *PopInjected(SJobGroup *inGroup = NULL)
+    {
+        if (m_InjectedCount.load(std::memory_order_seq_cst) == 0)
+            return NULL;
+        TLockType __injectedLocker(m_InjectedMutex);
+        QT3DSU32 theIndex = m_InjectedHead;
+        if (inGroup) {
+            for (QT3DSU32 end = m_Injected.size();
+                 theIndex < end && m_Injected[theIndex]->m_Group != inGroup; ++theIndex) {
+            }
+        }
+        if (theIndex == m_Injected.size())
+            return NULL;
+        SJob *retval = m_Injected[theIndex];
+        if (theIndex == m_InjectedHead)
+            ++m_InjectedHead;
+        else
+            m_Injected.erase(m_Injected.begin() + theIndex);
+        if (m_InjectedHead == m_Injected.size()) {
+            m_Injected.clear();
+            m_InjectedHead = 0;
+        }
+        m_InjectedCount.fetch_sub(1, std::memory_order_relaxed);
+        return retval;
+    }
+
+    bool HasInjectedJob(SJobGroup *inGroup)
+    {
+        TLockType __injectedLocker(m_InjectedMutex);
+        for (QT3DSU32 idx = m_InjectedHead, end = m_Injected.size(); idx < end; ++idx) {
+            if (inGroup == NULL || m_Injected[idx]->m_Group == inGroup)
+                return true;
+        }
+        return false;
+    }
+
+    bool HasStealableJob()
+    {
+        for (QT3DSU32 idx = 0, end = m_Workers.size(); idx < end; ++idx) {
+            const SJobDeque &theDeque = m_Workers[idx]->m_Deque;
+            if (theDeque.m_Top.load(std::memory_order_acquire)
+                < theDeque.m_Bottom.load(std::memory_order_acquire)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    SJob *FindJob(SJobWorker *inWorker, QT3DSU32 &ioRandomState)
+    {
+        if (inWorker) {
+            if (SJob *theJob = inWorker->m_Deque.Pop())
+                return theJob;
+        }
+        if (SJob *theJob = PopInjected())
+            return theJob;
+        QT3DSU32 numWorkers = m_Workers.size();
+        if (numWorkers == 0)
+            return NULL;
+        QT3DSU32 start = NextRandom(ioRandomState) % numWorkers;
+        for (QT3DSU32 idx = 0; idx < numWorkers; ++idx) {
+            SJobWorker *theVictim = m_Workers[(start + idx) % numWorkers];
+            if (theVictim == inWorker)
+                continue;
+            if (SJob *theJob = theVictim->m_Deque.Steal())
+                return theJob;
+        }
+        return NULL;
+    }
+
+    void FinishGroupJob(SJobGroup &inGroup)
+    {
+        if (inGroup.m_Pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            if (inGroup.m_Continuation)
+                inGroup.m_Continuation(inGroup.m_ContinuationData);
+            // Last access to the group, the owner may destroy it once this is visible.
+            inGroup.m_Done.store(true, std::memory_order_release);
+            WakeWaiters();
+        }
+    }
+
+    // Blocks until a group finishes or a job is submitted, unless inGroup is done or there
+    // is a job the waiter could run already.
+    void BlockWaiter(SJobGroup &inGroup, SJobWorker *inWorker)
+    {
+        QMutexLocker locker(&m_WaitMutex);
+        m_BlockedWaiters.fetch_add(1, std::memory_order_seq_cst);
+        bool hasWork = inWorker ? HasInjectedJob(NULL) || HasStealableJob()
+                                : HasInjectedJob(&inGroup);
+        if (!inGroup.IsDone() && !hasWork)
+            m_WaitCondition.wait(&m_WaitMutex, 100);
+        m_BlockedWaiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void Execute(SJob *inJob, SJobWorker *inWorker)
+    {
+        if (inJob->m_RangeFunction) {
+            QT3DSU32 begin = inJob->m_Begin;
+            QT3DSU32 end = inJob->m_End;
+            // Keep the first half and offer the second one to thieves until the
+            // range is down to the grain size.
+            while (end - begin > inJob->m_GrainSize) {
+                QT3DSU32 middle = begin + (end - begin) / 2;
+                SJob *theHalf = AllocateJob(inWorker);
+                theHalf->m_Function = NULL;
+                theHalf->m_RangeFunction = inJob->m_RangeFunction;
+                theHalf->m_UserData = inJob->m_UserData;
+                theHalf->m_Group = inJob->m_Group;
+                theHalf->m_Begin = middle;
+                theHalf->m_End = end;
+                theHalf->m_GrainSize = inJob->m_GrainSize;
+                if (theHalf->m_Group)
+                    theHalf->m_Group->m_Pending.fetch_add(1, std::memory_order_relaxed);
+                Submit(theHalf, inWorker);
+                end = middle;
+            }
+            inJob->m_RangeFunction(inJob->m_UserData, begin, end);
+        } else if (inJob->m_Function) {
+            inJob->m_Function(inJob->m_UserData);
+        }
+        SJobGroup *theGroup = inJob->m_Group;
+        FreeJob(inJob);
+        if (theGroup)
+            FinishGroupJob(*theGroup);
+    }
+
+    void Run(SJobGroup *inGroup, void *inUserData, TJobFunction inFunction) override
+    {
+        if (inFunction == NULL) {
+            QT3DS_ASSERT(false);
+            return;
+        }
+        if (inGroup) {
+            QT3DS_ASSERT(!inGroup->m_Sealed);
+            inGroup->m_Pending.fetch_add(1, std::memory_order_relaxed);
+        }
+        SJobWorker *theWorker = CurrentWorker();
+        SJob *theJob = AllocateJob(theWorker);
+        theJob->m_Function = inFunction;
+        theJob->m_RangeFunction = NULL;
+        theJob->m_UserData = inUserData;
+        theJob->m_Group = inGroup;
+        Submit(theJob, theWorker);
+    }
+
+    void Then(SJobGroup &inGroup, void *inUserData, TJobFunction inFunction) override
+    {
+        QT3DS_ASSERT(!inGroup.m_Sealed);
+        if (inGroup.m_Sealed)
+            return;
+        inGroup.m_ContinuationData = inUserData;
+        inGroup.m_Continuation = inFunction;
+        inGroup.m_Sealed = true;
+        FinishGroupJob(inGroup);
+    }
+
+    void Wait(SJobGroup &inGroup) override
+    {
+        if (!inGroup.m_Sealed) {
+            inGroup.m_Sealed = true;
+            FinishGroupJob(inGroup);
+        }
+        // Workers waiting inside a job help with any job, otherwise the jobs they wait for
+        // could be stuck below their own. Other threads, such as the render thread, only run
+        // injected jobs of the group they wait for, so that they never pick up unrelated
+        // work like image decoding while they hold their own locks.
+        SJobWorker *theWorker = CurrentWorker();
+        QT3DSU32 randomState = theWorker ? theWorker->m_RandomState : 1;
+        QT3DSU32 idleCount = 0;
+        while (!inGroup.IsDone()) {
+            SJob *theJob = theWorker ? FindJob(theWorker, randomState) : PopInjected(&inGroup);
+            if (theJob) {
+                Execute(theJob, theWorker);
+                idleCount = 0;
+            } else if (++idleCount < 64) {
+                Thread::yield();
+            } else {
+                // Whatever is left is running elsewhere and may take a while.
+                BlockWaiter(inGroup, theWorker);
+            }
+        }
+        if (theWorker)
+            theWorker->m_RandomState = randomState;
+    }
+
+    void ParallelFor(QT3DSU32 inCount, QT3DSU32 inGrainSize, void *inUserData,
+                     TRangeJobFunction inFunction) override
+    {
+        if (inCount == 0 || inFunction == NULL)
+            return;
+        inGrainSize = NVMax(inGrainSize, QT3DSU32(1));
+        if (inCount <= inGrainSize || m_Workers.empty()) {
+            inFunction(inUserData, 0, inCount);
+            return;
+        }
+        SJobGroup theGroup;
+        SJobWorker *theWorker = CurrentWorker();
+        SJob *theJob = AllocateJob(theWorker);
+        theJob->m_Function = NULL;
+        theJob->m_RangeFunction = inFunction;
+        theJob->m_UserData = inUserData;
+        theJob->m_Group = &theGroup;
+        theJob->m_Begin = 0;
+        theJob->m_End = inCount;
+        theJob->m_GrainSize = inGrainSize;
+        theGroup.m_Pending.fetch_add(1, std::memory_order_relaxed);
+        // The calling thread takes the first range itself.
+        Execute(theJob, theWorker);
+        Wait(theGroup);
+    }
+
+    void WorkerLoop(SJobWorker &inWorker)
+    {
+        TlsSet(m_TlsIndex, &inWorker);
+        QT3DSU32 idleCount = 0;
+        while (!inWorker.quitIsSignalled()) {
+            SJob *theJob = FindJob(&inWorker, inWorker.m_RandomState);
+            if (theJob) {
+                Execute(theJob, &inWorker);
+                idleCount = 0;
+                continue;
+            }
+            if (++idleCount < 64) {
+                Thread::yield();
+                continue;
+            }
+            m_Sleepers.fetch_add(1, std::memory_order_seq_cst);
+            theJob = FindJob(&inWorker, inWorker.m_RandomState);
+            if (theJob) {
+                m_Sleepers.fetch_sub(1, std::memory_order_relaxed);
+                Execute(theJob, &inWorker);
+                idleCount = 0;
+                continue;
+            }
+            m_WakeSemaphore.wait(100);
+            m_Sleepers.fetch_sub(1, std::memory_order_relaxed);
+        }
+        TlsSet(m_TlsIndex, NULL);
+    }
+};
+}
+}
+
+void SJobWorker::execute(void)
+{
+    setName("Qt3DSRender job worker");
+    m_System.WorkerLoop(*this);
+    quit();
+}
+
+IJobSystem &IJobSystem::CreateJobSystem(NVFoundationBase &inFoundation, QT3DSU32 inNumWorkers)
+{
+    if (inNumWorkers == 0) {
+        bool isSet = false;
+        int requested = qEnvironmentVariableIntValue("QT3DS_JOB_THREADS", &isSet);
+        if (isSet && requested > 0)
+            inNumWorkers = QT3DSU32(requested);
+        else
+            inNumWorkers = QT3DSU32(qMax(QThread::idealThreadCount() - 1, 1));
+    }
+    return *QT3DS_NEW(inFoundation.getAllocator(), SJobSystem)(inFoundation, inNumWorkers);
+}
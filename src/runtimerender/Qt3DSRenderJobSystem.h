@@ -0,0 +1,126 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qt 3D Studio.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#pragma once
+#ifndef QT3DS_RENDER_JOB_SYSTEM_H
+#define QT3DS_RENDER_JOB_SYSTEM_H
+#include "Qt3DSRender.h"
+#include "foundation/Qt3DSRefCounted.h"
+#include <atomic>
+
+namespace qt3ds {
+namespace render {
+
+    typedef void (*TJobFunction)(void *inUserData);
+    // Processes the half open index range [inBegin, inEnd).
+    typedef void (*TRangeJobFunction)(void *inUserData, QT3DSU32 inBegin, QT3DSU32 inEnd);
+
+    // Counts the outstanding jobs of a unit of work so it can be waited upon or followed
+    // by a continuation. Groups are owned by the caller, usually on the stack, and must
+    // outlive the jobs run in them; waiting on the group guarantees that.
+    class SJobGroup
+    {
+    public:
+        SJobGroup()
+            : m_Pending(1)
+            , m_Done(false)
+            , m_Sealed(false)
+            , m_ContinuationData(NULL)
+            , m_Continuation(NULL)
+        {
+        }
+        ~SJobGroup() { QT3DS_ASSERT(m_Done.load(std::memory_order_acquire) || !m_Sealed); }
+
+        bool IsDone() const { return m_Done.load(std::memory_order_acquire); }
+
+    private:
+        friend struct SJobSystem;
+        // One extra count is held until the group is sealed by Then() or Wait() so the
+        // group cannot complete while jobs are still being added to it.
+        std::atomic<QT3DSI32> m_Pending;
+        std::atomic<bool> m_Done;
+        bool m_Sealed;
+        void *m_ContinuationData;
+        TJobFunction m_Continuation;
+
+        SJobGroup(const SJobGroup &);
+        SJobGroup &operator=(const SJobGroup &);
+    };
+
+    // Work stealing job system. Every worker owns a lock free deque; jobs started from a
+    // worker go to the front of its own deque and idle workers steal from the back of
+    // the others. Jobs started from threads that are not workers go through a shared
+    // injection queue. Workers waiting on a group execute pending jobs while they wait;
+    // other threads only execute the injected jobs of the group they wait for and block
+    // once there are none left.
+    class IJobSystem : public NVRefCounted
+    {
+    protected:
+        virtual ~IJobSystem() {}
+    public:
+        virtual QT3DSU32 GetWorkerCount() const = 0;
+
+        // Start a job. A null group makes the job fire and forget.
+        virtual void Run(SJobGroup *inGroup, void *inUserData, TJobFunction inFunction) = 0;
+        // Seal the group and run the continuation once all of its jobs have finished.
+        // The continuation runs on the thread finishing the last job, or immediately if
+        // the group is already empty. No jobs may be added to the group afterwards.
+        virtual void Then(SJobGroup &inGroup, void *inUserData, TJobFunction inFunction) = 0;
+        // Seal the group and wait until it and its continuation have finished, executing
+        // jobs meanwhile as described above.
+        virtual void Wait(SJobGroup &inGroup) = 0;
+
+        // Split [0, inCount) into ranges of at least inGrainSize items and process them
+        // on all workers plus the calling thread. Returns once every range has finished.
+        virtual void ParallelFor(QT3DSU32 inCount, QT3DSU32 inGrainSize, void *inUserData,
+                                 TRangeJobFunction inFunction) = 0;
+
+        // Zero workers selects one less than the number of hardware threads, which can be
+        // overridden with the QT3DS_JOB_THREADS environment variable.
+        static IJobSystem &CreateJobSystem(NVFoundationBase &inFoundation,
+                                           QT3DSU32 inNumWorkers = 0);
+    };
+
+    // Convenience wrapper calling inFunctor(begin, end) for every range.
+    template <typename TFunctor>
+    inline void ParallelFor(IJobSystem &inSystem, QT3DSU32 inCount, QT3DSU32 inGrainSize,
+                            TFunctor &inFunctor)
+    {
+        struct SThunk
+        {
+            static void Run(void *inUserData, QT3DSU32 inBegin, QT3DSU32 inEnd)
+            {
+                (*reinterpret_cast<TFunctor *>(inUserData))(inBegin, inEnd);
+            }
+        };
+        inSystem.ParallelFor(inCount, inGrainSize, &inFunctor, &SThunk::Run);
+    }
+}
+}
+#endif
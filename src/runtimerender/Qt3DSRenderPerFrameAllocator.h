@@ -0,0 +1,103 @@
+/****************************************************************************
+**
+** Copyright (C) 2008-2012 NVIDIA Corporation.
+** Copyright (C) 2017 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qt 3D Studio.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#pragma once
+#ifndef QT3DS_RENDER_PER_FRAME_ALLOCATOR_H
+#define QT3DS_RENDER_PER_FRAME_ALLOCATOR_H
+#include "Qt3DSRender.h"
+#include "foundation/FastAllocator.h"
+#include "foundation/AutoDeallocatorAllocator.h"
+
+namespace qt3ds {
+namespace render {
+
+    // Bump allocator for objects that are thrown away all at once. Small allocations come from
+    // slabs, larger ones are tracked and freed individually on reset. Nothing is destructed.
+    struct SPerFrameAllocator : public NVAllocatorCallback
+    {
+        SFastAllocator<> m_FastAllocator;
+        SSAutoDeallocatorAllocator m_LargeAllocator;
+
+        SPerFrameAllocator(NVAllocatorCallback &baseAllocator)
+            : m_FastAllocator(baseAllocator, "PerFrameAllocation")
+            , m_LargeAllocator(baseAllocator)
+        {
+        }
+
+        inline void *allocate(size_t inSize, const char *inFile, int inLine)
+        {
+            if (inSize < 8192)
+                return m_FastAllocator.allocate(inSize, "PerFrameAllocation", inFile, inLine, 0);
+            else
+                return m_LargeAllocator.allocate(inSize, "PerFrameAllocation", inFile, inLine, 0);
+        }
+
+        inline void *allocate(size_t inSize, const char *inFile, int inLine, int, int)
+        {
+            if (inSize < 8192)
+                return m_FastAllocator.allocate(inSize, "PerFrameAllocation", inFile, inLine, 0);
+            else
+                return m_LargeAllocator.allocate(inSize, "PerFrameAllocation", inFile, inLine, 0);
+        }
+
+        inline void deallocate(void *, size_t) {}
+
+        void reset()
+        {
+            m_FastAllocator.reset();
+            m_LargeAllocator.deallocateAllAllocations();
+        }
+
+        void *allocate(size_t inSize, const char *typeName, const char *inFile, int inLine,
+                               int flags = 0) override
+        {
+            if (inSize < SFastAllocator<>::SlabSize)
+                return m_FastAllocator.allocate(inSize, typeName, inFile, inLine, flags);
+            else
+                return m_LargeAllocator.allocate(inSize, typeName, inFile, inLine, flags);
+        }
+
+        void *allocate(size_t inSize, const char *typeName, const char *inFile, int inLine,
+                               size_t alignment, size_t alignmentOffset) override
+        {
+            if (inSize < SFastAllocator<>::SlabSize)
+                return m_FastAllocator.allocate(inSize, typeName, inFile, inLine, alignment,
+                                                alignmentOffset);
+            else
+                return m_LargeAllocator.allocate(inSize, typeName, inFile, inLine, alignment,
+                                                 alignmentOffset);
+        }
+
+        void deallocate(void *) override {}
+    };
+}
+}
+
+#endif
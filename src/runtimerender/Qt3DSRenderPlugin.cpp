@@ -427,6 +427,10 @@ struct InstanceImpl : public IRenderPluginInstance
         return false;
     }
 
+    // Plugins decide in NeedsRender if they have new content, which can only be asked while
+    // rendering.
+    bool IsUpdateRequested() override { return true; }
+
     TRenderPluginInstancePtr GetRenderPluginInstance() override { return m_Instance; }
     void Update(NVConstDataRef<SRenderPropertyValueUpdate> updateBuffer) override
     {
@@ -46,6 +46,11 @@
 
 #include <QtCore/qstring.h>
 #include <QtCore/qdatastream.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qsavefile.h>
+#include <QtCore/qdatetime.h>
+#include <QtCore/qcryptographichash.h>
 
 using namespace qt3ds::render;
 
@@ -141,6 +146,13 @@ struct ShaderCache : public IShaderCache
     };
     QVector<ShaderSource> m_shaderSourceCache;
 
+    // Persistent per program binary cache
+    QString m_persistentCacheDir;
+    qint64 m_persistentCacheMaxSize = 0;
+    qint64 m_persistentCacheSize = 0;
+    QByteArray m_driverFingerprint;
+    bool m_persistentCacheInitialized = false;
+
     ShaderCache(NVRenderContext &ctx, IInputStreamFactory &inInputStreamFactory,
                 IPerfTimer &inPerfTimer)
         : m_RenderContext(ctx)
@@ -148,6 +160,13 @@ struct ShaderCache : public IShaderCache
         , m_Shaders(ctx.GetAllocator(), "ShaderCache::m_Shaders")
         , m_InputStreamFactory(inInputStreamFactory)
     {
+        const QString cacheDir = qEnvironmentVariable("QT3DS_SHADER_CACHE_DIR");
+        if (!cacheDir.isEmpty()) {
+            setPersistentCacheDirectory(
+                        cacheDir,
+                        qint64(qEnvironmentVariableIntValue("QT3DS_SHADER_CACHE_MAX_SIZE"))
+                        * 1024 * 1024);
+        }
     }
     QT3DS_IMPLEMENT_REF_COUNT_ADDREF_RELEASE_OVERRIDE(m_RenderContext.GetAllocator())
 
@@ -449,13 +468,28 @@ struct ShaderCache : public IShaderCache
         if (!fromDisk)
             addShaderPreprocessors(inKey, inFlags, inFeatures, separableProgram, false);
 
-        NVRenderVertFragCompilationResult res = m_RenderContext
-                .CompileSource(inKey, m_VertexCode.c_str(), QT3DSU32(m_VertexCode.size()),
-                               m_FragmentCode.c_str(), QT3DSU32(m_FragmentCode.size()),
-                               m_TessCtrlCode.c_str(), QT3DSU32(m_TessCtrlCode.size()),
-                               m_TessEvalCode.c_str(), QT3DSU32(m_TessEvalCode.size()),
-                               m_GeometryCode.c_str(), QT3DSU32(m_GeometryCode.size()),
-                               separableProgram);
+        QString persistentFile;
+        QByteArray sourceHash;
+        NVRenderVertFragCompilationResult res;
+        // Separable programs need to be flagged before linking, so they can't be loaded from
+        // a binary.
+        if (!fromDisk && !separableProgram && isPersistentCacheEnabled()) {
+            persistentFile = persistentCacheFilePath(inKey, inFeatures);
+            sourceHash = generatedSourceHash();
+            res = loadPersistentProgram(inKey, persistentFile, sourceHash);
+        }
+
+        if (!res.mShader) {
+            res = m_RenderContext
+                    .CompileSource(inKey, m_VertexCode.c_str(), QT3DSU32(m_VertexCode.size()),
+                                   m_FragmentCode.c_str(), QT3DSU32(m_FragmentCode.size()),
+                                   m_TessCtrlCode.c_str(), QT3DSU32(m_TessCtrlCode.size()),
+                                   m_TessEvalCode.c_str(), QT3DSU32(m_TessEvalCode.size()),
+                                   m_GeometryCode.c_str(), QT3DSU32(m_GeometryCode.size()),
+                                   separableProgram);
+            if (res.mShader && !persistentFile.isEmpty())
+                storePersistentProgram(*res.mShader, persistentFile, sourceHash);
+        }
         theInserter.first->second = res.mShader;
         errors = res.errors;
 
@@ -687,6 +721,188 @@ struct ShaderCache : public IShaderCache
     {
         m_ShaderCompilationEnabled = inEnableShaderCompilation;
     }
+
+    // Magic number to identify persistent cache entries
+    const quint32 persistentCacheFileId = 0x26a9b359;
+
+    void setPersistentCacheDirectory(const QString &inDirectory, qint64 inMaxSize) override
+    {
+        m_persistentCacheDir = inDirectory;
+        m_persistentCacheMaxSize = inMaxSize;
+        m_persistentCacheSize = 0;
+        m_persistentCacheInitialized = false;
+    }
+
+    // The driver can only be queried with a current context, so the cache directory is set up
+    // when the first program is compiled.
+    bool isPersistentCacheEnabled()
+    {
+        if (m_persistentCacheDir.isEmpty())
+            return false;
+        if (m_persistentCacheInitialized)
+            return true;
+
+        if (!m_RenderContext.isBinaryProgramSupported()) {
+            qCWarning(WARNING) << "Persistent shader cache disabled:"
+                               << "binary programs are not supported";
+            m_persistentCacheDir.clear();
+            return false;
+        }
+        QDir dir(m_persistentCacheDir);
+        if (!dir.mkpath(QStringLiteral("."))) {
+            qCWarning(WARNING) << "Persistent shader cache disabled: cannot create"
+                               << m_persistentCacheDir;
+            m_persistentCacheDir.clear();
+            return false;
+        }
+
+        QCryptographicHash fingerprint(QCryptographicHash::Sha1);
+        fingerprint.addData(m_RenderContext.GetDriverDescription());
+        fingerprint.addData(QByteArray::number(
+                                QT3DSU32(m_RenderContext.GetRenderContextType())));
+        fingerprint.addData(QByteArray::number(m_RenderContext.format().majorVersion()));
+        fingerprint.addData(QByteArray::number(m_RenderContext.format().minorVersion()));
+        fingerprint.addData(QByteArray::number(IShaderCache::shaderCacheVersion()));
+        m_driverFingerprint = fingerprint.result();
+
+        const QFileInfoList entries = dir.entryInfoList(QDir::Files);
+        for (const QFileInfo &entry : entries)
+            m_persistentCacheSize += entry.size();
+
+        m_persistentCacheInitialized = true;
+        return true;
+    }
+
+    QString persistentCacheFilePath(CRegisteredString inKey,
+                                    NVConstDataRef<SShaderPreprocessorFeature> inFeatures) const
+    {
+        QCryptographicHash hash(QCryptographicHash::Sha1);
+        hash.addData(m_driverFingerprint);
+        hash.addData(QByteArray(inKey.c_str()));
+        for (QT3DSU32 idx = 0, end = inFeatures.size(); idx < end; ++idx) {
+            hash.addData(QByteArray(inFeatures[idx].m_Name.c_str()));
+            hash.addData(inFeatures[idx].m_Enabled ? "1" : "0", 1);
+        }
+        return m_persistentCacheDir + QLatin1Char('/')
+                + QString::fromLatin1(hash.result().toHex()) + QStringLiteral(".bin");
+    }
+
+    // Hash of the generated sources, so that entries written for an older version of a shader
+    // using the same key are never used.
+    QByteArray generatedSourceHash() const
+    {
+        QCryptographicHash hash(QCryptographicHash::Sha1);
+        const Qt3DSString *sources[] = { &m_VertexCode, &m_FragmentCode, &m_TessCtrlCode,
+                                         &m_TessEvalCode, &m_GeometryCode };
+        for (const Qt3DSString *source : sources) {
+            hash.addData(source->toUtf8());
+            hash.addData("\0", 1);
+        }
+        return hash.result();
+    }
+
+    void removePersistentEntry(const QString &inPath)
+    {
+        QFile file(inPath);
+        const qint64 size = file.size();
+        if (file.remove())
+            m_persistentCacheSize = qMax(qint64(0), m_persistentCacheSize - size);
+    }
+
+    NVRenderVertFragCompilationResult loadPersistentProgram(CRegisteredString inKey,
+                                                            const QString &inPath,
+                                                            const QByteArray &inSourceHash)
+    {
+        NVRenderVertFragCompilationResult res;
+        QFile file(inPath);
+        if (!file.open(QIODevice::ReadOnly))
+            return res;
+
+        QT3DS_PERF_SCOPED_TIMER(m_PerfTimer, "ShaderCache: Persistent load")
+        QDataStream data(&file);
+        quint32 type = 0;
+        quint32 version = 0;
+        QByteArray fingerprint;
+        QByteArray sourceHash;
+        QT3DSU32 format = 0;
+        QByteArray binary;
+        QByteArray checksum;
+        data >> type >> version >> fingerprint >> sourceHash >> format >> binary >> checksum;
+        file.close();
+
+        if (data.status() != QDataStream::Ok || type != persistentCacheFileId
+                || version != IShaderCache::shaderCacheVersion()
+                || fingerprint != m_driverFingerprint || sourceHash != inSourceHash
+                || checksum != QCryptographicHash::hash(binary, QCryptographicHash::Sha1)) {
+            qCInfo(TRACE_INFO) << "Discarding stale persistent shader cache entry: '<"
+                               << inKey << ">'";
+            removePersistentEntry(inPath);
+            return res;
+        }
+
+        res = m_RenderContext.CompileBinary(inKey, format, binary);
+        if (!res.mShader || !res.errors.isEmpty()) {
+            qCInfo(TRACE_INFO) << "Discarding rejected persistent shader cache entry: '<"
+                               << inKey << ">'";
+            removePersistentEntry(inPath);
+            return NVRenderVertFragCompilationResult();
+        }
+
+        qCInfo(TRACE_INFO) << "Loaded from persistent shader cache: '<" << inKey << ">'";
+        // Modification time is used as the last use time for eviction
+        if (file.open(QIODevice::ReadWrite)) {
+            file.setFileTime(QDateTime::currentDateTimeUtc(), QFileDevice::FileModificationTime);
+            file.close();
+        }
+        return res;
+    }
+
+    void storePersistentProgram(NVRenderShaderProgram &inProgram, const QString &inPath,
+                                const QByteArray &inSourceHash)
+    {
+        QT3DSU32 format = 0;
+        QByteArray binary;
+        inProgram.getProgramBinary(format, binary);
+        if (binary.isEmpty())
+            return;
+
+        QSaveFile file(inPath);
+        if (!file.open(QIODevice::WriteOnly))
+            return;
+        QDataStream data(&file);
+        data << persistentCacheFileId << IShaderCache::shaderCacheVersion() << m_driverFingerprint
+             << inSourceHash << format << binary
+             << QCryptographicHash::hash(binary, QCryptographicHash::Sha1);
+        const qint64 size = file.size();
+        if (!file.commit())
+            return;
+
+        m_persistentCacheSize += size;
+        evictPersistentCache(inPath);
+    }
+
+    // Removes least recently used entries until the cache fits within its maximum size
+    void evictPersistentCache(const QString &inKeepPath)
+    {
+        if (m_persistentCacheMaxSize <= 0 || m_persistentCacheSize <= m_persistentCacheMaxSize)
+            return;
+
+        QDir dir(m_persistentCacheDir);
+        const QFileInfoList entries = dir.entryInfoList(QDir::Files,
+                                                        QDir::Time | QDir::Reversed);
+        m_persistentCacheSize = 0;
+        for (const QFileInfo &entry : entries)
+            m_persistentCacheSize += entry.size();
+
+        for (const QFileInfo &entry : entries) {
+            if (m_persistentCacheSize <= m_persistentCacheMaxSize)
+                break;
+            if (entry.absoluteFilePath() == QFileInfo(inKeepPath).absoluteFilePath())
+                continue;
+            if (QFile::remove(entry.absoluteFilePath()))
+                m_persistentCacheSize -= entry.size();
+        }
+    }
 };
 }
 
@@ -151,6 +151,16 @@ namespace render {
         // only current use case.
         virtual void SetShaderCompilationEnabled(bool inEnableShaderCompilation) = 0;
 
+        // Persistent program binary cache. Each compiled program is written to its own file in
+        // the directory, keyed by the shader key, feature set and driver. ForceCompileProgram
+        // loads the binary from there instead of compiling when the generated source matches.
+        // The oldest used files are removed when the directory grows over inMaxSize bytes,
+        // zero means no limit. An empty directory disables the persistent cache.
+        // The environment variables QT3DS_SHADER_CACHE_DIR and QT3DS_SHADER_CACHE_MAX_SIZE
+        // (in megabytes) enable it for the whole application.
+        virtual void setPersistentCacheDirectory(const QString &inDirectory,
+                                                 qint64 inMaxSize = 0) = 0;
+
         // Upping the shader version invalidates all previous cache files.
         static quint32 shaderCacheVersion() { return 1; }
 
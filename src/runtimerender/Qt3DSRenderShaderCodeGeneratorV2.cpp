@@ -37,6 +37,7 @@
 #include "Qt3DSRenderContextCore.h"
 #include "Qt3DSRenderDynamicObjectSystem.h"
 
+#include "EASTL/algorithm.h"
 #include <QtGui/qopengl.h>
 
 using namespace qt3ds::render;
@@ -52,6 +53,9 @@ struct SStageGeneratorBase : public IShaderStageGenerator
     TStrTableStrMap m_Uniforms;
     TStrTableStrMap m_ConstantBuffers;
     TConstantBufferParamArray m_ConstantBufferParams;
+    // Uniforms routed into std140 uniform blocks; owned by the program generator.
+    const TConstantBufferParamArray *m_UniformBlockMembers;
+    nvvector<CRegisteredString> m_UsedUniformBlocks;
     Qt3DSString m_CodeBuilder;
     Qt3DSString m_FinalBuilder;
     ShaderGeneratorStages::Enum m_Stage;
@@ -69,6 +73,8 @@ struct SStageGeneratorBase : public IShaderStageGenerator
         , m_Uniforms(inFnd.getAllocator(), "m_Uniforms")
         , m_ConstantBuffers(inFnd.getAllocator(), "m_ConstantBuffers")
         , m_ConstantBufferParams(inFnd.getAllocator(), "m_ConstantBufferParams")
+        , m_UniformBlockMembers(NULL)
+        , m_UsedUniformBlocks(inFnd.getAllocator(), "m_UsedUniformBlocks")
         , m_Stage(inStage)
     {
     }
@@ -81,6 +87,7 @@ struct SStageGeneratorBase : public IShaderStageGenerator
         m_Uniforms.clear();
         m_ConstantBuffers.clear();
         m_ConstantBufferParams.clear();
+        m_UsedUniformBlocks.clear();
         m_CodeBuilder.clear();
         m_FinalBuilder.clear();
         m_EnabledStages = inEnabledStages;
@@ -219,7 +226,64 @@ struct SStageGeneratorBase : public IShaderStageGenerator
 
     virtual void AddShaderIncomingMap() { AddShaderItemMap(GetIncomingVariableName(), m_Incoming); }
 
-    virtual void AddShaderUniformMap() { AddShaderItemMap("uniform", m_Uniforms); }
+    CRegisteredString FindUniformBlock(CRegisteredString inUniform) const
+    {
+        for (TConstantBufferParamArray::const_iterator iter = m_UniformBlockMembers->begin(),
+                                                       end = m_UniformBlockMembers->end();
+             iter != end; ++iter) {
+            if (iter->second.first == inUniform)
+                return iter->first;
+        }
+        return CRegisteredString();
+    }
+
+    virtual void AddShaderUniformMap()
+    {
+        if (m_UniformBlockMembers == NULL || m_UniformBlockMembers->empty()) {
+            AddShaderItemMap("uniform", m_Uniforms);
+            return;
+        }
+
+        m_FinalBuilder.append("\n");
+
+        // Uniforms routed into a block are declared through it. A stage declares all members of
+        // every block it touches, so each stage sees the same std140 layout.
+        m_UsedUniformBlocks.clear();
+        for (TStrTableStrMap::const_iterator iter = m_Uniforms.begin(), end = m_Uniforms.end();
+             iter != end; ++iter) {
+            CRegisteredString theBlock = FindUniformBlock(iter->first);
+            if (theBlock.IsValid()) {
+                if (eastl::find(m_UsedUniformBlocks.begin(), m_UsedUniformBlocks.end(), theBlock)
+                    == m_UsedUniformBlocks.end()) {
+                    m_UsedUniformBlocks.push_back(theBlock);
+                }
+                continue;
+            }
+            m_FinalBuilder.append("uniform ");
+            m_FinalBuilder.append(iter->second);
+            m_FinalBuilder.append(" ");
+            m_FinalBuilder.append(iter->first);
+            m_FinalBuilder.append(";\n");
+        }
+
+        for (QT3DSU32 idx = 0, end = m_UsedUniformBlocks.size(); idx < end; ++idx) {
+            m_FinalBuilder.append("layout(std140) uniform ");
+            m_FinalBuilder.append(m_UsedUniformBlocks[idx]);
+            m_FinalBuilder.append(" {\n");
+            for (TConstantBufferParamArray::const_iterator iter = m_UniformBlockMembers->begin(),
+                                                           memberEnd = m_UniformBlockMembers->end();
+                 iter != memberEnd; ++iter) {
+                if (iter->first == m_UsedUniformBlocks[idx]) {
+                    m_FinalBuilder.append("    ");
+                    m_FinalBuilder.append(iter->second.second);
+                    m_FinalBuilder.append(" ");
+                    m_FinalBuilder.append(iter->second.first);
+                    m_FinalBuilder.append(";\n");
+                }
+            }
+            m_FinalBuilder.append("};\n");
+        }
+    }
 
     virtual void AddShaderOutgoingMap()
     {
@@ -420,6 +484,7 @@ struct SProgramGenerator : public IShaderProgramGenerator
     SFragmentShaderGenerator m_FS;
 
     TShaderGeneratorStageFlags m_EnabledStages;
+    TConstantBufferParamArray m_UniformBlockMembers;
 
     QT3DSI32 m_RefCount;
 
@@ -430,8 +495,14 @@ struct SProgramGenerator : public IShaderProgramGenerator
         , m_TE(inContext.GetFoundation(), inContext.GetStringTable())
         , m_GS(inContext.GetFoundation(), inContext.GetStringTable())
         , m_FS(inContext.GetFoundation(), inContext.GetStringTable())
+        , m_UniformBlockMembers(inContext.GetAllocator(), "m_UniformBlockMembers")
         , m_RefCount(0)
     {
+        m_VS.m_UniformBlockMembers = &m_UniformBlockMembers;
+        m_TC.m_UniformBlockMembers = &m_UniformBlockMembers;
+        m_TE.m_UniformBlockMembers = &m_UniformBlockMembers;
+        m_GS.m_UniformBlockMembers = &m_UniformBlockMembers;
+        m_FS.m_UniformBlockMembers = &m_UniformBlockMembers;
     }
 
     void addRef() override { atomicIncrement(&m_RefCount); }
@@ -471,9 +542,19 @@ struct SProgramGenerator : public IShaderProgramGenerator
         m_GS.Begin(inEnabledStages);
         m_FS.Begin(inEnabledStages);
         m_EnabledStages = inEnabledStages;
+        m_UniformBlockMembers.clear();
         LinkStages();
     }
 
+    void AddUniformBlockMember(const char8_t *inBlockName, const char8_t *inName,
+                               const char8_t *inType) override
+    {
+        IStringTable &theStrings(m_Context.GetStringTable());
+        m_UniformBlockMembers.push_back(TConstantBufferParamPair(
+            theStrings.RegisterStr(inBlockName),
+            TParamPair(theStrings.RegisterStr(inName), theStrings.RegisterStr(inType))));
+    }
+
     TShaderGeneratorStageFlags GetEnabledStages() const override { return m_EnabledStages; }
 
     SStageGeneratorBase &InternalGetStage(ShaderGeneratorStages::Enum inStage)
@@ -107,6 +107,13 @@ namespace render {
 
         virtual TShaderGeneratorStageFlags GetEnabledStages() const = 0;
 
+        // Declare inName as a member of the std140 uniform block inBlockName for the program
+        // being generated. Members are laid out in the order they are added and stages that use
+        // any of them declare the whole block instead of plain uniforms.
+        // BeginProgram clears the block members.
+        virtual void AddUniformBlockMember(const char8_t *inBlockName, const char8_t *inName,
+                                           const char8_t *inType) = 0;
+
         // get the stage or NULL if it has not been created.
         virtual IShaderStageGenerator *GetStage(ShaderGeneratorStages::Enum inStage) = 0;
 
@@ -29,6 +29,7 @@
 ****************************************************************************/
 #include "Qt3DSRenderTextTextureCache.h"
 #include "Qt3DSTextRenderer.h"
+#include "Qt3DSRenderJobSystem.h"
 #include "foundation/Qt3DSContainers.h"
 #include "foundation/Qt3DSAtomic.h"
 #include "foundation/Qt3DSFoundation.h"
@@ -129,6 +130,52 @@ struct STextCacheNode
 };
 
 typedef nvhash_map<STextRenderInfoAndHash, STextCacheNode *> TTextureInfoHash;
+typedef nvhash_map<NVRenderTexture2D *, STextCacheNode *> TTextureNodeHash;
+
+// Text rasterized on the job system. Every element showing the same text shares the job until
+// the render thread uploads the result.
+struct STextRasterJob
+{
+    ITextRenderer &m_TextRenderer;
+    STextRenderInfo m_Info;
+    STextRaster m_Raster;
+    QT3DSU32 m_StartFrame;
+    // Last frame an element waited for the text. Jobs nobody waits for are dropped.
+    QT3DSU32 m_RequestFrame;
+    SJobGroup m_Group;
+
+    STextRasterJob(ITextRenderer &inTextRenderer, const STextRenderInfo &inInfo,
+                   QT3DSU32 inStartFrame)
+        : m_TextRenderer(inTextRenderer)
+        , m_Info(inInfo)
+        , m_StartFrame(inStartFrame)
+        , m_RequestFrame(inStartFrame)
+    {
+    }
+
+    static void Rasterize(void *inUserData)
+    {
+        STextRasterJob &theJob(*reinterpret_cast<STextRasterJob *>(inUserData));
+        theJob.m_TextRenderer.RasterizeText(theJob.m_Info, theJob.m_Raster);
+    }
+};
+
+typedef nvhash_map<STextRenderInfoAndHash, STextRasterJob *> TRasterJobHash;
+
+// The text an element asked for last while it still shows an older texture.
+struct SPendingText
+{
+    STextRenderInfoAndHash m_Key;
+    QT3DSU32 m_RequestFrame;
+
+    SPendingText(const STextRenderInfoAndHash &inKey, QT3DSU32 inRequestFrame)
+        : m_Key(inKey)
+        , m_RequestFrame(inRequestFrame)
+    {
+    }
+};
+
+typedef nvhash_map<const void *, SPendingText> TPendingTextHash;
 
 DEFINE_INVASIVE_LIST(TextCacheNode);
 IMPLEMENT_INVASIVE_LIST(TextCacheNode, m_PreviousSibling, m_NextSibling);
@@ -140,27 +187,45 @@ struct STextTextureCache : public ITextTextureCache
     volatile QT3DSI32 mRefCount;
     NVScopedRefCounted<ITextRenderer> m_TextRenderer;
     TTextureInfoHash m_TextureCache;
+    TTextureNodeHash m_TextureNodes;
+    TRasterJobHash m_RasterJobs;
+    TPendingTextHash m_PendingTexts;
     TTextCacheNodeList m_LRUList;
     TPoolType m_CacheNodePool;
     QT3DSU32 m_HighWaterMark;
     QT3DSU32 m_FrameCount;
     QT3DSU32 m_TextureTotalBytes;
     NVScopedRefCounted<NVRenderContext> m_RenderContext;
+    IJobSystem *m_JobSystem;
+    // Frames a changed text may keep showing its previous texture while it is rasterized.
+    QT3DSU32 m_RasterLatency;
+    bool m_AsyncRaster;
     bool m_CanUsePathRendering; ///< true if we use hardware accelerated font rendering
 
     STextTextureCache(NVFoundationBase &inFnd, ITextRenderer &inRenderer,
-                      NVRenderContext &inRenderContext)
+                      NVRenderContext &inRenderContext, IJobSystem *inJobSystem)
         : m_Foundation(inFnd)
         , mRefCount(0)
         , m_TextRenderer(inRenderer)
         , m_TextureCache(m_Foundation.getAllocator(), "STextTextureCache::m_TextureCache")
+        , m_TextureNodes(m_Foundation.getAllocator(), "STextTextureCache::m_TextureNodes")
+        , m_RasterJobs(m_Foundation.getAllocator(), "STextTextureCache::m_RasterJobs")
+        , m_PendingTexts(m_Foundation.getAllocator(), "STextTextureCache::m_PendingTexts")
         , m_CacheNodePool(ForwardingAllocator(m_Foundation.getAllocator(),
                                               "STextTextureCache::m_CacheNodePool"))
         , m_HighWaterMark(0x100000)
         , m_FrameCount(0)
         , m_TextureTotalBytes(0)
         , m_RenderContext(inRenderContext)
+        , m_JobSystem(inJobSystem)
+        , m_RasterLatency(1)
     {
+        bool isSet = false;
+        int latency = qEnvironmentVariableIntValue("QT3DS_TEXT_RASTER_LATENCY", &isSet);
+        if (isSet && latency >= 0)
+            m_RasterLatency = QT3DSU32(latency);
+        m_AsyncRaster = m_JobSystem && m_RasterLatency > 0
+                && m_TextRenderer->SupportsRasterizeText();
         // hardware accelerate font rendering not ready yet
         m_CanUsePathRendering = (m_RenderContext->IsPathRenderingSupported()
                                  && m_RenderContext->IsProgramPipelineSupported());
@@ -168,6 +233,11 @@ struct STextTextureCache : public ITextTextureCache
 
     virtual ~STextTextureCache()
     {
+        for (TRasterJobHash::iterator iter = m_RasterJobs.begin(), end = m_RasterJobs.end();
+             iter != end; ++iter) {
+            m_JobSystem->Wait(iter->second->m_Group);
+            NVDelete(m_Foundation.getAllocator(), iter->second);
+        }
         for (TTextCacheNodeList::iterator iter = m_LRUList.begin(), end = m_LRUList.end();
              iter != end; ++iter)
             iter->~STextCacheNode();
@@ -182,16 +252,25 @@ struct STextTextureCache : public ITextTextureCache
             * NVRenderTextureFormats::getSizeofFormat(theDetails.m_Format);
     }
 
+    // A texture drawn the previous frame may still be shown while its replacement is being
+    // rasterized, so it cannot be recycled yet.
+    bool IsInUse(const STextCacheNode &inNode) const
+    {
+        // algorithm is resistant to rollover.
+        return m_FrameCount - inNode.m_FrameCount <= (m_AsyncRaster ? 1u : 0u);
+    }
+
     NVScopedRefCounted<NVRenderTexture2D> InvalidateLastItem()
     {
         NVScopedRefCounted<NVRenderTexture2D> nextTexture;
         if (m_LRUList.empty() == false) {
             STextCacheNode &theEnd = m_LRUList.back();
-            if (theEnd.m_FrameCount != m_FrameCount) {
+            if (!IsInUse(theEnd)) {
                 nextTexture = theEnd.m_TextInfo.second.second;
                 STextureDetails theDetails = nextTexture->GetTextureDetails();
                 m_TextureTotalBytes -= GetNumBytes(*nextTexture.mPtr);
                 m_LRUList.remove(theEnd);
+                m_TextureNodes.erase(nextTexture.mPtr);
                 // copy the key because the next statement will destroy memory
                 m_TextureCache.erase(theEnd.m_RenderInfo);
                 theEnd.~STextCacheNode();
@@ -201,6 +280,87 @@ struct STextTextureCache : public ITextTextureCache
         return nextTexture;
     }
 
+    NVScopedRefCounted<NVRenderTexture2D> NextTexture()
+    {
+        NVScopedRefCounted<NVRenderTexture2D> nextTexture;
+        if (m_TextureTotalBytes >= m_HighWaterMark && m_LRUList.empty() == false)
+            nextTexture = InvalidateLastItem();
+
+        if (nextTexture.mPtr == NULL)
+            nextTexture = m_RenderContext->CreateTexture2D();
+        return nextTexture;
+    }
+
+    void Touch(STextCacheNode &inNode)
+    {
+        m_LRUList.remove(inNode);
+        inNode.m_FrameCount = m_FrameCount;
+        m_LRUList.push_front(inNode);
+    }
+
+    STextCacheNode *InsertNode(const STextRenderInfoAndHash &inKey,
+                               STextTextureDetails inDetails,
+                               const TPathFontSpecAndPathObject &inPathFont,
+                               const NVScopedRefCounted<NVRenderTexture2D> &inTexture)
+    {
+        if (fabs(inKey.m_ScaleFactor - 1.0f) > .001f) {
+            TTPathObjectAndTexture theCanonicalDetails = RenderText(inKey.m_Info, 1.0f);
+            inDetails.m_ScaleFactor.x =
+                (QT3DSF32)inDetails.m_TextWidth / theCanonicalDetails.second.first.m_TextWidth;
+            inDetails.m_ScaleFactor.y =
+                (QT3DSF32)inDetails.m_TextHeight / theCanonicalDetails.second.first.m_TextHeight;
+        }
+        STextCacheNode *retval = m_CacheNodePool.construct(
+            inKey, TTPathObjectAndTexture(inPathFont,
+                                          TTextTextureDetailsAndTexture(inDetails, inTexture)),
+            __FILE__, __LINE__);
+        m_TextureCache.insert(eastl::make_pair(inKey, retval));
+        m_TextureNodes.insert(eastl::make_pair(inTexture.mPtr, retval));
+        if (!m_CanUsePathRendering)
+            m_TextureTotalBytes += GetNumBytes(*inTexture.mPtr);
+        retval->m_FrameCount = m_FrameCount;
+        m_LRUList.push_front(*retval);
+        return retval;
+    }
+
+    // Starts rasterizing the text unless it is cached or being rasterized already, and keeps
+    // its job from being dropped at the end of the frame.
+    void RequestRasterJob(const STextRenderInfoAndHash &inKey)
+    {
+        if (m_TextureCache.find(inKey) != m_TextureCache.end())
+            return;
+        TRasterJobHash::iterator theFind = m_RasterJobs.find(inKey);
+        if (theFind != m_RasterJobs.end()) {
+            theFind->second->m_RequestFrame = m_FrameCount;
+        } else {
+            STextRenderInfo theTextInfo(inKey.m_Info);
+            theTextInfo.m_FontSize *= inKey.m_ScaleFactor;
+            STextRasterJob *theJob = QT3DS_NEW(m_Foundation.getAllocator(), STextRasterJob)(
+                        *m_TextRenderer, theTextInfo, m_FrameCount);
+            m_RasterJobs.insert(eastl::make_pair(inKey, theJob));
+            m_JobSystem->Run(&theJob->m_Group, theJob, &STextRasterJob::Rasterize);
+            // Seal the group so IsDone reports when the text has been rasterized.
+            m_JobSystem->Then(theJob->m_Group, nullptr, nullptr);
+        }
+        // The scale factor of scaled text is relative to the canonical text.
+        if (fabs(inKey.m_ScaleFactor - 1.0f) > .001f)
+            RequestRasterJob(STextRenderInfoAndHash(inKey.m_Info, 1.0f));
+    }
+
+    // Uploads rasterized text, waiting for the job if it has not finished yet.
+    STextCacheNode *FinishRasterJob(TRasterJobHash::iterator inJob)
+    {
+        STextRenderInfoAndHash theKey(inJob->first);
+        STextRasterJob *theJob = inJob->second;
+        m_RasterJobs.erase(inJob);
+        m_JobSystem->Wait(theJob->m_Group);
+        NVScopedRefCounted<NVRenderTexture2D> nextTexture(NextTexture());
+        STextTextureDetails theDetails =
+            ITextRenderer::UploadRaster(theJob->m_Raster, *nextTexture.mPtr);
+        NVDelete(m_Foundation.getAllocator(), theJob);
+        return InsertNode(theKey, theDetails, TPathFontSpecAndPathObject(), nextTexture);
+    }
+
     TTPathObjectAndTexture RenderText(const STextRenderInfo &inText, QT3DSF32 inScaleFactor) override
     {
         STextRenderInfoAndHash theKey(inText, inScaleFactor);
@@ -209,14 +369,13 @@ struct STextTextureCache : public ITextTextureCache
         STextCacheNode *retval = NULL;
         if (theFind != m_TextureCache.end()) {
             retval = theFind->second;
-            m_LRUList.remove(*retval);
+            Touch(*retval);
         } else {
-            NVScopedRefCounted<NVRenderTexture2D> nextTexture;
-            if (m_TextureTotalBytes >= m_HighWaterMark && m_LRUList.empty() == false)
-                nextTexture = InvalidateLastItem();
+            TRasterJobHash::iterator theJob = m_RasterJobs.find(theKey);
+            if (theJob != m_RasterJobs.end())
+                return FinishRasterJob(theJob)->m_TextInfo;
 
-            if (nextTexture.mPtr == NULL)
-                nextTexture = m_RenderContext->CreateTexture2D();
+            NVScopedRefCounted<NVRenderTexture2D> nextTexture(NextTexture());
 
             NVScopedRefCounted<NVRenderPathFontItem> nextPathFontItemObject;
             NVScopedRefCounted<NVRenderPathFontSpecification> nextPathFontObject;
@@ -238,27 +397,91 @@ struct STextTextureCache : public ITextTextureCache
             //    theDetails = m_TextRenderer->RenderText(theTextInfo, *nextPathFontItemObject.mPtr,
             //                                            *nextPathFontObject.mPtr);
 
-            if (fabs(inScaleFactor - 1.0f) > .001f) {
-                TTPathObjectAndTexture theCanonicalDetails = RenderText(inText, 1.0f);
-                theDetails.m_ScaleFactor.x =
-                    (QT3DSF32)theDetails.m_TextWidth / theCanonicalDetails.second.first.m_TextWidth;
-                theDetails.m_ScaleFactor.y =
-                    (QT3DSF32)theDetails.m_TextHeight / theCanonicalDetails.second.first.m_TextHeight;
-            }
-            retval = m_CacheNodePool.construct(
-                theKey, TTPathObjectAndTexture(
-                            TPathFontSpecAndPathObject(nextPathFontObject, nextPathFontItemObject),
-                            TTextTextureDetailsAndTexture(theDetails, nextTexture)),
-                __FILE__, __LINE__);
-            TTextureInfoHash::iterator insert =
-                m_TextureCache.insert(eastl::make_pair(theKey, retval)).first;
-            if (!m_CanUsePathRendering)
-                m_TextureTotalBytes += GetNumBytes(*(retval->m_TextInfo.second.second.mPtr));
+            retval = InsertNode(
+                theKey, theDetails,
+                TPathFontSpecAndPathObject(nextPathFontObject, nextPathFontItemObject),
+                nextTexture);
         }
-        retval->m_FrameCount = m_FrameCount;
-        m_LRUList.push_front(*retval);
         return retval->m_TextInfo;
     }
+
+    bool RenderTextAsync(const void *inElement, const STextRenderInfo &inText,
+                         QT3DSF32 inScaleFactor, NVRenderTexture2D *inPreviousTexture,
+                         TTPathObjectAndTexture &outResult) override
+    {
+        STextRenderInfoAndHash theKey(inText, inScaleFactor);
+        TTextureNodeHash::iterator thePrevious = m_TextureNodes.find(inPreviousTexture);
+        if (!m_AsyncRaster || m_TextureCache.find(theKey) != m_TextureCache.end()
+            || thePrevious == m_TextureNodes.end() || !IsInUse(*thePrevious->second)) {
+            m_PendingTexts.erase(inElement);
+            outResult = RenderText(inText, inScaleFactor);
+            return true;
+        }
+
+        STextCacheNode *theShown = thePrevious->second;
+        TPendingTextHash::iterator thePending = m_PendingTexts.find(inElement);
+        if (thePending != m_PendingTexts.end()) {
+            // Text changing every frame supersedes its pending text before that is uploaded.
+            // The pending text is still shown once it is ready, so the element keeps updating
+            // while it changes.
+            STextRenderInfoAndHash thePendingKey(thePending->second.m_Key);
+            STextCacheNode *theNewer = NULL;
+            TTextureInfoHash::iterator theDone = m_TextureCache.find(thePendingKey);
+            TRasterJobHash::iterator theJob = m_RasterJobs.find(thePendingKey);
+            if (theDone != m_TextureCache.end()) {
+                theNewer = theDone->second;
+            } else if (theJob != m_RasterJobs.end()) {
+                STextRasterJob &thePendingJob(*theJob->second);
+                if (!thePendingJob.m_Group.IsDone()
+                    && m_FrameCount - thePendingJob.m_StartFrame < m_RasterLatency) {
+                    thePending->second.m_RequestFrame = m_FrameCount;
+                    RequestRasterJob(thePendingKey);
+                    Touch(*theShown);
+                    outResult = theShown->m_TextInfo;
+                    return false;
+                }
+                theNewer = FinishRasterJob(theJob);
+            }
+            m_PendingTexts.erase(inElement);
+            if (theNewer) {
+                Touch(*theNewer);
+                if (theNewer->m_RenderInfo == theKey) {
+                    outResult = theNewer->m_TextInfo;
+                    return true;
+                }
+                theShown = theNewer;
+            }
+        }
+
+        RequestRasterJob(theKey);
+        m_PendingTexts.insert(eastl::make_pair(inElement, SPendingText(theKey, m_FrameCount)));
+        Touch(*theShown);
+        outResult = theShown->m_TextInfo;
+        return false;
+    }
+
+    // Forgets elements that were not prepared this frame and drops the text nobody waits for
+    // anymore once it has been rasterized, so superseded text does not accumulate.
+    void DropUnusedRasterJobs()
+    {
+        for (TPendingTextHash::iterator iter = m_PendingTexts.begin();
+             iter != m_PendingTexts.end();) {
+            if (iter->second.m_RequestFrame != m_FrameCount)
+                iter = m_PendingTexts.erase(iter);
+            else
+                ++iter;
+        }
+        for (TRasterJobHash::iterator iter = m_RasterJobs.begin(); iter != m_RasterJobs.end();) {
+            STextRasterJob *theJob = iter->second;
+            if (theJob->m_RequestFrame != m_FrameCount && theJob->m_Group.IsDone()) {
+                iter = m_RasterJobs.erase(iter);
+                NVDelete(m_Foundation.getAllocator(), theJob);
+            } else {
+                ++iter;
+            }
+        }
+    }
+
     // We may have one more texture in cache than this byte count, but this will be the limiting
     // factor.
     QT3DSU32 GetCacheHighWaterBytes() const override { return m_HighWaterMark; }
@@ -268,6 +491,7 @@ struct STextTextureCache : public ITextTextureCache
     void BeginFrame() override {}
     void EndFrame() override
     {
+        DropUnusedRasterJobs();
         // algorithm is resistant to rollover.
         ++m_FrameCount;
         // Release any texture that put us over the limit.
@@ -283,7 +507,9 @@ struct STextTextureCache : public ITextTextureCache
 
 ITextTextureCache &ITextTextureCache::CreateTextureCache(NVFoundationBase &inFnd,
                                                          ITextRenderer &inTextRenderer,
-                                                         NVRenderContext &inRenderContext)
+                                                         NVRenderContext &inRenderContext,
+                                                         IJobSystem *inJobSystem)
 {
-    return *QT3DS_NEW(inFnd.getAllocator(), STextTextureCache)(inFnd, inTextRenderer, inRenderContext);
+    return *QT3DS_NEW(inFnd.getAllocator(), STextTextureCache)(inFnd, inTextRenderer,
+                                                              inRenderContext, inJobSystem);
 }
@@ -39,6 +39,7 @@ namespace qt3ds {
 namespace render {
 
     class ITextRenderer;
+    class IJobSystem;
 
     typedef eastl::pair<NVScopedRefCounted<NVRenderPathFontSpecification>,
                         NVScopedRefCounted<NVRenderPathFontItem>>
@@ -55,6 +56,18 @@ namespace render {
     public:
         virtual TTPathObjectAndTexture RenderText(const STextRenderInfo &inText,
                                                   QT3DSF32 inScaleFactor) = 0;
+        // Rasterizes the text on the job system when it is not cached yet. inElement identifies
+        // the text element across frames and inPreviousTexture is the texture it was drawn with
+        // the previous frame. outResult always receives the texture to draw; the return value
+        // is false while that is still older text, in which case the element should ask again
+        // the next frame. Rasterized text is uploaded at most QT3DS_TEXT_RASTER_LATENCY frames
+        // after it was requested, one by default; zero disables asynchronous rasterization.
+        // Text changing every frame skips the values superseded while older text was pending.
+        // The text is rendered synchronously when there is no previous texture or it was
+        // already released.
+        virtual bool RenderTextAsync(const void *inElement, const STextRenderInfo &inText,
+                                     QT3DSF32 inScaleFactor, NVRenderTexture2D *inPreviousTexture,
+                                     TTPathObjectAndTexture &outResult) = 0;
         // We may have one more texture in cache than this byte count, but this will be the limiting
         // factor.
         virtual QT3DSU32 GetCacheHighWaterBytes() const = 0;
@@ -67,7 +80,8 @@ namespace render {
 
         static ITextTextureCache &CreateTextureCache(NVFoundationBase &inFnd,
                                                      ITextRenderer &inTextRenderer,
-                                                     NVRenderContext &inRenderContext);
+                                                     NVRenderContext &inRenderContext,
+                                                     IJobSystem *inJobSystem = nullptr);
     };
 }
 }
@@ -28,17 +28,16 @@
 **
 ****************************************************************************/
 #include "Qt3DSRenderThreadPool.h"
-#include "foundation/Qt3DSThread.h"
 #include "EASTL/utility.h"
 #include "EASTL/list.h"
 #include "foundation/Qt3DSMutex.h"
 #include "foundation/Qt3DSContainers.h"
 #include "foundation/Qt3DSAtomic.h"
 #include "foundation/Qt3DSBroadcastingAllocator.h"
-#include "foundation/Qt3DSSync.h"
 #include "foundation/Qt3DSMutex.h"
 #include "foundation/Qt3DSPool.h"
 #include "foundation/Qt3DSInvasiveLinkedList.h"
+#include "Qt3DSRenderJobSystem.h"
 
 using namespace qt3ds::render;
 
@@ -58,28 +57,6 @@ struct STaskTailOp
 
 typedef InvasiveLinkedList<STask, STaskHeadOp, STaskTailOp> TTaskList;
 
-struct SThreadPoolThread : public Thread
-{
-    IThreadPool *m_Mgr;
-    SThreadPoolThread(NVFoundationBase &foundation, IThreadPool *inMgr)
-        : Thread(foundation)
-        , m_Mgr(inMgr)
-    {
-    }
-    void execute(void) override
-    {
-        setName("Qt3DSRender Thread manager thread");
-        while (!quitIsSignalled()) {
-            STask task = m_Mgr->GetNextTask();
-            if (task.m_Function) {
-                task.CallFunction();
-                m_Mgr->TaskFinished(task.m_Id);
-            }
-        }
-        quit();
-    }
-};
-
 struct SThreadPool : public IThreadPool
 {
     typedef nvhash_map<QT3DSU64, STask *> TIdTaskMap;
@@ -88,9 +65,12 @@ struct SThreadPool : public IThreadPool
 
     NVFoundationBase &m_Foundation;
     volatile QT3DSI32 mRefCount;
-    nvvector<SThreadPoolThread *> m_Threads;
+    // Tasks are executed by the job system, one job per added task. A job takes whatever
+    // task is at the front of the list so tasks still start roughly in order, and a job
+    // whose task has been canceled finds nothing to do.
+    NVScopedRefCounted<IJobSystem> m_JobSystem;
+    SJobGroup m_Jobs;
     TIdTaskMap m_Tasks;
-    Sync m_TaskListEvent;
     volatile bool m_Running;
     Mutex m_TaskListMutex;
     TTaskPool m_TaskPool;
@@ -98,22 +78,25 @@ struct SThreadPool : public IThreadPool
 
     QT3DSU64 m_NextId;
 
-    SThreadPool(NVFoundationBase &inBase, QT3DSU32 inMaxThreads)
+    SThreadPool(NVFoundationBase &inBase, IJobSystem &inJobSystem)
         : m_Foundation(inBase)
         , mRefCount(0)
-        , m_Threads(inBase.getAllocator(), "SThreadPool::m_Threads")
+        , m_JobSystem(inJobSystem)
         , m_Tasks(inBase.getAllocator(), "SThreadPool::m_Tasks")
-        , m_TaskListEvent(inBase.getAllocator())
         , m_Running(true)
         , m_TaskListMutex(m_Foundation.getAllocator())
         , m_TaskPool(ForwardingAllocator(m_Foundation.getAllocator(), "SThreadPool::m_TaskPool"))
         , m_NextId(1)
     {
-        // Fire up our little pools of chaos.
-        for (QT3DSU32 idx = 0; idx < inMaxThreads; ++idx) {
-            m_Threads.push_back(
-                QT3DS_NEW(m_Foundation.getAllocator(), SThreadPoolThread)(m_Foundation, this));
-            m_Threads.back()->start(Thread::DEFAULT_STACK_SIZE);
+    }
+
+    static void RunNextTask(void *inPool)
+    {
+        SThreadPool *thePool = reinterpret_cast<SThreadPool *>(inPool);
+        STask task = thePool->GetNextTask();
+        if (task.m_Function) {
+            task.CallFunction();
+            thePool->TaskFinished(task.m_Id);
         }
     }
 
@@ -142,23 +125,19 @@ struct SThreadPool : public IThreadPool
     {
         m_Running = false;
 
-        m_TaskListEvent.set();
-
-        for (QT3DSU32 idx = 0, end = m_Threads.size(); idx < end; ++idx)
-            m_Threads[idx]->signalQuit();
+        {
+            TLockType __listMutexLocker(m_TaskListMutex);
 
-        for (QT3DSU32 idx = 0, end = m_Threads.size(); idx < end; ++idx) {
-            m_Threads[idx]->waitForQuit();
-            NVDelete(m_Foundation.getAllocator(), m_Threads[idx]);
+            for (STask *theTask = MutexHeldNextTask(); theTask;
+                 theTask = MutexHeldNextTask()) {
+                theTask->Cancel();
+                m_Tasks.erase(theTask->m_Id);
+                m_TaskPool.deallocate(theTask);
+            }
         }
 
-        m_Threads.clear();
-
-        TLockType __listMutexLocker(m_TaskListMutex);
-
-        for (STask *theTask = MutexHeldNextTask(); theTask; theTask = MutexHeldNextTask()) {
-            theTask->Cancel();
-        }
+        // Tasks already running finish, the jobs of the canceled ones find an empty list.
+        m_JobSystem->Wait(m_Jobs);
 
         m_Tasks.clear();
     }
@@ -198,8 +177,7 @@ struct SThreadPool : public IThreadPool
 #ifdef _DEBUG
             VerifyTaskList();
 #endif
-            m_TaskListEvent.set();
-            m_TaskListEvent.reset();
+            m_JobSystem->Run(&m_Jobs, this, RunNextTask);
             return taskId;
         }
         QT3DS_ASSERT(false);
@@ -235,16 +213,13 @@ struct SThreadPool : public IThreadPool
 
     STask GetNextTask() override
     {
-
         if (m_Running) {
-            {
-                TLockType __listMutexLocker(m_TaskListMutex);
-                STask *retval = MutexHeldNextTask();
-                if (retval)
-                    return *retval;
+            TLockType __listMutexLocker(m_TaskListMutex);
+            STask *retval = MutexHeldNextTask();
+            if (retval) {
+                retval->m_TaskState = TaskStates::Running;
+                return *retval;
             }
-            // If we couldn't get a task then wait.
-            m_TaskListEvent.wait(1000);
         }
         return STask();
     }
@@ -273,5 +248,11 @@ struct SThreadPool : public IThreadPool
 
 IThreadPool &IThreadPool::CreateThreadPool(NVFoundationBase &inFoundation, QT3DSU32 inNumThreads)
 {
-    return *QT3DS_NEW(inFoundation.getAllocator(), SThreadPool)(inFoundation, inNumThreads);
+    return CreateThreadPool(inFoundation,
+                            IJobSystem::CreateJobSystem(inFoundation, NVMax(inNumThreads, 1U)));
+}
+
+IThreadPool &IThreadPool::CreateThreadPool(NVFoundationBase &inFoundation, IJobSystem &inJobSystem)
+{
+    return *QT3DS_NEW(inFoundation.getAllocator(), SThreadPool)(inFoundation, inJobSystem);
 }
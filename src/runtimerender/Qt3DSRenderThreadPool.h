@@ -119,8 +119,12 @@ struct STask
         virtual STask GetNextTask() = 0;
         virtual void TaskFinished(QT3DSU64 inId) = 0;
 
+        // Creates a pool running on its own job system with the given number of workers.
         static IThreadPool &CreateThreadPool(NVFoundationBase &inFoundation,
                                              QT3DSU32 inNumThreads = 4);
+        // Creates a pool whose tasks are run as jobs on an existing job system.
+        static IThreadPool &CreateThreadPool(NVFoundationBase &inFoundation,
+                                             IJobSystem &inJobSystem);
     };
 }
 }
@@ -232,6 +232,12 @@ namespace render {
         // Called before a layer goes completely out of scope to release any rendering resources
         // related to the layer.
         virtual void ReleaseLayerRenderResources(SLayer &inLayer, const SRenderInstanceId id) = 0;
+        // Called before a material is freed to release the rendering resources kept for it.
+        virtual void ReleaseMaterialRenderResources(const SGraphObject &inMaterial) = 0;
+        // Generates the default material shaders the layer and its sibling layers need with the
+        // current node activity, ignoring frustum culling, so that they are in the shader cache
+        // before a frame needs them. Callers set up the activity of each slide to cover.
+        virtual void PrecompileShaders(SLayer &inLayer, const QT3DSVec2 &inViewportDimensions) = 0;
 
         // render a screen aligned 2D text
         virtual void RenderText2D(QT3DSF32 x, QT3DSF32 y, qt3ds::foundation::Option<qt3ds::QT3DSVec3> inColor,
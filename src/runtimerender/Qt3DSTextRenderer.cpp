@@ -56,6 +56,19 @@ QT3DSU32 ITextRenderer::NextMultipleOf4(QT3DSU32 inValue)
     return inValue;
 }
 
+STextTextureDetails ITextRenderer::UploadRaster(STextRaster &inRaster,
+                                                NVRenderTexture2D &inTexture)
+{
+    if (inRaster.m_Image.isNull()) {
+        return UploadData(toU8DataRef((char *)nullptr, 0), inTexture, 4, 4, 0, 0,
+                          NVRenderTextureFormats::RGBA8, true);
+    }
+    QImage &theImage(inRaster.m_Image);
+    return UploadData(toU8DataRef(theImage.bits(), theImage.byteCount()), inTexture,
+                      theImage.width(), theImage.height(), inRaster.m_TextWidth,
+                      inRaster.m_TextHeight, NVRenderTextureFormats::RGBA8, true);
+}
+
 STextTextureDetails ITextRenderer::UploadData(NVDataRef<QT3DSU8> inTextureData,
                                               NVRenderTexture2D &inTexture, QT3DSU32 inDataWidth,
                                               QT3DSU32 inDataHeight, QT3DSU32 inTextWidth,
@@ -35,6 +35,7 @@
 #include "render/Qt3DSRenderBaseTypes.h"
 #include "foundation/StringTable.h"
 #include "Qt3DSRenderTextTypes.h"
+#include <QtGui/qimage.h>
 
 namespace qt3ds {
 namespace render {
@@ -51,6 +52,20 @@ namespace render {
         }
     };
 
+    // Text laid out and rasterized into CPU memory, ready to be uploaded with UploadRaster.
+    struct STextRaster
+    {
+        QImage m_Image;
+        QT3DSU32 m_TextWidth;
+        QT3DSU32 m_TextHeight;
+
+        STextRaster()
+            : m_TextWidth(0)
+            , m_TextHeight(0)
+        {
+        }
+    };
+
     class ITextRendererCore : public NVRefCounted
     {
     public:
@@ -109,6 +124,16 @@ namespace render {
         // the image.
         virtual STextTextureDetails RenderText(const STextRenderInfo &inText,
                                                NVRenderTexture2D &inTexture) = 0;
+        // Lays out and rasterizes the text without touching the render context. Renderers that
+        // support this may be called from worker threads while the render thread keeps using
+        // them, so that text does not have to be rasterized during the frame.
+        virtual bool SupportsRasterizeText() const { return false; }
+        virtual void RasterizeText(const STextRenderInfo &inText, STextRaster &outRaster)
+        {
+            Q_UNUSED(inText);
+            Q_UNUSED(outRaster);
+            QT3DS_ASSERT(false);
+        }
         // this is for rendering text with NV path rendering
         virtual STextTextureDetails
         RenderText(const STextRenderInfo &inText, NVRenderPathFontItem &inPathFontItem,
@@ -137,6 +162,10 @@ namespace render {
                    QT3DSU32 inDataHeight, QT3DSU32 inTextWidth, QT3DSU32 inTextHeight,
                    NVRenderTextureFormats::Enum inFormat, bool inFlipYAxis);
 
+        // Uploads the result of RasterizeText to the texture.
+        static STextTextureDetails UploadRaster(STextRaster &inRaster,
+                                               NVRenderTexture2D &inTexture);
+
         // Helper function to return the next power of two.
         // Fails for values of 0 or QT3DS_MAX_U32
         static QT3DSU32 NextPowerOf2(QT3DSU32 inValue);
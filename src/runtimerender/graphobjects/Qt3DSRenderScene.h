@@ -40,7 +40,7 @@ namespace render {
     struct SPresentation;
     typedef void *SRenderInstanceId;
 
-    struct SScene : public SGraphObject
+    struct QT3DS_AUTOTEST_EXPORT SScene : public SGraphObject
     {
         SPresentation *m_Presentation;
         SLayer *m_FirstChild;
@@ -107,6 +107,11 @@ SOffscreenRenderFlags Q3DSQmlRender::NeedsRender(const SOffscreenRendererEnviron
     return SOffscreenRenderFlags(true, render);
 }
 
+bool Q3DSQmlRender::IsUpdateRequested()
+{
+    return m_qmlStreamRenderer && m_qmlStreamRenderer->isUpdateRequested();
+}
+
 void Q3DSQmlRender::Render(const SOffscreenRendererEnvironment &inEnvironment,
                            NVRenderContext &inRenderContext, QT3DSVec2 inPresentationScaleFactor,
                            SScene::RenderClearCommand inColorBufferNeedsClear,
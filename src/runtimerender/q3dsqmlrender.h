@@ -73,6 +73,7 @@ public:
         Q_UNUSED(instanceId)
         return nullptr;
     }
+    bool IsUpdateRequested() override;
     bool Pick(const QT3DSVec2 &inMouseCoords, const QT3DSVec2 &inViewportDimensions,
               const SRenderInstanceId instanceId) override
     {
@@ -317,6 +317,150 @@ namespace render {
         }
     }
 
+    void SSubsetRenderable::RenderInstanced(const QT3DSVec2 &inCameraVec,
+                                            TShaderFeatureSet inFeatureSet,
+                                            NVConstDataRef<SSubsetRenderable *> inInstances)
+    {
+        NVRenderContext &context(m_Generator.GetContext());
+
+        // Do not render if alpha test is enabled, but no alpha test in object or vice versa
+        if (m_Generator.alphaTestEnabled() ^ m_RenderableFlags.hasAlphaTest())
+            return;
+
+        SShaderGeneratorGeneratedShader *shader =
+            m_Generator.GetShader(*this, inFeatureSet, false, true);
+        NVRenderConstantBuffer *theInstanceBuffer = m_Generator.GetInstanceConstantBuffer();
+        if (shader == nullptr || !shader->m_InstanceBlock.IsValid()
+            || theInstanceBuffer == nullptr) {
+            for (QT3DSU32 idx = 0, end = inInstances.size(); idx < end; ++idx)
+                inInstances[idx]->Render(inCameraVec, inFeatureSet, false);
+            return;
+        }
+
+        context.SetActiveShader(&shader->m_Shader);
+
+        // The model matrices of this call are overridden by the instance block
+        m_Generator.GetQt3DSContext().GetDefaultMaterialShaderGenerator().SetMaterialProperties(
+            shader->m_Shader, m_Material, inCameraVec, m_ModelContext.m_ModelViewProjection,
+            m_ModelContext.m_NormalMatrix, m_ModelContext.m_Model.m_GlobalTransform, m_FirstImage,
+            m_Opacity, m_Generator.GetLayerGlobalRenderProperties(),
+            QT3DSVec2(m_Generator.alphaOpRef()));
+
+        context.SetCullingEnabled(m_Material.m_CullMode != DefaultMaterialCullMode::None);
+        context.SetInputAssembler(m_Subset.m_InputAssembler);
+        NVScopedRefCounted<qt3ds::render::NVRenderRasterizerState> rsdefaultstate;
+        if (m_Material.m_CullMode != DefaultMaterialCullMode::None) {
+            rsdefaultstate =
+                context.CreateRasterizerState(0.0, 0.0, qt3ds::render::NVRenderFaces::Back);
+            qt3ds::render::NVRenderFaces::Enum face = qt3ds::render::NVRenderFaces::Back;
+            switch (m_Material.m_CullMode) {
+            case DefaultMaterialCullMode::Front:
+                face = qt3ds::render::NVRenderFaces::Front;
+                break;
+            case DefaultMaterialCullMode::FrontAndBack:
+                face = qt3ds::render::NVRenderFaces::FrontAndBack;
+                break;
+            default:
+                break;
+            }
+
+            NVScopedRefCounted<qt3ds::render::NVRenderRasterizerState> rasterState =
+                context.CreateRasterizerState(0.0, 0.0, face);
+            context.SetRasterizerState(rasterState);
+        }
+
+        // model view projection, model and normal matrix of every instance
+        QT3DSMat44 theMatrices[QT3DS_MAX_NUM_INSTANCES * 3];
+        for (QT3DSU32 first = 0, end = inInstances.size(); first < end;
+             first += QT3DS_MAX_NUM_INSTANCES) {
+            const QT3DSU32 theCount = NVMin(end - first, (QT3DSU32)QT3DS_MAX_NUM_INSTANCES);
+            for (QT3DSU32 idx = 0; idx < theCount; ++idx) {
+                const SModelContext &theContext(inInstances[first + idx]->m_ModelContext);
+                theMatrices[idx * 3] = theContext.m_ModelViewProjection;
+                theMatrices[idx * 3 + 1] = theContext.m_Model.m_GlobalTransform;
+                theMatrices[idx * 3 + 2] = QT3DSMat44(theContext.m_NormalMatrix, QT3DSVec3(0.0f));
+            }
+            theInstanceBuffer->UpdateRaw(
+                0, NVDataRef<QT3DSU8>((QT3DSU8 *)theMatrices, theCount * 3 * sizeof(QT3DSMat44)));
+            shader->m_InstanceBlock.Set();
+            context.DrawInstanced(m_Subset.m_PrimitiveType, m_Subset.m_Count, m_Subset.m_Offset,
+                                  theCount);
+        }
+
+        if (rsdefaultstate)
+            context.SetRasterizerState(rsdefaultstate);
+    }
+
+    namespace {
+        bool IsSameMaterial(const SDefaultMaterial &inA, const SDefaultMaterial &inB)
+        {
+            return inA.m_Lighting == inB.m_Lighting && inA.m_BlendMode == inB.m_BlendMode
+                && inA.m_DiffuseColor == inB.m_DiffuseColor
+                && inA.m_EmissivePower == inB.m_EmissivePower
+                && inA.m_EmissiveColor == inB.m_EmissiveColor
+                && inA.m_SpecularModel == inB.m_SpecularModel
+                && inA.m_SpecularTint == inB.m_SpecularTint && inA.m_IOR == inB.m_IOR
+                && inA.m_FresnelPower == inB.m_FresnelPower
+                && inA.m_SpecularAmount == inB.m_SpecularAmount
+                && inA.m_SpecularRoughness == inB.m_SpecularRoughness
+                && inA.m_Opacity == inB.m_Opacity && inA.m_BumpAmount == inB.m_BumpAmount
+                && inA.m_DisplaceAmount == inB.m_DisplaceAmount
+                && inA.m_TranslucentFalloff == inB.m_TranslucentFalloff
+                && inA.m_DiffuseLightWrap == inB.m_DiffuseLightWrap
+                && inA.m_VertexColors == inB.m_VertexColors
+                && inA.m_TransparencyMode == inB.m_TransparencyMode
+                && inA.m_CullMode == inB.m_CullMode && inA.m_IblProbe == inB.m_IblProbe;
+        }
+
+        bool IsSameImageChain(const SRenderableImage *inA, const SRenderableImage *inB)
+        {
+            for (; inA && inB; inA = inA->m_NextImage, inB = inB->m_NextImage) {
+                if (inA->m_MapType != inB->m_MapType)
+                    return false;
+                const SImage &theA(inA->m_Image);
+                const SImage &theB(inB->m_Image);
+                if (&theA == &theB)
+                    continue;
+                if (theA.m_TextureData.m_Texture != theB.m_TextureData.m_Texture
+                    || theA.m_TextureData.m_TextureFlags.IsPreMultiplied()
+                        != theB.m_TextureData.m_TextureFlags.IsPreMultiplied()
+                    || theA.m_HorizontalTilingMode != theB.m_HorizontalTilingMode
+                    || theA.m_VerticalTilingMode != theB.m_VerticalTilingMode
+                    || memcmp(&theA.m_TextureTransform, &theB.m_TextureTransform,
+                              sizeof(QT3DSMat44))) {
+                    return false;
+                }
+            }
+            return inA == inB;
+        }
+    }
+
+    bool SSubsetRenderable::IsInstanceable() const
+    {
+        return m_Bones.size() == 0 && m_ScopedLights.empty()
+            && m_TessellationMode == TessModeValues::NoTess
+            && m_Subset.m_PrimitiveType != NVRenderDrawMode::Patches;
+    }
+
+    bool SSubsetRenderable::IsInstanceCompatible(const SSubsetRenderable &inOther) const
+    {
+        if (m_Subset.m_InputAssembler != inOther.m_Subset.m_InputAssembler
+            || m_Subset.m_Count != inOther.m_Subset.m_Count
+            || m_Subset.m_Offset != inOther.m_Subset.m_Offset
+            || m_Subset.m_PrimitiveType != inOther.m_Subset.m_PrimitiveType) {
+            return false;
+        }
+        if (!(m_ShaderDescription == inOther.m_ShaderDescription)
+            || m_Opacity != inOther.m_Opacity
+            || m_RenderableFlags.hasAlphaTest() != inOther.m_RenderableFlags.hasAlphaTest()) {
+            return false;
+        }
+        if (&m_Material == &inOther.m_Material)
+            return true;
+        return IsSameMaterial(m_Material, inOther.m_Material)
+            && IsSameImageChain(m_FirstImage, inOther.m_FirstImage);
+    }
+
     void SSubsetRenderable::RenderShadow(const QT3DSVec2 &inCameraVec,
                                          TShaderFeatureSet inFeatureSet, const SLight *inLight,
                                          const SCamera &inCamera, SShadowMapEntry *inShadowMapEntry)
@@ -44,6 +44,9 @@
 #include "Qt3DSRenderableImage.h"
 #include "Qt3DSDistanceFieldRenderer.h"
 
+// Upper limit of renderables drawn with a single instanced draw call
+#define QT3DS_MAX_NUM_INSTANCES 64
+
 namespace qt3ds {
 namespace render {
 
@@ -330,6 +333,10 @@ namespace render {
         }
 
         void Render(const QT3DSVec2 &inCameraVec, TShaderFeatureSet inFeatureSet, bool depth);
+        // Renders inInstances, this renderable being the first of them, with instanced draw
+        // calls. All of them must be IsInstanceCompatible with this one.
+        void RenderInstanced(const QT3DSVec2 &inCameraVec, TShaderFeatureSet inFeatureSet,
+                             NVConstDataRef<SSubsetRenderable *> inInstances);
         void RenderShadow(const QT3DSVec2 &inCameraVec, TShaderFeatureSet inFeatureSet,
                           const SLight *inLight, const SCamera &inCamera,
                           SShadowMapEntry *inShadowMapEntry);
@@ -339,6 +346,12 @@ namespace render {
         {
             return m_Material.m_BlendMode;
         }
+
+        // True if nothing but the model matrices differ from renderable to renderable, which
+        // are then the only per instance data
+        bool IsInstanceable() const;
+        // True if inOther draws the same subset with the same shader and material values
+        bool IsInstanceCompatible(const SSubsetRenderable &inOther) const;
     };
 
     struct SCustomMaterialRenderable : public SSubsetRenderableBase
@@ -58,6 +58,7 @@
 #include "Qt3DSRenderShaderCodeGeneratorV2.h"
 #include "Qt3DSRenderDefaultMaterialShaderGenerator.h"
 #include "backends/gl/Qt3DSOpenGLUtil.h"
+#include "foundation/Qt3DSPerfTimer.h"
 #include <stdlib.h>
 
 #ifdef _WIN32
@@ -104,9 +105,7 @@ namespace render {
         , m_StringTable(ctx.GetStringTable())
         , m_LayerShaders(ctx.GetAllocator(), "Qt3DSRendererImpl::m_LayerShaders")
         , m_Shaders(ctx.GetAllocator(), "Qt3DSRendererImpl::m_Shaders")
-        , m_DepthShaders(ctx.GetAllocator(), "Qt3DSRendererImpl::m_DepthShaders")
-        , m_ShadowMapShaders(ctx.GetAllocator(), "Qt3DSRendererImpl::m_ShadowMapShaders")
-        , m_ShadowCubeShaders(ctx.GetAllocator(), "Qt3DSRendererImpl::m_ShadowCubeShaders")
+        , m_ShadowShaders(ctx.GetAllocator(), "Qt3DSRendererImpl::m_ShadowShaders")
         , m_ConstantBuffers(ctx.GetAllocator(), "Qt3DSRendererImpl::m_ConstantBuffers")
         , m_TextShader(ctx.GetAllocator())
         , m_TextPathShader(ctx.GetAllocator())
@@ -129,31 +128,16 @@ namespace render {
         , m_PickRenderPlugins(true)
         , m_LayerCachingEnabled(true)
         , m_LayerGPuProfilingEnabled(false)
+        , m_InstancingEnabled(m_Context->IsInstancingSupported()
+                              && m_Context->GetConstantBufferSupport()
+                              && !qEnvironmentVariableIsSet("QT3DS_DISABLE_INSTANCING"))
     {
     }
     Qt3DSRendererImpl::~Qt3DSRendererImpl()
     {
         m_LayerShaders.clear();
-        for (TShaderMap::iterator iter = m_Shaders.begin(), end = m_Shaders.end(); iter != end;
-             ++iter) {
-            NVDelete(m_Context->GetAllocator(), iter->second);
-        }
-        for (TShaderMap::iterator iter = m_DepthShaders.begin(), end = m_DepthShaders.end();
-             iter != end; ++iter) {
-            NVDelete(m_Context->GetAllocator(), iter->second);
-        }
-        for (TShadowShaderMap::iterator iter = m_ShadowMapShaders.begin(),
-             end = m_ShadowMapShaders.end(); iter != end; ++iter) {
-            NVDelete(m_Context->GetAllocator(), iter->second);
-        }
-        for (TShadowShaderMap::iterator iter = m_ShadowCubeShaders.begin(),
-             end = m_ShadowCubeShaders.end(); iter != end; ++iter) {
-            NVDelete(m_Context->GetAllocator(), iter->second);
-        }
-        m_ShadowMapShaders.clear();
-        m_ShadowCubeShaders.clear();
-        m_Shaders.clear();
-        m_DepthShaders.clear();
+        m_Shaders.Release(m_Context->GetAllocator());
+        m_ShadowShaders.Release(m_Context->GetAllocator());
         m_InstanceRenderMap.clear();
         m_ConstantBuffers.clear();
     }
@@ -179,6 +163,8 @@ namespace render {
             if (theIter != m_InstanceRenderMap.end()) {
                 theIter->second->m_CamerasAndLights.clear();
                 theIter->second->m_RenderableNodes.clear();
+                theIter->second->m_TransformNodes.clear();
+                theIter->second->m_TransformLevelOffsets.clear();
             }
         } else if (inParent.m_Parent)
             ChildrenUpdated(*inParent.m_Parent);
@@ -277,6 +263,114 @@ namespace render {
         return retval;
     }
 
+    namespace {
+        // Disables frustum culling below the given layers for the lifetime of the scope so that
+        // renderables outside of the current view contribute their shader keys as well. Nodes
+        // are marked dirty on entry and exit so that global activity follows whatever local
+        // activity the caller has set up.
+        struct SScopedPrecompileCulling
+        {
+            nvvector<SNode *> m_VisitedNodes;
+            nvvector<SCamera *> m_CulledCameras;
+
+            SScopedPrecompileCulling(NVAllocatorCallback &alloc, SLayer &inLayer)
+                : m_VisitedNodes(alloc, "SScopedPrecompileCulling::m_VisitedNodes")
+                , m_CulledCameras(alloc, "SScopedPrecompileCulling::m_CulledCameras")
+            {
+                Visit(inLayer);
+                for (SLayer *theLayer = GetNextLayer(inLayer); theLayer;
+                     theLayer = GetNextLayer(*theLayer)) {
+                    Visit(*theLayer);
+                }
+            }
+
+            ~SScopedPrecompileCulling()
+            {
+                for (QT3DSU32 idx = 0, end = m_CulledCameras.size(); idx < end; ++idx)
+                    m_CulledCameras[idx]->m_EnableFrustumCulling = true;
+                // Global activity is only recalculated for dirty nodes.
+                for (QT3DSU32 idx = 0, end = m_VisitedNodes.size(); idx < end; ++idx)
+                    m_VisitedNodes[idx]->m_Flags.SetDirty(true);
+            }
+
+            void Visit(SNode &inNode)
+            {
+                m_VisitedNodes.push_back(&inNode);
+                inNode.m_Flags.SetDirty(true);
+                if (inNode.m_Type == GraphObjectTypes::Camera) {
+                    SCamera &theCamera(static_cast<SCamera &>(inNode));
+                    if (theCamera.m_EnableFrustumCulling) {
+                        theCamera.m_EnableFrustumCulling = false;
+                        m_CulledCameras.push_back(&theCamera);
+                    }
+                }
+                for (SNode *theChild = inNode.m_FirstChild; theChild;
+                     theChild = theChild->m_NextSibling) {
+                    Visit(*theChild);
+                }
+            }
+        };
+    }
+
+    void Qt3DSRendererImpl::PrecompileShaders(SLayer &inLayer,
+                                              const QT3DSVec2 &inViewportDimensions)
+    {
+        QT3DS_PERF_SCOPED_TIMER(m_qt3dsContext.GetPerfTimer(), "Renderer: PrecompileShaders")
+
+        SScopedPrecompileCulling theCulling(m_Context->GetAllocator(), inLayer);
+        nvvector<SLayer *> renderableLayers(m_qt3dsContext.GetPerFrameAllocator(), "LayerVector");
+        BuildRenderableLayers(inLayer, renderableLayers, true);
+
+        const QSize theViewportSize((int)inViewportDimensions.x, (int)inViewportDimensions.y);
+        SLayerRenderData *thePreviousLayer = m_CurrentLayer;
+        for (QT3DSU32 layerIdx = 0, layerEnd = renderableLayers.size(); layerIdx < layerEnd;
+             ++layerIdx) {
+            SLayerRenderData *theRenderData =
+                GetOrCreateLayerRenderDataForNode(*renderableLayers[layerIdx]);
+            if (theRenderData == nullptr)
+                continue;
+
+            theRenderData->ResetForFrame();
+            // Activity is changed for every slide without marking the nodes dirty.
+            theRenderData->m_RetainedRenderablesValid = false;
+            theRenderData->PrepareForRender(theViewportSize);
+            m_CurrentLayer = theRenderData;
+
+            TShaderFeatureSet theFeatures(theRenderData->GetShaderFeatureSet());
+            const bool hasShadows = theRenderData->m_ShadowMapManager.mPtr != nullptr;
+            const TRenderableObjectList *theLists[] = { &theRenderData->m_OpaqueObjects,
+                                                        &theRenderData->m_TransparentObjects };
+            for (QT3DSU32 listIdx = 0; listIdx < 2; ++listIdx) {
+                const TRenderableObjectList &theObjects(*theLists[listIdx]);
+                for (QT3DSU32 idx = 0, end = theObjects.size(); idx < end; ++idx) {
+                    SRenderableObject &theObject(*theObjects[idx]);
+                    if (!theObject.m_RenderableFlags.IsDefaultMaterialMeshSubset())
+                        continue;
+                    SSubsetRenderable &theSubset(static_cast<SSubsetRenderable &>(theObject));
+                    GetShader(theSubset, theFeatures, false);
+                    // Runs of equal subsets are drawn with the instanced variant.
+                    if (IsInstancingEnabled() && theSubset.IsInstanceable())
+                        GetShader(theSubset, theFeatures, false, true);
+                    // Depth and shadow passes only use generated shaders for alpha tested
+                    // subsets, everything else goes through the fixed depth prepass shaders.
+                    if (!theSubset.m_RenderableFlags.hasAlphaTest())
+                        continue;
+                    GetShader(theSubset, theFeatures, true);
+                    if (!hasShadows || !theSubset.m_RenderableFlags.IsShadowCaster())
+                        continue;
+                    for (QT3DSU32 lightIdx = 0, lightEnd = theRenderData->m_Lights.size();
+                         lightIdx < lightEnd; ++lightIdx) {
+                        const SLight &theLight(*theRenderData->m_Lights[lightIdx]);
+                        if (theLight.m_CastShadow)
+                            GetShadowShader(theSubset, theFeatures, theLight.m_LightType);
+                    }
+                }
+            }
+            theRenderData->ResetForFrame();
+        }
+        m_CurrentLayer = thePreviousLayer;
+    }
+
     void Qt3DSRendererImpl::RenderLayer(SLayer &inLayer, const QT3DSVec2 &inViewportDimensions,
                                         bool clear, QT3DSVec4 clearColor, bool inRenderSiblings,
                                         const SRenderInstanceId id)
@@ -1164,6 +1258,11 @@ namespace render {
         }
     }
 
+    void Qt3DSRendererImpl::ReleaseMaterialRenderResources(const SGraphObject &inMaterial)
+    {
+        m_qt3dsContext.GetDefaultMaterialShaderGenerator().ReleaseMaterial(inMaterial);
+    }
+
     void Qt3DSRendererImpl::FillQuad(const QT3DSVec4 &color)
     {
         m_Context->SetCullingEnabled(false);
@@ -1437,6 +1536,57 @@ namespace render {
         return Empty();
     }
 
+    static const SGraphObject *GetPickObject(SRenderableObject &inRenderableObject)
+    {
+        if (inRenderableObject.m_RenderableFlags.IsDefaultMaterialMeshSubset())
+            return &static_cast<SSubsetRenderable *>(&inRenderableObject)->m_ModelContext.m_Model;
+        else if (inRenderableObject.m_RenderableFlags.IsText())
+            return &static_cast<STextRenderable *>(&inRenderableObject)->m_Text;
+#if QT_VERSION >= QT_VERSION_CHECK(5,12,2)
+        else if (inRenderableObject.m_RenderableFlags.isDistanceField())
+            return &static_cast<SDistanceFieldRenderable *>(&inRenderableObject)->m_text;
+#endif
+        else if (inRenderableObject.m_RenderableFlags.IsCustomMaterialMeshSubset())
+            return &static_cast<SCustomMaterialRenderable *>(&inRenderableObject)
+                        ->m_ModelContext.m_Model;
+        else if (inRenderableObject.m_RenderableFlags.IsPath())
+            return &static_cast<SPathRenderable *>(&inRenderableObject)->m_Path;
+        return nullptr;
+    }
+
+    static void AddPickRenderable(SLayerRenderPreparationData &inLayerRenderData,
+                                  SRenderableObject &inRenderableObject)
+    {
+        NVBounds3 theWorldBounds(inRenderableObject.m_Bounds);
+        theWorldBounds.transform(inRenderableObject.m_GlobalTransform);
+        inLayerRenderData.m_PickRenderables.push_back(&inRenderableObject);
+        inLayerRenderData.m_PickBvh.m_Bounds.push_back(theWorldBounds);
+        inLayerRenderData.m_PickBvh.m_Keys.push_back(GetPickObject(inRenderableObject));
+    }
+
+    // Refills the pick tree with the renderables of the last prepared frame, in the order
+    // they used to be tested in.
+    static void UpdatePickBvh(SLayerRenderPreparationData &inLayerRenderData)
+    {
+        inLayerRenderData.m_PickRenderables.clear();
+        inLayerRenderData.m_PickBvh.m_Bounds.clear();
+        inLayerRenderData.m_PickBvh.m_Keys.clear();
+        for (QT3DSU32 idx = inLayerRenderData.m_OpaqueObjects.size(), end = 0; idx > end; --idx)
+            AddPickRenderable(inLayerRenderData, *inLayerRenderData.m_OpaqueObjects[idx - 1]);
+        for (QT3DSU32 idx = inLayerRenderData.m_GroupObjects.size(), end = 0; idx > end; --idx) {
+            SRenderableObject *object = inLayerRenderData.m_GroupObjects[idx - 1];
+            SOrderedGroupRenderable &group(static_cast<SOrderedGroupRenderable &>(*object));
+            Q_ASSERT(object->m_RenderableFlags.isOrderedGroup());
+            for (int i = 0; i < group.m_renderables.size(); ++i)
+                AddPickRenderable(inLayerRenderData, *group.m_renderables[i]);
+        }
+        for (QT3DSU32 idx = inLayerRenderData.m_TransparentObjects.size(), end = 0;
+             idx > end; --idx) {
+            AddPickRenderable(inLayerRenderData, *inLayerRenderData.m_TransparentObjects[idx - 1]);
+        }
+        inLayerRenderData.m_PickBvh.Update();
+    }
+
     void Qt3DSRendererImpl::GetLayerHitObjectList(SLayerRenderData &inLayerRenderData,
                                                   const QT3DSVec2 &inViewportDimensions,
                                                   const QT3DSVec2 &inPresCoords,
@@ -1477,35 +1627,22 @@ namespace render {
             return;
         // Scale the mouse coords to change them into the camera's coordinate space.
         SRay thePickRay = *theHitRay;
-        for (QT3DSU32 idx = inLayerRenderData.m_OpaqueObjects.size(), end = 0; idx > end; --idx) {
-            SRenderableObject *theRenderableObject = inLayerRenderData.m_OpaqueObjects[idx - 1];
+        if (!inLayerRenderData.m_PickBvh.IsValid())
+            UpdatePickBvh(inLayerRenderData);
+        // The hits come back in the order the renderables were added, so results at the same
+        // distance sort the same way as when every renderable was tested.
+        nvvector<QT3DSU32> &theHits(inLayerRenderData.m_PickHits);
+        theHits.clear();
+        inLayerRenderData.m_PickBvh.Pick(thePickRay, theHits);
+        for (QT3DSU32 idx = 0, end = theHits.size(); idx < end; ++idx) {
+            SRenderableObject *theRenderableObject =
+                inLayerRenderData.m_PickRenderables[theHits[idx]];
             if (inPickEverything || theRenderableObject->m_RenderableFlags.GetPickable()) {
                 IntersectRayWithSubsetRenderable(thePickRay, *theRenderableObject,
                                                  outIntersectionResult,
                                                  inTempAllocator);
             }
         }
-        for (QT3DSU32 idx = inLayerRenderData.m_GroupObjects.size(), end = 0; idx > end; --idx) {
-            SRenderableObject *object = inLayerRenderData.m_GroupObjects[idx - 1];
-            SOrderedGroupRenderable &group(static_cast<SOrderedGroupRenderable &>(*object));
-            Q_ASSERT(object->m_RenderableFlags.isOrderedGroup());
-            for (int i = 0; i < group.m_renderables.size(); ++i) {
-                if (inPickEverything || group.m_renderables[i]->m_RenderableFlags.GetPickable()) {
-                    IntersectRayWithSubsetRenderable(thePickRay, *group.m_renderables[i],
-                                                     outIntersectionResult,
-                                                     inTempAllocator);
-                }
-            }
-        }
-        for (QT3DSU32 idx = inLayerRenderData.m_TransparentObjects.size(), end = 0;
-             idx > end; --idx) {
-            SRenderableObject *renderableObject = inLayerRenderData.m_TransparentObjects[idx - 1];
-            if (inPickEverything || renderableObject->m_RenderableFlags.GetPickable()) {
-                IntersectRayWithSubsetRenderable(thePickRay, *renderableObject,
-                                                 outIntersectionResult,
-                                                 inTempAllocator);
-            }
-        }
     }
 
     static inline Qt3DSRenderPickSubResult ConstructSubResult(SRenderableImage &inImage)
@@ -1524,21 +1661,7 @@ namespace render {
         SRayIntersectionResult &theResult(*theIntersectionResultOpt);
 
         // Leave the coordinates relative for right now.
-        const SGraphObject *thePickObject = nullptr;
-        if (inRenderableObject.m_RenderableFlags.IsDefaultMaterialMeshSubset())
-            thePickObject =
-                &static_cast<SSubsetRenderable *>(&inRenderableObject)->m_ModelContext.m_Model;
-        else if (inRenderableObject.m_RenderableFlags.IsText())
-            thePickObject = &static_cast<STextRenderable *>(&inRenderableObject)->m_Text;
-#if QT_VERSION >= QT_VERSION_CHECK(5,12,2)
-        else if (inRenderableObject.m_RenderableFlags.isDistanceField())
-            thePickObject = &static_cast<SDistanceFieldRenderable *>(&inRenderableObject)->m_text;
-#endif
-        else if (inRenderableObject.m_RenderableFlags.IsCustomMaterialMeshSubset())
-            thePickObject = &static_cast<SCustomMaterialRenderable *>(&inRenderableObject)
-                                 ->m_ModelContext.m_Model;
-        else if (inRenderableObject.m_RenderableFlags.IsPath())
-            thePickObject = &static_cast<SPathRenderable *>(&inRenderableObject)->m_Path;
+        const SGraphObject *thePickObject = GetPickObject(inRenderableObject);
 
         if (thePickObject != nullptr) {
             outIntersectionResultList.push_back(Qt3DSRenderPickResult(
@@ -1608,36 +1731,34 @@ namespace render {
 
     SShaderGeneratorGeneratedShader *Qt3DSRendererImpl::GetShader(SSubsetRenderable &inRenderable,
                                                                   TShaderFeatureSet inFeatureSet,
-                                                                  bool depth)
+                                                                  bool depth, bool instanced)
     {
         if (m_CurrentLayer == nullptr) {
             QT3DS_ASSERT(false);
             return nullptr;
         }
 
+        const ShaderProgramPasses::Enum thePass = depth ? ShaderProgramPasses::Depth
+                : instanced ? ShaderProgramPasses::Instanced : ShaderProgramPasses::Main;
+        const SShaderProgramKey theKey(inRenderable.m_ShaderDescription, thePass);
         SShaderGeneratorGeneratedShader *retval = nullptr;
-        TShaderMap &map = depth ? m_DepthShaders : m_Shaders;
-        TShaderMap::iterator theFind = map.find(inRenderable.m_ShaderDescription);
-        if (theFind == map.end()) {
+        SShaderGeneratorGeneratedShader **theFind = m_Shaders.Find(theKey);
+        if (theFind == nullptr) {
             // Generate the shader.
-            NVRenderShaderProgram *theShader(GenerateShader(inRenderable, inFeatureSet, depth));
+            NVRenderShaderProgram *theShader(
+                GenerateShader(inRenderable, inFeatureSet, depth, instanced));
             if (theShader) {
-                SShaderGeneratorGeneratedShader *theGeneratedShader =
-                    (SShaderGeneratorGeneratedShader *)m_Context->GetAllocator().allocate(
+                retval = (SShaderGeneratorGeneratedShader *)m_Context->GetAllocator().allocate(
                         sizeof(SShaderGeneratorGeneratedShader), "SShaderGeneratorGeneratedShader",
                         __FILE__, __LINE__);
-                new (theGeneratedShader) SShaderGeneratorGeneratedShader(
-                    m_StringTable->RegisterStr(m_GeneratedShaderString.c_str()), *theShader);
-                map.insert(make_pair(inRenderable.m_ShaderDescription, theGeneratedShader));
-                retval = theGeneratedShader;
+                new (retval) SShaderGeneratorGeneratedShader(*theShader);
             }
             // We still insert something because we don't want to attempt to generate the same
             // bad shader twice.
-            else
-                map.insert(make_pair(inRenderable.m_ShaderDescription,
-                                           (SShaderGeneratorGeneratedShader *)nullptr));
-        } else
-            retval = theFind->second;
+            m_Shaders.Insert(theKey, retval);
+        } else {
+            retval = *theFind;
+        }
 
         if (retval != nullptr && !depth) {
             if (!m_LayerShaders.contains(*retval)) {
@@ -1661,30 +1782,27 @@ namespace render {
             return nullptr;
         }
 
+        const SShaderProgramKey theKey(inRenderable.m_ShaderDescription,
+                                       lightType == RenderLightTypes::Point
+                                           ? ShaderProgramPasses::ShadowCube
+                                           : ShaderProgramPasses::ShadowMap);
         SRenderableDepthPrepassShader *retval = nullptr;
-        TShadowShaderMap &map = lightType == RenderLightTypes::Point ? m_ShadowCubeShaders
-                                                               : m_ShadowMapShaders;
-        TShadowShaderMap::iterator theFind = map.find(inRenderable.m_ShaderDescription);
-        if (theFind == map.end()) {
+        SRenderableDepthPrepassShader **theFind = m_ShadowShaders.Find(theKey);
+        if (theFind == nullptr) {
             // Generate the shader.
             NVRenderShaderProgram *theShader(GenerateShadowShader(inRenderable, inFeatureSet,
                                                                   lightType));
             if (theShader) {
-                SRenderableDepthPrepassShader *theGeneratedShader =
-                    (SRenderableDepthPrepassShader *)m_Context->GetAllocator().allocate(
+                retval = (SRenderableDepthPrepassShader *)m_Context->GetAllocator().allocate(
                         sizeof(SRenderableDepthPrepassShader), "SRenderableDepthPrepassShader",
                         __FILE__, __LINE__);
-                new (theGeneratedShader) SRenderableDepthPrepassShader(*theShader, GetContext());
-                map.insert(make_pair(inRenderable.m_ShaderDescription, theGeneratedShader));
-                retval = theGeneratedShader;
+                new (retval) SRenderableDepthPrepassShader(*theShader, GetContext());
             }
             // We still insert something because we don't want to attempt to generate the same
             // bad shader twice.
-            else {
-                map.insert(make_pair(inRenderable.m_ShaderDescription, nullptr));
-            }
+            m_ShadowShaders.Insert(theKey, retval);
         } else {
-            retval = theFind->second;
+            retval = *theFind;
         }
 
         return retval;
@@ -1826,6 +1944,30 @@ namespace render {
             toConstDataRef(&strides, 1), toConstDataRef(&offsets, 1));
     }
 
+    NVRenderConstantBuffer *Qt3DSRendererImpl::GetInstanceConstantBuffer()
+    {
+        CRegisteredString theName = m_Context->GetStringTable().RegisterStr("cbInstances");
+        NVRenderConstantBuffer *pCB = m_Context->GetConstantBuffer(theName);
+
+        if (!pCB) {
+            // three matrices per instance, see SSubsetRenderable::RenderInstanced
+            QT3DSMat44 theMatrices[QT3DS_MAX_NUM_INSTANCES * 3];
+            memset(theMatrices, 0, sizeof(theMatrices));
+            pCB = m_Context->CreateConstantBuffer(
+                theName, qt3ds::render::NVRenderBufferUsageType::Dynamic, sizeof(theMatrices),
+                NVDataRef<QT3DSU8>((QT3DSU8 *)theMatrices, sizeof(theMatrices)));
+            if (!pCB) {
+                QT3DS_ASSERT(false);
+                return nullptr;
+            }
+            pCB->UpdateRaw(0, NVDataRef<QT3DSU8>((QT3DSU8 *)theMatrices, sizeof(theMatrices)));
+            pCB->Update(); // update to hardware
+            m_ConstantBuffers.insert(eastl::make_pair(theName, pCB));
+        }
+
+        return pCB;
+    }
+
     void Qt3DSRendererImpl::UpdateCbAoShadow(const SLayer *pLayer, const SCamera *pCamera,
                                             CResourceTexture2D &inDepthTexture)
     {
@@ -34,6 +34,7 @@
 #include "Qt3DSRenderer.h"
 #include "Qt3DSRenderableObjects.h"
 #include "Qt3DSRendererImplShaders.h"
+#include "Qt3DSRendererImplShaderProgramTable.h"
 #include "Qt3DSRendererImplLayerRenderData.h"
 #include "foundation/Qt3DSFlags.h"
 #include "Qt3DSRenderMesh.h"
@@ -154,9 +155,8 @@ namespace render {
     class QT3DS_AUTOTEST_EXPORT Qt3DSRendererImpl : public IQt3DSRenderer,
                                                     public IRenderWidgetContext
     {
-        typedef nvhash_map<SShaderDefaultMaterialKey, SShaderGeneratorGeneratedShader *> TShaderMap;
-        typedef nvhash_map<SShaderDefaultMaterialKey, SRenderableDepthPrepassShader *>
-            TShadowShaderMap;
+        typedef SShaderProgramTable<SShaderGeneratorGeneratedShader> TShaderMap;
+        typedef SShaderProgramTable<SRenderableDepthPrepassShader> TShadowShaderMap;
         typedef nvhash_map<CRegisteredString, NVScopedRefCounted<NVRenderConstantBuffer>>
             TStrConstanBufMap;
         typedef nvhash_map<SRenderInstanceId, NVScopedRefCounted<SLayerRenderData>,
@@ -214,10 +214,9 @@ namespace render {
         Option<NVScopedRefCounted<SFillRectShader>> m_fillRectShader;
         Option<NVScopedRefCounted<SLayerProgAABlendShader>> m_LayerProgAAShader;
 
+        // Keyed by material key, feature set and pass; see ShaderProgramPasses.
         TShaderMap m_Shaders;
-        TShaderMap m_DepthShaders;
-        TShadowShaderMap m_ShadowMapShaders;
-        TShadowShaderMap m_ShadowCubeShaders;
+        TShadowShaderMap m_ShadowShaders;
         TStrConstanBufMap m_ConstantBuffers; ///< store the the shader constant buffers
         // Option is true if we have attempted to generate the shader.
         // This does not mean we were successul, however.
@@ -296,6 +295,9 @@ namespace render {
         bool m_PickRenderPlugins;
         bool m_LayerCachingEnabled;
         bool m_LayerGPuProfilingEnabled;
+        // Opaque models sharing mesh and material are drawn with one instanced draw call.
+        // Needs instancing and constant buffers, QT3DS_DISABLE_INSTANCING turns it off.
+        bool m_InstancingEnabled;
         SShaderDefaultMaterialKeyProperties m_DefaultMaterialShaderKeyProperties;
 
         QHash<SLayer *, SLayerRenderData *> m_initialPrepareData;
@@ -415,6 +417,8 @@ namespace render {
                                                      SLayerRenderData &inRenderData);
 
         void ReleaseLayerRenderResources(SLayer &inLayer, const SRenderInstanceId id) override;
+        void ReleaseMaterialRenderResources(const SGraphObject &inMaterial) override;
+        void PrecompileShaders(SLayer &inLayer, const QT3DSVec2 &inViewportDimensions) override;
 
         void RenderQuad(const QT3DSVec2 inDimensions, const QT3DSMat44 &inMVP,
                                 NVRenderTexture2D &inQuadTexture) override;
@@ -444,13 +448,17 @@ namespace render {
         NVRenderShaderProgram *CompileShader(CRegisteredString inName, const char8_t *inVert,
                                              const char8_t *inFrame);
 
+        CRegisteredString GetShaderCacheName(const SShaderDefaultMaterialKey &inKey,
+                                             ShaderProgramPasses::Enum inPass);
         NVRenderShaderProgram *GenerateShader(SSubsetRenderable &inRenderable,
-                                              TShaderFeatureSet inFeatureSet, bool depth);
+                                              TShaderFeatureSet inFeatureSet, bool depth,
+                                              bool instanced = false);
         NVRenderShaderProgram *GenerateShadowShader(SSubsetRenderable &inRenderable,
                                                     TShaderFeatureSet inFeatureSet,
                                                     RenderLightTypes::Enum lightType);
         SShaderGeneratorGeneratedShader *GetShader(SSubsetRenderable &inRenderable,
-                                                   TShaderFeatureSet inFeatureSet, bool depth);
+                                                   TShaderFeatureSet inFeatureSet, bool depth,
+                                                   bool instanced = false);
         SRenderableDepthPrepassShader *GetShadowShader(SSubsetRenderable &inRenderable,
                                                        TShaderFeatureSet inFeatureSet,
                                                        RenderLightTypes::Enum lightType);
@@ -509,6 +517,9 @@ namespace render {
         SLayerGlobalRenderProperties GetLayerGlobalRenderProperties();
         void UpdateCbAoShadow(const SLayer *pLayer, const SCamera *pCamera,
                               CResourceTexture2D &inDepthTexture);
+        // Backing store of the cbInstances block of instanced subset shaders
+        NVRenderConstantBuffer *GetInstanceConstantBuffer();
+        bool IsInstancingEnabled() const { return m_InstancingEnabled; }
 
         NVRenderContext &GetContext() { return *m_Context; }
 
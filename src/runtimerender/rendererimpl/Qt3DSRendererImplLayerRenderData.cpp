@@ -98,6 +98,14 @@ namespace render {
         , m_TextScale(1.0f)
         , mRefCount(0)
         , m_DepthBufferFormat(NVRenderTextureFormats::Unknown)
+        , m_InstanceLastIndex(inRenderer.GetContext().GetAllocator(),
+                              "SLayerRenderData::m_InstanceLastIndex")
+        , m_InstanceNext(inRenderer.GetContext().GetAllocator(),
+                         "SLayerRenderData::m_InstanceNext")
+        , m_InstanceDrawn(inRenderer.GetContext().GetAllocator(),
+                          "SLayerRenderData::m_InstanceDrawn")
+        , m_InstanceBatch(inRenderer.GetContext().GetAllocator(),
+                          "SLayerRenderData::m_InstanceBatch")
     {
 
     }
@@ -1125,6 +1133,51 @@ void SLayerRenderData::renderTransparentObjectsPass(
     }
 };
 
+void SLayerRenderData::BuildInstanceLinks(NVDataRef<SRenderableObject *> inObjects)
+{
+    m_InstanceLastIndex.clear();
+    m_InstanceNext.assign(inObjects.size(), QT3DS_MAX_U32);
+    m_InstanceDrawn.assign(inObjects.size(), 0);
+    for (QT3DSU32 idx = 0, end = inObjects.size(); idx < end; ++idx) {
+        SRenderableObject &theObject(*inObjects[idx]);
+        if (!theObject.m_RenderableFlags.IsDefaultMaterialMeshSubset()
+            || !static_cast<SSubsetRenderable &>(theObject).IsInstanceable()) {
+            continue;
+        }
+        NVRenderInputAssembler *theAssembler =
+            static_cast<SSubsetRenderable &>(theObject).m_Subset.m_InputAssembler;
+        eastl::pair<nvhash_map<NVRenderInputAssembler *, QT3DSU32>::iterator, bool> theInserter =
+            m_InstanceLastIndex.insert(eastl::make_pair(theAssembler, idx));
+        if (!theInserter.second) {
+            m_InstanceNext[theInserter.first->second] = idx;
+            theInserter.first->second = idx;
+        }
+    }
+}
+
+bool SLayerRenderData::RenderInstanceBatch(NVDataRef<SRenderableObject *> inObjects,
+                                           QT3DSU32 inIndex, const QT3DSVec2 &inCameraProps)
+{
+    SSubsetRenderable &theFirst(static_cast<SSubsetRenderable &>(*inObjects[inIndex]));
+    m_InstanceBatch.clear();
+    m_InstanceBatch.push_back(&theFirst);
+    for (QT3DSU32 idx = m_InstanceNext[inIndex]; idx != QT3DS_MAX_U32; idx = m_InstanceNext[idx]) {
+        SSubsetRenderable &theOther(static_cast<SSubsetRenderable &>(*inObjects[idx]));
+        if (!m_InstanceDrawn[idx] && theFirst.IsInstanceCompatible(theOther)) {
+            m_InstanceBatch.push_back(&theOther);
+            m_InstanceDrawn[idx] = 1;
+        }
+    }
+    if (m_InstanceBatch.size() < 2)
+        return false;
+
+    SetShaderFeature(m_CGLightingFeatureName, m_Lights.empty() == false);
+    theFirst.RenderInstanced(inCameraProps, GetShaderFeatureSet(),
+                             qt3ds::foundation::toConstDataRef(
+                                 m_InstanceBatch.data(), (QT3DSU32)m_InstanceBatch.size()));
+    return true;
+}
+
 void SLayerRenderData::RunRenderPass(TRenderRenderableFunction inRenderFn,
                                      bool inEnableBlending, bool inEnableDepthWrite,
                                      bool inEnableTransparentDepthWrite, QT3DSU32 indexLight,
@@ -1145,9 +1198,25 @@ void SLayerRenderData::RunRenderPass(TRenderRenderableFunction inRenderFn,
         theRenderContext.SetDepthTestEnabled(opaqueDepthTest);
         theRenderContext.SetDepthWriteEnabled(opaqueDepthWrite);
 
+        // Only the color pass is batched, the draw order of opaque objects does not matter
+        // as long as the depth test is on.
+        const bool instancing = inRenderFn == RenderRenderable && opaqueDepthTest
+                && m_Renderer.IsInstancingEnabled();
+        if (instancing)
+            BuildInstanceLinks(theOpaqueObjects);
+
         for (QT3DSU32 idx = 0, end = theOpaqueObjects.size(); idx < end; ++idx) {
             SRenderableObject &theObject(*theOpaqueObjects[idx]);
 
+            if (instancing && m_InstanceNext[idx] != QT3DS_MAX_U32 && !m_InstanceDrawn[idx]) {
+                theRenderContext.SetBlendingEnabled(false);
+                theRenderContext.SetDepthWriteEnabled(opaqueDepthWrite);
+                if (RenderInstanceBatch(theOpaqueObjects, idx, theCameraProps))
+                    continue;
+            }
+            if (instancing && m_InstanceDrawn[idx])
+                continue;
+
             if (theObject.m_RenderableFlags.isOrderedGroup()) {
                 renderOrderedGroup(theObject, inRenderFn, inEnableBlending, inEnableDepthWrite,
                                    inEnableTransparentDepthWrite, indexLight, inCamera, theFB);
@@ -2428,6 +2497,8 @@ void SLayerRenderData::RunRenderPass(TRenderRenderableFunction inRenderFn,
         theTransparentObjects.clear();
         theOpaqueObjects.clear();
         m_ModelContexts.clear();
+        // The renderables prepared here replace the retained ones.
+        m_RetainedRenderablesValid = false;
         SLayerRenderPreparationResultFlags theFlags;
         PrepareRenderablesForRender(inViewProjection, Empty(), 1.0, theFlags);
         RenderDepthPass(false);
@@ -98,6 +98,13 @@ struct AdvancedBlendModes
 
         QSize m_previousDimensions;
 
+        // Instanced drawing of the opaque pass. m_InstanceNext links every opaque renderable
+        // that can be instanced to the next one drawing the same input assembler.
+        nvhash_map<NVRenderInputAssembler *, QT3DSU32> m_InstanceLastIndex;
+        nvvector<QT3DSU32> m_InstanceNext;
+        nvvector<QT3DSU8> m_InstanceDrawn;
+        nvvector<SSubsetRenderable *> m_InstanceBatch;
+
         SLayerRenderData(SLayer &inLayer, Qt3DSRendererImpl &inRenderer);
 
         virtual ~SLayerRenderData();
@@ -182,6 +189,11 @@ struct AdvancedBlendModes
         void BlendAdvancedToFB(DefaultMaterialBlendMode::Enum blendMode, bool depthEnabled,
                                CResourceFrameBuffer *theFB);
 #endif
+        void BuildInstanceLinks(NVDataRef<SRenderableObject *> inObjects);
+        // Draws the opaque renderable at inIndex together with every later compatible one.
+        // Returns false, drawing nothing, if there is no other renderable to batch it with.
+        bool RenderInstanceBatch(NVDataRef<SRenderableObject *> inObjects, QT3DSU32 inIndex,
+                                 const QT3DSVec2 &inCameraProps);
         void renderTransparentObjectsPass(TRenderRenderableFunction inRenderFn,
                                           bool inEnableBlending, bool inEnableDepthWrite,
                                           bool inEnableTransparentDepthWrite,
@@ -59,6 +59,7 @@
 #include "Qt3DSRenderRenderList.h"
 #include "Qt3DSRenderPath.h"
 #include "Qt3DSRenderPathManager.h"
+#include "Qt3DSRenderJobSystem.h"
 
 #ifdef _WIN32
 #pragma warning(disable : 4355)
@@ -101,6 +102,226 @@ namespace render {
         {
             return inLightProbeImage && inLightProbeImage->m_TextureData.m_Texture;
         }
+
+        // Breadth first so that each depth level can be updated as a batch once the level
+        // above it is done.
+        void FlattenLayerTransforms(SLayer &inLayer, nvvector<SNode *> &outNodes,
+                                    nvvector<QT3DSU32> &outLevelOffsets)
+        {
+            outNodes.clear();
+            outLevelOffsets.clear();
+            for (SNode *theChild = inLayer.m_FirstChild; theChild;
+                 theChild = theChild->m_NextSibling)
+                outNodes.push_back(theChild);
+            QT3DSU32 levelStart = 0;
+            while (levelStart < outNodes.size()) {
+                outLevelOffsets.push_back(levelStart);
+                QT3DSU32 levelEnd = outNodes.size();
+                for (QT3DSU32 idx = levelStart; idx < levelEnd; ++idx) {
+                    SNode *theParent = outNodes[idx];
+                    for (SNode *theChild = theParent->m_FirstChild; theChild;
+                         theChild = theChild->m_NextSibling)
+                        outNodes.push_back(theChild);
+                }
+                levelStart = levelEnd;
+            }
+            outLevelOffsets.push_back(outNodes.size());
+        }
+
+        // Nodes processed in one job. Small layers stay on the calling thread.
+        const QT3DSU32 RENDERABLE_NODE_GRAIN_SIZE = 64;
+
+        struct SNodeTransformPass
+        {
+            SNode *const *m_Nodes;
+
+            void operator()(QT3DSU32 inBegin, QT3DSU32 inEnd) const
+            {
+                // The parents are on an earlier level and already up to date so this only
+                // writes to the node itself.
+                for (QT3DSU32 idx = inBegin; idx < inEnd; ++idx)
+                    m_Nodes[idx]->CalculateGlobalVariables();
+            }
+        };
+
+        // Consecutive renderable nodes sharing one set of cluster bounds.
+        const QT3DSU32 RENDERABLE_NODE_CLUSTER_SIZE = 16;
+
+        // Updates the cached world bounds of the models that moved and of their clusters. Runs
+        // over clusters so each job owns the nodes it writes to.
+        struct SRenderableNodeBoundsPass
+        {
+            SRenderableNodeEntry *m_Nodes;
+            SRenderMesh *const *m_Meshes;
+            const QT3DSU32 *m_CullOffsets;
+            SSubsetCullResult *m_CullResults;
+            SRenderableNodeBounds *m_NodeBounds;
+            NVBounds3 *m_ClusterBounds;
+            QT3DSU32 m_NumNodes;
+            bool m_UpdateAll;
+
+            void operator()(QT3DSU32 inBegin, QT3DSU32 inEnd) const
+            {
+                for (QT3DSU32 cluster = inBegin; cluster < inEnd; ++cluster) {
+                    QT3DSU32 nodeBegin = cluster * RENDERABLE_NODE_CLUSTER_SIZE;
+                    QT3DSU32 nodeEnd =
+                        NVMin(nodeBegin + RENDERABLE_NODE_CLUSTER_SIZE, m_NumNodes);
+                    bool clusterChanged = m_UpdateAll;
+                    for (QT3DSU32 idx = nodeBegin; idx < nodeEnd; ++idx) {
+                        SRenderMesh *theMesh = m_Meshes[idx];
+                        if (theMesh == NULL)
+                            continue;
+                        const SModel &theModel(*static_cast<SModel *>(m_Nodes[idx].m_Node));
+                        SRenderableNodeBounds &theNodeBounds(m_NodeBounds[idx]);
+                        const QT3DSMat44 &theTransform(theModel.m_GlobalTransform);
+                        if (!m_UpdateAll
+                            && memcmp(&theNodeBounds.m_GlobalTransform, &theTransform,
+                                      sizeof(QT3DSMat44)) == 0) {
+                            continue;
+                        }
+                        theNodeBounds.m_GlobalTransform = theTransform;
+                        theNodeBounds.m_WorldBounds.setEmpty();
+                        SSubsetCullResult *theResults = m_CullResults + m_CullOffsets[idx];
+                        for (QT3DSU32 subsetIdx = 0, subsetEnd = theMesh->m_Subsets.size();
+                             subsetIdx < subsetEnd; ++subsetIdx) {
+                            const SRenderSubset &theSubset(theMesh->m_Subsets[subsetIdx]);
+                            SSubsetCullResult &theResult(theResults[subsetIdx]);
+                            theResult.m_WorldCenter =
+                                theTransform.transform(theSubset.m_Bounds.getCenter());
+                            theResult.m_WorldBounds = theSubset.m_Bounds;
+                            theResult.m_WorldBounds.transform(theTransform);
+                            theNodeBounds.m_WorldBounds.include(theResult.m_WorldBounds);
+                        }
+                        clusterChanged = true;
+                    }
+                    if (!clusterChanged)
+                        continue;
+                    NVBounds3 &theClusterBounds(m_ClusterBounds[cluster]);
+                    theClusterBounds.setEmpty();
+                    for (QT3DSU32 idx = nodeBegin; idx < nodeEnd; ++idx) {
+                        if (m_Meshes[idx])
+                            theClusterBounds.include(m_NodeBounds[idx].m_WorldBounds);
+                    }
+                }
+            }
+        };
+
+        // Culls the subsets from the top down: clusters, then models, then subsets. Boxes
+        // completely outside or inside of the frustum decide for everything below them and
+        // the boxes of one level are tested four at a time.
+        struct SRenderableNodeCullPass
+        {
+            SRenderableNodeEntry *m_Nodes;
+            SRenderMesh *const *m_Meshes;
+            const QT3DSU32 *m_CullOffsets;
+            SSubsetCullResult *m_CullResults;
+            const SRenderableNodeBounds *m_NodeBounds;
+            const NVBounds3 *m_ClusterBounds;
+            QT3DSU32 m_NumNodes;
+            const SClippingFrustum *m_ClipFrustum;
+
+            bool CanCull(QT3DSU32 inNode) const
+            {
+                const SModel &theModel(*static_cast<SModel *>(m_Nodes[inNode].m_Node));
+                return m_ClipFrustum != NULL
+                    && theModel.m_GlobalOpacity >= QT3DS_RENDER_MINIMUM_RENDER_OPACITY;
+            }
+
+            void SetNodeCulled(QT3DSU32 inNode, bool inCulled) const
+            {
+                SRenderMesh *theMesh = m_Meshes[inNode];
+                if (theMesh == NULL)
+                    return;
+                inCulled = inCulled && CanCull(inNode);
+                SSubsetCullResult *theResults = m_CullResults + m_CullOffsets[inNode];
+                for (QT3DSU32 subsetIdx = 0, subsetEnd = theMesh->m_Subsets.size();
+                     subsetIdx < subsetEnd; ++subsetIdx)
+                    theResults[subsetIdx].m_Culled = inCulled;
+            }
+
+            void CullSubsets(QT3DSU32 inNode) const
+            {
+                if (!CanCull(inNode)) {
+                    SetNodeCulled(inNode, false);
+                    return;
+                }
+                SSubsetCullResult *theResults = m_CullResults + m_CullOffsets[inNode];
+                QT3DSU32 numSubsets = m_Meshes[inNode]->m_Subsets.size();
+                for (QT3DSU32 first = 0; first < numSubsets; first += 4) {
+                    // Short batches repeat their last box.
+                    const NVBounds3 *theBounds[4];
+                    QT3DSU32 numLanes = NVMin(4u, numSubsets - first);
+                    for (QT3DSU32 lane = 0; lane < 4; ++lane) {
+                        QT3DSU32 subsetIdx = first + NVMin(lane, numLanes - 1);
+                        theBounds[lane] = &theResults[subsetIdx].m_WorldBounds;
+                    }
+                    QT3DSU32 theOutside, theInside;
+                    m_ClipFrustum->intersect4(theBounds, theOutside, theInside);
+                    for (QT3DSU32 lane = 0; lane < numLanes; ++lane)
+                        theResults[first + lane].m_Culled = ((theOutside >> lane) & 1) != 0;
+                }
+            }
+
+            void CullNodes(QT3DSU32 inBegin, QT3DSU32 inEnd) const
+            {
+                // Only the nodes with a mesh are tested, gathered into batches of four.
+                QT3DSU32 theBatch[4];
+                QT3DSU32 theBatchSize = 0;
+                for (QT3DSU32 idx = inBegin; idx <= inEnd; ++idx) {
+                    if (idx < inEnd) {
+                        if (m_Meshes[idx] == NULL)
+                            continue;
+                        theBatch[theBatchSize++] = idx;
+                        if (theBatchSize < 4)
+                            continue;
+                    } else if (theBatchSize == 0) {
+                        break;
+                    }
+                    const NVBounds3 *theBounds[4];
+                    for (QT3DSU32 lane = 0; lane < 4; ++lane)
+                        theBounds[lane] =
+                            &m_NodeBounds[theBatch[NVMin(lane, theBatchSize - 1)]].m_WorldBounds;
+                    QT3DSU32 theOutside, theInside;
+                    m_ClipFrustum->intersect4(theBounds, theOutside, theInside);
+                    for (QT3DSU32 lane = 0; lane < theBatchSize; ++lane) {
+                        if ((theOutside >> lane) & 1)
+                            SetNodeCulled(theBatch[lane], true);
+                        else if ((theInside >> lane) & 1)
+                            SetNodeCulled(theBatch[lane], false);
+                        else
+                            CullSubsets(theBatch[lane]);
+                    }
+                    theBatchSize = 0;
+                }
+            }
+
+            void operator()(QT3DSU32 inBegin, QT3DSU32 inEnd) const
+            {
+                for (QT3DSU32 first = inBegin; first < inEnd; first += 4) {
+                    QT3DSU32 numClusters = NVMin(4u, inEnd - first);
+                    QT3DSU32 theOutside = 0, theInside = 0;
+                    if (m_ClipFrustum) {
+                        const NVBounds3 *theBounds[4];
+                        for (QT3DSU32 lane = 0; lane < 4; ++lane)
+                            theBounds[lane] =
+                                &m_ClusterBounds[first + NVMin(lane, numClusters - 1)];
+                        m_ClipFrustum->intersect4(theBounds, theOutside, theInside);
+                    }
+                    for (QT3DSU32 lane = 0; lane < numClusters; ++lane) {
+                        QT3DSU32 nodeBegin = (first + lane) * RENDERABLE_NODE_CLUSTER_SIZE;
+                        QT3DSU32 nodeEnd =
+                            NVMin(nodeBegin + RENDERABLE_NODE_CLUSTER_SIZE, m_NumNodes);
+                        if (m_ClipFrustum == NULL || (((theOutside | theInside) >> lane) & 1)) {
+                            bool culled = ((theOutside >> lane) & 1) != 0;
+                            for (QT3DSU32 idx = nodeBegin; idx < nodeEnd; ++idx)
+                                SetNodeCulled(idx, culled);
+                        } else {
+                            CullNodes(nodeBegin, nodeEnd);
+                        }
+                    }
+                }
+            }
+        };
     }
 
     SDefaultMaterialPreparationResult::SDefaultMaterialPreparationResult(
@@ -130,6 +351,12 @@ namespace render {
                            "SLayerRenderPreparationData::m_LightToNodeMap")
         , m_CamerasAndLights(inRenderer.GetContext().GetAllocator(),
                              "SLayerRenderPreparationData::m_CamerasAndLights")
+        , m_TransformNodes(inRenderer.GetContext().GetAllocator(),
+                           "SLayerRenderPreparationData::m_TransformNodes")
+        , m_TransformLevelOffsets(inRenderer.GetContext().GetAllocator(),
+                                  "SLayerRenderPreparationData::m_TransformLevelOffsets")
+        , m_DirtyTransformNodes(inRenderer.GetContext().GetAllocator(),
+                                "SLayerRenderPreparationData::m_DirtyTransformNodes")
         , m_Camera(NULL)
         , m_Lights(inRenderer.GetContext().GetAllocator(), "SLayerRenderPreparationData::m_Lights")
         , m_OpaqueObjects(inRenderer.GetContext().GetAllocator(),
@@ -142,6 +369,10 @@ namespace render {
                                   "SLayerRenderPreparationData::m_RenderedOpaqueObjects")
         , m_RenderedTransparentObjects(inRenderer.GetContext().GetAllocator(),
                                        "SLayerRenderPreparationData::m_RenderedTransparentObjects")
+        , m_OpaqueSortCache(inRenderer.GetContext().GetAllocator())
+        , m_TransparentSortCache(inRenderer.GetContext().GetAllocator())
+        , m_SortScratchObjects(inRenderer.GetContext().GetAllocator(),
+                               "SLayerRenderPreparationData::m_SortScratchObjects")
         , m_IRenderWidgets(inRenderer.GetContext().GetAllocator(),
                            "SLayerRenderPreparationData::m_IRenderWidgets")
         , m_SourceLightDirections(inRenderer.GetContext().GetAllocator(),
@@ -150,6 +381,35 @@ namespace render {
                             "SLayerRenderPreparationData::m_LightDirections")
         , m_ModelContexts(inRenderer.GetContext().GetAllocator(),
                           "SLayerRenderPreparationData::m_ModelContexts")
+        , m_RenderableNodeMeshes(inRenderer.GetContext().GetAllocator(),
+                                 "SLayerRenderPreparationData::m_RenderableNodeMeshes")
+        , m_RenderableNodeCullOffsets(inRenderer.GetContext().GetAllocator(),
+                                      "SLayerRenderPreparationData::m_RenderableNodeCullOffsets")
+        , m_SubsetCullResults(inRenderer.GetContext().GetAllocator(),
+                              "SLayerRenderPreparationData::m_SubsetCullResults")
+        , m_RenderableNodeBounds(inRenderer.GetContext().GetAllocator(),
+                                 "SLayerRenderPreparationData::m_RenderableNodeBounds")
+        , m_RenderableClusterBounds(inRenderer.GetContext().GetAllocator(),
+                                    "SLayerRenderPreparationData::m_RenderableClusterBounds")
+        , m_CullHadFrustum(false)
+        , m_CullResultsValid(false)
+        , m_CullBoundsValid(false)
+        , m_PickBvh(inRenderer.GetContext().GetAllocator())
+        , m_PickRenderables(inRenderer.GetContext().GetAllocator(),
+                            "SLayerRenderPreparationData::m_PickRenderables")
+        , m_PickHits(inRenderer.GetContext().GetAllocator(),
+                     "SLayerRenderPreparationData::m_PickHits")
+        , m_TransformsChanged(true)
+        , m_RenderableAllocator(inRenderer.GetContext().GetAllocator())
+        , m_RetainedOpaqueObjects(inRenderer.GetContext().GetAllocator(),
+                                  "SLayerRenderPreparationData::m_RetainedOpaqueObjects")
+        , m_RetainedTransparentObjects(inRenderer.GetContext().GetAllocator(),
+                                       "SLayerRenderPreparationData::m_RetainedTransparentObjects")
+        , m_RetainedGroupObjects(inRenderer.GetContext().GetAllocator(),
+                                 "SLayerRenderPreparationData::m_RetainedGroupObjects")
+        , m_RetainedWireframeMode(false)
+        , m_RenderablesRetainable(false)
+        , m_RetainedRenderablesValid(false)
         , m_CGLightingFeatureName(
               inRenderer.GetContext().GetStringTable().RegisterStr("QT3DS_ENABLE_CG_LIGHTING"))
         , m_FeaturesDirty(true)
@@ -257,6 +517,48 @@ namespace render {
         return *m_CameraDirection;
     }
 
+    void SLayerRenderPreparationData::SortRenderableObjects(TRenderableObjectList &ioObjects,
+                                                            SRenderableSortCache &ioCache,
+                                                            RenderableSortPasses::Enum inPass)
+    {
+        QT3DS_PERF_SCOPED_TIMER(m_Renderer.GetQt3DSContext().GetPerfTimer(),
+                                "LayerRenderData: SortRenderableObjects")
+        QT3DSU32 theCount = ioObjects.size();
+        ioCache.m_Keys.resize(theCount);
+        for (QT3DSU32 idx = 0; idx < theCount; ++idx) {
+            const SRenderableObject &theObject(*ioObjects[idx]);
+            if (inPass == RenderableSortPasses::Transparent) {
+                ioCache.m_Keys[idx] = MakeTransparentSortKey(theObject.m_CameraDistanceSq);
+                continue;
+            }
+            QT3DSU32 theShaderId = 0;
+            QT3DSU32 theMaterialId = 0;
+            if (theObject.m_RenderableFlags.IsDefaultMaterialMeshSubset()) {
+                const SSubsetRenderable &theSubset(
+                    static_cast<const SSubsetRenderable &>(theObject));
+                theShaderId = FoldSortId(theSubset.m_ShaderDescription.hash());
+                theMaterialId = FoldSortId(size_t(&theSubset.m_Material) >> 4);
+            } else if (theObject.m_RenderableFlags.IsCustomMaterialMeshSubset()) {
+                const SCustomMaterialRenderable &theSubset(
+                    static_cast<const SCustomMaterialRenderable &>(theObject));
+                theShaderId = FoldSortId(theSubset.m_ShaderDescription.hash());
+                theMaterialId = FoldSortId(size_t(&theSubset.m_Material) >> 4);
+            } else if (theObject.m_RenderableFlags.IsPath()) {
+                const SPathRenderable &thePath(static_cast<const SPathRenderable &>(theObject));
+                theShaderId = FoldSortId(thePath.m_ShaderDescription.hash());
+                theMaterialId = FoldSortId(size_t(&thePath.m_Material) >> 4);
+            }
+            ioCache.m_Keys[idx] = MakeOpaqueSortKey(theObject.m_CameraDistanceSq, theShaderId,
+                                                    theMaterialId);
+        }
+
+        ioCache.Sort();
+
+        m_SortScratchObjects.assign(ioObjects.begin(), ioObjects.end());
+        for (QT3DSU32 idx = 0; idx < theCount; ++idx)
+            ioObjects[idx] = m_SortScratchObjects[ioCache.m_Order[idx]];
+    }
+
     // Per-frame cache of renderable objects post-sort.
     NVDataRef<SRenderableObject *> SLayerRenderPreparationData::GetOpaqueRenderableObjects()
     {
@@ -281,10 +583,9 @@ namespace render {
                 theInfo.m_CameraDistanceSq = difference.dot(theCameraDirection);
             }
 
-            ForwardingAllocator alloc(m_Renderer.GetPerFrameAllocator(), "SortAllocations");
             // Render nearest to furthest objects
-            eastl::merge_sort(m_RenderedOpaqueObjects.begin(), m_RenderedOpaqueObjects.end(), alloc,
-                              ISRenderObjectPtrLessThan);
+            SortRenderableObjects(m_RenderedOpaqueObjects, m_OpaqueSortCache,
+                                  RenderableSortPasses::Opaque);
         }
         return m_RenderedOpaqueObjects;
     }
@@ -319,11 +620,9 @@ namespace render {
                     theInfo.m_RenderableFlags.setAlphaTest(0);
             }
 
-            ForwardingAllocator alloc(m_Renderer.GetPerFrameAllocator(), "SortAllocations");
             // render furthest to nearest.
-            eastl::merge_sort(m_RenderedTransparentObjects.begin(),
-                              m_RenderedTransparentObjects.end(), alloc,
-                              ISRenderObjectPtrGreatThan);
+            SortRenderableObjects(m_RenderedTransparentObjects, m_TransparentSortCache,
+                                  RenderableSortPasses::Transparent);
         }
 
         return m_RenderedTransparentObjects;
@@ -347,7 +646,8 @@ namespace render {
             m_IRenderWidgets.push_back(&inWidget);
     }
 
-#define RENDER_FRAME_NEW(type) QT3DS_NEW(m_Renderer.GetPerFrameAllocator(), type)
+// Renderables outlive the frame as long as they can be reused, see PrepareForRender.
+#define RENDER_FRAME_NEW(type) QT3DS_NEW(m_RenderableAllocator, type)
 
 #define QT3DS_RENDER_MINIMUM_RENDER_OPACITY .01f
 
@@ -430,8 +730,13 @@ namespace render {
             } else
 #endif
             {
-                TTPathObjectAndTexture theResult
-                        = theTextRenderer->RenderText(inText, inTextScaleFactor);
+                TTPathObjectAndTexture theResult;
+                if (!theTextRenderer->RenderTextAsync(&inText, inText, inTextScaleFactor,
+                                                      inText.m_TextTexture, theResult)) {
+                    // Older text is drawn until the new one has been rasterized.
+                    inText.m_Flags.SetTextDirty(true);
+                    retval = true;
+                }
                 inText.m_TextTexture = theResult.second.second.mPtr;
                 inText.m_TextTextureDetails = theResult.second.first;
                 inText.m_PathFontItem = theResult.first.second;
@@ -643,6 +948,11 @@ namespace render {
         if (inImage.ClearDirty(bufferManager, theOffscreenRenderManager, theRenderPluginManager,
                                false, m_Layer.m_Scene->m_Presentation->m_flipCompressedTextures))
             ioFlags |= RenderPreparationResultFlagValues::Dirty;
+        // Offscreen results and textures still loading change without the image getting dirty.
+        if (inImage.m_OffscreenRendererId.IsValid() || inImage.m_RenderPlugin
+            || inImage.m_TextureData.m_Texture == NULL) {
+            m_RenderablesRetainable = false;
+        }
 
         // All objects with offscreen renderers are pickable so we can pass the pick through to the
         // offscreen renderer and let it deal with the pick.
@@ -731,8 +1041,10 @@ namespace render {
         m_Renderer.DefaultMaterialShaderKeyProperties().m_WireframeMode.SetValue(
             theGeneratedKey, m_Renderer.GetQt3DSContext().GetWireframeMode());
 
-        if (theMaterial->m_IblProbe && CheckLightProbeDirty(*theMaterial->m_IblProbe)) {
-            m_Renderer.PrepareImageForIbl(*theMaterial->m_IblProbe);
+        if (theMaterial->m_IblProbe) {
+            m_RenderablesRetainable = false;
+            if (CheckLightProbeDirty(*theMaterial->m_IblProbe))
+                m_Renderer.PrepareImageForIbl(*theMaterial->m_IblProbe);
         }
 
         if (!m_Renderer.DefaultMaterialShaderKeyProperties().m_HasIbl.GetValue(theGeneratedKey)) {
@@ -922,15 +1234,12 @@ namespace render {
     }
 
     bool SLayerRenderPreparationData::PrepareModelForRender(
-        SModel &inModel, const QT3DSMat44 &inViewProjection,
-        const Option<SClippingFrustum> &inClipFrustum, TNodeLightEntryList &inScopedLights,
+        SModel &inModel, SRenderMesh &inMesh, const SSubsetCullResult *inCullResults,
+        const QT3DSMat44 &inViewProjection, TNodeLightEntryList &inScopedLights,
         SOrderedGroupRenderable *group)
     {
         IQt3DSRenderContext &qt3dsContext(m_Renderer.GetQt3DSContext());
-        IBufferManager &bufferManager = qt3dsContext.GetBufferManager();
-        SRenderMesh *theMesh = bufferManager.LoadMesh(inModel.m_MeshPath);
-        if (theMesh == NULL)
-            return false;
+        SRenderMesh *theMesh = &inMesh;
 
         SGraphObject *theSourceMaterialObject = inModel.m_FirstMaterial;
         SModelContext &theModelContext =
@@ -951,17 +1260,9 @@ namespace render {
                 renderableFlags.SetPickable(false);
                 renderableFlags.SetShadowCaster(inModel.m_ShadowCaster);
                 QT3DSF32 subsetOpacity = inModel.m_GlobalOpacity;
-                QT3DSVec3 theModelCenter(theSubset.m_Bounds.getCenter());
-                theModelCenter = inModel.m_GlobalTransform.transform(theModelCenter);
-
-                if (subsetOpacity >= QT3DS_RENDER_MINIMUM_RENDER_OPACITY
-                    && inClipFrustum.hasValue()) {
-                    // Check bounding box against the clipping planes
-                    NVBounds3 theGlobalBounds = theSubset.m_Bounds;
-                    theGlobalBounds.transform(theModelContext.m_Model.m_GlobalTransform);
-                    if (inClipFrustum->intersectsWith(theGlobalBounds) == false)
-                        subsetOpacity = 0.0f;
-                }
+                QT3DSVec3 theModelCenter(inCullResults[idx].m_WorldCenter);
+                if (inCullResults[idx].m_Culled)
+                    subsetOpacity = 0.0f;
 
                 // For now everything is pickable.  Eventually we want to have localPickable and
                 // globalPickable set on the node during
@@ -979,6 +1280,9 @@ namespace render {
                     ResolveReferenceMaterial(theSourceMaterialObject);
                 SGraphObject *theMaterialObject = theMaterialObjectAndDirty.second;
                 subsetDirty = subsetDirty || theMaterialObjectAndDirty.first;
+                // Reference dirtiness is only tracked by resolving the reference.
+                if (theSourceMaterialObject->m_Type == GraphObjectTypes::ReferencedMaterial)
+                    m_RenderablesRetainable = false;
                 if (theMaterialObject == NULL)
                     continue;
 
@@ -1043,6 +1347,7 @@ namespace render {
                 else if (theMaterialObject->m_Type == GraphObjectTypes::CustomMaterial) {
                     SCustomMaterial &theMaterial(
                         static_cast<SCustomMaterial &>(*theMaterialObject));
+                    m_RenderablesRetainable = false;
 
                     ICustomMaterialSystem &theMaterialSystem(
                         qt3dsContext.GetCustomMaterialSystem());
@@ -1098,6 +1403,110 @@ namespace render {
         return subsetDirty;
     }
 
+    bool SLayerRenderPreparationData::UpdateLayerTransforms()
+    {
+        IJobSystem &theJobSystem(m_Renderer.GetQt3DSContext().GetJobSystem());
+        bool wasDirty = false;
+        QT3DSU32 numLevels = m_TransformLevelOffsets.empty() ? 0
+                                                             : m_TransformLevelOffsets.size() - 1;
+        for (QT3DSU32 level = 0; level < numLevels; ++level) {
+            // Marking a node dirty marks its whole subtree, so the dirty nodes of a level are
+            // the dirty roots plus the descendants of dirty roots above it.
+            m_DirtyTransformNodes.clear();
+            for (QT3DSU32 idx = m_TransformLevelOffsets[level],
+                          end = m_TransformLevelOffsets[level + 1];
+                 idx < end; ++idx) {
+                SNode *theNode = m_TransformNodes[idx];
+                if (theNode->m_Flags.IsDirty())
+                    m_DirtyTransformNodes.push_back(theNode);
+            }
+            if (m_DirtyTransformNodes.empty())
+                continue;
+            wasDirty = true;
+            SNodeTransformPass thePass = { m_DirtyTransformNodes.data() };
+            ParallelFor(theJobSystem, m_DirtyTransformNodes.size(), RENDERABLE_NODE_GRAIN_SIZE,
+                        thePass);
+        }
+        m_TransformsChanged = m_TransformsChanged || wasDirty;
+        return wasDirty;
+    }
+
+    bool SLayerRenderPreparationData::PrepareRenderableNodes(
+            const Option<SClippingFrustum> &inClipFrustum)
+    {
+        IQt3DSRenderContext &theContext(m_Renderer.GetQt3DSContext());
+        QT3DSU32 numNodes = m_RenderableNodes.size();
+        // Normally a no-op as PrepareForRender already did this, PrepareAndRender does not.
+        bool wasDataDirty = UpdateLayerTransforms();
+
+        // Mesh uploads go through the buffer manager and have to stay on this thread.  Meshes
+        // still being parsed on the job system are left out and the layer stays dirty until
+        // they are in.
+        IBufferManager &theBufferManager(theContext.GetBufferManager());
+        bool meshesChanged = m_RenderableNodeMeshes.size() != numNodes;
+        m_RenderableNodeMeshes.resize(numNodes);
+        m_RenderableNodeCullOffsets.resize(numNodes);
+        QT3DSU32 numSubsets = 0;
+        for (QT3DSU32 idx = 0; idx < numNodes; ++idx) {
+            SNode *theNode = m_RenderableNodes[idx].m_Node;
+            SRenderMesh *theMesh = NULL;
+            if (theNode->m_Type == GraphObjectTypes::Model && theNode->m_Flags.IsGloballyActive()) {
+                CRegisteredString theMeshPath = static_cast<SModel *>(theNode)->m_MeshPath;
+                theMesh = theBufferManager.TryLoadMesh(theMeshPath);
+                if (theMesh == NULL && theMeshPath.IsValid())
+                    wasDataDirty = true;
+            }
+            meshesChanged = meshesChanged || m_RenderableNodeMeshes[idx] != theMesh;
+            m_RenderableNodeMeshes[idx] = theMesh;
+            m_RenderableNodeCullOffsets[idx] = numSubsets;
+            if (theMesh)
+                numSubsets += theMesh->m_Subsets.size();
+        }
+
+        // Nothing moved and the camera is where it was, the last cull results still hold.
+        const SClippingFrustum *theClipFrustum =
+            inClipFrustum.hasValue() ? &inClipFrustum.getValue() : NULL;
+        bool cullResultsValid = m_CullResultsValid && !m_TransformsChanged && !meshesChanged
+            && numSubsets == m_SubsetCullResults.size()
+            && m_CullHadFrustum == (theClipFrustum != NULL)
+            && memcmp(&m_CullViewProjection, &m_ViewProjection, sizeof(QT3DSMat44)) == 0;
+        if (!cullResultsValid) {
+            IJobSystem &theJobSystem(theContext.GetJobSystem());
+            QT3DSU32 numClusters = (numNodes + RENDERABLE_NODE_CLUSTER_SIZE - 1)
+                / RENDERABLE_NODE_CLUSTER_SIZE;
+            QT3DSU32 theClusterGrain = RENDERABLE_NODE_GRAIN_SIZE / RENDERABLE_NODE_CLUSTER_SIZE;
+            // Bounds only need an update for the models that moved, unless the subsets of the
+            // layer changed and the cached ones no longer line up.
+            bool updateAllBounds = !m_CullBoundsValid || meshesChanged
+                || numSubsets != m_SubsetCullResults.size();
+            if (updateAllBounds || m_TransformsChanged) {
+                m_SubsetCullResults.resize(numSubsets);
+                m_RenderableNodeBounds.resize(numNodes);
+                m_RenderableClusterBounds.resize(numClusters);
+                SRenderableNodeBoundsPass theBoundsPass = {
+                    m_RenderableNodes.data(), m_RenderableNodeMeshes.data(),
+                    m_RenderableNodeCullOffsets.data(), m_SubsetCullResults.data(),
+                    m_RenderableNodeBounds.data(), m_RenderableClusterBounds.data(), numNodes,
+                    updateAllBounds
+                };
+                ParallelFor(theJobSystem, numClusters, theClusterGrain, theBoundsPass);
+                m_CullBoundsValid = true;
+            }
+            SRenderableNodeCullPass theCullPass = {
+                m_RenderableNodes.data(), m_RenderableNodeMeshes.data(),
+                m_RenderableNodeCullOffsets.data(), m_SubsetCullResults.data(),
+                m_RenderableNodeBounds.data(), m_RenderableClusterBounds.data(), numNodes,
+                theClipFrustum
+            };
+            ParallelFor(theJobSystem, numClusters, theClusterGrain, theCullPass);
+            m_CullViewProjection = m_ViewProjection;
+            m_CullHadFrustum = theClipFrustum != NULL;
+            m_CullResultsValid = true;
+        }
+        m_TransformsChanged = false;
+        return wasDataDirty;
+    }
+
     bool SLayerRenderPreparationData::PrepareRenderablesForRender(
             const QT3DSMat44 &inViewProjection, const Option<SClippingFrustum> &inClipFrustum,
             QT3DSF32 inTextScaleFactor, SLayerRenderPreparationResultFlags &ioFlags)
@@ -1105,11 +1514,13 @@ namespace render {
         QT3DS_PERF_SCOPED_TIMER(m_Renderer.GetQt3DSContext().GetPerfTimer(),
                                 "LayerRenderData: PrepareRenderablesForRender")
         m_ViewProjection = inViewProjection;
+        m_PickBvh.Invalidate();
         QT3DSF32 theTextScaleFactor = inTextScaleFactor;
-        bool wasDataDirty = false;
         bool hasTextRenderer
                 = m_Renderer.GetQt3DSContext().getDistanceFieldRenderer() != nullptr
                 || m_Renderer.GetQt3DSContext().GetTextRenderer() != nullptr;
+        bool wasDataDirty = PrepareRenderableNodes(inClipFrustum);
+        m_RenderablesRetainable = true;
         for (QT3DSU32 idx = 0, end = m_GroupNodes.size(); idx < end; ++idx) {
             SRenderableNodeEntry &theNodeEntry(m_GroupNodes[idx]);
             SRenderableObjectFlags flags;
@@ -1119,14 +1530,13 @@ namespace render {
             SOrderedGroupRenderable *renderable
                     = RENDER_FRAME_NEW(SOrderedGroupRenderable)(
                         flags, inWorldCenterPt, inGlobalTransform, inBounds,
-                        m_Renderer.GetPerFrameAllocator());
+                        m_RenderableAllocator);
             m_GroupObjects.push_back(renderable);
         }
 
         for (QT3DSU32 idx = 0, end = m_RenderableNodes.size(); idx < end; ++idx) {
             SRenderableNodeEntry &theNodeEntry(m_RenderableNodes[idx]);
             SNode *theNode = theNodeEntry.m_Node;
-            wasDataDirty = wasDataDirty || theNode->m_Flags.IsDirty();
             SOrderedGroupRenderable *group = nullptr;
             if (theNode->m_GroupIndex) {
                 group = static_cast<SOrderedGroupRenderable *>(
@@ -1136,17 +1546,19 @@ namespace render {
             switch (theNode->m_Type) {
             case GraphObjectTypes::Model: {
                 SModel *theModel = static_cast<SModel *>(theNode);
-                theModel->CalculateGlobalVariables();
-                if (theModel->m_Flags.IsGloballyActive()) {
+                SRenderMesh *theMesh = m_RenderableNodeMeshes[idx];
+                if (theMesh) {
                     bool wasModelDirty = PrepareModelForRender(
-                        *theModel, inViewProjection, inClipFrustum, theNodeEntry.m_Lights, group);
+                        *theModel, *theMesh,
+                        m_SubsetCullResults.data() + m_RenderableNodeCullOffsets[idx],
+                        inViewProjection, theNodeEntry.m_Lights, group);
                     wasDataDirty = wasDataDirty || wasModelDirty;
                 }
             } break;
             case GraphObjectTypes::Text: {
+                m_RenderablesRetainable = false;
                 if (hasTextRenderer) {
                     SText *theText = static_cast<SText *>(theNode);
-                    theText->CalculateGlobalVariables();
                     // Omit check for global active flag intentionally and force
                     // render preparation for all Text items. This eliminates
                     // large delay for distance field text items becoming active
@@ -1159,7 +1571,7 @@ namespace render {
             } break;
             case GraphObjectTypes::Path: {
                 SPath *thePath = static_cast<SPath *>(theNode);
-                thePath->CalculateGlobalVariables();
+                m_RenderablesRetainable = false;
                 if (thePath->m_Flags.IsGloballyActive()) {
                     bool wasPathDirty =
                         PreparePathForRender(*thePath, inViewProjection, inClipFrustum, ioFlags,
@@ -1404,6 +1816,51 @@ namespace render {
                                              paddedBoundsWidth, paddedBoundsHeight));
     }
 
+    static bool IsRetainedRenderableClean(const SRenderableObject &inObject)
+    {
+        if (inObject.m_RenderableFlags.isOrderedGroup()) {
+            const SOrderedGroupRenderable &theGroup(
+                static_cast<const SOrderedGroupRenderable &>(inObject));
+            for (QT3DSU32 idx = 0, end = theGroup.m_renderables.size(); idx < end; ++idx) {
+                if (!IsRetainedRenderableClean(*theGroup.m_renderables[idx]))
+                    return false;
+            }
+            return true;
+        }
+        // Anything else is not retained, see m_RenderablesRetainable.
+        if (!inObject.m_RenderableFlags.IsDefaultMaterialMeshSubset())
+            return false;
+        const SSubsetRenderable &theSubset(static_cast<const SSubsetRenderable &>(inObject));
+        if (theSubset.m_Material.m_Dirty.IsDirty())
+            return false;
+        for (const SRenderableImage *theImage = theSubset.m_FirstImage; theImage;
+             theImage = theImage->m_NextImage) {
+            if (theImage->m_Image.m_Flags.IsDirty())
+                return false;
+        }
+        return true;
+    }
+
+    bool SLayerRenderPreparationData::CanReuseRetainedRenderables()
+    {
+        if (!m_RetainedRenderablesValid
+            || m_RetainedWireframeMode != m_Renderer.GetQt3DSContext().GetWireframeMode()
+            || memcmp(&m_RetainedViewProjection, &m_ViewProjection, sizeof(QT3DSMat44)) != 0) {
+            return false;
+        }
+        const TRenderableObjectList *theLists[] = { &m_RetainedOpaqueObjects,
+                                                    &m_RetainedTransparentObjects,
+                                                    &m_RetainedGroupObjects };
+        for (QT3DSU32 listIdx = 0; listIdx < 3; ++listIdx) {
+            const TRenderableObjectList &theObjects(*theLists[listIdx]);
+            for (QT3DSU32 idx = 0, end = theObjects.size(); idx < end; ++idx) {
+                if (!IsRetainedRenderableClean(*theObjects[idx]))
+                    return false;
+            }
+        }
+        return true;
+    }
+
     bool SLayerRenderPreparationData::PrepareForRender(const QSize &inViewportDimensions)
     {
         QT3DS_PERF_SCOPED_TIMER(m_Renderer.GetQt3DSContext().GetPerfTimer(),
@@ -1462,6 +1919,9 @@ namespace render {
                         requiresDepthPrepass = true;
 
                     if (theEffect->m_imageMaps && theEffect->m_imageMaps->size() > 0) {
+                        // The images below come from the renderable allocator as well, which
+                        // is only reset when the renderables are rebuilt.
+                        m_RetainedRenderablesValid = false;
                         SRenderableImage *firstImage = nullptr;
                         SRenderableImage *nextImage = nullptr;
                         SShaderDefaultMaterialKey key;
@@ -1551,7 +2011,14 @@ namespace render {
                     reverse(m_CamerasAndLights.begin(), m_CamerasAndLights.end());
                     reverse(m_RenderableNodes.begin(), m_RenderableNodes.end());
                     m_LightToNodeMap.clear();
+                    m_RetainedRenderablesValid = false;
+                    FlattenLayerTransforms(m_Layer, m_TransformNodes, m_TransformLevelOffsets);
+                    m_CullResultsValid = false;
+                    m_CullBoundsValid = false;
                 }
+                // Cameras, lights and renderables below all see up to date global variables.
+                if (UpdateLayerTransforms())
+                    wasDataDirty = true;
                 m_Camera = NULL;
                 m_Lights.clear();
                 m_OpaqueObjects.clear();
@@ -1714,8 +2181,28 @@ namespace render {
                     m_LightDirections.push_back(m_Lights[lightIdx]->GetScalingCorrectDirection());
                 }
 
-                m_ModelContexts.clear();
-                if (GetOffscreenRenderer() == false) {
+                // Antialiasing offsets the model view projections of the model contexts in
+                // place, so those have to be rebuilt every frame.
+                bool canRetainRenderables =
+                    maxNumAAPasses == 0 && !m_Layer.m_TemporalAAEnabled;
+                if (GetOffscreenRenderer() == false && canRetainRenderables && !wasDirty
+                    && !wasDataDirty && theLightNodeMarkers.empty()
+                    && CanReuseRetainedRenderables()) {
+                    m_OpaqueObjects.assign(m_RetainedOpaqueObjects.begin(),
+                                           m_RetainedOpaqueObjects.end());
+                    m_TransparentObjects.assign(m_RetainedTransparentObjects.begin(),
+                                                m_RetainedTransparentObjects.end());
+                    m_GroupObjects.assign(m_RetainedGroupObjects.begin(),
+                                          m_RetainedGroupObjects.end());
+                    for (QT3DSU32 idx = 0, end = (QT3DSU32)m_RetainedFeatures.size(); idx < end;
+                         ++idx) {
+                        SetShaderFeature(m_RetainedFeatures[idx].m_Name,
+                                         m_RetainedFeatures[idx].m_Enabled);
+                    }
+                } else if (GetOffscreenRenderer() == false) {
+                    m_RetainedRenderablesValid = false;
+                    m_ModelContexts.clear();
+                    m_RenderableAllocator.reset();
                     bool renderablesDirty =
                         PrepareRenderablesForRender(m_ViewProjection,
                                                     m_ClippingFrustum,
@@ -1723,7 +2210,24 @@ namespace render {
                     wasDataDirty = wasDataDirty || renderablesDirty;
                     if (thePrepResult.m_Flags.RequiresStencilBuffer())
                         thePrepResult.m_Flags.SetShouldRenderToTexture(true);
+                    // Only renderables built from clean state are kept, anything dirty may
+                    // still settle over the next frames.
+                    if (canRetainRenderables && m_RenderablesRetainable && !wasDirty
+                        && !wasDataDirty) {
+                        m_RetainedOpaqueObjects.assign(m_OpaqueObjects.begin(),
+                                                       m_OpaqueObjects.end());
+                        m_RetainedTransparentObjects.assign(m_TransparentObjects.begin(),
+                                                            m_TransparentObjects.end());
+                        m_RetainedGroupObjects.assign(m_GroupObjects.begin(),
+                                                      m_GroupObjects.end());
+                        m_RetainedFeatures = m_Features;
+                        m_RetainedViewProjection = m_ViewProjection;
+                        m_RetainedWireframeMode =
+                            m_Renderer.GetQt3DSContext().GetWireframeMode();
+                        m_RetainedRenderablesValid = true;
+                    }
                 } else {
+                    m_ModelContexts.clear();
                     NVRenderRect theViewport =
                         thePrepResult.GetLayerToPresentationViewport().ToIntegerRect();
                     bool theScissor = true;
@@ -1779,6 +2283,7 @@ namespace render {
         m_TransparentObjects.clear_unsafe();
         m_OpaqueObjects.clear_unsafe();
         m_GroupObjects.clear_unsafe();
+        m_PickBvh.Invalidate();
         m_LayerPrepResult.setEmpty();
         // The check for if the camera is or is not null is used
         // to figure out if this layer was rendered at all.
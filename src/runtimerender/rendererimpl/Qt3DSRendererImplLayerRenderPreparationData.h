@@ -41,7 +41,8 @@
 #include "Qt3DSRenderProfiler.h"
 #include "Qt3DSRenderShadowMap.h"
 #include "foundation/Qt3DSPool.h"
-#include "Qt3DSRenderableObjects.h"
+#include "Qt3DSRendererImplRenderableSort.h"
+#include "Qt3DSRendererImplPickBvh.h"
 
 namespace qt3ds {
 namespace render {
@@ -192,6 +193,22 @@ namespace render {
         }
     };
 
+    // Per frame results of the parallel pass over the renderable nodes of a layer.
+    struct SSubsetCullResult
+    {
+        NVBounds3 m_WorldBounds;
+        QT3DSVec3 m_WorldCenter;
+        bool m_Culled;
+    };
+
+    // World space bounds of a model and the global transform they were computed with, so they
+    // are only recomputed for the models that moved.
+    struct SRenderableNodeBounds
+    {
+        QT3DSMat44 m_GlobalTransform;
+        NVBounds3 m_WorldBounds;
+    };
+
     struct SScopedLightsListScope
     {
         nvvector<SLight *> &m_LightsList;
@@ -260,6 +277,12 @@ namespace render {
         // these are processed so they are available when the shaders for the models
         // are being generated.
         nvvector<SNode *> m_CamerasAndLights;
+        // Every node under the layer ordered breadth first so parents always come before their
+        // children. m_TransformLevelOffsets holds the start of each depth level plus the end of
+        // the list. Rebuilt together with the renderable nodes.
+        nvvector<SNode *> m_TransformNodes;
+        nvvector<QT3DSU32> m_TransformLevelOffsets;
+        nvvector<SNode *> m_DirtyTransformNodes;
 
         // Results of prepare for render.
         SCamera *m_Camera;
@@ -276,6 +299,11 @@ namespace render {
         // it is simplest to duplicate the lists.
         TRenderableObjectList m_RenderedOpaqueObjects;
         TRenderableObjectList m_RenderedTransparentObjects;
+        // Sort keys and the resulting order of the two lists above, reused as long as
+        // nothing moves.
+        SRenderableSortCache m_OpaqueSortCache;
+        SRenderableSortCache m_TransparentSortCache;
+        TRenderableObjectList m_SortScratchObjects;
         QT3DSMat44 m_ViewProjection;
         Option<SClippingFrustum> m_ClippingFrustum;
         Option<SLayerRenderPreparationResult> m_LayerPrepResult;
@@ -293,6 +321,44 @@ namespace render {
         nvvector<QT3DSVec3> m_SourceLightDirections;
         nvvector<QT3DSVec3> m_LightDirections;
         TModelContextPtrList m_ModelContexts;
+        // Filled by PrepareRenderableNodes, indexed like m_RenderableNodes. The cull
+        // results of a model's subsets start at its cull offset.
+        nvvector<SRenderMesh *> m_RenderableNodeMeshes;
+        nvvector<QT3DSU32> m_RenderableNodeCullOffsets;
+        nvvector<SSubsetCullResult> m_SubsetCullResults;
+        // Cached world bounds of the renderable nodes and of the clusters of consecutive
+        // renderable nodes above them. The nodes are in depth first order so a cluster mostly
+        // holds one subtree, and a cluster outside of the frustum culls all of its models.
+        nvvector<SRenderableNodeBounds> m_RenderableNodeBounds;
+        nvvector<NVBounds3> m_RenderableClusterBounds;
+        // The cull results are kept while no transform, mesh or the view projection changes.
+        QT3DSMat44 m_CullViewProjection;
+        bool m_CullHadFrustum;
+        bool m_CullResultsValid;
+        // False when the node list or a mesh changed and every cached bound is recomputed.
+        bool m_CullBoundsValid;
+        // Pick acceleration over the renderables above, built by the first pick after they
+        // were prepared. m_PickRenderables maps the boxes of the tree back to renderables.
+        SPickBvh m_PickBvh;
+        TRenderableObjectList m_PickRenderables;
+        nvvector<QT3DSU32> m_PickHits;
+        bool m_TransformsChanged;
+        // The renderables, model contexts and renderable images live here instead of the per
+        // frame allocator, which is reset only when the renderables are rebuilt. That lets a
+        // frame where nothing changed hand out the lists below again.
+        SPerFrameAllocator m_RenderableAllocator;
+        TRenderableObjectList m_RetainedOpaqueObjects;
+        TRenderableObjectList m_RetainedTransparentObjects;
+        TRenderableObjectList m_RetainedGroupObjects;
+        eastl::vector<SShaderPreprocessorFeature> m_RetainedFeatures;
+        QT3DSMat44 m_RetainedViewProjection;
+        bool m_RetainedWireframeMode;
+        // Cleared while preparing anything that has to be looked at every frame: text, paths,
+        // custom and referenced materials, light probes and images without a plain texture.
+        bool m_RenderablesRetainable;
+        // Set after a clean rebuild of retainable renderables, cleared by anything that
+        // changes the lists behind PrepareForRender's back.
+        bool m_RetainedRenderablesValid;
         qt3ds::foundation::CRegisteredString m_LastFrameOffscreenRendererId;
         NVScopedRefCounted<IOffscreenRenderer> m_LastFrameOffscreenRenderer;
 
@@ -329,8 +395,9 @@ namespace render {
                                        SRenderableObjectFlags &inExistingFlags, QT3DSF32 inOpacity,
                                        bool alreadyDirty);
 
-        bool PrepareModelForRender(SModel &inModel, const QT3DSMat44 &inViewProjection,
-                                   const Option<SClippingFrustum> &inClipFrustum,
+        bool PrepareModelForRender(SModel &inModel, SRenderMesh &inMesh,
+                                   const SSubsetCullResult *inCullResults,
+                                   const QT3DSMat44 &inViewProjection,
                                    TNodeLightEntryList &inScopedLights,
                                    SOrderedGroupRenderable *group);
 
@@ -342,16 +409,31 @@ namespace render {
                                   const Option<SClippingFrustum> &inClipFrustum,
                                   SLayerRenderPreparationResultFlags &ioFlags,
                                   SOrderedGroupRenderable *group);
+        // Updates the global variables of the dirty nodes under the layer one depth level at a
+        // time, each level on the job system. Returns false without touching any matrix when
+        // nothing in the layer is dirty.
+        bool UpdateLayerTransforms();
+        // Loads the meshes of the renderable nodes and culls model subsets against the clip
+        // frustum on the job system, keeping the last results if nothing moved. Returns true if
+        // any node was dirty.
+        bool PrepareRenderableNodes(const Option<SClippingFrustum> &inClipFrustum);
         // Helper function used during PRepareForRender and PrepareAndRender
         bool PrepareRenderablesForRender(const QT3DSMat44 &inViewProjection,
                                          const Option<SClippingFrustum> &inClipFrustum,
                                          QT3DSF32 inTextScaleFactor,
                                          SLayerRenderPreparationResultFlags &ioFlags);
+        // True if the retained renderables can stand in for a rebuild: no material or image
+        // behind them is dirty and neither the view projection nor the wireframe mode moved.
+        // Transforms, cameras and lights are checked by the caller.
+        bool CanReuseRetainedRenderables();
 
         void calculateDynamicLayerSize(SLayerRenderPreparationResult &prepResult);
 
         // returns true if this object will render something different than it rendered the last
         // time.
+        // When no transform, camera, light, material or image changed since the last clean
+        // rebuild, the renderable lists of that rebuild are reused instead of preparing every
+        // renderable again.
         virtual bool PrepareForRender(const QSize &inViewportDimensions);
         bool CheckLightProbeDirty(SImage &inLightProbe);
         void AddRenderWidget(IRenderWidget &inWidget);
@@ -362,6 +444,10 @@ namespace render {
         // The graph object is not const because this traversal updates dirty state on the objects.
         eastl::pair<bool, SGraphObject *> ResolveReferenceMaterial(SGraphObject *inMaterial);
 
+        void SortRenderableObjects(TRenderableObjectList &ioObjects,
+                                   SRenderableSortCache &ioCache,
+                                   RenderableSortPasses::Enum inPass);
+
         QT3DSVec3 GetCameraDirection();
         // Per-frame cache of renderable objects post-sort.
         NVDataRef<SRenderableObject *> GetOpaqueRenderableObjects();
@@ -0,0 +1,226 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qt 3D Studio.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "Qt3DSRendererImplPickBvh.h"
+#include "EASTL/sort.h"
+#include <string.h>
+
+using namespace qt3ds::render;
+
+namespace {
+
+const QT3DSU32 PICK_BVH_LEAF_SIZE = 4;
+// Median splits keep the depth at log2 of the leaf count.
+const QT3DSU32 PICK_BVH_MAX_DEPTH = 64;
+// A refit tree whose boxes grew this much against the built one is rebuilt.
+const QT3DSF32 PICK_BVH_MAX_REFIT_COST = 2.0f;
+
+struct SCenterLessThan
+{
+    const QT3DSVec3 *m_Centers;
+    QT3DSU32 m_Axis;
+
+    bool operator()(QT3DSU32 lhs, QT3DSU32 rhs) const
+    {
+        return m_Centers[lhs][m_Axis] < m_Centers[rhs][m_Axis];
+    }
+};
+
+QT3DSF32 GetSurfaceArea(const NVBounds3 &inBounds)
+{
+    if (inBounds.isEmpty())
+        return 0.0f;
+    QT3DSVec3 theDimensions(inBounds.getDimensions());
+    return theDimensions.x * theDimensions.y + theDimensions.y * theDimensions.z
+        + theDimensions.z * theDimensions.x;
+}
+
+// Slab test in world space. A box in world space encloses the transformed local box, so
+// everything SRay::IntersectWithAABB hits passes this test as well.
+bool IntersectRayWithBounds(const SRay &inRay, const NVBounds3 &inBounds)
+{
+    static const QT3DSF32 kEpsilon = 1e-5f;
+    if (inBounds.isEmpty())
+        return false;
+    QT3DSF32 theMinWinner = -QT3DS_MAX_F32;
+    QT3DSF32 theMaxWinner = QT3DS_MAX_F32;
+    for (QT3DSU32 theAxis = 0; theAxis < 3; ++theAxis) {
+        QT3DSF32 theMinBox = inBounds.minimum[theAxis];
+        QT3DSF32 theMaxBox = inBounds.maximum[theAxis];
+        QT3DSF32 theDirectionAxis = inRay.m_Direction[theAxis];
+        QT3DSF32 theOriginAxis = inRay.m_Origin[theAxis];
+        if (theDirectionAxis > kEpsilon) {
+            theMinWinner = NVMax(theMinWinner, (theMinBox - theOriginAxis) / theDirectionAxis);
+            theMaxWinner = NVMin(theMaxWinner, (theMaxBox - theOriginAxis) / theDirectionAxis);
+        } else if (theDirectionAxis < -kEpsilon) {
+            theMinWinner = NVMax(theMinWinner, (theMaxBox - theOriginAxis) / theDirectionAxis);
+            theMaxWinner = NVMin(theMaxWinner, (theMinBox - theOriginAxis) / theDirectionAxis);
+        } else if (theOriginAxis < theMinBox || theOriginAxis > theMaxBox) {
+            return false;
+        }
+        if (theMinWinner > theMaxWinner || theMaxWinner < 0)
+            return false;
+    }
+    return true;
+}
+}
+
+SPickBvh::SPickBvh(NVAllocatorCallback &inAllocator)
+    : m_Bounds(inAllocator, "SPickBvh::m_Bounds")
+    , m_Keys(inAllocator, "SPickBvh::m_Keys")
+    , m_LastKeys(inAllocator, "SPickBvh::m_LastKeys")
+    , m_Order(inAllocator, "SPickBvh::m_Order")
+    , m_Centers(inAllocator, "SPickBvh::m_Centers")
+    , m_Nodes(inAllocator, "SPickBvh::m_Nodes")
+    , m_BuildCost(0.0f)
+    , m_Valid(false)
+{
+}
+
+bool SPickBvh::Update()
+{
+    QT3DSU32 theCount = m_Bounds.size();
+    QT3DS_ASSERT(m_Keys.size() == theCount);
+    m_Valid = true;
+    if (theCount == m_LastKeys.size() && m_Order.size() == theCount
+        && (theCount == 0
+            || memcmp(m_Keys.data(), m_LastKeys.data(), theCount * sizeof(const void *)) == 0)) {
+        Refit();
+        if (GetCost() <= m_BuildCost * PICK_BVH_MAX_REFIT_COST)
+            return true;
+    }
+    m_LastKeys.assign(m_Keys.begin(), m_Keys.end());
+    Build();
+    return false;
+}
+
+void SPickBvh::Build()
+{
+    QT3DSU32 theCount = m_Bounds.size();
+    m_Order.resize(theCount);
+    m_Centers.resize(theCount);
+    for (QT3DSU32 idx = 0; idx < theCount; ++idx) {
+        m_Order[idx] = idx;
+        m_Centers[idx] = m_Bounds[idx].isEmpty() ? QT3DSVec3(0.0f) : m_Bounds[idx].getCenter();
+    }
+    m_Nodes.clear();
+    if (theCount) {
+        m_Nodes.reserve(2 * (theCount / PICK_BVH_LEAF_SIZE + 1));
+        m_Nodes.push_back(SPickBvhNode());
+        BuildNode(0, 0, theCount);
+    }
+    m_BuildCost = GetCost();
+}
+
+void SPickBvh::BuildNode(QT3DSU32 inNode, QT3DSU32 inFirst, QT3DSU32 inCount)
+{
+    NVBounds3 theBounds(NVBounds3::empty());
+    NVBounds3 theCenterBounds(NVBounds3::empty());
+    for (QT3DSU32 idx = inFirst, end = inFirst + inCount; idx < end; ++idx) {
+        theBounds.include(m_Bounds[m_Order[idx]]);
+        theCenterBounds.include(m_Centers[m_Order[idx]]);
+    }
+    m_Nodes[inNode].m_Bounds = theBounds;
+    if (inCount <= PICK_BVH_LEAF_SIZE) {
+        m_Nodes[inNode].m_First = inFirst;
+        m_Nodes[inNode].m_Count = inCount;
+        return;
+    }
+
+    // Median split along the longest axis of the box centers.
+    QT3DSVec3 theExtents(theCenterBounds.getDimensions());
+    QT3DSU32 theAxis = 0;
+    if (theExtents.y > theExtents[theAxis])
+        theAxis = 1;
+    if (theExtents.z > theExtents[theAxis])
+        theAxis = 2;
+    SCenterLessThan theLessThan = { m_Centers.data(), theAxis };
+    eastl::sort(m_Order.begin() + inFirst, m_Order.begin() + inFirst + inCount, theLessThan);
+
+    QT3DSU32 theLeft = m_Nodes.size();
+    m_Nodes.resize(theLeft + 2);
+    m_Nodes[inNode].m_First = theLeft;
+    m_Nodes[inNode].m_Count = 0;
+    QT3DSU32 theHalf = inCount / 2;
+    BuildNode(theLeft, inFirst, theHalf);
+    BuildNode(theLeft + 1, inFirst + theHalf, inCount - theHalf);
+}
+
+void SPickBvh::Refit()
+{
+    // Children are always stored after their parent.
+    for (QT3DSU32 idx = m_Nodes.size(); idx > 0; --idx) {
+        SPickBvhNode &theNode(m_Nodes[idx - 1]);
+        if (theNode.m_Count) {
+            theNode.m_Bounds.setEmpty();
+            for (QT3DSU32 entry = theNode.m_First, end = theNode.m_First + theNode.m_Count;
+                 entry < end; ++entry)
+                theNode.m_Bounds.include(m_Bounds[m_Order[entry]]);
+        } else {
+            theNode.m_Bounds = m_Nodes[theNode.m_First].m_Bounds;
+            theNode.m_Bounds.include(m_Nodes[theNode.m_First + 1].m_Bounds);
+        }
+    }
+}
+
+QT3DSF32 SPickBvh::GetCost() const
+{
+    QT3DSF32 theCost = 0.0f;
+    for (QT3DSU32 idx = 0, end = m_Nodes.size(); idx < end; ++idx)
+        theCost += GetSurfaceArea(m_Nodes[idx].m_Bounds);
+    return theCost;
+}
+
+void SPickBvh::Pick(const SRay &inRay, nvvector<QT3DSU32> &outHits) const
+{
+    if (m_Nodes.empty())
+        return;
+    QT3DSU32 theFirstHit = outHits.size();
+    QT3DSU32 theStack[PICK_BVH_MAX_DEPTH];
+    QT3DSU32 theStackSize = 0;
+    theStack[theStackSize++] = 0;
+    while (theStackSize) {
+        const SPickBvhNode &theNode(m_Nodes[theStack[--theStackSize]]);
+        if (!IntersectRayWithBounds(inRay, theNode.m_Bounds))
+            continue;
+        if (theNode.m_Count) {
+            for (QT3DSU32 entry = theNode.m_First, end = theNode.m_First + theNode.m_Count;
+                 entry < end; ++entry) {
+                QT3DSU32 theIndex = m_Order[entry];
+                if (theNode.m_Count == 1 || IntersectRayWithBounds(inRay, m_Bounds[theIndex]))
+                    outHits.push_back(theIndex);
+            }
+        } else {
+            QT3DS_ASSERT(theStackSize + 2 <= PICK_BVH_MAX_DEPTH);
+            theStack[theStackSize++] = theNode.m_First + 1;
+            theStack[theStackSize++] = theNode.m_First;
+        }
+    }
+    eastl::sort(outHits.begin() + theFirstHit, outHits.end());
+}
@@ -0,0 +1,87 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qt 3D Studio.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#pragma once
+#ifndef QT3DS_RENDERER_IMPL_PICK_BVH_H
+#define QT3DS_RENDERER_IMPL_PICK_BVH_H
+#include "Qt3DSRender.h"
+#include "foundation/Qt3DSContainers.h"
+#include "foundation/Qt3DSBounds3.h"
+#include "Qt3DSRenderRay.h"
+
+namespace qt3ds {
+namespace render {
+
+    struct SPickBvhNode
+    {
+        NVBounds3 m_Bounds;
+        // Leaves hold m_Count entries of the order starting at m_First. Inner nodes have a
+        // count of zero, m_First is their left child and the right child follows it.
+        QT3DSU32 m_First;
+        QT3DSU32 m_Count;
+    };
+
+    // Bounding volume hierarchy over the world bounds of the pickable renderables of a layer.
+    // The renderables are recreated every frame, so the boxes are refilled on the first pick
+    // after a frame. While the objects behind the boxes stay the same the existing tree is only
+    // refit to the new bounds; it is rebuilt when they change or the refit tree got too loose.
+    struct SPickBvh
+    {
+        // Filled by the caller before Update(). The keys identify the object behind each box.
+        nvvector<NVBounds3> m_Bounds;
+        nvvector<const void *> m_Keys;
+
+        nvvector<const void *> m_LastKeys;
+        nvvector<QT3DSU32> m_Order;
+        nvvector<QT3DSVec3> m_Centers;
+        nvvector<SPickBvhNode> m_Nodes;
+        QT3DSF32 m_BuildCost;
+        bool m_Valid;
+
+        SPickBvh(NVAllocatorCallback &inAllocator);
+
+        // Returns true if the tree of the previous update was refit instead of rebuilt.
+        bool Update();
+        void Invalidate() { m_Valid = false; }
+        bool IsValid() const { return m_Valid; }
+
+        // Appends the indices of the boxes hit by the ray to outHits in ascending order. The
+        // test is against the world bounds only, the caller does the exact test on the hits.
+        void Pick(const SRay &inRay, nvvector<QT3DSU32> &outHits) const;
+
+    private:
+        void Build();
+        void BuildNode(QT3DSU32 inNode, QT3DSU32 inFirst, QT3DSU32 inCount);
+        void Refit();
+        QT3DSF32 GetCost() const;
+    };
+}
+}
+
+#endif
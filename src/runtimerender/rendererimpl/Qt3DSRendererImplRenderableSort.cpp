@@ -0,0 +1,122 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qt 3D Studio.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "Qt3DSRendererImplRenderableSort.h"
+
+using namespace qt3ds::render;
+
+namespace {
+
+const QT3DSU32 INSERTION_SORT_LIMIT = 64;
+
+void InsertionSortEntries(SRenderableSortEntry *ioEntries, QT3DSU32 inCount)
+{
+    for (QT3DSU32 idx = 1; idx < inCount; ++idx) {
+        SRenderableSortEntry theEntry = ioEntries[idx];
+        QT3DSU32 insertIdx = idx;
+        for (; insertIdx > 0 && ioEntries[insertIdx - 1].m_Key > theEntry.m_Key; --insertIdx)
+            ioEntries[insertIdx] = ioEntries[insertIdx - 1];
+        ioEntries[insertIdx] = theEntry;
+    }
+}
+}
+
+void qt3ds::render::RadixSortRenderableEntries(SRenderableSortEntry *ioEntries,
+                                               SRenderableSortEntry *ioScratch, QT3DSU32 inCount)
+{
+    if (inCount <= INSERTION_SORT_LIMIT) {
+        InsertionSortEntries(ioEntries, inCount);
+        return;
+    }
+
+    QT3DSU32 theHistograms[8][256];
+    memset(theHistograms, 0, sizeof(theHistograms));
+    for (QT3DSU32 idx = 0; idx < inCount; ++idx) {
+        QT3DSU64 theKey = ioEntries[idx].m_Key;
+        for (QT3DSU32 digit = 0; digit < 8; ++digit)
+            ++theHistograms[digit][(theKey >> (digit * 8)) & 0xff];
+    }
+
+    SRenderableSortEntry *theSource = ioEntries;
+    SRenderableSortEntry *theDest = ioScratch;
+    for (QT3DSU32 digit = 0; digit < 8; ++digit) {
+        QT3DSU32 *theCounts = theHistograms[digit];
+        // A digit every key shares does not change the order.
+        if (theCounts[(theSource[0].m_Key >> (digit * 8)) & 0xff] == inCount)
+            continue;
+        QT3DSU32 theOffset = 0;
+        for (QT3DSU32 bucket = 0; bucket < 256; ++bucket) {
+            QT3DSU32 theCount = theCounts[bucket];
+            theCounts[bucket] = theOffset;
+            theOffset += theCount;
+        }
+        for (QT3DSU32 idx = 0; idx < inCount; ++idx) {
+            const SRenderableSortEntry &theEntry = theSource[idx];
+            theDest[theCounts[(theEntry.m_Key >> (digit * 8)) & 0xff]++] = theEntry;
+        }
+        SRenderableSortEntry *theSwap = theSource;
+        theSource = theDest;
+        theDest = theSwap;
+    }
+    if (theSource != ioEntries)
+        memcpy(ioEntries, theSource, inCount * sizeof(SRenderableSortEntry));
+}
+
+SRenderableSortCache::SRenderableSortCache(NVAllocatorCallback &inAllocator)
+    : m_Keys(inAllocator, "SRenderableSortCache::m_Keys")
+    , m_Order(inAllocator, "SRenderableSortCache::m_Order")
+    , m_LastKeys(inAllocator, "SRenderableSortCache::m_LastKeys")
+    , m_Entries(inAllocator, "SRenderableSortCache::m_Entries")
+    , m_Scratch(inAllocator, "SRenderableSortCache::m_Scratch")
+{
+}
+
+bool SRenderableSortCache::Sort()
+{
+    QT3DSU32 theCount = m_Keys.size();
+    if (theCount == m_LastKeys.size() && m_Order.size() == theCount
+        && (theCount == 0
+            || memcmp(m_Keys.data(), m_LastKeys.data(), theCount * sizeof(QT3DSU64)) == 0)) {
+        return true;
+    }
+
+    m_LastKeys.assign(m_Keys.begin(), m_Keys.end());
+    m_Entries.resize(theCount);
+    m_Scratch.resize(theCount);
+    for (QT3DSU32 idx = 0; idx < theCount; ++idx) {
+        m_Entries[idx].m_Key = m_Keys[idx];
+        m_Entries[idx].m_Index = idx;
+        m_Entries[idx].m_Padding = 0;
+    }
+    RadixSortRenderableEntries(m_Entries.data(), m_Scratch.data(), theCount);
+    m_Order.resize(theCount);
+    for (QT3DSU32 idx = 0; idx < theCount; ++idx)
+        m_Order[idx] = m_Entries[idx].m_Index;
+    return false;
+}
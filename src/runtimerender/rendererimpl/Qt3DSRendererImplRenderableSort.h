@@ -0,0 +1,124 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qt 3D Studio.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#pragma once
+#ifndef QT3DS_RENDERER_IMPL_RENDERABLE_SORT_H
+#define QT3DS_RENDERER_IMPL_RENDERABLE_SORT_H
+#include "Qt3DSRender.h"
+#include "foundation/Qt3DSContainers.h"
+#include <string.h>
+
+namespace qt3ds {
+namespace render {
+
+    struct RenderableSortPasses
+    {
+        enum Enum {
+            Opaque = 0,
+            Transparent = 1,
+        };
+    };
+
+    // Renderables are sorted on a packed 64 bit key. The lists are per layer so the
+    // layer itself needs no bits. Opaque keys are
+    //  63..60 pass
+    //  59..36 camera distance, nearest first
+    //  35..20 shader key
+    //  19..4  material
+    // The distance is quantized to 24 bits of its ordered float representation, which
+    // keeps about 15 bits of relative precision. Opaque renderables at the same distance
+    // are grouped by shader and material, anything still equal keeps its list order.
+    // Transparent keys are
+    //  63..60 pass
+    //  59..28 camera distance, furthest first
+    // Blending depends on the draw order, so transparent renderables keep the full
+    // distance and renderables at the same distance keep their list order.
+    inline QT3DSU32 GetOrderedFloatBits(QT3DSF32 inValue)
+    {
+        QT3DSU32 theBits;
+        memcpy(&theBits, &inValue, sizeof(theBits));
+        return (theBits & 0x80000000u) ? ~theBits : (theBits | 0x80000000u);
+    }
+
+    inline QT3DSU32 FoldSortId(size_t inValue)
+    {
+        QT3DSU64 theValue = QT3DSU64(inValue);
+        theValue ^= theValue >> 32;
+        theValue ^= theValue >> 16;
+        return QT3DSU32(theValue) & 0xffffu;
+    }
+
+    inline QT3DSU64 MakeOpaqueSortKey(QT3DSF32 inCameraDistance, QT3DSU32 inShaderId,
+                                      QT3DSU32 inMaterialId)
+    {
+        QT3DSU32 theDepth = GetOrderedFloatBits(inCameraDistance) >> 8;
+        return (QT3DSU64(RenderableSortPasses::Opaque) << 60) | (QT3DSU64(theDepth) << 36)
+            | (QT3DSU64(inShaderId & 0xffffu) << 20) | (QT3DSU64(inMaterialId & 0xffffu) << 4);
+    }
+
+    inline QT3DSU64 MakeTransparentSortKey(QT3DSF32 inCameraDistance)
+    {
+        QT3DSU32 theDepth = ~GetOrderedFloatBits(inCameraDistance);
+        return (QT3DSU64(RenderableSortPasses::Transparent) << 60) | (QT3DSU64(theDepth) << 28);
+    }
+
+    struct SRenderableSortEntry
+    {
+        QT3DSU64 m_Key;
+        QT3DSU32 m_Index;
+        QT3DSU32 m_Padding;
+    };
+
+    // Stable sort of the entries by key. ioScratch must hold inCount entries. Small
+    // counts use an insertion sort, larger ones an LSD radix sort over 8 bit digits that
+    // skips every digit all keys agree on.
+    void RadixSortRenderableEntries(SRenderableSortEntry *ioEntries,
+                                    SRenderableSortEntry *ioScratch, QT3DSU32 inCount);
+
+    // Sort state of one renderable list, kept across frames.
+    struct SRenderableSortCache
+    {
+        // Keys of the list in list order, filled by the caller before Sort().
+        nvvector<QT3DSU64> m_Keys;
+        // Result of Sort(): m_Order[i] is the list index of the i'th renderable to draw.
+        nvvector<QT3DSU32> m_Order;
+
+        nvvector<QT3DSU64> m_LastKeys;
+        nvvector<SRenderableSortEntry> m_Entries;
+        nvvector<SRenderableSortEntry> m_Scratch;
+
+        SRenderableSortCache(NVAllocatorCallback &inAllocator);
+
+        // Returns true if the keys matched the previous call and its order was reused.
+        bool Sort();
+    };
+}
+}
+
+#endif
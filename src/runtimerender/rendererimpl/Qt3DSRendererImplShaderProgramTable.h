@@ -0,0 +1,189 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qt 3D Studio.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#pragma once
+#ifndef QT3DS_RENDERER_IMPL_SHADER_PROGRAM_TABLE_H
+#define QT3DS_RENDERER_IMPL_SHADER_PROGRAM_TABLE_H
+#include "Qt3DSRender.h"
+#include "foundation/Qt3DSContainers.h"
+#include "Qt3DSRenderShaderKeys.h"
+
+namespace qt3ds {
+namespace render {
+
+    struct ShaderProgramPasses
+    {
+        enum Enum {
+            Main = 0,
+            Depth,
+            Instanced,
+            ShadowMap,
+            ShadowCube,
+        };
+    };
+
+    // Binary identity of a generated default material program. The material key already carries
+    // the hash of the feature set, the pass tells the variants of one material apart. The hash
+    // is computed once so that probing only compares it before comparing the key words.
+    struct SShaderProgramKey
+    {
+        SShaderDefaultMaterialKey m_MaterialKey;
+        QT3DSU32 m_Pass;
+        QT3DSU32 m_Hash;
+
+        SShaderProgramKey()
+            : m_Pass(0)
+            , m_Hash(0)
+        {
+        }
+
+        SShaderProgramKey(const SShaderDefaultMaterialKey &inMaterialKey,
+                          ShaderProgramPasses::Enum inPass)
+            : m_MaterialKey(inMaterialKey)
+            , m_Pass((QT3DSU32)inPass)
+        {
+            // FNV-1a over the key words with a final avalanche, the key words are sparse bit
+            // fields so xoring them together like SShaderDefaultMaterialKey::hash does collides
+            // a lot.
+            QT3DSU32 theHash = 2166136261u;
+            for (QT3DSU32 idx = 0; idx < SShaderDefaultMaterialKey::DataBufferSize; ++idx)
+                theHash = (theHash ^ m_MaterialKey.m_DataBuffer[idx]) * 16777619u;
+            const QT3DSU64 theFeatureHash = (QT3DSU64)m_MaterialKey.m_FeatureSetHash;
+            theHash = (theHash ^ (QT3DSU32)theFeatureHash) * 16777619u;
+            theHash = (theHash ^ (QT3DSU32)(theFeatureHash >> 32)) * 16777619u;
+            theHash = (theHash ^ m_Pass) * 16777619u;
+            theHash ^= theHash >> 16;
+            theHash *= 0x85ebca6bu;
+            theHash ^= theHash >> 13;
+            theHash *= 0xc2b2ae35u;
+            theHash ^= theHash >> 16;
+            m_Hash = theHash;
+        }
+
+        bool operator==(const SShaderProgramKey &other) const
+        {
+            return m_Hash == other.m_Hash && m_Pass == other.m_Pass
+                    && m_MaterialKey == other.m_MaterialKey;
+        }
+    };
+
+    // Open addressing table from program keys to generated shaders. Lookups probe linearly
+    // through one contiguous array and neither allocate nor build strings, so they are cheap
+    // enough to run for every renderable every frame. Null values are valid; they remember
+    // programs that failed to generate.
+    template <typename TValue>
+    struct SShaderProgramTable
+    {
+        struct SSlot
+        {
+            SShaderProgramKey m_Key;
+            TValue *m_Value;
+            bool m_Occupied;
+            SSlot()
+                : m_Value(NULL)
+                , m_Occupied(false)
+            {
+            }
+        };
+
+        nvvector<SSlot> m_Slots;
+        QT3DSU32 m_Count;
+
+        SShaderProgramTable(NVAllocatorCallback &inAllocator, const char *inName)
+            : m_Slots(inAllocator, inName)
+            , m_Count(0)
+        {
+        }
+
+        QT3DSU32 size() const { return m_Count; }
+
+        // Returns the address of the value stored for the key, or NULL if there is none.
+        TValue **Find(const SShaderProgramKey &inKey)
+        {
+            if (m_Count == 0)
+                return NULL;
+            const QT3DSU32 theMask = (QT3DSU32)m_Slots.size() - 1;
+            for (QT3DSU32 idx = inKey.m_Hash & theMask;; idx = (idx + 1) & theMask) {
+                SSlot &theSlot(m_Slots[idx]);
+                if (!theSlot.m_Occupied)
+                    return NULL;
+                if (theSlot.m_Key == inKey)
+                    return &theSlot.m_Value;
+            }
+        }
+
+        // The key must not be in the table yet.
+        void Insert(const SShaderProgramKey &inKey, TValue *inValue)
+        {
+            // Keep the load factor at or below one half so probe sequences stay short.
+            if ((m_Count + 1) * 2 > (QT3DSU32)m_Slots.size())
+                Grow();
+            InsertSlot(inKey, inValue);
+            ++m_Count;
+        }
+
+        // Deletes the values with the allocator they were created with and empties the table.
+        void Release(NVAllocatorCallback &inAllocator)
+        {
+            for (QT3DSU32 idx = 0, end = (QT3DSU32)m_Slots.size(); idx < end; ++idx) {
+                if (m_Slots[idx].m_Occupied && m_Slots[idx].m_Value)
+                    NVDelete(inAllocator, m_Slots[idx].m_Value);
+            }
+            m_Slots.clear();
+            m_Count = 0;
+        }
+
+    private:
+        void InsertSlot(const SShaderProgramKey &inKey, TValue *inValue)
+        {
+            const QT3DSU32 theMask = (QT3DSU32)m_Slots.size() - 1;
+            QT3DSU32 idx = inKey.m_Hash & theMask;
+            while (m_Slots[idx].m_Occupied)
+                idx = (idx + 1) & theMask;
+            m_Slots[idx].m_Key = inKey;
+            m_Slots[idx].m_Value = inValue;
+            m_Slots[idx].m_Occupied = true;
+        }
+
+        void Grow()
+        {
+            nvvector<SSlot> theOldSlots(m_Slots);
+            const QT3DSU32 theNewSize = theOldSlots.empty() ? 64 : (QT3DSU32)theOldSlots.size() * 2;
+            m_Slots.clear();
+            m_Slots.resize(theNewSize);
+            for (QT3DSU32 idx = 0, end = (QT3DSU32)theOldSlots.size(); idx < end; ++idx) {
+                if (theOldSlots[idx].m_Occupied)
+                    InsertSlot(theOldSlots[idx].m_Key, theOldSlots[idx].m_Value);
+            }
+        }
+    };
+}
+}
+
+#endif
@@ -183,9 +183,11 @@ namespace render {
         Qt3DSRendererImpl &m_Renderer;
         SSubsetRenderable &m_Renderable;
         TessModeValues::Enum m_TessMode;
+        // Per instance matrices come from the cbInstances block instead of uniforms
+        bool m_Instanced;
 
         SSubsetMaterialVertexPipeline(Qt3DSRendererImpl &renderer, SSubsetRenderable &renderable,
-                                      bool inWireframeRequested)
+                                      bool inWireframeRequested, bool inInstanced = false)
             : SVertexPipelineImpl(renderer.GetQt3DSContext().GetAllocator(),
                                   renderer.GetQt3DSContext().GetDefaultMaterialShaderGenerator(),
                                   renderer.GetQt3DSContext().GetShaderProgramGenerator(),
@@ -193,6 +195,7 @@ namespace render {
             , m_Renderer(renderer)
             , m_Renderable(renderable)
             , m_TessMode(TessModeValues::NoTess)
+            , m_Instanced(inInstanced)
         {
             if (m_Renderer.GetContext().IsTessellationSupported()) {
                 m_TessMode = renderable.m_TessellationMode;
@@ -388,6 +391,22 @@ namespace render {
             vertexShader << "\tvec3 uTransform;" << Endl;
             vertexShader << "\tvec3 vTransform;" << Endl;
 
+            if (m_Instanced) {
+                // Three matrices per instance. The locals hide the uniforms of the same name so
+                // the rest of the pipeline does not need to know about instancing.
+                vertexShader.AddConstantBuffer("cbInstances", "layout(std140)");
+                vertexShader.AddConstantBufferParam(
+                    QStringLiteral("cbInstances"),
+                    QStringLiteral("instance_matrices[%1]").arg(QT3DS_MAX_NUM_INSTANCES * 3),
+                    "mat4");
+                vertexShader << "\tmat4 model_view_projection = "
+                                "instance_matrices[gl_InstanceID * 3];" << Endl;
+                vertexShader << "\tmat4 model_matrix = instance_matrices[gl_InstanceID * 3 + 1];"
+                             << Endl;
+                vertexShader << "\tmat3 normal_matrix = "
+                                "mat3(instance_matrices[gl_InstanceID * 3 + 2]);" << Endl;
+            }
+
             if (displacementImage) {
                 GenerateUVCoords();
                 MaterialGenerator().GenerateImageUVCoordinates(*this, displacementImageIdx, 0,
@@ -553,34 +572,55 @@ namespace render {
         IShaderStageGenerator &ActiveStage() override { return Vertex(); }
     };
 
+    CRegisteredString Qt3DSRendererImpl::GetShaderCacheName(const SShaderDefaultMaterialKey &inKey,
+                                                            ShaderProgramPasses::Enum inPass)
+    {
+        // Lookups go through the binary program keys, this string is only built when a program
+        // has to be fetched from the shader cache or generated. It names the program in the log
+        // and in exported shader caches.
+        m_GeneratedShaderString.assign("mesh subset pipeline-- ");
+        SShaderDefaultMaterialKeyProperties::KeyMode theMode =
+                SShaderDefaultMaterialKeyProperties::DepthKey;
+        switch (inPass) {
+        case ShaderProgramPasses::Main:
+            theMode = SShaderDefaultMaterialKeyProperties::DefaultKey;
+            break;
+        case ShaderProgramPasses::Instanced:
+            m_GeneratedShaderString.append("instanced--");
+            theMode = SShaderDefaultMaterialKeyProperties::DefaultKey;
+            break;
+        case ShaderProgramPasses::Depth:
+            m_GeneratedShaderString.append("depth--");
+            break;
+        case ShaderProgramPasses::ShadowMap:
+            m_GeneratedShaderString.append("shadowmap--");
+            break;
+        case ShaderProgramPasses::ShadowCube:
+            m_GeneratedShaderString.append("shadowcube--");
+            break;
+        }
+        inKey.ToString(m_GeneratedShaderString, m_DefaultMaterialShaderKeyProperties, theMode);
+        return m_qt3dsContext.GetStringTable().RegisterStr(m_GeneratedShaderString.c_str());
+    }
+
     NVRenderShaderProgram *Qt3DSRendererImpl::GenerateShader(SSubsetRenderable &inRenderable,
                                                              TShaderFeatureSet inFeatureSet,
-                                                             bool depth)
+                                                             bool depth, bool instanced)
     {
-        // build a string that allows us to print out the shader we are generating to the log.
-        // This is time consuming but I feel like it doesn't happen all that often and is very
-        // useful to users looking at the log file.
         QLatin1String logPrefix("mesh subset pipeline-- ");
-
-        m_GeneratedShaderString.clear();
-        m_GeneratedShaderString.assign(logPrefix.data());
-        if (depth)
-            m_GeneratedShaderString.append("depth--");
-
         SShaderDefaultMaterialKey theKey(inRenderable.m_ShaderDescription);
-        theKey.ToString(m_GeneratedShaderString, m_DefaultMaterialShaderKeyProperties,
-                        depth ? SShaderDefaultMaterialKeyProperties::DepthKey
-                              : SShaderDefaultMaterialKeyProperties::DefaultKey);
+        CRegisteredString theCacheKey = GetShaderCacheName(
+                    theKey, depth ? ShaderProgramPasses::Depth
+                                  : instanced ? ShaderProgramPasses::Instanced
+                                              : ShaderProgramPasses::Main);
         IShaderCache &theCache = m_qt3dsContext.GetShaderCache();
-        CRegisteredString theCacheKey =
-            m_qt3dsContext.GetStringTable().RegisterStr(m_GeneratedShaderString.c_str());
         NVRenderShaderProgram *cachedProgram = theCache.GetProgram(theCacheKey, inFeatureSet);
         if (cachedProgram)
             return cachedProgram;
 
         SSubsetMaterialVertexPipeline pipeline(
             *this, inRenderable,
-            m_DefaultMaterialShaderKeyProperties.m_WireframeMode.GetValue(theKey));
+            m_DefaultMaterialShaderKeyProperties.m_WireframeMode.GetValue(theKey), instanced);
         if (depth) {
             return m_qt3dsContext.GetDefaultMaterialShaderGenerator().GenerateDepthPassShader(
                 inRenderable.m_Material, inRenderable.m_ShaderDescription, pipeline, inFeatureSet,
@@ -599,24 +639,12 @@ namespace render {
                                                                    TShaderFeatureSet inFeatureSet,
                                                                    RenderLightTypes::Enum lightType)
     {
-        // build a string that allows us to print out the shader we are generating to the log.
-        // This is time consuming but I feel like it doesn't happen all that often and is very
-        // useful to users looking at the log file.
         QLatin1String logPrefix("mesh subset pipeline-- ");
-
-        m_GeneratedShaderString.clear();
-        m_GeneratedShaderString.assign(logPrefix.data());
-        if (lightType == RenderLightTypes::Point)
-            m_GeneratedShaderString.append("shadowcube--");
-        else
-            m_GeneratedShaderString.append("shadowmap--");
-
         SShaderDefaultMaterialKey theKey(inRenderable.m_ShaderDescription);
-        theKey.ToString(m_GeneratedShaderString, m_DefaultMaterialShaderKeyProperties,
-                        SShaderDefaultMaterialKeyProperties::DepthKey);
+        CRegisteredString theCacheKey = GetShaderCacheName(
+                    theKey, lightType == RenderLightTypes::Point ? ShaderProgramPasses::ShadowCube
+                                                                 : ShaderProgramPasses::ShadowMap);
         IShaderCache &theCache = m_qt3dsContext.GetShaderCache();
-        CRegisteredString theCacheKey
-                = m_qt3dsContext.GetStringTable().RegisterStr(m_GeneratedShaderString.c_str());
         NVRenderShaderProgram *cachedProgram = theCache.GetProgram(theCacheKey, inFeatureSet);
         if (cachedProgram)
             return cachedProgram;
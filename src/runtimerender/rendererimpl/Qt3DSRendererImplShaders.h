@@ -72,18 +72,18 @@ namespace render {
     struct SShaderGeneratorGeneratedShader
     {
         QT3DSU32 m_LayerSetIndex;
-        CRegisteredString m_QueryString;
         NVRenderShaderProgram &m_Shader;
         NVRenderCachedShaderProperty<QT3DSMat44> m_ViewportMatrix;
         SShaderTessellationProperties m_Tessellation;
+        // Only valid for the instanced variant of a subset shader
+        NVRenderCachedShaderBuffer<qt3ds::render::NVRenderShaderConstantBuffer *> m_InstanceBlock;
 
-        SShaderGeneratorGeneratedShader(CRegisteredString inQueryString,
-                                        NVRenderShaderProgram &inShader)
+        SShaderGeneratorGeneratedShader(NVRenderShaderProgram &inShader)
             : m_LayerSetIndex(QT3DS_MAX_U32)
-            , m_QueryString(inQueryString)
             , m_Shader(inShader)
             , m_ViewportMatrix("viewport_matrix", inShader)
             , m_Tessellation(inShader)
+            , m_InstanceBlock("cbInstances", inShader)
         {
             m_Shader.addRef();
         }
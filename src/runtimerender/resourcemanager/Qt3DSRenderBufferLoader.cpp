@@ -37,6 +37,8 @@
 #include "Qt3DSRenderInputStreamFactory.h"
 #include "Qt3DSRenderThreadPool.h"
 
+#include <QtCore/qfile.h>
+
 using namespace qt3ds::render;
 
 namespace {
@@ -80,6 +82,50 @@ struct SBufferLoadResult : public ILoadedBuffer
         return new (allocMem) SBufferLoadResult(fnd, p, ud, dataBuffer);
     }
 };
+
+struct SMappedBufferResult : public ILoadedBuffer
+{
+    NVFoundationBase &m_Foundation;
+    CRegisteredString m_Path;
+    QFile m_File;
+    NVDataRef<QT3DSU8> m_Data;
+    QT3DSI32 mRefCount;
+
+    SMappedBufferResult(NVFoundationBase &fnd, CRegisteredString p)
+        : m_Foundation(fnd)
+        , m_Path(p)
+        , m_File(QString::fromUtf8(p.c_str()))
+        , mRefCount(0)
+    {
+    }
+    ~SMappedBufferResult()
+    {
+        if (m_Data.begin())
+            m_File.unmap(m_Data.begin());
+    }
+
+    QT3DS_IMPLEMENT_REF_COUNT_ADDREF_RELEASE_OVERRIDE(m_Foundation.getAllocator())
+
+    bool Map()
+    {
+        if (!m_File.open(QIODevice::ReadOnly) || m_File.size() <= 0
+            || m_File.size() > qint64(QT3DS_MAX_U32)) {
+            return false;
+        }
+        QT3DSU8 *theData = m_File.map(0, m_File.size(), QFileDevice::MapPrivateOption);
+        if (theData == NULL)
+            return false;
+        m_Data = toDataRef(theData, QT3DSU32(m_File.size()));
+        // The mapping stays valid after closing the file, unmap happens on destruction.
+        m_File.close();
+        return true;
+    }
+
+    CRegisteredString Path() override { return m_Path; }
+    NVDataRef<QT3DSU8> Data() override { return m_Data; }
+    IBufferLoaderCallback *UserData() override { return NULL; }
+};
+
 struct SLoadedBufferImpl
 {
     SBufferLoader &m_Loader;
@@ -324,3 +370,41 @@ IBufferLoader &IBufferLoader::Create(NVFoundationBase &fnd, IInputStreamFactory
 {
     return *QT3DS_NEW(fnd.getAllocator(), SBufferLoader)(fnd, inFactory, inThreadPool);
 }
+
+ILoadedBuffer *ILoadedBuffer::CreateMapped(NVFoundationBase &inFoundation,
+                                           CRegisteredString inPath)
+{
+    const char *thePath = inPath.c_str();
+    // Resources are read only; private mappings of them can't be written to.
+    if (thePath[0] == ':' || strncmp(thePath, "qrc:", 4) == 0)
+        return NULL;
+
+    SMappedBufferResult *theResult =
+        QT3DS_NEW(inFoundation.getAllocator(), SMappedBufferResult)(inFoundation, inPath);
+    if (!theResult->Map()) {
+        NVDelete(inFoundation.getAllocator(), theResult);
+        return NULL;
+    }
+    return theResult;
+}
+
+ILoadedBuffer *ILoadedBuffer::CreateRead(NVFoundationBase &inFoundation, CRegisteredString inPath)
+{
+    QFile theFile(QString::fromUtf8(inPath.c_str()));
+    if (!theFile.open(QIODevice::ReadOnly) || theFile.size() <= 0
+        || theFile.size() > qint64(QT3DS_MAX_U32)) {
+        return NULL;
+    }
+    SBufferLoadResult *theResult =
+        SBufferLoadResult::Allocate(QT3DSU32(theFile.size()), inFoundation, inPath,
+                                    NVScopedRefCounted<IBufferLoaderCallback>());
+    if (theResult == NULL)
+        return NULL;
+    NVDataRef<QT3DSU8> theData(theResult->Data());
+    if (theFile.read(reinterpret_cast<char *>(theData.begin()), theData.size())
+        != qint64(theData.size())) {
+        NVDelete(inFoundation.getAllocator(), theResult);
+        return NULL;
+    }
+    return theResult;
+}
@@ -40,13 +40,23 @@ namespace render {
 
     class IBufferLoaderCallback;
 
-    class ILoadedBuffer : public NVRefCounted
+    class QT3DS_AUTOTEST_EXPORT ILoadedBuffer : public NVRefCounted
     {
     public:
         virtual CRegisteredString Path() = 0;
         // Data is released when the buffer itself is released.
         virtual NVDataRef<QT3DSU8> Data() = 0;
         virtual IBufferLoaderCallback *UserData() = 0;
+
+        // Maps the file into memory instead of reading it. The mapping is private, so writes
+        // to Data() (e.g. pointer fixups) are copied on write and only visible to this
+        // process, while untouched pages are shared with other processes mapping the same file.
+        // Returns null if the file cannot be mapped; resource files are never mapped.
+        static ILoadedBuffer *CreateMapped(NVFoundationBase &inFoundation,
+                                           CRegisteredString inPath);
+        // Reads the whole file into a heap buffer, also works for resource files.
+        // Returns null if the file cannot be read.
+        static ILoadedBuffer *CreateRead(NVFoundationBase &inFoundation, CRegisteredString inPath);
     };
 
     class IBufferLoaderCallback : public NVRefCounted
@@ -50,7 +50,9 @@
 #include "foundation/Qt3DSPerfTimer.h"
 #include "foundation/Qt3DSMutex.h"
 #include "Qt3DSRenderPrefilterTexture.h"
+#include "Qt3DSRenderJobSystem.h"
 #include <QtCore/qdir.h>
+#include <QtCore/qfile.h>
 
 using namespace qt3ds::render;
 
@@ -95,6 +97,74 @@ struct SPrimitiveEntry
     CRegisteredString m_FileName;
 };
 
+// Parses one mesh file on the job system.  Mappable meshes are used straight out of the mapped
+// file, which stays open until the mesh has been uploaded.
+struct SMeshLoadJob
+{
+    NVAllocatorCallback &m_Allocator;
+    IInputStreamFactory &m_InputStreamFactory;
+    QString m_Path;
+    QT3DSU32 m_Id;
+    SJobGroup m_Group;
+    QFile m_File;
+    bool m_Mapped;
+    // Set once TryLoadMesh has returned null for this mesh, i.e. a frame is missing it
+    bool m_Requested;
+    qt3dsimp::SMultiLoadResult m_Result;
+
+    SMeshLoadJob(NVAllocatorCallback &inAllocator, IInputStreamFactory &inFactory,
+                 const QString &inPath, QT3DSU32 inId)
+        : m_Allocator(inAllocator)
+        , m_InputStreamFactory(inFactory)
+        , m_Path(inPath)
+        , m_Id(inId)
+        , m_Mapped(false)
+        , m_Requested(false)
+    {
+    }
+    ~SMeshLoadJob()
+    {
+        if (m_Result.m_Mesh && !m_Mapped)
+            m_Allocator.deallocate(m_Result.m_Mesh);
+    }
+
+    void LoadMapped()
+    {
+        QString theFilePath;
+        if (!m_InputStreamFactory.GetPathForFile(m_Path, theFilePath, true))
+            return;
+        m_File.setFileName(theFilePath);
+        if (!m_File.open(QIODevice::ReadOnly))
+            return;
+        qint64 theSize = m_File.size();
+        uchar *theData = theSize > 0 && theSize <= QT3DS_MAX_U32 ? m_File.map(0, theSize) : nullptr;
+        if (theData) {
+            m_Result = qt3dsimp::Mesh::LoadMultiMapped(
+                        NVConstDataRef<QT3DSU8>(theData, QT3DSU32(theSize)), m_Id);
+            if (m_Result.m_Mesh) {
+                m_Mapped = true;
+                return;
+            }
+            m_File.unmap(theData);
+        }
+        m_File.close();
+    }
+
+    static void Load(void *inUserData)
+    {
+        SMeshLoadJob &theJob(*reinterpret_cast<SMeshLoadJob *>(inUserData));
+        theJob.LoadMapped();
+        if (theJob.m_Mapped)
+            return;
+        NVScopedRefCounted<IRefCountedInputStream> theStream(
+            theJob.m_InputStreamFactory.GetStreamForFile(theJob.m_Path, true));
+        if (theStream) {
+            theJob.m_Result =
+                qt3dsimp::Mesh::LoadMulti(theJob.m_Allocator, *theStream, theJob.m_Id);
+        }
+    }
+};
+
 struct SBufferManager : public IBufferManager
 {
     typedef eastl::hash_set<CRegisteredString, eastl::hash<CRegisteredString>,
@@ -103,11 +173,13 @@ struct SBufferManager : public IBufferManager
     typedef nvhash_map<CRegisteredString, SImageEntry> TImageMap;
     typedef nvhash_map<CRegisteredString, SRenderMesh *> TMeshMap;
     typedef nvhash_map<CRegisteredString, CRegisteredString> TAliasImageMap;
+    typedef nvhash_map<CRegisteredString, SMeshLoadJob *> TMeshLoadJobMap;
 
     NVScopedRefCounted<NVRenderContext> m_Context;
     NVScopedRefCounted<IStringTable> m_StrTable;
     NVScopedRefCounted<IInputStreamFactory> m_InputStreamFactory;
     IPerfTimer &m_PerfTimer;
+    IJobSystem *m_JobSystem;
     volatile QT3DSI32 mRefCount;
     TStr m_PathBuilder;
     TImageMap m_ImageMap;
@@ -115,6 +187,7 @@ struct SBufferManager : public IBufferManager
     TStringSet m_LoadedImageSet;
     TAliasImageMap m_AliasImageMap;
     TMeshMap m_MeshMap;
+    TMeshLoadJobMap m_MeshLoadJobs;
     SPrimitiveEntry m_PrimitiveNames[5];
     nvvector<qt3ds::render::NVRenderVertexBufferEntry> m_EntryBuffer;
     bool m_GPUSupportsCompressedTextures;
@@ -126,11 +199,13 @@ struct SBufferManager : public IBufferManager
     static const char8_t *GetPrimitivesDirectory() { return "res//primitives"; }
 
     SBufferManager(NVRenderContext &ctx, IStringTable &strTable,
-                   IInputStreamFactory &inInputStreamFactory, IPerfTimer &inTimer)
+                   IInputStreamFactory &inInputStreamFactory, IPerfTimer &inTimer,
+                   IJobSystem *inJobSystem)
         : m_Context(ctx)
         , m_StrTable(strTable)
         , m_InputStreamFactory(inInputStreamFactory)
         , m_PerfTimer(inTimer)
+        , m_JobSystem(inJobSystem)
         , mRefCount(0)
         , m_PathBuilder(ForwardingAllocator(ctx.GetAllocator(), "SBufferManager::m_PathBuilder"))
         , m_ImageMap(ctx.GetAllocator(), "SBufferManager::m_ImageMap")
@@ -139,6 +214,7 @@ struct SBufferManager : public IBufferManager
               ForwardingAllocator(ctx.GetAllocator(), "SBufferManager::m_LoadedImageSet"))
         , m_AliasImageMap(ctx.GetAllocator(), "SBufferManager::m_AliasImageMap")
         , m_MeshMap(ctx.GetAllocator(), "SBufferManager::m_MeshMap")
+        , m_MeshLoadJobs(ctx.GetAllocator(), "SBufferManager::m_MeshLoadJobs")
         , m_EntryBuffer(ctx.GetAllocator(), "SBufferManager::m_EntryBuffer")
         , m_GPUSupportsCompressedTextures(ctx.AreCompressedTexturesSupported())
         , m_reloadableResources(false)
@@ -503,7 +579,7 @@ struct SBufferManager : public IBufferManager
                 if (theBSDFMipMap == NULL) {
                     theBSDFMipMap = Qt3DSRenderPrefilterTexture::Create(
                         m_Context, inLoadedImage.width, inLoadedImage.height, *theTexture,
-                        destFormat, m_Context->GetFoundation());
+                        destFormat, m_Context->GetFoundation(), m_JobSystem);
                     theImage.first->second.m_BSDFMipMap = theBSDFMipMap;
                 }
 
@@ -893,10 +969,98 @@ struct SBufferManager : public IBufferManager
         }
     }
 
+    // Splits the mesh id off the path; the file is left in m_PathBuilder.
+    QT3DSU32 ResolveMeshFile(CRegisteredString inMeshPath)
+    {
+        m_PathBuilder = inMeshPath;
+        TStr::size_type pound = m_PathBuilder.rfind('#');
+        QT3DSU32 id = 0;
+        if (pound != TStr::npos) {
+            id = QT3DSU32(atoi(m_PathBuilder.c_str() + pound + 1));
+            m_PathBuilder.erase(m_PathBuilder.begin() + pound, m_PathBuilder.end());
+        }
+        return id;
+    }
+
+    void StartMeshLoad(CRegisteredString inMeshPath)
+    {
+        // Primitives are tiny and are loaded when they are needed.
+        if (!inMeshPath.IsValid() || inMeshPath.c_str()[0] == '#'
+            || m_MeshMap.find(inMeshPath) != m_MeshMap.end()
+            || m_MeshLoadJobs.find(inMeshPath) != m_MeshLoadJobs.end()) {
+            return;
+        }
+        QT3DSU32 id = ResolveMeshFile(inMeshPath);
+        SMeshLoadJob *theJob = QT3DS_NEW(m_Context->GetAllocator(), SMeshLoadJob)(
+                    m_Context->GetAllocator(), *m_InputStreamFactory,
+                    QString::fromUtf8(m_PathBuilder.c_str()), id);
+        m_MeshLoadJobs.insert(make_pair(inMeshPath, theJob));
+        m_JobSystem->Run(&theJob->m_Group, theJob, &SMeshLoadJob::Load);
+        // Seal the group so IsDone reports when the mesh has been parsed.
+        m_JobSystem->Then(theJob->m_Group, nullptr, nullptr);
+    }
+
+    // Uploads a parsed mesh, waiting for the job if it has not finished yet.
+    SRenderMesh *FinishMeshLoad(TMeshLoadJobMap::iterator inJob)
+    {
+        CRegisteredString theMeshPath = inJob->first;
+        SMeshLoadJob *theJob = inJob->second;
+        m_MeshLoadJobs.erase(inJob);
+        m_JobSystem->Wait(theJob->m_Group);
+        SRenderMesh *theMesh = nullptr;
+        if (theJob->m_Result.m_Mesh)
+            theMesh = createRenderMesh(theJob->m_Result);
+        else
+            qCWarning(WARNING, "Failed to load mesh: %s", qPrintable(theJob->m_Path));
+        m_MeshMap.insert(make_pair(theMeshPath, theMesh));
+        NVDelete(m_Context->GetAllocator(), theJob);
+        return theMesh;
+    }
+
+    void PreloadMeshes(NVConstDataRef<CRegisteredString> inMeshPaths) override
+    {
+        if (m_JobSystem == nullptr)
+            return;
+        for (QT3DSU32 idx = 0, end = inMeshPaths.size(); idx < end; ++idx)
+            StartMeshLoad(inMeshPaths[idx]);
+    }
+
+    SRenderMesh *TryLoadMesh(CRegisteredString inMeshPath) override
+    {
+        if (m_JobSystem == nullptr || inMeshPath.IsValid() == false)
+            return LoadMesh(inMeshPath);
+        TMeshMap::iterator theMesh = m_MeshMap.find(inMeshPath);
+        if (theMesh != m_MeshMap.end())
+            return theMesh->second;
+        StartMeshLoad(inMeshPath);
+        TMeshLoadJobMap::iterator theJob = m_MeshLoadJobs.find(inMeshPath);
+        if (theJob == m_MeshLoadJobs.end())
+            return LoadMesh(inMeshPath);
+        if (!theJob->second->m_Group.IsDone()) {
+            theJob->second->m_Requested = true;
+            return nullptr;
+        }
+        return FinishMeshLoad(theJob);
+    }
+
+    bool HasPendingMeshLoads() const override
+    {
+        for (TMeshLoadJobMap::const_iterator iter = m_MeshLoadJobs.begin(),
+                                             end = m_MeshLoadJobs.end();
+             iter != end; ++iter) {
+            if (iter->second->m_Requested && iter->second->m_Group.IsDone())
+                return true;
+        }
+        return false;
+    }
+
     SRenderMesh *LoadMesh(CRegisteredString inMeshPath) override
     {
         if (inMeshPath.IsValid() == false)
             return nullptr;
+        TMeshLoadJobMap::iterator theJob = m_MeshLoadJobs.find(inMeshPath);
+        if (theJob != m_MeshLoadJobs.end())
+            return FinishMeshLoad(theJob);
         pair<TMeshMap::iterator, bool> theMesh =
             m_MeshMap.insert(make_pair(inMeshPath, static_cast<SRenderMesh *>(nullptr)));
         if (theMesh.second) {
@@ -905,13 +1069,7 @@ struct SBufferManager : public IBufferManager
 
             // Attempt a load from the filesystem if this mesh isn't a primitive.
             if (!theResult.m_Mesh) {
-                m_PathBuilder = inMeshPath;
-                TStr::size_type pound = m_PathBuilder.rfind('#');
-                QT3DSU32 id = 0;
-                if (pound != TStr::npos) {
-                    id = QT3DSU32(atoi(m_PathBuilder.c_str() + pound + 1));
-                    m_PathBuilder.erase(m_PathBuilder.begin() + pound, m_PathBuilder.end());
-                }
+                QT3DSU32 id = ResolveMeshFile(inMeshPath);
                 NVScopedRefCounted<IRefCountedInputStream> theStream(
                     m_InputStreamFactory->GetStreamForFile(m_PathBuilder.c_str()));
                 if (theStream) {
@@ -1095,6 +1253,12 @@ struct SBufferManager : public IBufferManager
     void Clear() override
     {
         m_reloadableTextures.clear();
+        for (TMeshLoadJobMap::iterator iter = m_MeshLoadJobs.begin(), end = m_MeshLoadJobs.end();
+             iter != end; ++iter) {
+            m_JobSystem->Wait(iter->second->m_Group);
+            NVDelete(m_Context->GetAllocator(), iter->second);
+        }
+        m_MeshLoadJobs.clear();
         for (TMeshMap::iterator iter = m_MeshMap.begin(), end = m_MeshMap.end(); iter != end;
              ++iter) {
             SRenderMesh *theMesh = iter->second;
@@ -1117,6 +1281,15 @@ struct SBufferManager : public IBufferManager
     }
     void InvalidateBuffer(CRegisteredString inSourcePath) override
     {
+        {
+            TMeshLoadJobMap::iterator theJob = m_MeshLoadJobs.find(inSourcePath);
+            if (theJob != m_MeshLoadJobs.end()) {
+                m_JobSystem->Wait(theJob->second->m_Group);
+                NVDelete(m_Context->GetAllocator(), theJob->second);
+                m_MeshLoadJobs.erase(theJob);
+                return;
+            }
+        }
         {
             TMeshMap::iterator iter = m_MeshMap.find(inSourcePath);
             if (iter != m_MeshMap.end()) {
@@ -1144,8 +1317,10 @@ struct SBufferManager : public IBufferManager
 }
 
 IBufferManager &IBufferManager::Create(NVRenderContext &inRenderContext, IStringTable &inStrTable,
-                                       IInputStreamFactory &inFactory, IPerfTimer &inPerfTimer)
+                                       IInputStreamFactory &inFactory, IPerfTimer &inPerfTimer,
+                                       IJobSystem *inJobSystem)
 {
     return *QT3DS_NEW(inRenderContext.GetAllocator(), SBufferManager)(inRenderContext, inStrTable,
-                                                                      inFactory, inPerfTimer);
+                                                                      inFactory, inPerfTimer,
+                                                                      inJobSystem);
 }
@@ -106,6 +106,15 @@ namespace render {
 
         virtual void loadCustomMesh(const QString &name, qt3dsimp::Mesh *mesh) = 0;
         virtual SRenderMesh *LoadMesh(CRegisteredString inSourcePath) = 0;
+        // Start parsing these meshes on the job system.  Only the upload to the graphics api
+        // is left for LoadMesh, which waits for a mesh that is still being parsed.
+        virtual void PreloadMeshes(NVConstDataRef<CRegisteredString> inSourcePaths) = 0;
+        // Like LoadMesh but returns null instead of waiting while the mesh is being parsed;
+        // a mesh that was not requested before starts loading.
+        virtual SRenderMesh *TryLoadMesh(CRegisteredString inSourcePath) = 0;
+        // True if a mesh that TryLoadMesh could not return yet has been parsed and the next
+        // frame would upload and show it.  Preloaded meshes nothing asked for do not count.
+        virtual bool HasPendingMeshLoads() const = 0;
 
         virtual SRenderMesh *CreateMesh(const char *inSourcePath, QT3DSU8 *inVertData,
                                         QT3DSU32 inNumVerts, QT3DSU32 inVertStride, QT3DSU32 *inIndexData,
@@ -120,9 +129,10 @@ namespace render {
         virtual void InvalidateBuffer(CRegisteredString inSourcePath) = 0;
         virtual IStringTable &GetStringTable() = 0;
 
+        // The job system is used to prefilter light probes on the CPU.
         static IBufferManager &Create(NVRenderContext &inRenderContext, IStringTable &inStrTable,
                                       IInputStreamFactory &inInputStreamFactory,
-                                      IPerfTimer &inTimer);
+                                      IPerfTimer &inTimer, IJobSystem *inJobSystem = nullptr);
     };
 }
 }
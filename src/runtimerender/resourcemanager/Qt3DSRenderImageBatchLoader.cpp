@@ -178,6 +178,8 @@ struct SBatchLoadedImage
     {
     }
 
+    QT3DSU32 GetUploadSize() const { return m_Texture ? m_Texture->dataSizeInBytes : 0; }
+
     // Called from main thread
     bool Finalize(IBufferManager &inMgr);
 };
@@ -217,6 +219,8 @@ struct SBatchLoader : public IImageBatchLoader
     nvvector<SLoadingImage> m_LoaderBuilderWorkspace;
     TLoadingImagePool m_LoadingImagePool;
     TBatchPool m_BatchPool;
+    // Bytes of image data uploaded per frame before the rest is left for the next frames.
+    QT3DSU32 m_UploadBudget;
 
     SBatchLoader(NVFoundationBase &inFoundation, IInputStreamFactory &inFactory,
                  IBufferManager &inBufferManager, IThreadPool &inThreadPool, IPerfTimer &inTimer)
@@ -237,7 +241,11 @@ struct SBatchLoader : public IImageBatchLoader
         , m_LoadingImagePool(
               ForwardingAllocator(inFoundation.getAllocator(), "SBatchLoader::m_LoadingImagePool"))
         , m_BatchPool(ForwardingAllocator(inFoundation.getAllocator(), "SBatchLoader::m_BatchPool"))
+        , m_UploadBudget(4 * 1024 * 1024)
     {
+        const int budgetKb = qEnvironmentVariableIntValue("QT3DS_IMAGE_UPLOAD_BUDGET_KB");
+        if (budgetKb > 0)
+            m_UploadBudget = QT3DSU32(budgetKb) * 1024;
     }
 
     virtual ~SBatchLoader()
@@ -341,25 +349,36 @@ struct SBatchLoader : public IImageBatchLoader
         inImage.m_Batch->IncrementLoadedImageCount();
         inImage.m_Batch->m_LoadEvent.set();
     }
+    bool HasPendingLoads() override
+    {
+        TScopedLock __loaderLock(m_LoaderMutex);
+        return m_Batches.size() > 0 || m_LoadedImages.size() > 0;
+    }
+
     // These are called by the render context, users don't need to call this.
     void BeginFrame(bool firstFrame) override
     {
         TScopedLock __loaderLock(m_LoaderMutex);
-        // Pass 1 - send out all image loaded signals
+        // Pass 1 - upload the decoded images and send out the image loaded signals.
+        // Outside of the first frame the uploads are spread over frames by the upload budget,
+        // at least one image is uploaded each frame.
+        QT3DSU32 theUploadedBytes = 0;
+        QT3DSU32 theFinalizedCount = 0;
         for (QT3DSU32 idx = 0, end = m_LoadedImages.size(); idx < end; ++idx) {
-
-            m_SourcePathToBatches.erase(m_LoadedImages[idx].m_SourcePath);
-            m_LoadedImages[idx].Finalize(m_BufferManager);
-            m_LoadedImages[idx].m_Batch->IncrementFinalizedImageCount();
-            if (m_LoadedImages[idx].m_Batch->IsFinalizedFinished())
-                m_FinishedBatches.push_back(m_LoadedImages[idx].m_Batch->m_BatchId);
-            if (!firstFrame)
+            SBatchLoadedImage &theImage(m_LoadedImages[idx]);
+            const QT3DSU32 theUploadSize = theImage.GetUploadSize();
+            if (!firstFrame && idx > 0 && theUploadedBytes + theUploadSize > m_UploadBudget)
                 break;
+            theUploadedBytes += theUploadSize;
+            ++theFinalizedCount;
+
+            m_SourcePathToBatches.erase(theImage.m_SourcePath);
+            theImage.Finalize(m_BufferManager);
+            theImage.m_Batch->IncrementFinalizedImageCount();
+            if (theImage.m_Batch->IsFinalizedFinished())
+                m_FinishedBatches.push_back(theImage.m_Batch->m_BatchId);
         }
-        if (firstFrame)
-            m_LoadedImages.clear();
-        else if (m_LoadedImages.size())
-            m_LoadedImages.erase(m_LoadedImages.begin());
+        m_LoadedImages.erase(m_LoadedImages.begin(), m_LoadedImages.begin() + theFinalizedCount);
         // pass 2 - clean up any existing batches.
         for (QT3DSU32 idx = 0, end = m_FinishedBatches.size(); idx < end; ++idx) {
             TImageLoaderBatchMap::iterator theIter = m_Batches.find(m_FinishedBatches[idx]);
@@ -400,6 +419,12 @@ void SLoadingImage::LoadImage(void *inImg)
         //	theTexture->EnsureMultiplerOfFour( theThis->m_Batch->m_Loader.m_Foundation,
         //theThis->m_SourcePath.c_str() );
 
+        // Scan here so that uploading the image on the render thread does not have to.
+        if (theTexture) {
+            bool alsoOpaquePixels = false;
+            theTexture->ScanForTransparency(alsoOpaquePixels);
+        }
+
         theThis->m_Batch->m_Loader.ImageLoaded(*theThis, theTexture);
     } else {
         theThis->m_Batch->m_Loader.ImageLoaded(*theThis, NULL);
@@ -82,6 +82,9 @@ namespace render {
         // Block until every image in the batch is loaded.
         virtual void BlockUntilLoaded(TImageBatchId inId) = 0;
 
+        // True while images are loading or waiting to be finalized in BeginFrame.
+        virtual bool HasPendingLoads() = 0;
+
         // These are called by the render context, users don't need to call this.
         virtual void BeginFrame(bool firstFrame) = 0;
         virtual void EndFrame() = 0;
@@ -727,6 +727,17 @@ void SLoadedTexture::release()
 }
 
 bool SLoadedTexture::ScanForTransparency(bool &alsoOpaquePixels)
+{
+    if (!m_TransparencyScanned) {
+        m_HasOpaquePixels = false;
+        m_HasTransparency = DoScanForTransparency(m_HasOpaquePixels);
+        m_TransparencyScanned = true;
+    }
+    alsoOpaquePixels = m_HasOpaquePixels;
+    return m_HasTransparency;
+}
+
+bool SLoadedTexture::DoScanForTransparency(bool &alsoOpaquePixels)
 {
     switch (format) {
     case NVRenderTextureFormats::SRGB8A8:
@@ -94,6 +94,10 @@ namespace render {
         char8_t m_BackgroundColor[3];
         uint8_t *m_TransparencyTable;
         int32_t m_TransparentPaletteIndex;
+        // Cached result of ScanForTransparency so the scan can run on a loader thread.
+        bool m_TransparencyScanned;
+        bool m_HasTransparency;
+        bool m_HasOpaquePixels;
 
         SLoadedTexture(NVAllocatorCallback &inAllocator)
             : m_Allocator(inAllocator)
@@ -110,6 +114,9 @@ namespace render {
             , m_BitCount(0)
             , m_TransparencyTable(NULL)
             , m_TransparentPaletteIndex(-1)
+            , m_TransparencyScanned(false)
+            , m_HasTransparency(false)
+            , m_HasOpaquePixels(false)
         {
             m_CustomMasks[0] = 0;
             m_CustomMasks[1] = 0;
@@ -142,6 +149,7 @@ namespace render {
         void EnsureMultiplerOfFour(NVFoundationBase &inFoundation, const char *inPath);
         // Returns true if this image has a pixel less than 255.
         // If yes, then alsoOpaquePixels is true if some are not
+        // The image is scanned only once, later calls return the cached result.
         bool ScanForTransparency(bool &alsoOpaquePixels);
 
         // Be sure to call this or risk leaking an enormous amount of memory
@@ -184,6 +192,7 @@ namespace render {
                                         NVRenderContextType renderContextType);
 
     private:
+        bool DoScanForTransparency(bool &alsoOpaquePixels);
         // Implemented in the bmp loader.
         void FreeImagePostProcess(bool inFlipY);
     };
@@ -31,9 +31,23 @@
 #include "Qt3DSRenderPrefilterTexture.h"
 #include "render/Qt3DSRenderContext.h"
 #include "render/Qt3DSRenderShaderProgram.h"
+#include "Qt3DSRenderJobSystem.h"
+#include "foundation/Qt3DSFoundation.h"
+
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qsavefile.h>
 
 #include <string>
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define QT3DS_PREFILTER_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define QT3DS_PREFILTER_NEON
+#endif
+
 using namespace qt3ds;
 using namespace qt3ds::render;
 using namespace qt3ds::foundation;
@@ -271,7 +285,7 @@ Qt3DSRenderPrefilterTexture *
 Qt3DSRenderPrefilterTexture::Create(NVRenderContext *inNVRenderContext, QT3DSI32 inWidth, QT3DSI32 inHeight,
                                   NVRenderTexture2D &inTexture2D,
                                   NVRenderTextureFormats::Enum inDestFormat,
-                                  qt3ds::NVFoundationBase &inFnd)
+                                  qt3ds::NVFoundationBase &inFnd, IJobSystem *inJobSystem)
 {
     Qt3DSRenderPrefilterTexture *theBSDFMipMap = nullptr;
 
@@ -282,7 +296,7 @@ Qt3DSRenderPrefilterTexture::Create(NVRenderContext *inNVRenderContext, QT3DSI32
 
     if (!theBSDFMipMap) {
         theBSDFMipMap = QT3DS_NEW(inFnd.getAllocator(), Qt3DSRenderPrefilterTextureCPU)(
-            inNVRenderContext, inWidth, inHeight, inTexture2D, inDestFormat, inFnd);
+            inNVRenderContext, inWidth, inHeight, inTexture2D, inDestFormat, inFnd, inJobSystem);
     }
 
     if (theBSDFMipMap)
@@ -299,101 +313,272 @@ Qt3DSRenderPrefilterTexture::~Qt3DSRenderPrefilterTexture()
 // CPU based filtering
 //------------------------------------------------------------------------------------
 
-Qt3DSRenderPrefilterTextureCPU::Qt3DSRenderPrefilterTextureCPU(
-    NVRenderContext *inNVRenderContext, int inWidth, int inHeight, NVRenderTexture2D &inTexture2D,
-    NVRenderTextureFormats::Enum inDestFormat, NVFoundationBase &inFnd)
-    : Qt3DSRenderPrefilterTexture(inNVRenderContext, inWidth, inHeight, inTexture2D, inDestFormat,
-                                inFnd)
+namespace {
+
+// Bump when the filter or the cache layout changes to invalidate old cache files.
+const QT3DSU32 g_BsdfCacheVersion = 1;
+const char g_BsdfCacheMagic[8] = { 'Q', '3', 'D', 'S', 'B', 'S', 'D', 'F' };
+
+struct SBsdfCacheHeader
 {
-}
+    char m_Magic[8];
+    QT3DSU32 m_Version;
+    QT3DSU32 m_Width;
+    QT3DSU32 m_Height;
+    QT3DSU32 m_Format;
+    QT3DSU32 m_LevelCount;
+};
+
+struct SBsdfCacheLevel
+{
+    QT3DSU32 m_Width;
+    QT3DSU32 m_Height;
+    QT3DSU32 m_DataSize;
+};
 
-inline int Qt3DSRenderPrefilterTextureCPU::wrapMod(int a, int base)
+inline int wrapMod(int a, int base)
 {
     return (a >= 0) ? a % base : (a % base) + base;
 }
 
-inline void Qt3DSRenderPrefilterTextureCPU::getWrappedCoords(int &sX, int &sY, int width, int height)
+// Maps a row of the 5x5 filter footprint back into the image. Rows wrapping over a pole
+// continue half way around the horizon, which is expressed as a column offset.
+inline int getWrappedRow(int sY, int width, int height, int &outColumnOffset)
 {
+    outColumnOffset = 0;
     if (sY < 0) {
-        sX -= width >> 1;
+        outColumnOffset -= width >> 1;
         sY = -sY;
     }
     if (sY >= height) {
-        sX += width >> 1;
+        outColumnOffset += width >> 1;
         sY = height - sY;
     }
-    sX = wrapMod(sX, width);
+    if (sY < 0)
+        sY = height + sY;
+    return sY;
 }
 
-STextureData
-Qt3DSRenderPrefilterTextureCPU::CreateBsdfMipLevel(STextureData &inCurMipLevel,
-                                                 STextureData &inPrevMipLevel, int width,
-                                                 int height) //, IPerfTimer& inPerfTimer )
+inline void decodeRow(const void *inData, QT3DSI32 inRow, QT3DSI32 inWidth, QT3DSU32 inPixelSize,
+                      NVRenderTextureFormats::Enum inFormat, float *outRow)
 {
-    STextureData retval;
-    int newWidth = width >> 1;
-    int newHeight = height >> 1;
-    newWidth = newWidth >= 1 ? newWidth : 1;
-    newHeight = newHeight >= 1 ? newHeight : 1;
-    const QT3DSU32 size = NVRenderTextureFormats::getSizeofFormat(inPrevMipLevel.format);
-
-    if (inCurMipLevel.data) {
-        retval = inCurMipLevel;
-        retval.dataSizeInBytes = newWidth * newHeight * size;
-    } else {
-        retval.dataSizeInBytes = newWidth * newHeight * size;
-        retval.format = inPrevMipLevel.format; // inLoadedImage.format;
-        retval.data = m_Foundation.getAllocator().allocate(
-            retval.dataSizeInBytes, "Bsdf Scaled Image Data", __FILE__, __LINE__);
-    }
-
-    for (int y = 0; y < newHeight; ++y) {
-        for (int x = 0; x < newWidth; ++x) {
-            float accumVal[4];
-            accumVal[0] = 0;
-            accumVal[1] = 0;
-            accumVal[2] = 0;
-            accumVal[3] = 0;
-            for (int sy = -2; sy <= 2; ++sy) {
-                for (int sx = -2; sx <= 2; ++sx) {
-                    int sampleX = sx + (x << 1);
-                    int sampleY = sy + (y << 1);
-                    getWrappedCoords(sampleX, sampleY, width, height);
-
-                    // Cauchy filter (this is simply because it's the easiest to evaluate, and
-                    // requires no complex functions).
-                    float filterPdf = 1.f / (1.f + float(sx * sx + sy * sy) * 2.f);
-                    // With FP HDR formats, we're not worried about intensity loss so much as
-                    // unnecessary energy gain,
-                    // whereas with LDR formats, the fear with a continuous normalization factor is
-                    // that we'd lose intensity and saturation as well.
-                    filterPdf /= (size >= 8) ? 4.71238898f : 4.5403446f;
-                    // filterPdf /= 4.5403446f;        // Discrete normalization factor
-                    // filterPdf /= 4.71238898f;        // Continuous normalization factor
-                    float curPix[4];
-                    QT3DSI32 byteOffset = (sampleY * width + sampleX) * size;
-                    if (byteOffset < 0) {
-                        sampleY = height + sampleY;
-                        byteOffset = (sampleY * width + sampleX) * size;
-                    }
+    for (QT3DSI32 x = 0; x < inWidth; ++x) {
+        NVRenderTextureFormats::decodeToFloat(const_cast<void *>(inData),
+                                              (inRow * inWidth + x) * inPixelSize, outRow + x * 4,
+                                              inFormat);
+    }
+}
 
-                    NVRenderTextureFormats::decodeToFloat(inPrevMipLevel.data, byteOffset, curPix,
-                                                          retval.format);
+struct SBsdfRowFilter
+{
+    const float *m_PrevLevel;
+    QT3DSI32 m_Width;
+    QT3DSI32 m_Height;
+    NVRenderTextureFormats::Enum m_Format;
+    QT3DSU8 *m_OutLevel;
+    float *m_OutFloats;
+    float m_Weights[25];
+
+    SBsdfRowFilter(const float *inPrevLevel, QT3DSI32 inWidth, QT3DSI32 inHeight,
+                   NVRenderTextureFormats::Enum inFormat, QT3DSU8 *outLevel, float *outFloats)
+        : m_PrevLevel(inPrevLevel)
+        , m_Width(inWidth)
+        , m_Height(inHeight)
+        , m_Format(inFormat)
+        , m_OutLevel(outLevel)
+        , m_OutFloats(outFloats)
+    {
+        // With FP HDR formats, we're not worried about intensity loss so much as unnecessary
+        // energy gain, whereas with LDR formats, the fear with a continuous normalization
+        // factor is that we'd lose intensity and saturation as well.
+        const float theNormalization =
+            (NVRenderTextureFormats::getSizeofFormat(inFormat) >= 8) ? 4.71238898f : 4.5403446f;
+        for (int sy = -2; sy <= 2; ++sy) {
+            for (int sx = -2; sx <= 2; ++sx) {
+                // Cauchy filter (this is simply because it's the easiest to evaluate, and
+                // requires no complex functions).
+                m_Weights[(sy + 2) * 5 + sx + 2] =
+                    1.f / (1.f + float(sx * sx + sy * sy) * 2.f) / theNormalization;
+            }
+        }
+    }
 
-                    accumVal[0] += filterPdf * curPix[0];
-                    accumVal[1] += filterPdf * curPix[1];
-                    accumVal[2] += filterPdf * curPix[2];
-                    accumVal[3] += filterPdf * curPix[3];
+    void operator()(QT3DSU32 inBegin, QT3DSU32 inEnd)
+    {
+        const QT3DSI32 newWidth = qMax(m_Width >> 1, 1);
+        const QT3DSU32 size = NVRenderTextureFormats::getSizeofFormat(m_Format);
+        for (QT3DSI32 y = QT3DSI32(inBegin); y < QT3DSI32(inEnd); ++y) {
+            const float *theRows[5];
+            int theColumnOffsets[5];
+            for (int sy = -2; sy <= 2; ++sy) {
+                theRows[sy + 2] = m_PrevLevel
+                        + getWrappedRow(sy + (y << 1), m_Width, m_Height, theColumnOffsets[sy + 2])
+                        * m_Width * 4;
+            }
+            float *theOutRow = m_OutFloats + y * newWidth * 4;
+            for (QT3DSI32 x = 0; x < newWidth; ++x) {
+#if defined(QT3DS_PREFILTER_SSE)
+                __m128 theAccum = _mm_setzero_ps();
+#elif defined(QT3DS_PREFILTER_NEON)
+                float32x4_t theAccum = vdupq_n_f32(0.f);
+#else
+                float theAccum[4] = { 0.f, 0.f, 0.f, 0.f };
+#endif
+                for (int sy = 0; sy < 5; ++sy) {
+                    const float *theRow = theRows[sy];
+                    const float *theWeights = m_Weights + sy * 5;
+                    for (int sx = 0; sx < 5; ++sx) {
+                        const float *thePixel =
+                            theRow + wrapMod((x << 1) + sx - 2 + theColumnOffsets[sy], m_Width) * 4;
+#if defined(QT3DS_PREFILTER_SSE)
+                        theAccum = _mm_add_ps(theAccum, _mm_mul_ps(_mm_set1_ps(theWeights[sx]),
+                                                                   _mm_loadu_ps(thePixel)));
+#elif defined(QT3DS_PREFILTER_NEON)
+                        theAccum = vmlaq_n_f32(theAccum, vld1q_f32(thePixel), theWeights[sx]);
+#else
+                        theAccum[0] += theWeights[sx] * thePixel[0];
+                        theAccum[1] += theWeights[sx] * thePixel[1];
+                        theAccum[2] += theWeights[sx] * thePixel[2];
+                        theAccum[3] += theWeights[sx] * thePixel[3];
+#endif
+                    }
                 }
+                float *theOutPixel = theOutRow + x * 4;
+#if defined(QT3DS_PREFILTER_SSE)
+                _mm_storeu_ps(theOutPixel, theAccum);
+#elif defined(QT3DS_PREFILTER_NEON)
+                vst1q_f32(theOutPixel, theAccum);
+#else
+                theOutPixel[0] = theAccum[0];
+                theOutPixel[1] = theAccum[1];
+                theOutPixel[2] = theAccum[2];
+                theOutPixel[3] = theAccum[3];
+#endif
+                NVRenderTextureFormats::encodeToPixel(theOutPixel, m_OutLevel,
+                                                      (y * newWidth + x) * size, m_Format);
             }
+            // The next level is filtered from the encoded values, as they are uploaded.
+            decodeRow(m_OutLevel, y, newWidth, size, m_Format, theOutRow);
+        }
+    }
+};
+
+struct SDecodeRows
+{
+    const void *m_Data;
+    QT3DSI32 m_Width;
+    QT3DSU32 m_PixelSize;
+    NVRenderTextureFormats::Enum m_Format;
+    float *m_Out;
+
+    void operator()(QT3DSU32 inBegin, QT3DSU32 inEnd)
+    {
+        for (QT3DSU32 y = inBegin; y < inEnd; ++y)
+            decodeRow(m_Data, QT3DSI32(y), m_Width, m_PixelSize, m_Format, m_Out + y * m_Width * 4);
+    }
+};
+
+template <typename TFunctor>
+void runRows(IJobSystem *inJobSystem, QT3DSI32 inRowCount, QT3DSI32 inRowWidth,
+             TFunctor &inFunctor)
+{
+    if (inJobSystem) {
+        // Aim for a few thousand pixels per job.
+        const QT3DSU32 theGrain = QT3DSU32(qMax(1, 4096 / qMax(inRowWidth, 1)));
+        ParallelFor(*inJobSystem, QT3DSU32(inRowCount), theGrain, inFunctor);
+    } else {
+        inFunctor(0, QT3DSU32(inRowCount));
+    }
+}
+}
+
+Qt3DSRenderPrefilterTextureCPU::Qt3DSRenderPrefilterTextureCPU(
+    NVRenderContext *inNVRenderContext, int inWidth, int inHeight, NVRenderTexture2D &inTexture2D,
+    NVRenderTextureFormats::Enum inDestFormat, NVFoundationBase &inFnd, IJobSystem *inJobSystem)
+    : Qt3DSRenderPrefilterTexture(inNVRenderContext, inWidth, inHeight, inTexture2D, inDestFormat,
+                                inFnd)
+    , m_JobSystem(inJobSystem)
+{
+}
+
+void Qt3DSRenderPrefilterTextureCPU::CreateBsdfMipLevel(const float *inPrevLevel, int width,
+                                                        int height,
+                                                        NVRenderTextureFormats::Enum inFormat,
+                                                        QT3DSU8 *outLevel, float *outFloats)
+{
+    SBsdfRowFilter theFilter(inPrevLevel, width, height, inFormat, outLevel, outFloats);
+    runRows(m_JobSystem, qMax(height >> 1, 1), qMax(width >> 1, 1), theFilter);
+}
 
-            QT3DSU32 newIdx = (y * newWidth + x) * size;
+bool Qt3DSRenderPrefilterTextureCPU::LoadCachedMipChain(const QString &inCacheFile,
+                                                        NVRenderTextureFormats::Enum inFormat)
+{
+    QFile theFile(inCacheFile);
+    if (!theFile.open(QIODevice::ReadOnly))
+        return false;
+    const QByteArray theData = theFile.readAll();
+    const char *theCursor = theData.constData();
+    const char *theEnd = theCursor + theData.size();
+
+    SBsdfCacheHeader theHeader;
+    if (theData.size() < int(sizeof(theHeader)))
+        return false;
+    memcpy(&theHeader, theCursor, sizeof(theHeader));
+    theCursor += sizeof(theHeader);
+    if (memcmp(theHeader.m_Magic, g_BsdfCacheMagic, sizeof(g_BsdfCacheMagic)) != 0
+            || theHeader.m_Version != g_BsdfCacheVersion
+            || theHeader.m_Width != QT3DSU32(m_Width) || theHeader.m_Height != QT3DSU32(m_Height)
+            || theHeader.m_Format != QT3DSU32(inFormat)
+            || theHeader.m_LevelCount != QT3DSU32(m_MaxMipMapLevel)) {
+        return false;
+    }
 
-            NVRenderTextureFormats::encodeToPixel(accumVal, retval.data, newIdx, retval.format);
+    // Validate the whole file before uploading anything. Every level has to be exactly the size
+    // Build would generate, anything else is a corrupt file and the chain is regenerated.
+    const QT3DSU32 theSizeOfFormat = NVRenderTextureFormats::getSizeofFormat(inFormat);
+    const char *theLevels = theCursor;
+    QT3DSU32 theLevelWidth = QT3DSU32(m_Width);
+    QT3DSU32 theLevelHeight = QT3DSU32(m_Height);
+    for (QT3DSU32 idx = 0; idx < theHeader.m_LevelCount; ++idx) {
+        theLevelWidth = qMax(theLevelWidth >> 1, 1u);
+        theLevelHeight = qMax(theLevelHeight >> 1, 1u);
+        SBsdfCacheLevel theLevel;
+        if (theEnd - theCursor < qint64(sizeof(theLevel)))
+            return false;
+        memcpy(&theLevel, theCursor, sizeof(theLevel));
+        theCursor += sizeof(theLevel);
+        if (theLevel.m_Width != theLevelWidth || theLevel.m_Height != theLevelHeight
+                || theLevel.m_DataSize != theLevelWidth * theLevelHeight * theSizeOfFormat
+                || theEnd - theCursor < qint64(theLevel.m_DataSize)) {
+            return false;
         }
+        theCursor += theLevel.m_DataSize;
     }
 
-    return retval;
+    theCursor = theLevels;
+    for (QT3DSU32 idx = 1; idx <= theHeader.m_LevelCount; ++idx) {
+        SBsdfCacheLevel theLevel;
+        memcpy(&theLevel, theCursor, sizeof(theLevel));
+        theCursor += sizeof(theLevel);
+        m_Texture2D.SetTextureData(toU8DataRef(const_cast<char *>(theCursor), theLevel.m_DataSize),
+                                   QT3DSU8(idx), theLevel.m_Width, theLevel.m_Height, inFormat,
+                                   m_DestinationFormat);
+        theCursor += theLevel.m_DataSize;
+    }
+    return true;
+}
+
+void Qt3DSRenderPrefilterTextureCPU::SaveCachedMipChain(const QString &inCacheFile,
+                                                        const QByteArray &inMipChain)
+{
+    QSaveFile theFile(inCacheFile);
+    if (!theFile.open(QIODevice::WriteOnly)) {
+        qCWarning(WARNING, "Failed to write light probe cache %s", qPrintable(inCacheFile));
+        return;
+    }
+    theFile.write(inMipChain);
+    if (!theFile.commit())
+        qCWarning(WARNING, "Failed to write light probe cache %s", qPrintable(inCacheFile));
 }
 
 void Qt3DSRenderPrefilterTextureCPU::Build(void *inTextureData, QT3DSI32 inTextureDataSize,
@@ -408,36 +593,80 @@ void Qt3DSRenderPrefilterTextureCPU::Build(void *inTextureData, QT3DSI32 inTextu
     m_Texture2D.SetTextureData(NVDataRef<QT3DSU8>((QT3DSU8 *)inTextureData, inTextureDataSize), 0,
                                m_Width, m_Height, inFormat, m_DestinationFormat);
 
-    STextureData theMipImage;
-    STextureData prevImage;
-    prevImage.data = inTextureData;
-    prevImage.dataSizeInBytes = inTextureDataSize;
-    prevImage.format = inFormat;
+    QString theCacheFile;
+    const QString theCacheDir = qEnvironmentVariable("QT3DS_IBL_CACHE_DIR");
+    if (!theCacheDir.isEmpty()) {
+        QCryptographicHash theHash(QCryptographicHash::Sha1);
+        const QT3DSU32 theKey[] = { g_BsdfCacheVersion, QT3DSU32(m_Width), QT3DSU32(m_Height),
+                                    QT3DSU32(inFormat) };
+        theHash.addData(reinterpret_cast<const char *>(theKey), sizeof(theKey));
+        theHash.addData(reinterpret_cast<const char *>(inTextureData), inTextureDataSize);
+        theCacheFile = QDir(theCacheDir).filePath(QString::fromLatin1(theHash.result().toHex())
+                                                  + QStringLiteral(".bsdf"));
+        if (LoadCachedMipChain(theCacheFile, inFormat))
+            return;
+    }
+
+    const QT3DSU32 size = QT3DSU32(m_SizeOfInternalFormat);
+    NVAllocatorCallback &theAllocator(m_Foundation.getAllocator());
+    // Every level is decoded once to RGBA floats so the filter taps don't have to decode.
+    float *thePrevFloats = reinterpret_cast<float *>(theAllocator.allocate(
+        m_Width * m_Height * 4 * sizeof(float), "Bsdf Filter Data", __FILE__, __LINE__));
+    float *theCurFloats = reinterpret_cast<float *>(theAllocator.allocate(
+        qMax(m_Width >> 1, 1) * qMax(m_Height >> 1, 1) * 4 * sizeof(float), "Bsdf Filter Data",
+        __FILE__, __LINE__));
+    QT3DSU8 *theMipData = reinterpret_cast<QT3DSU8 *>(theAllocator.allocate(
+        qMax(m_Width >> 1, 1) * qMax(m_Height >> 1, 1) * size, "Bsdf Scaled Image Data",
+        __FILE__, __LINE__));
+
+    SDecodeRows theDecoder = { inTextureData, m_Width, size, inFormat, thePrevFloats };
+    runRows(m_JobSystem, m_Height, m_Width, theDecoder);
+
+    QByteArray theMipChain;
+    if (!theCacheFile.isEmpty()) {
+        SBsdfCacheHeader theHeader;
+        memcpy(theHeader.m_Magic, g_BsdfCacheMagic, sizeof(g_BsdfCacheMagic));
+        theHeader.m_Version = g_BsdfCacheVersion;
+        theHeader.m_Width = m_Width;
+        theHeader.m_Height = m_Height;
+        theHeader.m_Format = inFormat;
+        theHeader.m_LevelCount = m_MaxMipMapLevel;
+        theMipChain.append(reinterpret_cast<const char *>(&theHeader), sizeof(theHeader));
+    }
+
     int curWidth = m_Width;
     int curHeight = m_Height;
-    int size = NVRenderTextureFormats::getSizeofFormat(m_InternalFormat);
     for (int idx = 1; idx <= m_MaxMipMapLevel; ++idx) {
-        theMipImage =
-            CreateBsdfMipLevel(theMipImage, prevImage, curWidth, curHeight); //, m_PerfTimer );
+        CreateBsdfMipLevel(thePrevFloats, curWidth, curHeight, inFormat, theMipData,
+                           theCurFloats);
         curWidth = curWidth >> 1;
         curHeight = curHeight >> 1;
         curWidth = curWidth >= 1 ? curWidth : 1;
         curHeight = curHeight >= 1 ? curHeight : 1;
         inTextureDataSize = curWidth * curHeight * size;
 
-        m_Texture2D.SetTextureData(toU8DataRef((char *)theMipImage.data, (QT3DSU32)inTextureDataSize),
-                                   (QT3DSU8)idx, (QT3DSU32)curWidth, (QT3DSU32)curHeight, theMipImage.format,
+        m_Texture2D.SetTextureData(toU8DataRef((char *)theMipData, (QT3DSU32)inTextureDataSize),
+                                   (QT3DSU8)idx, (QT3DSU32)curWidth, (QT3DSU32)curHeight, inFormat,
                                    m_DestinationFormat);
 
-        if (prevImage.data == inTextureData)
-            prevImage = STextureData();
+        if (!theCacheFile.isEmpty()) {
+            const SBsdfCacheLevel theLevel = { QT3DSU32(curWidth), QT3DSU32(curHeight),
+                                               QT3DSU32(inTextureDataSize) };
+            theMipChain.append(reinterpret_cast<const char *>(&theLevel), sizeof(theLevel));
+            theMipChain.append(reinterpret_cast<const char *>(theMipData), inTextureDataSize);
+        }
 
-        STextureData temp = prevImage;
-        prevImage = theMipImage;
-        theMipImage = temp;
+        // Levels only shrink, so the buffers can be swapped.
+        float *temp = thePrevFloats;
+        thePrevFloats = theCurFloats;
+        theCurFloats = temp;
     }
-    QT3DS_FREE(m_Foundation.getAllocator(), theMipImage.data);
-    QT3DS_FREE(m_Foundation.getAllocator(), prevImage.data);
+    QT3DS_FREE(theAllocator, thePrevFloats);
+    QT3DS_FREE(theAllocator, theCurFloats);
+    QT3DS_FREE(theAllocator, theMipData);
+
+    if (!theCacheFile.isEmpty())
+        SaveCachedMipChain(theCacheFile, theMipChain);
 }
 
 //------------------------------------------------------------------------------------
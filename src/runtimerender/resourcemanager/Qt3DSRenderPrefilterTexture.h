@@ -52,10 +52,12 @@ namespace render {
         virtual void Build(void *inTextureData, QT3DSI32 inTextureDataSize,
                            NVRenderTextureFormats::Enum inFormat) = 0;
 
+        // The optional job system spreads CPU filtering over its workers.
         static Qt3DSRenderPrefilterTexture *Create(NVRenderContext *inNVRenderContext, QT3DSI32 inWidth,
                                                  QT3DSI32 inHeight, NVRenderTexture2D &inTexture,
                                                  NVRenderTextureFormats::Enum inDestFormat,
-                                                 qt3ds::NVFoundationBase &inFnd);
+                                                 qt3ds::NVFoundationBase &inFnd,
+                                                 IJobSystem *inJobSystem = nullptr);
 
     protected:
         NVFoundationBase &m_Foundation; ///< Foundation class for allocations and other base things
@@ -81,17 +83,27 @@ namespace render {
         Qt3DSRenderPrefilterTextureCPU(NVRenderContext *inNVRenderContext, QT3DSI32 inWidth,
                                      QT3DSI32 inHeight, NVRenderTexture2D &inTexture,
                                      NVRenderTextureFormats::Enum inDestFormat,
-                                     qt3ds::NVFoundationBase &inFnd);
+                                     qt3ds::NVFoundationBase &inFnd,
+                                     IJobSystem *inJobSystem = nullptr);
 
+        // Filtered mip chains are cached in the directory named by the
+        // QT3DS_IBL_CACHE_DIR environment variable, keyed by a hash of the source image.
         void Build(void *inTextureData, QT3DSI32 inTextureDataSize,
                    NVRenderTextureFormats::Enum inFormat) override;
 
-        STextureData CreateBsdfMipLevel(STextureData &inCurMipLevel, STextureData &inPrevMipLevel,
-                                        QT3DSI32 width, QT3DSI32 height);
+        // Filters the previous level, decoded to RGBA floats, into the next mip level. The
+        // level is encoded to inFormat into outLevel and decoded back into outFloats, so the
+        // next level is filtered from the same data that gets uploaded.
+        void CreateBsdfMipLevel(const float *inPrevLevel, QT3DSI32 width, QT3DSI32 height,
+                                NVRenderTextureFormats::Enum inFormat, QT3DSU8 *outLevel,
+                                float *outFloats);
         QT3DS_IMPLEMENT_REF_COUNT_ADDREF_RELEASE_OVERRIDE(m_Foundation)
 
-        int wrapMod(int a, int base);
-        void getWrappedCoords(int &sX, int &sY, int width, int height);
+    private:
+        bool LoadCachedMipChain(const QString &inCacheFile, NVRenderTextureFormats::Enum inFormat);
+        void SaveCachedMipChain(const QString &inCacheFile, const QByteArray &inMipChain);
+
+        IJobSystem *m_JobSystem;
     };
 
     class Qt3DSRenderPrefilterTextureCompute : public Qt3DSRenderPrefilterTexture
@@ -0,0 +1,149 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qt 3D Studio.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#pragma once
+
+#include "Qt3DSTypes.h"
+#include "Qt3DSBezierEval.h"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define QT3DS_BEZIER_BAKE_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define QT3DS_BEZIER_BAKE_NEON
+#endif
+
+//==============================================================================
+//	Baked bezier keyframes
+//
+//	A baked segment replaces the per-frame cubic root solve of
+//	EvaluateBezierKeyframe with a table of values sampled at a fixed rate over
+//	the segment, so that evaluation becomes a table lookup and a lerp.
+//==============================================================================
+namespace Q3DStudio {
+
+const FLOAT BAKED_SAMPLE_INTERVAL = 4.0f; ///< Milliseconds between baked samples
+const UINT32 BAKED_MIN_INTERVALS = 4; ///< Minimum number of sample intervals per segment
+const UINT32 BAKED_MAX_INTERVALS = 256; ///< Maximum number of sample intervals per segment
+const UINT32 BAKED_BATCH_SIZE = 64; ///< Number of tracks evaluated per SoA batch
+
+//==============================================================================
+/**
+ *	Number of sample intervals used to bake a segment between two key times.
+ *	The segment holds one more sample than this, both end keys included.
+ */
+inline UINT32 GetBakedIntervalCount(FLOAT inTime1, FLOAT inTime2)
+{
+    FLOAT theDuration = inTime2 - inTime1;
+    if (theDuration <= 0.0f)
+        return BAKED_MIN_INTERVALS;
+    UINT32 theCount = static_cast<UINT32>(theDuration / BAKED_SAMPLE_INTERVAL) + 1;
+    return qBound(BAKED_MIN_INTERVALS, theCount, BAKED_MAX_INTERVALS);
+}
+
+//==============================================================================
+/**
+ *	Same as EvaluateBezierKeyframe, but without truncating the times to whole
+ *	milliseconds so that sample points between frames can be evaluated.
+ */
+inline FLOAT EvaluateBezierKeyframeAt(double inTime, FLOAT inTime1, FLOAT inValue1,
+                                      FLOAT inC1Time, FLOAT inC1Value, FLOAT inC2Time,
+                                      FLOAT inC2Value, FLOAT inTime2, FLOAT inValue2)
+{
+    if (inTime <= inTime1)
+        return inValue1;
+
+    if (inTime >= inTime2)
+        return inValue2;
+
+    CubicPolynomial thePolynomial(inTime1 - inTime, inC1Time - inTime, inC2Time - inTime,
+                                  inTime2 - inTime);
+
+    // Allow for a small amount of numerical error around the segment ends
+    const double theEpsilon = 1e-6;
+    for (double t : thePolynomial.roots()) {
+        if (t < -theEpsilon || t > 1.0 + theEpsilon)
+            continue;
+        return FLOAT(evaluateForT(qBound(0.0, t, 1.0), inValue1, inC1Value, inC2Value,
+                                  inValue2));
+    }
+
+    // Degenerate curve, fall back to linear interpolation
+    double theFraction = (inTime - inTime1) / (inTime2 - inTime1);
+    return FLOAT(inValue1 + (inValue2 - inValue1) * theFraction);
+}
+
+//==============================================================================
+/**
+ *	Samples a bezier segment at inIntervalCount + 1 evenly spaced times.
+ *	@param outSamples		receives inIntervalCount + 1 values
+ */
+inline void BakeBezierKeyframe(FLOAT *outSamples, UINT32 inIntervalCount, FLOAT inTime1,
+                               FLOAT inValue1, FLOAT inC1Time, FLOAT inC1Value, FLOAT inC2Time,
+                               FLOAT inC2Value, FLOAT inTime2, FLOAT inValue2)
+{
+    const double theStep = (double(inTime2) - double(inTime1)) / inIntervalCount;
+    outSamples[0] = inValue1;
+    for (UINT32 idx = 1; idx < inIntervalCount; ++idx) {
+        outSamples[idx] = EvaluateBezierKeyframeAt(inTime1 + theStep * idx, inTime1, inValue1,
+                                                   inC1Time, inC1Value, inC2Time, inC2Value,
+                                                   inTime2, inValue2);
+    }
+    outSamples[inIntervalCount] = inValue2;
+}
+
+//==============================================================================
+/**
+ *	Evaluates a batch of baked lookups stored as structure of arrays:
+ *	outValues[i] = inLow[i] + (inHigh[i] - inLow[i]) * inFraction[i]
+ */
+inline void EvaluateBakedBatch(const FLOAT *inLow, const FLOAT *inHigh, const FLOAT *inFraction,
+                               FLOAT *outValues, UINT32 inCount)
+{
+    UINT32 idx = 0;
+#if defined(QT3DS_BEZIER_BAKE_SSE)
+    for (; idx + 4 <= inCount; idx += 4) {
+        __m128 theLow = _mm_loadu_ps(inLow + idx);
+        __m128 theDelta = _mm_sub_ps(_mm_loadu_ps(inHigh + idx), theLow);
+        __m128 theResult = _mm_add_ps(theLow, _mm_mul_ps(theDelta, _mm_loadu_ps(inFraction + idx)));
+        _mm_storeu_ps(outValues + idx, theResult);
+    }
+#elif defined(QT3DS_BEZIER_BAKE_NEON)
+    for (; idx + 4 <= inCount; idx += 4) {
+        float32x4_t theLow = vld1q_f32(inLow + idx);
+        float32x4_t theDelta = vsubq_f32(vld1q_f32(inHigh + idx), theLow);
+        vst1q_f32(outValues + idx, vmlaq_f32(theLow, theDelta, vld1q_f32(inFraction + idx)));
+    }
+#endif
+    for (; idx < inCount; ++idx)
+        outValues[idx] = inLow[idx] + (inHigh[idx] - inLow[idx]) * inFraction[idx];
+}
+
+} // namespace Q3DStudio
@@ -28,6 +28,8 @@
 **
 ****************************************************************************/
 
+#pragma once
+
 #include <vector>
 #include <QtCore/qglobal.h>
 #include <QtCore/qmath.h>
@@ -148,7 +148,9 @@ public: // Parse UIP file
 
     virtual QVector<QString> GetSlideSourcePaths() const = 0;
 
-    // Creation function
+    // Creation function. Creation only reads and parses the file, which may be done on a loader
+    // thread as long as the meta data string table has multithreaded access enabled; Load must
+    // run on the thread owning the presentation.
     static IUIPParser &Create(const QString &inFileName, IRuntimeMetaData &inMetaData,
                               qt3ds::render::IInputStreamFactory &inStreamFactory,
                               qt3ds::foundation::IStringTable &inStrTable);
@@ -497,9 +497,10 @@ CUIPParserImpl::CUIPParserImpl(const QString &inFileName, IRuntimeMetaData &inMe
         }
     }
 
-    // Create Helper class
-    m_ObjectRefHelper = new CUIPParserObjectRefHelper(m_MetaData);
-    m_ActionHelper = new CUIPParserActionHelper(this, m_ObjectRefHelper, m_MetaData);
+    // The helper classes query the meta data, which is not thread safe, so they are created in
+    // Load. This lets the file be read and parsed on a loader thread.
+    m_ActionHelper = NULL;
+    m_ObjectRefHelper = NULL;
 }
 
 //==============================================================================
@@ -527,6 +528,10 @@ BOOL CUIPParserImpl::Load(IPresentation &inPresentation,
                           bool initInRenderThread)
 {
     m_CurrentPresentation = &inPresentation;
+    if (!m_ObjectRefHelper) {
+        m_ObjectRefHelper = new CUIPParserObjectRefHelper(m_MetaData);
+        m_ActionHelper = new CUIPParserActionHelper(this, m_ObjectRefHelper, m_MetaData);
+    }
     if (!m_DOMReader) {
         qCCritical(qt3ds::INVALID_PARAMETER) << "CUIPParserImpl::Load, No DOM reader";
         return FALSE;
@@ -578,6 +578,19 @@ bool Q3DSViewerApp::WasLastFrameDirty()
     return false;
 }
 
+bool Q3DSViewerApp::WasLastFrameSkipped()
+{
+    if (m_Impl.m_view)
+        return m_Impl.m_view->WasLastFrameSkipped();
+    return false;
+}
+
+void Q3DSViewerApp::RequestRender()
+{
+    if (m_Impl.m_view)
+        m_Impl.m_view->RequestRender();
+}
+
 QString Q3DSViewerApp::error()
 {
     QString error = m_Impl.m_error;
@@ -769,6 +782,31 @@ void Q3DSViewerApp::SetAttribute(const char *elementPath, const char *attributeN
     m_Impl.m_view->SetAttribute(elementPath, attributeName, value);
 }
 
+void Q3DSViewerApp::RegisterAttributeHandle(int handle, const char *elementPath,
+                                            const char *attributeName)
+{
+    if (!m_Impl.m_view)
+        return;
+
+    m_Impl.m_view->RegisterAttributeHandle(handle, elementPath, attributeName);
+}
+
+void Q3DSViewerApp::ReleaseAttributeHandle(int handle)
+{
+    if (!m_Impl.m_view)
+        return;
+
+    m_Impl.m_view->ReleaseAttributeHandle(handle);
+}
+
+void Q3DSViewerApp::SetAttributeHandleValues(const int *handles, const float *values, int count)
+{
+    if (!m_Impl.m_view)
+        return;
+
+    m_Impl.m_view->SetAttributeHandleValues(handles, values, count);
+}
+
 bool Q3DSViewerApp::GetAttribute(const char *elementPath, const char *attributeName, void *value)
 {
     if (!m_Impl.m_view)
@@ -892,6 +930,12 @@ void Q3DSViewerApp::SetSkipFramesInterval(int interval)
         m_Impl.m_view->GetTegraRenderEngine()->SetSkipFramesInterval(interval);
 }
 
+void Q3DSViewerApp::SetRenderOnDemand(bool enable)
+{
+    if (m_Impl.m_view && m_Impl.m_view->GetTegraRenderEngine())
+        m_Impl.m_view->GetTegraRenderEngine()->SetRenderOnDemand(enable);
+}
+
 void Q3DSViewerApp::setMatteColor(const QColor &color)
 {
     if (m_Impl.m_view && m_Impl.m_view->GetTegraRenderEngine()) {
@@ -329,6 +329,7 @@ public:
     bool GetStereoProgressiveEnabled() const;
 
     void SetSkipFramesInterval(int interval);
+    void SetRenderOnDemand(bool enable);
 
     void setMatteColor(const QColor &color);
     void setShowOnScreenStats(bool s);
@@ -431,6 +432,29 @@ public:
     */
     void SetAttribute(const char *elementPath, const char *attributeName, const char *value);
 
+    /*
+    * @brief Register a handle for writing float attribute values without path lookups
+    *
+    * @param[in] handle			handle id
+    * @param[in] elementPath	where to find the element
+    * @param[in] attributeName	attribute name, vectors and colors are expanded to components
+    *
+    * @return no return
+    */
+    void RegisterAttributeHandle(int handle, const char *elementPath, const char *attributeName);
+    void ReleaseAttributeHandle(int handle);
+
+    /*
+    * @brief Set attribute values through handles
+    *
+    * @param[in] handles		registered attribute handles
+    * @param[in] values			four floats per handle
+    * @param[in] count			number of handles
+    *
+    * @return no return
+    */
+    void SetAttributeHandleValues(const int *handles, const float *values, int count);
+
     /*
     * @brief Get attribute values
     *
@@ -476,6 +500,8 @@ public:
                                 const qml_Function inCallback, void *inUserData);
 
     bool WasLastFrameDirty();
+    bool WasLastFrameSkipped();
+    void RequestRender();
 
     int GetWindowHeight();
     int GetWindowWidth();
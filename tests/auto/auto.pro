@@ -1,6 +1,14 @@
 TEMPLATE = subdirs
 CONFIG += ordered
 
+SUBDIRS += \
+    backendrecorder \
+    binaryscene \
+    jobsystem \
+    runtimeview \
+    shadercache \
+    texttexturecache
+
 #!macos:!win32: SUBDIRS += \
 #    qtextras
 
@@ -0,0 +1,155 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qt 3D Studio.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include "foundation/TrackingAllocator.h"
+#include "foundation/Qt3DSFoundation.h"
+#include "render/backends/recorder/Qt3DSRenderBackendRecorder.h"
+#include "render/backends/software/Qt3DSRenderBackendNULL.h"
+
+using namespace qt3ds;
+using namespace qt3ds::foundation;
+using namespace qt3ds::render;
+
+class tst_backendrecorder : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+    void init();
+    void cleanup();
+    void redundantCallsAreDropped();
+    void stateObjectShadowsAreReset();
+
+private:
+    CAllocator m_allocator;
+    NVFoundation *m_foundation = nullptr;
+    NVRenderBackendRecorder *m_recorder = nullptr;
+};
+
+void tst_backendrecorder::initTestCase()
+{
+    m_foundation = NVCreateFoundation(QT3DS_FOUNDATION_VERSION, m_allocator);
+    QVERIFY(m_foundation);
+}
+
+void tst_backendrecorder::cleanupTestCase()
+{
+    m_foundation->release();
+}
+
+void tst_backendrecorder::init()
+{
+    m_recorder = &NVRenderBackendRecorder::CreateRecorder(
+                *m_foundation, NVRenderBackendNULL::CreateBackend(*m_foundation));
+    m_recorder->addRef();
+}
+
+void tst_backendrecorder::cleanup()
+{
+    m_recorder->release();
+    m_recorder = nullptr;
+}
+
+void tst_backendrecorder::redundantCallsAreDropped()
+{
+    NVRenderBackend &backend(*m_recorder);
+    NVRenderBackend::NVRenderBackendTextureObject texture =
+            reinterpret_cast<NVRenderBackend::NVRenderBackendTextureObject>(size_t(1));
+    NVRenderBackend::NVRenderBackendShaderProgramObject program =
+            reinterpret_cast<NVRenderBackend::NVRenderBackendShaderProgramObject>(size_t(1));
+    const QT3DSU8 pixels[4 * 4 * 4] = {};
+    const QT3DSVec4 color(1.0f, 0.0f, 0.0f, 1.0f);
+
+    backend.SetDepthWrite(true);
+    backend.SetDepthWrite(true);
+    backend.SetViewportRect(NVRenderRect(0, 0, 640, 480));
+    backend.SetViewportRect(NVRenderRect(0, 0, 640, 480));
+    backend.BindTexture(texture, NVRenderTextureTargetType::Texture2D, 0);
+    backend.BindTexture(texture, NVRenderTextureTargetType::Texture2D, 0);
+    // uploads bind the texture themselves
+    backend.SetTextureData2D(texture, NVRenderTextureTargetType::Texture2D, 0,
+                             NVRenderTextureFormats::RGBA8, 4, 4, 0,
+                             NVRenderTextureFormats::RGBA8, pixels);
+    backend.BindTexture(texture, NVRenderTextureTargetType::Texture2D, 0);
+    backend.SetConstantValue(program, 0, NVRenderShaderDataTypes::QT3DSVec4, 1, &color, false);
+    backend.SetConstantValue(program, 0, NVRenderShaderDataTypes::QT3DSVec4, 1, &color, false);
+    backend.Draw(NVRenderDrawMode::Triangles, 0, 3);
+    backend.InvalidateStateCache();
+    backend.SetDepthWrite(true);
+    backend.EndFrame();
+
+    NVRenderBackendRecorder::SFrameStatistics stats = m_recorder->GetFrameStatistics();
+    QCOMPARE(stats.m_Calls, QT3DSU32(12));
+    QCOMPARE(stats.m_RedundantCalls, QT3DSU32(4));
+    QCOMPARE(stats.m_DrawCalls, QT3DSU32(1));
+    QCOMPARE(stats.m_UploadedBytes, QT3DSU64(sizeof(pixels) + sizeof(color)));
+
+    // every forwarded call that carries arguments is issued again
+    NVScopedRefCounted<NVRenderBackend> target = NVRenderBackendNULL::CreateBackend(*m_foundation);
+    QCOMPARE(NVRenderBackendRecorder::Replay(*target, m_recorder->GetFrameCommands()),
+             QT3DSU32(7));
+
+    // shadowed state does not survive the frame
+    backend.SetDepthWrite(true);
+    backend.EndFrame();
+    QCOMPARE(m_recorder->GetFrameStatistics().m_RedundantCalls, QT3DSU32(0));
+}
+
+// Individual depth state calls and released objects reset the state object shadows
+void tst_backendrecorder::stateObjectShadowsAreReset()
+{
+    NVRenderBackend &backend(*m_recorder);
+    NVRenderBackend::NVRenderBackendDepthStencilStateObject depthStencilState =
+            reinterpret_cast<NVRenderBackend::NVRenderBackendDepthStencilStateObject>(size_t(1));
+    NVRenderBackend::NVRenderBackendRasterizerStateObject rasterizerState =
+            reinterpret_cast<NVRenderBackend::NVRenderBackendRasterizerStateObject>(size_t(1));
+    backend.SetDepthStencilState(depthStencilState);
+    backend.SetDepthStencilState(depthStencilState);
+    backend.SetDepthWrite(false);
+    backend.SetDepthStencilState(depthStencilState);
+    backend.SetDepthFunc(NVRenderBoolOp::Less);
+    backend.SetDepthStencilState(depthStencilState);
+    backend.SetRenderState(false, NVRenderState::DepthTest);
+    backend.SetDepthStencilState(depthStencilState);
+    backend.ReleaseDepthStencilState(depthStencilState);
+    backend.SetDepthStencilState(depthStencilState);
+    backend.SetRasterizerState(rasterizerState);
+    backend.SetRasterizerState(rasterizerState);
+    backend.ReleaseRasterizerState(rasterizerState);
+    backend.SetRasterizerState(rasterizerState);
+    backend.EndFrame();
+    QCOMPARE(m_recorder->GetFrameStatistics().m_RedundantCalls, QT3DSU32(2));
+}
+
+QTEST_APPLESS_MAIN(tst_backendrecorder)
+
+#include "tst_backendrecorder.moc"
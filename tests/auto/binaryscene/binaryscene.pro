@@ -0,0 +1,22 @@
+TEMPLATE = app
+CONFIG += testcase
+include($$PWD/../../../commoninclude.pri)
+
+TARGET = tst_binaryscene
+QT += testlib gui
+
+SOURCES += \
+    tst_binaryscene.cpp
+
+LIBS += \
+    -lqt3dsopengl$$qtPlatformTargetSuffix()
+
+win32 {
+    LIBS += \
+        -lws2_32
+}
+
+linux {
+    LIBS += \
+        -ldl
+}
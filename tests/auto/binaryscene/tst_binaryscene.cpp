@@ -0,0 +1,249 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qt 3D Studio.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtCore/qfile.h>
+#include <QtCore/qtemporarydir.h>
+#include <QtGui/qguiapplication.h>
+#include <QtGui/qsurfaceformat.h>
+#include "foundation/SerializationTypes.h"
+#include "Qt3DSRenderRuntimeBinding.h"
+#include "Qt3DSRenderContextCore.h"
+#include "Qt3DSRenderGraphObjectSerializer.h"
+#include "Qt3DSRenderBufferLoader.h"
+#include "Qt3DSRenderPresentation.h"
+#include "Qt3DSRenderScene.h"
+#include "Qt3DSRenderLayer.h"
+#include "Qt3DSRenderModel.h"
+#include "Qt3DSRenderDefaultMaterial.h"
+#include "Qt3DSSceneManager.h"
+#include "Qt3DSWindowSystem.h"
+#include "Qt3DSTimer.h"
+#include "../runtime/Qt3DSRenderTestNullBackend.h"
+
+using namespace qt3ds;
+using namespace qt3ds::foundation;
+using namespace qt3ds::render;
+
+// Saves a small scene graph in the binary scene format and loads it back through the scene
+// loader of the runtime, mapped and read.
+
+class tst_binaryscene : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+    void mappedLoad();
+    void readLoad();
+    void rejectsBrokenHeaders();
+    void checksumIsOptIn();
+
+private:
+    QByteArray saveScene();
+    QString writeFile(const QString &name, const QByteArray &data);
+    QT3DSU32 loadMapped(const QString &path);
+
+    SNullBackendTimeProvider m_timeProvider;
+    SNullBackendWindowSystem m_windowSystem;
+    NVScopedRefCounted<IQt3DSRenderFactoryCore> m_coreFactory;
+    IQt3DSRenderFactory *m_factory = nullptr;
+    QTemporaryDir m_dir;
+};
+
+void tst_binaryscene::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+    m_coreFactory = &IQt3DSRenderFactoryCore::CreateRenderFactoryCore("", m_windowSystem,
+                                                                      m_timeProvider);
+    m_factory = &m_coreFactory->CreateRenderFactory(QSurfaceFormat::defaultFormat(), false);
+}
+
+void tst_binaryscene::cleanupTestCase()
+{
+    m_factory = nullptr;
+    m_coreFactory = nullptr;
+}
+
+// Presentation, scene, layer and a model with a default material, saved the way
+// ISceneManager::BinarySave does but without translators.
+QByteArray tst_binaryscene::saveScene()
+{
+    IQt3DSRenderContext &context(m_factory->GetQt3DSRenderContext());
+    SPresentation presentation;
+    SScene scene;
+    SLayer layer;
+    SModel model;
+    SDefaultMaterial material;
+    presentation.m_Scene = &scene;
+    scene.m_Presentation = &presentation;
+    scene.m_FirstChild = &layer;
+    layer.m_Scene = &scene;
+    layer.m_FirstChild = &model;
+    model.m_Parent = &layer;
+    model.m_Position = QT3DSVec3(1.0f, 2.0f, 3.0f);
+    model.m_FirstMaterial = &material;
+    material.m_Parent = &model;
+
+    SWriteBuffer buffer(context.GetAllocator(), "tst_binaryscene::buffer");
+    SPtrOffsetMap offsets(context.GetAllocator(), "tst_binaryscene::offsets");
+    buffer.writeZeros(sizeof(SBinarySceneHeader));
+    const QT3DSU32 dataSectionStart = buffer.size();
+    SGraphObjectSerializer::Save(context.GetFoundation(), presentation, buffer,
+                                 context.GetDynamicObjectSystem(), context.GetPathManager(),
+                                 offsets, context.GetStringTable());
+    buffer.align(sizeof(void *));
+    const QT3DSU32 translatorOffset = buffer.size() - dataSectionStart;
+    buffer.writeZeros(4); // translator count
+    reinterpret_cast<SBinarySceneHeader *>(buffer.begin())->Finalize(
+                toConstDataRef(buffer.begin() + dataSectionStart,
+                               buffer.size() - dataSectionStart),
+                translatorOffset);
+    return QByteArray(reinterpret_cast<const char *>(buffer.begin()), int(buffer.size()));
+}
+
+QString tst_binaryscene::writeFile(const QString &name, const QByteArray &data)
+{
+    const QString path = m_dir.filePath(name);
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size())
+        return QString();
+    return path;
+}
+
+QT3DSU32 tst_binaryscene::loadMapped(const QString &path)
+{
+    IStringTable &strings(m_factory->GetStringTable());
+    NVScopedRefCounted<ILoadedBuffer> buffer = ILoadedBuffer::CreateMapped(
+                m_factory->GetFoundation(), strings.RegisterStr(path));
+    if (!buffer)
+        return 0;
+    return m_factory->GetSceneLoader().LoadSceneStage1(strings.RegisterStr(m_dir.path()),
+                                                       *buffer);
+}
+
+void tst_binaryscene::mappedLoad()
+{
+    const QByteArray data = saveScene();
+    const QString path = writeFile(QStringLiteral("mapped.uibsg"), data);
+    QVERIFY(!path.isEmpty());
+    QVERIFY(loadMapped(path) != 0);
+
+    // The graph is used in place, pointer fixups stay private to the mapping.
+    IQt3DSRenderContext &context(m_factory->GetQt3DSRenderContext());
+    NVScopedRefCounted<ILoadedBuffer> buffer = ILoadedBuffer::CreateMapped(
+                context.GetFoundation(), context.GetStringTable().RegisterStr(path));
+    QVERIFY(buffer);
+    NVDataRef<QT3DSU8> file(buffer->Data());
+    const SBinarySceneHeader *header =
+            SBinarySceneHeader::Validate(file, true, buffer->Path().c_str());
+    QVERIFY(header);
+    SPresentation *presentation = SGraphObjectSerializer::Load(
+                toDataRef(file.begin() + sizeof(SBinarySceneHeader), header->m_TranslatorOffset),
+                NVDataRef<QT3DSU8>(), context.GetDynamicObjectSystem(), context.GetPathManager(),
+                context.GetAllocator(), "");
+    QVERIFY(presentation);
+    QVERIFY(presentation->m_Scene);
+    SLayer *layer = presentation->m_Scene->m_FirstChild;
+    QVERIFY(layer);
+    QCOMPARE(layer->m_Type, GraphObjectTypes::Layer);
+    QCOMPARE(layer->m_Scene, presentation->m_Scene);
+    QVERIFY(layer->m_FirstChild);
+    QCOMPARE(layer->m_FirstChild->m_Type, GraphObjectTypes::Model);
+    SModel *model = static_cast<SModel *>(layer->m_FirstChild);
+    QCOMPARE(model->m_Parent, static_cast<SNode *>(layer));
+    QCOMPARE(model->m_Position, QT3DSVec3(1.0f, 2.0f, 3.0f));
+    QVERIFY(model->m_FirstMaterial);
+    QCOMPARE(model->m_FirstMaterial->m_Type, GraphObjectTypes::DefaultMaterial);
+    QCOMPARE(static_cast<SDefaultMaterial *>(model->m_FirstMaterial)->m_Parent, model);
+    QVERIFY(reinterpret_cast<QT3DSU8 *>(model) > file.begin()
+            && reinterpret_cast<QT3DSU8 *>(model) < file.end());
+
+    QFile onDisk(path);
+    QVERIFY(onDisk.open(QIODevice::ReadOnly));
+    QCOMPARE(onDisk.readAll(), data);
+}
+
+void tst_binaryscene::readLoad()
+{
+    const QByteArray data = saveScene();
+    const QString path = writeFile(QStringLiteral("read.uibsg"), data);
+    QVERIFY(!path.isEmpty());
+
+    IStringTable &strings(m_factory->GetStringTable());
+    NVScopedRefCounted<ILoadedBuffer> buffer = ILoadedBuffer::CreateRead(
+                m_factory->GetFoundation(), strings.RegisterStr(path));
+    QVERIFY(buffer);
+    QCOMPARE(buffer->Data().size(), QT3DSU32(data.size()));
+    QVERIFY(memcmp(buffer->Data().begin(), data.constData(), size_t(data.size())) == 0);
+    QVERIFY(m_factory->GetSceneLoader().LoadSceneStage1(strings.RegisterStr(m_dir.path()),
+                                                        *buffer) != 0);
+
+    QVERIFY(!ILoadedBuffer::CreateRead(m_factory->GetFoundation(),
+                                       strings.RegisterStr(m_dir.filePath("missing.uibsg"))));
+}
+
+void tst_binaryscene::rejectsBrokenHeaders()
+{
+    const QByteArray data = saveScene();
+
+    QByteArray wrongTag = data;
+    wrongTag[0] = char(wrongTag[0] ^ 0xff);
+    QCOMPARE(loadMapped(writeFile(QStringLiteral("tag.uibsg"), wrongTag)), QT3DSU32(0));
+
+    QByteArray wrongVersion = data;
+    reinterpret_cast<SBinarySceneHeader *>(wrongVersion.data())->m_HeaderVersion += 1;
+    QCOMPARE(loadMapped(writeFile(QStringLiteral("version.uibsg"), wrongVersion)), QT3DSU32(0));
+
+    QCOMPARE(loadMapped(writeFile(QStringLiteral("truncated.uibsg"), data.left(data.size() - 4))),
+             QT3DSU32(0));
+    QCOMPARE(loadMapped(writeFile(QStringLiteral("header.uibsg"),
+                                  data.left(int(sizeof(SBinarySceneHeader)) - 1))),
+             QT3DSU32(0));
+    QCOMPARE(loadMapped(m_dir.filePath(QStringLiteral("missing.uibsg"))), QT3DSU32(0));
+}
+
+void tst_binaryscene::checksumIsOptIn()
+{
+    // Damage the translator count, which stage 1 doesn't read.
+    QByteArray corrupt = saveScene();
+    corrupt[corrupt.size() - 1] = char(corrupt[corrupt.size() - 1] ^ 0x01);
+    const QString path = writeFile(QStringLiteral("corrupt.uibsg"), corrupt);
+    QVERIFY(!path.isEmpty());
+
+    QVERIFY(loadMapped(path) != 0);
+    qputenv("QT3DS_VERIFY_BINARY_SCENES", "1");
+    QCOMPARE(loadMapped(path), QT3DSU32(0));
+    qunsetenv("QT3DS_VERIFY_BINARY_SCENES");
+}
+
+QT3DS_NULL_BACKEND_TEST_MAIN(tst_binaryscene)
+
+#include "tst_binaryscene.moc"
@@ -0,0 +1,230 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qt 3D Studio.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtCore/qatomic.h>
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qthread.h>
+#include "foundation/TrackingAllocator.h"
+#include "foundation/Qt3DSFoundation.h"
+#include "Qt3DSRenderJobSystem.h"
+
+using namespace qt3ds;
+using namespace qt3ds::foundation;
+using namespace qt3ds::render;
+
+namespace {
+
+const int workerCount = 2;
+
+struct SCounter
+{
+    QAtomicInt m_Count;
+};
+
+void countJob(void *inUserData)
+{
+    reinterpret_cast<SCounter *>(inUserData)->m_Count.fetchAndAddOrdered(1);
+}
+
+struct SThreadRecord
+{
+    QAtomicPointer<QThread> m_MainThread;
+    QAtomicInt m_RunOnMainThread;
+    QAtomicInt m_Count;
+};
+
+void recordThreadJob(void *inUserData)
+{
+    SThreadRecord &theRecord(*reinterpret_cast<SThreadRecord *>(inUserData));
+    if (QThread::currentThread() == theRecord.m_MainThread.loadAcquire())
+        theRecord.m_RunOnMainThread.fetchAndAddOrdered(1);
+    QThread::usleep(200);
+    theRecord.m_Count.fetchAndAddOrdered(1);
+}
+
+void sleepJob(void *inUserData)
+{
+    QThread::msleep(50);
+    countJob(inUserData);
+}
+
+struct SRangeRecord
+{
+    QVector<int> m_Visits;
+};
+
+void visitRange(void *inUserData, QT3DSU32 inBegin, QT3DSU32 inEnd)
+{
+    SRangeRecord &theRecord(*reinterpret_cast<SRangeRecord *>(inUserData));
+    for (QT3DSU32 idx = inBegin; idx < inEnd; ++idx)
+        ++theRecord.m_Visits[int(idx)];
+}
+
+struct SNestedJob
+{
+    IJobSystem *m_JobSystem;
+    SCounter m_Counter;
+};
+
+void nestedJob(void *inUserData)
+{
+    SNestedJob &theJob(*reinterpret_cast<SNestedJob *>(inUserData));
+    SJobGroup theGroup;
+    for (int i = 0; i < 16; ++i)
+        theJob.m_JobSystem->Run(&theGroup, &theJob.m_Counter, countJob);
+    theJob.m_JobSystem->Wait(theGroup);
+}
+
+}
+
+class tst_jobsystem : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+    void runAndWait();
+    void continuation();
+    void parallelForVisitsEveryIndexOnce();
+    void nestedWait();
+    void waitBlocksForLongJobs();
+    void waitDoesNotRunOtherJobs();
+
+private:
+    CAllocator m_allocator;
+    NVFoundation *m_foundation = nullptr;
+    IJobSystem *m_jobSystem = nullptr;
+};
+
+void tst_jobsystem::initTestCase()
+{
+    m_foundation = NVCreateFoundation(QT3DS_FOUNDATION_VERSION, m_allocator);
+    QVERIFY(m_foundation);
+    m_jobSystem = &IJobSystem::CreateJobSystem(*m_foundation, workerCount);
+    m_jobSystem->addRef();
+    QCOMPARE(m_jobSystem->GetWorkerCount(), QT3DSU32(workerCount));
+}
+
+void tst_jobsystem::cleanupTestCase()
+{
+    m_jobSystem->release();
+    m_foundation->release();
+}
+
+void tst_jobsystem::runAndWait()
+{
+    SCounter theCounter;
+    SJobGroup theGroup;
+    for (int i = 0; i < 1000; ++i)
+        m_jobSystem->Run(&theGroup, &theCounter, countJob);
+    m_jobSystem->Wait(theGroup);
+    QVERIFY(theGroup.IsDone());
+    QCOMPARE(theCounter.m_Count.loadAcquire(), 1000);
+}
+
+void tst_jobsystem::continuation()
+{
+    SCounter theJobs;
+    SCounter theContinuations;
+    SJobGroup theGroup;
+    for (int i = 0; i < 100; ++i)
+        m_jobSystem->Run(&theGroup, &theJobs, countJob);
+    m_jobSystem->Then(theGroup, &theContinuations, countJob);
+    m_jobSystem->Wait(theGroup);
+    QCOMPARE(theJobs.m_Count.loadAcquire(), 100);
+    QCOMPARE(theContinuations.m_Count.loadAcquire(), 1);
+}
+
+void tst_jobsystem::parallelForVisitsEveryIndexOnce()
+{
+    SRangeRecord theRecord;
+    theRecord.m_Visits.fill(0, 10000);
+    m_jobSystem->ParallelFor(QT3DSU32(theRecord.m_Visits.size()), 7, &theRecord, visitRange);
+    for (int visits : qAsConst(theRecord.m_Visits))
+        QCOMPARE(visits, 1);
+}
+
+// Jobs waiting on jobs they started must not deadlock even when every worker does so.
+void tst_jobsystem::nestedWait()
+{
+    SNestedJob theJobs[workerCount * 4];
+    SJobGroup theGroup;
+    for (SNestedJob &theJob : theJobs) {
+        theJob.m_JobSystem = m_jobSystem;
+        m_jobSystem->Run(&theGroup, &theJob, nestedJob);
+    }
+    m_jobSystem->Wait(theGroup);
+    for (SNestedJob &theJob : theJobs)
+        QCOMPARE(theJob.m_Counter.m_Count.loadAcquire(), 16);
+}
+
+void tst_jobsystem::waitBlocksForLongJobs()
+{
+    SCounter theCounter;
+    SJobGroup theGroup;
+    QElapsedTimer theTimer;
+    theTimer.start();
+    m_jobSystem->Run(&theGroup, &theCounter, sleepJob);
+    m_jobSystem->Wait(theGroup);
+    QCOMPARE(theCounter.m_Count.loadAcquire(), 1);
+    QVERIFY(theTimer.elapsed() >= 45);
+    // Waking up on completion rather than polling keeps the wait close to the job time.
+    QVERIFY(theTimer.elapsed() < 1000);
+}
+
+// The render thread waiting on its own jobs must not execute unrelated work queued by other
+// parts of the runtime.
+void tst_jobsystem::waitDoesNotRunOtherJobs()
+{
+    SThreadRecord theOther;
+    theOther.m_MainThread.storeRelease(QThread::currentThread());
+    const int otherCount = 200;
+    for (int i = 0; i < otherCount; ++i)
+        m_jobSystem->Run(nullptr, &theOther, recordThreadJob);
+
+    SCounter theCounter;
+    SJobGroup theGroup;
+    for (int i = 0; i < 100; ++i)
+        m_jobSystem->Run(&theGroup, &theCounter, countJob);
+    m_jobSystem->Wait(theGroup);
+    QCOMPARE(theCounter.m_Count.loadAcquire(), 100);
+
+    SRangeRecord theRecord;
+    theRecord.m_Visits.fill(0, 1000);
+    m_jobSystem->ParallelFor(QT3DSU32(theRecord.m_Visits.size()), 1, &theRecord, visitRange);
+
+    QTRY_COMPARE_WITH_TIMEOUT(theOther.m_Count.loadAcquire(), otherCount, 10000);
+    QCOMPARE(theOther.m_RunOnMainThread.loadAcquire(), 0);
+}
+
+QTEST_APPLESS_MAIN(tst_jobsystem)
+
+#include "tst_jobsystem.moc"
@@ -0,0 +1,75 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qt 3D Studio.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+#ifndef QT3DS_RENDER_TEST_NULL_BACKEND_H
+#define QT3DS_RENDER_TEST_NULL_BACKEND_H
+
+#include <QtTest/QtTest>
+#include <QtGui/qguiapplication.h>
+#include "Qt3DSWindowSystem.h"
+#include "Qt3DSTimer.h"
+
+// Helpers for tests and benchmarks that run the whole runtime on the NULL render backend, so
+// that they need neither a GPU nor a window.
+
+namespace qt3ds {
+namespace render {
+
+    struct SNullBackendTimeProvider : public Q3DStudio::ITimeProvider
+    {
+        Q3DStudio::INT64 GetCurrentTimeMicroSeconds() override { return 0; }
+    };
+
+    struct SNullBackendWindowSystem : public Q3DStudio::IWindowSystem
+    {
+        QSize m_size = QSize(1280, 720);
+
+        QSize GetWindowDimensions() override { return m_size; }
+        void SetWindowDimensions(const QSize &inSize) override { m_size = inSize; }
+        Q3DStudio::SEGLInfo *GetEGLInfo() override { return nullptr; }
+        int GetDefaultRenderTargetID() override { return 0; }
+        int GetDepthBitCount() override { return 24; }
+    };
+
+}
+}
+
+// Like QTEST_MAIN, but selects the NULL render backend and the offscreen platform. Both have
+// to be set before the application and the runtime are created.
+#define QT3DS_NULL_BACKEND_TEST_MAIN(TestObject)                                                \
+    int main(int argc, char *argv[])                                                           \
+    {                                                                                          \
+        qputenv("QT3DS_NULL_RENDER_BACKEND", "1");                                             \
+        if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))                                     \
+            qputenv("QT_QPA_PLATFORM", "offscreen");                                           \
+        QGuiApplication app(argc, argv);                                                       \
+        TestObject tc;                                                                         \
+        QTEST_SET_MAIN_SOURCE_PATH                                                             \
+        return QTest::qExec(&tc, argc, argv);                                                  \
+    }
+
+#endif // QT3DS_RENDER_TEST_NULL_BACKEND_H
@@ -0,0 +1,297 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qt 3D Studio.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtCore/qfile.h>
+#include <QtCore/qtemporarydir.h>
+#include <QtCore/qtextstream.h>
+#include <QtGui/qevent.h>
+#include <QtGui/qsurfaceformat.h>
+#include <QtGui/qvector4d.h>
+#include "Qt3DSRuntimeView.h"
+#include "Qt3DSApplication.h"
+#include "../runtime/Qt3DSRenderTestNullBackend.h"
+
+// Runs a small presentation through IRuntimeView on the NULL render backend and checks the
+// runtime side of the viewer API without a GPU.
+
+namespace {
+
+const int frameIntervalMs = 16;
+// Frames the runtime may take to settle after loading, e.g. for the initial image loads
+const int settleFrames = 10;
+
+// A rectangle with a red material. With inAnimated, the rectangle moves for the whole slide.
+QString writePresentation(const QString &inPath, bool inAnimated)
+{
+    QFile file(inPath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+        return QString();
+    QTextStream out(&file);
+    out << "<?xml version=\"1.0\" encoding=\"UTF-8\" ?>\n"
+        << "<UIP version=\"6\" >\n"
+        << "\t<Project >\n"
+        << "\t\t<ProjectSettings presentationWidth=\"640\" presentationHeight=\"480\" />\n"
+        << "\t\t<Graph >\n"
+        << "\t\t\t<Scene id=\"Scene\" >\n"
+        << "\t\t\t\t<Layer id=\"Layer\" >\n"
+        << "\t\t\t\t\t<Camera id=\"Camera\" />\n"
+        << "\t\t\t\t\t<Light id=\"Light\" />\n"
+        << "\t\t\t\t\t<Model id=\"Rect\" >\n"
+        << "\t\t\t\t\t\t<Material id=\"Material\" />\n"
+        << "\t\t\t\t\t</Model>\n"
+        << "\t\t\t\t</Layer>\n"
+        << "\t\t\t</Scene>\n"
+        << "\t\t</Graph>\n"
+        << "\t\t<Logic >\n"
+        << "\t\t\t<State name=\"Master Slide\" component=\"#Scene\" >\n"
+        << "\t\t\t\t<Add ref=\"#Layer\" name=\"Layer\" />\n"
+        << "\t\t\t\t<Add ref=\"#Camera\" name=\"Camera\" />\n"
+        << "\t\t\t\t<Add ref=\"#Light\" name=\"Light\" />\n"
+        << "\t\t\t\t<Add ref=\"#Rect\" name=\"Rect\" sourcepath=\"#Rectangle\" >\n";
+    if (inAnimated) {
+        out << "\t\t\t\t\t<AnimationTrack property=\"position.x\" type=\"EaseInOut\" >"
+            << "0 -100 100 100 1 100 100 100</AnimationTrack>\n";
+    }
+    out << "\t\t\t\t</Add>\n"
+        << "\t\t\t\t<Add ref=\"#Material\" name=\"Material\" diffuse=\"1 0 0 1\" />\n"
+        << "\t\t\t\t<State id=\"Scene-Slide1\" name=\"Slide1\" playmode=\"Looping\" >\n"
+        << "\t\t\t\t\t<Set ref=\"#Layer\" endtime=\"1000\" />\n"
+        << "\t\t\t\t</State>\n"
+        << "\t\t\t</State>\n"
+        << "\t\t</Logic>\n"
+        << "\t</Project>\n"
+        << "</UIP>\n";
+    return inPath;
+}
+
+}
+
+class tst_runtimeview : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanup();
+    void renderOnDemandSkipsUnchangedFrames();
+    void renderOnDemandRendersAnimations();
+    void attributeHandles();
+    void attributeHandleOfMissingElement();
+
+private:
+    bool load(bool inAnimated);
+    void renderFrame();
+    bool settle();
+    QVector4D diffuse(const char *inElementPath);
+
+    qt3ds::render::SNullBackendTimeProvider m_timeProvider;
+    qt3ds::render::SNullBackendWindowSystem m_windowSystem;
+    QTemporaryDir m_projectDir;
+    Q3DStudio::IRuntimeView *m_view = nullptr;
+    qt3ds::runtime::IApplication *m_application = nullptr;
+    qint64 m_timeMs = 0;
+};
+
+void tst_runtimeview::initTestCase()
+{
+    QVERIFY(m_projectDir.isValid());
+}
+
+void tst_runtimeview::cleanup()
+{
+    if (m_view) {
+        m_view->Cleanup();
+        m_view->release();
+    }
+    m_view = nullptr;
+    m_application = nullptr;
+    m_timeMs = 0;
+}
+
+bool tst_runtimeview::load(bool inAnimated)
+{
+    const QString source = writePresentation(
+                m_projectDir.filePath(inAnimated ? QStringLiteral("animated.uip")
+                                                 : QStringLiteral("static.uip")),
+                inAnimated);
+    if (source.isEmpty())
+        return false;
+
+    m_view = &Q3DStudio::IRuntimeView::Create(m_timeProvider, m_windowSystem);
+    if (!m_view->BeginLoad(source, QStringList()))
+        return false;
+    QString errors;
+    if (!m_view->InitializeGraphics(QSurfaceFormat::defaultFormat(), false, true,
+                                    QByteArray(), errors)) {
+        return false;
+    }
+    m_view->connectSignals();
+    QResizeEvent event(m_windowSystem.m_size, QSize());
+    m_view->HandleMessage(&event);
+
+    m_application = m_view->GetApplication();
+    return m_application != nullptr;
+}
+
+void tst_runtimeview::renderFrame()
+{
+    // Zero means the runtime clock, so manual time starts from the first interval
+    m_timeMs += frameIntervalMs;
+    m_application->SetTimeMilliSecs(m_timeMs);
+    m_view->Render();
+}
+
+// Renders until the first skipped frame
+bool tst_runtimeview::settle()
+{
+    for (int i = 0; i < settleFrames; ++i) {
+        renderFrame();
+        if (m_view->WasLastFrameSkipped())
+            return true;
+    }
+    return false;
+}
+
+void tst_runtimeview::renderOnDemandSkipsUnchangedFrames()
+{
+    QVERIFY(load(false));
+    m_view->GetTegraRenderEngine()->SetRenderOnDemand(true);
+
+    renderFrame();
+    QVERIFY(!m_view->WasLastFrameSkipped());
+    QVERIFY(settle());
+    for (int i = 0; i < 3; ++i) {
+        renderFrame();
+        QVERIFY(m_view->WasLastFrameSkipped());
+    }
+
+    // An attribute change renders one frame
+    const float x = 50.0f;
+    m_view->SetAttribute("Scene.Layer.Rect", "position.x", reinterpret_cast<const char *>(&x));
+    renderFrame();
+    QVERIFY(!m_view->WasLastFrameSkipped());
+    QVERIFY(settle());
+
+    // So does an explicit request
+    m_view->RequestRender();
+    renderFrame();
+    QVERIFY(!m_view->WasLastFrameSkipped());
+    QVERIFY(settle());
+
+    // Without render on demand every frame is rendered
+    m_view->GetTegraRenderEngine()->SetRenderOnDemand(false);
+    for (int i = 0; i < 3; ++i) {
+        renderFrame();
+        QVERIFY(!m_view->WasLastFrameSkipped());
+    }
+}
+
+void tst_runtimeview::renderOnDemandRendersAnimations()
+{
+    QVERIFY(load(true));
+    m_view->GetTegraRenderEngine()->SetRenderOnDemand(true);
+
+    // The animation changes the rectangle every frame of the looping slide
+    for (int i = 0; i < 2 * 1000 / frameIntervalMs; ++i) {
+        renderFrame();
+        QVERIFY(!m_view->WasLastFrameSkipped());
+    }
+}
+
+QVector4D tst_runtimeview::diffuse(const char *inElementPath)
+{
+    QVector4D theColor;
+    const char *components[] = { "diffuse.r", "diffuse.g", "diffuse.b" };
+    for (int i = 0; i < 3; ++i) {
+        float value = -1.0f;
+        if (m_view->GetAttribute(inElementPath, components[i], &value))
+            theColor[i] = value;
+    }
+    theColor[3] = 1.0f;
+    return theColor;
+}
+
+void tst_runtimeview::attributeHandles()
+{
+    QVERIFY(load(false));
+    renderFrame();
+
+    const char *materialPath = "Scene.Layer.Rect.Material";
+    m_view->RegisterAttributeHandle(1, materialPath, "diffuse");
+    m_view->RegisterAttributeHandle(2, "Scene.Layer.Rect", "position");
+    QCOMPARE(diffuse(materialPath), QVector4D(1.0f, 0.0f, 0.0f, 1.0f));
+
+    // Each handle takes four floats, unused components are ignored
+    const int handles[] = { 1, 2 };
+    const float values[] = { 0.0f, 0.0f, 1.0f, 1.0f,
+                             10.0f, 20.0f, 30.0f, 0.0f };
+    m_view->SetAttributeHandleValues(handles, values, 2);
+    renderFrame();
+    QCOMPARE(diffuse(materialPath), QVector4D(0.0f, 0.0f, 1.0f, 1.0f));
+    float y = 0.0f;
+    QVERIFY(m_view->GetAttribute("Scene.Layer.Rect", "position.y", &y));
+    QCOMPARE(y, 20.0f);
+
+    // Released handles are ignored
+    m_view->ReleaseAttributeHandle(1);
+    const float green[] = { 0.0f, 1.0f, 0.0f, 1.0f };
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression(QStringLiteral("Invalid handle 1")));
+    m_view->SetAttributeHandleValues(handles, green, 1);
+    QCOMPARE(diffuse(materialPath), QVector4D(0.0f, 0.0f, 1.0f, 1.0f));
+}
+
+// Writes to a handle whose element does not exist are skipped without affecting the other
+// handles.
+void tst_runtimeview::attributeHandleOfMissingElement()
+{
+    QVERIFY(load(false));
+    renderFrame();
+
+    const char *materialPath = "Scene.Layer.Rect.Material";
+    m_view->RegisterAttributeHandle(1, "Scene.Layer.Missing.Material", "diffuse");
+    m_view->RegisterAttributeHandle(2, materialPath, "diffuse");
+
+    const int handles[] = { 1, 2 };
+    const float values[] = { 1.0f, 1.0f, 1.0f, 1.0f,
+                             0.0f, 1.0f, 0.0f, 1.0f };
+    QTest::ignoreMessage(QtWarningMsg,
+                         QRegularExpression(QStringLiteral("Unable to find element")));
+    m_view->SetAttributeHandleValues(handles, values, 2);
+    QCOMPARE(diffuse(materialPath), QVector4D(0.0f, 1.0f, 0.0f, 1.0f));
+
+    const float blue[] = { 1.0f, 1.0f, 1.0f, 1.0f,
+                           0.0f, 0.0f, 1.0f, 1.0f };
+    m_view->SetAttributeHandleValues(handles, blue, 2);
+    QCOMPARE(diffuse(materialPath), QVector4D(0.0f, 0.0f, 1.0f, 1.0f));
+}
+
+QT3DS_NULL_BACKEND_TEST_MAIN(tst_runtimeview)
+
+#include "tst_runtimeview.moc"
@@ -0,0 +1,289 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qt 3D Studio.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtCore/qloggingcategory.h>
+#include <QtCore/qtemporarydir.h>
+#include "foundation/TrackingAllocator.h"
+#include "foundation/Qt3DSFoundation.h"
+#include "foundation/Qt3DSPerfTimer.h"
+#include "foundation/StringTable.h"
+#include "render/Qt3DSRenderContext.h"
+#include "Qt3DSRenderShaderCache.h"
+#include "Qt3DSRenderInputStreamFactory.h"
+
+using namespace qt3ds;
+using namespace qt3ds::foundation;
+using namespace qt3ds::render;
+
+namespace {
+
+const char *vertexSource = "void main() { gl_Position = vec4(0.0); }\n";
+const char *fragmentSource = "void main() { fragOutput = vec4(1.0); }\n";
+const char *changedFragmentSource = "void main() { fragOutput = vec4(0.5); }\n";
+
+// The cache reports where a program came from only through its trace log.
+QStringList *s_traceMessages = nullptr;
+QtMessageHandler s_previousHandler = nullptr;
+
+void traceMessageHandler(QtMsgType inType, const QMessageLogContext &inContext,
+                         const QString &inMessage)
+{
+    if (s_traceMessages && qstrcmp(inContext.category, "qt3ds.trace_info") == 0)
+        s_traceMessages->append(inMessage);
+    else if (s_previousHandler)
+        s_previousHandler(inType, inContext, inMessage);
+}
+
+}
+
+class tst_shadercache : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+    void init();
+    void cleanup();
+    void roundTrip();
+    void staleEntryIsReplaced();
+    void corruptEntryIsReplaced_data();
+    void corruptEntryIsReplaced();
+    void rejectedEntryIsReplaced();
+
+private:
+    NVRenderShaderProgram *compile(const char *inFragment);
+    QStringList cacheEntries() const;
+    bool traced(const char *inMessage) const;
+
+    CAllocator m_allocator;
+    NVFoundation *m_foundation = nullptr;
+    IStringTable *m_stringTable = nullptr;
+    NVRenderContext *m_renderContext = nullptr;
+    IInputStreamFactory *m_inputStreamFactory = nullptr;
+    IPerfTimer *m_perfTimer = nullptr;
+    QTemporaryDir *m_cacheDir = nullptr;
+    QStringList m_traceMessages;
+};
+
+void tst_shadercache::initTestCase()
+{
+    m_foundation = NVCreateFoundation(QT3DS_FOUNDATION_VERSION, m_allocator);
+    QVERIFY(m_foundation);
+    m_stringTable = &IStringTable::CreateStringTable(m_allocator);
+    m_stringTable->addRef();
+    m_renderContext = &NVRenderContext::CreateNULL(*m_foundation, *m_stringTable);
+    m_renderContext->addRef();
+    QVERIFY(m_renderContext->isBinaryProgramSupported());
+    m_inputStreamFactory = &IInputStreamFactory::Create(*m_foundation);
+    m_inputStreamFactory->addRef();
+    m_perfTimer = &IPerfTimer::CreatePerfTimer(*m_foundation);
+    m_perfTimer->addRef();
+
+    QLoggingCategory::setFilterRules(QStringLiteral("qt3ds.trace_info=true"));
+    s_traceMessages = &m_traceMessages;
+    s_previousHandler = qInstallMessageHandler(traceMessageHandler);
+}
+
+void tst_shadercache::cleanupTestCase()
+{
+    qInstallMessageHandler(s_previousHandler);
+    s_traceMessages = nullptr;
+    QLoggingCategory::setFilterRules(QString());
+
+    m_perfTimer->release();
+    m_inputStreamFactory->release();
+    m_renderContext->release();
+    m_stringTable->release();
+    m_foundation->release();
+}
+
+void tst_shadercache::init()
+{
+    m_cacheDir = new QTemporaryDir;
+    QVERIFY(m_cacheDir->isValid());
+    m_traceMessages.clear();
+}
+
+void tst_shadercache::cleanup()
+{
+    delete m_cacheDir;
+    m_cacheDir = nullptr;
+}
+
+// Compiles the test program with a fresh shader cache, so that nothing is served from memory.
+NVRenderShaderProgram *tst_shadercache::compile(const char *inFragment)
+{
+    NVScopedRefCounted<IShaderCache> theCache(
+                IShaderCache::CreateShaderCache(*m_renderContext, *m_inputStreamFactory,
+                                                *m_perfTimer));
+    theCache->setPersistentCacheDirectory(m_cacheDir->path());
+
+    SShaderPreprocessorFeature theFeatures[] = {
+        SShaderPreprocessorFeature(m_stringTable->RegisterStr("QT3DS_ENABLE_TEST"), true)
+    };
+    QString errors;
+    NVRenderShaderProgram *theProgram = theCache->CompileProgram(
+                m_stringTable->RegisterStr("test program"), vertexSource, inFragment, nullptr,
+                nullptr, nullptr, SShaderCacheProgramFlags(), toConstDataRef(theFeatures, 1),
+                errors);
+    return errors.isEmpty() ? theProgram : nullptr;
+}
+
+QStringList tst_shadercache::cacheEntries() const
+{
+    return QDir(m_cacheDir->path()).entryList(QDir::Files);
+}
+
+bool tst_shadercache::traced(const char *inMessage) const
+{
+    for (const QString &message : m_traceMessages) {
+        if (message.contains(QLatin1String(inMessage)))
+            return true;
+    }
+    return false;
+}
+
+void tst_shadercache::roundTrip()
+{
+    QVERIFY(compile(fragmentSource));
+    const QStringList theEntries = cacheEntries();
+    QCOMPARE(theEntries.size(), 1);
+    QVERIFY(!traced("Loaded from persistent shader cache"));
+
+    m_traceMessages.clear();
+    QVERIFY(compile(fragmentSource));
+    QVERIFY(traced("Loaded from persistent shader cache"));
+    QCOMPARE(cacheEntries(), theEntries);
+}
+
+// An entry written for other sources of the same shader key is never used.
+void tst_shadercache::staleEntryIsReplaced()
+{
+    QVERIFY(compile(fragmentSource));
+    const QStringList theEntries = cacheEntries();
+    QCOMPARE(theEntries.size(), 1);
+
+    m_traceMessages.clear();
+    QVERIFY(compile(changedFragmentSource));
+    QVERIFY(traced("Discarding stale persistent shader cache entry"));
+    QVERIFY(!traced("Loaded from persistent shader cache"));
+    QCOMPARE(cacheEntries(), theEntries);
+
+    m_traceMessages.clear();
+    QVERIFY(compile(changedFragmentSource));
+    QVERIFY(traced("Loaded from persistent shader cache"));
+}
+
+void tst_shadercache::corruptEntryIsReplaced_data()
+{
+    QTest::addColumn<bool>("truncate");
+    QTest::newRow("truncated") << true;
+    QTest::newRow("damaged binary") << false;
+}
+
+void tst_shadercache::corruptEntryIsReplaced()
+{
+    QFETCH(bool, truncate);
+
+    QVERIFY(compile(fragmentSource));
+    const QStringList theEntries = cacheEntries();
+    QCOMPARE(theEntries.size(), 1);
+
+    QFile theFile(m_cacheDir->filePath(theEntries.first()));
+    QVERIFY(theFile.open(QIODevice::ReadWrite));
+    QByteArray theData = theFile.readAll();
+    const QByteArray theBinary("NULL program");
+    if (truncate) {
+        theData.truncate(theData.size() / 2);
+    } else {
+        const int theOffset = theData.indexOf(theBinary);
+        QVERIFY(theOffset >= 0);
+        theData[theOffset] = 'X';
+    }
+    QVERIFY(theFile.resize(0));
+    QCOMPARE(theFile.write(theData), qint64(theData.size()));
+    theFile.close();
+
+    m_traceMessages.clear();
+    QVERIFY(compile(fragmentSource));
+    QVERIFY(traced("Discarding stale persistent shader cache entry"));
+    QVERIFY(!traced("Loaded from persistent shader cache"));
+
+    m_traceMessages.clear();
+    QVERIFY(compile(fragmentSource));
+    QVERIFY(traced("Loaded from persistent shader cache"));
+}
+
+// A well formed entry whose binary the driver does not accept is recompiled and rewritten.
+void tst_shadercache::rejectedEntryIsReplaced()
+{
+    QVERIFY(compile(fragmentSource));
+    const QStringList theEntries = cacheEntries();
+    QCOMPARE(theEntries.size(), 1);
+
+    QFile theFile(m_cacheDir->filePath(theEntries.first()));
+    QVERIFY(theFile.open(QIODevice::ReadWrite));
+    quint32 type = 0;
+    quint32 version = 0;
+    QByteArray fingerprint;
+    QByteArray sourceHash;
+    QT3DSU32 format = 0;
+    QByteArray binary;
+    QByteArray checksum;
+    {
+        QDataStream theStream(&theFile);
+        theStream >> type >> version >> fingerprint >> sourceHash >> format >> binary
+                  >> checksum;
+        QCOMPARE(theStream.status(), QDataStream::Ok);
+    }
+    binary = QByteArrayLiteral("program from another driver");
+    QVERIFY(theFile.resize(0));
+    QVERIFY(theFile.seek(0));
+    {
+        QDataStream theStream(&theFile);
+        theStream << type << version << fingerprint << sourceHash << format << binary
+                  << QCryptographicHash::hash(binary, QCryptographicHash::Sha1);
+    }
+    theFile.close();
+
+    m_traceMessages.clear();
+    QVERIFY(compile(fragmentSource));
+    QVERIFY(traced("Discarding rejected persistent shader cache entry"));
+    QCOMPARE(cacheEntries(), theEntries);
+
+    m_traceMessages.clear();
+    QVERIFY(compile(fragmentSource));
+    QVERIFY(traced("Loaded from persistent shader cache"));
+}
+
+QTEST_APPLESS_MAIN(tst_shadercache)
+
+#include "tst_shadercache.moc"
@@ -40,7 +40,10 @@
 #include <QtGui/qimage.h>
 #include <QtGui/qscreen.h>
 #include <QtGui/qopenglframebufferobject.h>
+#include <QtGui/qopenglfunctions.h>
 #include <QtGui/qevent.h>
+#include <QtGui/qvector3d.h>
+#include <QtGui/qvector4d.h>
 #include <QtCore/qurl.h>
 #include <QtCore/qfile.h>
 #include "../shared/shared_presentations.h"
@@ -75,6 +78,7 @@ private slots:
     void testReset();
     void testSettings_data();
     void testSettings();
+    void testRenderOnDemand();
     void testPresentation_data();
     void testPresentation();
     void testPresentationActivation_data();
@@ -83,6 +87,8 @@ private slots:
     void testSceneElement();
     void testElement_data();
     void testElement();
+    void testAttributeHandle_data();
+    void testAttributeHandle();
     void testMouseInput_data();
     void testMouseInput();
     void testDataInput_data();
@@ -795,6 +801,64 @@ void tst_Q3DSSurfaceViewer::testSettings()
     QSettings(QStringLiteral("The Qt Company"), QStringLiteral("tst_q3dsurfaceviewer")).clear();
 }
 
+void tst_Q3DSSurfaceViewer::testRenderOnDemand()
+{
+    // Use an offscreen fbo and manual updates, so that the fbo contents show whether the last
+    // update rendered. grab() can't be used for this, as it always renders.
+    createOffscreenAndViewer(m_viewer, RED, QSize(), -1);
+
+    Q3DSViewerSettings *s = m_viewer->settings();
+    QSignalSpy spy(s, &Q3DSViewerSettings::renderOnDemandChanged);
+    QVERIFY(spy.isValid());
+    QCOMPARE(s->renderOnDemand(), false);
+
+    checkPixel(m_viewer, Qt::red);
+
+    auto clearFbo = [this]() {
+        m_context->makeCurrent(m_surface);
+        m_fbo->bind();
+        m_context->functions()->glClearColor(0.0f, 1.0f, 0.0f, 1.0f);
+        m_context->functions()->glClear(GL_COLOR_BUFFER_BIT);
+        m_fbo->release();
+    };
+    auto updateAndGetPixel = [this]() -> QColor {
+        for (int i = 0; i < 3; i++)
+            m_viewer->update();
+        return QColor(m_fbo->toImage().pixel(50, 50));
+    };
+
+    // Without render on demand every update renders
+    clearFbo();
+    QCOMPARE(updateAndGetPixel(), QColor(Qt::red));
+
+    s->setRenderOnDemand(true);
+    QCOMPARE(s->renderOnDemand(), true);
+    QCOMPARE(spy.count(), 1);
+    // Let the settings change render its frame
+    updateAndGetPixel();
+
+    // Nothing changed, so the updates must not touch the fbo
+    clearFbo();
+    QCOMPARE(updateAndGetPixel(), QColor(Qt::green));
+
+    // A changed attribute renders again
+    m_viewer->presentation()->setAttribute(QStringLiteral("Scene.Layer.Rectangle.Material"),
+                                           QStringLiteral("diffuse.r"), QVariant(0.0));
+    m_viewer->presentation()->setAttribute(QStringLiteral("Scene.Layer.Rectangle.Material"),
+                                           QStringLiteral("diffuse.b"), QVariant(1.0));
+    QCOMPARE(updateAndGetPixel(), QColor(Qt::blue));
+
+    clearFbo();
+    QCOMPARE(updateAndGetPixel(), QColor(Qt::green));
+
+    // Back to rendering every update
+    s->setRenderOnDemand(false);
+    QCOMPARE(s->renderOnDemand(), false);
+    QCOMPARE(spy.count(), 2);
+    clearFbo();
+    QCOMPARE(updateAndGetPixel(), QColor(Qt::blue));
+}
+
 void tst_Q3DSSurfaceViewer::testPresentation_data()
 {
     testBasics_data();
@@ -1438,6 +1502,68 @@ void tst_Q3DSSurfaceViewer::testElement()
     checkPixel(m_viewer, Qt::cyan, c2Point);
 }
 
+void tst_Q3DSSurfaceViewer::testAttributeHandle_data()
+{
+    testBasics_data();
+}
+
+void tst_Q3DSSurfaceViewer::testAttributeHandle()
+{
+    QFETCH(bool, isWindow);
+
+    if (isWindow)
+        createWindowAndViewer(m_viewer, MULTISLIDE);
+    else
+        createOffscreenAndViewer(m_viewer, MULTISLIDE);
+
+    m_viewer->settings()->setScaleMode(Q3DSViewerSettings::ScaleModeFill);
+
+    QString path1 = QStringLiteral("Scene.Layer.Rect.Material"); // Red
+    QString path2 = QStringLiteral("Scene.Layer.Component1.Rectangle4.Material"); // Green
+
+    QPoint mainPoint(m_viewer->size().width() * 2 / 8, m_viewer->size().height() / 2);
+    QPoint c1Point(m_viewer->size().width() * 5 / 8, m_viewer->size().height() / 2);
+
+    Q3DSPresentation *p = m_viewer->presentation();
+    Q3DSElement *element2 = new Q3DSElement(p, path2);
+    const int handle1 = p->attributeHandle(path1, QStringLiteral("diffuse"));
+    const int handle2 = element2->attributeHandle(QStringLiteral("diffuse"));
+    QVERIFY(handle1 != 0);
+    QVERIFY(handle2 != 0);
+    QVERIFY(handle1 != handle2);
+
+    checkPixel(m_viewer, Qt::red, mainPoint);
+    checkPixel(m_viewer, Qt::green, c1Point);
+
+    p->setAttributeValue(handle1, QColor(Qt::blue));
+    checkPixel(m_viewer, Qt::blue, mainPoint);
+    checkPixel(m_viewer, Qt::green, c1Point);
+
+    p->setAttributeValue(handle2, QVector3D(1.0f, 0.0f, 1.0f));
+    checkPixel(m_viewer, Qt::blue, mainPoint);
+    checkPixel(m_viewer, Qt::magenta, c1Point);
+
+    p->setAttributeValues({handle1, handle2}, {QVector4D(0.0f, 1.0f, 1.0f, 1.0f),
+                                               QVector4D(1.0f, 1.0f, 0.0f, 1.0f)});
+    checkPixel(m_viewer, Qt::cyan, mainPoint);
+    checkPixel(m_viewer, Qt::yellow, c1Point);
+
+    // Released handles are ignored
+    p->releaseAttributeHandle(handle1);
+    p->setAttributeValue(handle1, QColor(Qt::red));
+    checkPixel(m_viewer, Qt::cyan, mainPoint);
+
+    // Handles of missing elements are skipped on every write without affecting the others
+    const int missingHandle = p->attributeHandle(QStringLiteral("Scene.Layer.Missing.Material"),
+                                                 QStringLiteral("diffuse"));
+    QVERIFY(missingHandle != 0);
+    p->setAttributeValue(missingHandle, QColor(Qt::red));
+    p->setAttributeValues({missingHandle, handle2}, {QVector4D(1.0f, 0.0f, 0.0f, 1.0f),
+                                                     QVector4D(0.0f, 0.0f, 1.0f, 1.0f)});
+    checkPixel(m_viewer, Qt::cyan, mainPoint);
+    checkPixel(m_viewer, Qt::blue, c1Point);
+}
+
 void tst_Q3DSSurfaceViewer::testMouseInput_data()
 {
     testBasics_data();
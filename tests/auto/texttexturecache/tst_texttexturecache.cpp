@@ -0,0 +1,289 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of Qt 3D Studio.
+**
+** $QT_BEGIN_LICENSE:GPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 or (at your option) any later version
+** approved by the KDE Free Qt Foundation. The licenses are as published by
+** the Free Software Foundation and appearing in the file LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include "foundation/TrackingAllocator.h"
+#include "foundation/Qt3DSFoundation.h"
+#include "foundation/StringTable.h"
+#include "render/Qt3DSRenderContext.h"
+#include "render/Qt3DSRenderTexture2D.h"
+#include "Qt3DSRenderJobSystem.h"
+#include "Qt3DSRenderTextTextureCache.h"
+#include "Qt3DSTextRenderer.h"
+
+using namespace qt3ds;
+using namespace qt3ds::foundation;
+using namespace qt3ds::render;
+
+namespace {
+
+// Rasterizes the number in the text as an image 4 * (number + 1) pixels wide, so the texture
+// details tell which text a texture holds.
+struct SNumberTextRenderer : public ITextRenderer
+{
+    NVFoundationBase &m_Foundation;
+    volatile QT3DSI32 mRefCount;
+    QAtomicInt m_Rasterized;
+
+    SNumberTextRenderer(NVFoundationBase &inFoundation)
+        : m_Foundation(inFoundation)
+        , mRefCount(0)
+    {
+    }
+
+    QT3DS_IMPLEMENT_REF_COUNT_ADDREF_RELEASE_OVERRIDE(m_Foundation.getAllocator())
+
+    void AddSystemFontDirectory(const char8_t *) override {}
+    void AddProjectFontDirectory(const char8_t *) override {}
+    void ClearProjectFontDirectories() override {}
+    void PreloadFonts() override {}
+    void BeginPreloadFonts(IThreadPool &, IPerfTimer &) override {}
+    void EndPreloadFonts() override {}
+    void ReloadFonts() override {}
+    NVConstDataRef<SRendererFontEntry> GetProjectFontList() override
+    {
+        return NVConstDataRef<SRendererFontEntry>();
+    }
+    Option<CRegisteredString> GetFontNameForFont(CRegisteredString) override { return Empty(); }
+    Option<CRegisteredString> GetFontNameForFont(const char8_t *) override { return Empty(); }
+    ITextRenderer &GetTextRenderer(NVRenderContext &) override { return *this; }
+
+    STextDimensions MeasureText(const STextRenderInfo &, QT3DSF32, const char8_t *) override
+    {
+        return STextDimensions();
+    }
+    STextTextureDetails RenderText(const STextRenderInfo &inText,
+                                   NVRenderTexture2D &inTexture) override
+    {
+        STextRaster theRaster;
+        RasterizeText(inText, theRaster);
+        return UploadRaster(theRaster, inTexture);
+    }
+    bool SupportsRasterizeText() const override { return true; }
+    void RasterizeText(const STextRenderInfo &inText, STextRaster &outRaster) override
+    {
+        const int width = 4 * (atoi(inText.m_Text.c_str()) + 1);
+        outRaster.m_Image = QImage(width, 4, QImage::Format_ARGB32);
+        outRaster.m_Image.fill(0);
+        outRaster.m_TextWidth = QT3DSU32(width);
+        outRaster.m_TextHeight = 4;
+        m_Rasterized.fetchAndAddRelaxed(1);
+    }
+    STextTextureDetails RenderText(const STextRenderInfo &, NVRenderPathFontItem &,
+                                   NVRenderPathFontSpecification &) override
+    {
+        return STextTextureDetails();
+    }
+    SRenderTextureAtlasDetails RenderText(const STextRenderInfo &) override
+    {
+        return SRenderTextureAtlasDetails();
+    }
+    void BeginFrame() override {}
+    void EndFrame() override {}
+    QT3DSI32 CreateTextureAtlas() override { return 0; }
+    STextTextureAtlasEntryDetails RenderAtlasEntry(QT3DSU32, NVRenderTexture2D &) override
+    {
+        return STextTextureAtlasEntryDetails();
+    }
+};
+
+int shownNumber(const TTPathObjectAndTexture &inResult)
+{
+    return int(inResult.second.first.m_TextWidth / 4) - 1;
+}
+
+}
+
+class tst_texttexturecache : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+    void init();
+    void cleanup();
+    void textChangingEveryFrame_data();
+    void textChangingEveryFrame();
+    void identicalTextIsRasterizedOnce();
+    void synchronousWithoutLatency();
+
+private:
+    STextRenderInfo numberText(int inNumber);
+    TTPathObjectAndTexture renderSync(int inNumber);
+
+    CAllocator m_allocator;
+    NVFoundation *m_foundation = nullptr;
+    IStringTable *m_stringTable = nullptr;
+    NVRenderContext *m_renderContext = nullptr;
+    IJobSystem *m_jobSystem = nullptr;
+    SNumberTextRenderer *m_textRenderer = nullptr;
+    ITextTextureCache *m_cache = nullptr;
+};
+
+void tst_texttexturecache::initTestCase()
+{
+    m_foundation = NVCreateFoundation(QT3DS_FOUNDATION_VERSION, m_allocator);
+    QVERIFY(m_foundation);
+    m_stringTable = &IStringTable::CreateStringTable(m_allocator);
+    m_stringTable->addRef();
+    m_renderContext = &NVRenderContext::CreateNULL(*m_foundation, *m_stringTable);
+    m_renderContext->addRef();
+    m_jobSystem = &IJobSystem::CreateJobSystem(*m_foundation, 2);
+    m_jobSystem->addRef();
+}
+
+void tst_texttexturecache::cleanupTestCase()
+{
+    m_jobSystem->release();
+    m_renderContext->release();
+    m_stringTable->release();
+    m_foundation->release();
+}
+
+void tst_texttexturecache::init()
+{
+    m_textRenderer = QT3DS_NEW(m_foundation->getAllocator(), SNumberTextRenderer)(*m_foundation);
+    m_textRenderer->addRef();
+}
+
+void tst_texttexturecache::cleanup()
+{
+    if (m_cache)
+        m_cache->release();
+    m_cache = nullptr;
+    m_textRenderer->release();
+    qunsetenv("QT3DS_TEXT_RASTER_LATENCY");
+}
+
+STextRenderInfo tst_texttexturecache::numberText(int inNumber)
+{
+    STextRenderInfo theInfo;
+    theInfo.m_Text = m_stringTable->RegisterStr(QByteArray::number(inNumber).constData());
+    return theInfo;
+}
+
+TTPathObjectAndTexture tst_texttexturecache::renderSync(int inNumber)
+{
+    return m_cache->RenderText(numberText(inNumber), 1.0f);
+}
+
+void tst_texttexturecache::textChangingEveryFrame_data()
+{
+    QTest::addColumn<int>("latency");
+    QTest::newRow("1") << 1;
+    QTest::newRow("3") << 3;
+}
+
+// A counter changing every frame has to keep updating instead of showing its first value
+// until it stops changing. Every value is uploaded at most latency frames after it was
+// requested, values superseded meanwhile are skipped.
+void tst_texttexturecache::textChangingEveryFrame()
+{
+    QFETCH(int, latency);
+    qputenv("QT3DS_TEXT_RASTER_LATENCY", QByteArray::number(latency));
+    m_cache = &ITextTextureCache::CreateTextureCache(*m_foundation, *m_textRenderer,
+                                                     *m_renderContext, m_jobSystem);
+    m_cache->addRef();
+
+    const int element = 0;
+    TTPathObjectAndTexture theShown = renderSync(0);
+    m_cache->EndFrame();
+    QCOMPARE(shownNumber(theShown), 0);
+
+    const int frames = 200;
+    for (int frame = 1; frame <= frames; ++frame) {
+        TTPathObjectAndTexture theResult;
+        const bool upToDate = m_cache->RenderTextAsync(
+                    &element, numberText(frame), 1.0f, theShown.second.second.mPtr, theResult);
+        m_cache->EndFrame();
+        const int shown = shownNumber(theResult);
+        QVERIFY2(shown >= frame - (2 * latency - 1) && shown <= frame,
+                 qPrintable(QStringLiteral("frame %1 shows %2").arg(frame).arg(shown)));
+        QCOMPARE(upToDate, shown == frame);
+        QVERIFY(shownNumber(theShown) <= shown);
+        theShown = theResult;
+    }
+
+    // Once the text stops changing the last value arrives after the pending one.
+    bool upToDate = false;
+    for (int frame = 0; frame <= 2 * latency && !upToDate; ++frame) {
+        TTPathObjectAndTexture theResult;
+        upToDate = m_cache->RenderTextAsync(&element, numberText(frames), 1.0f,
+                                            theShown.second.second.mPtr, theResult);
+        m_cache->EndFrame();
+        theShown = theResult;
+    }
+    QVERIFY(upToDate);
+    QCOMPARE(shownNumber(theShown), frames);
+    // Superseded text is not rasterized more than once per frame.
+    QVERIFY(m_textRenderer->m_Rasterized.load() <= frames + 1);
+}
+
+void tst_texttexturecache::identicalTextIsRasterizedOnce()
+{
+    m_cache = &ITextTextureCache::CreateTextureCache(*m_foundation, *m_textRenderer,
+                                                     *m_renderContext, m_jobSystem);
+    m_cache->addRef();
+
+    const int elements[2] = { 0, 0 };
+    TTPathObjectAndTexture theShown = renderSync(1);
+    m_cache->EndFrame();
+    for (int frame = 0; frame < 3; ++frame) {
+        for (const int &element : elements) {
+            TTPathObjectAndTexture theResult;
+            m_cache->RenderTextAsync(&element, numberText(2), 1.0f,
+                                     theShown.second.second.mPtr, theResult);
+        }
+        m_cache->EndFrame();
+    }
+    QCOMPARE(m_textRenderer->m_Rasterized.load(), 2);
+    QCOMPARE(shownNumber(renderSync(2)), 2);
+    QCOMPARE(m_textRenderer->m_Rasterized.load(), 2);
+}
+
+void tst_texttexturecache::synchronousWithoutLatency()
+{
+    qputenv("QT3DS_TEXT_RASTER_LATENCY", "0");
+    m_cache = &ITextTextureCache::CreateTextureCache(*m_foundation, *m_textRenderer,
+                                                     *m_renderContext, m_jobSystem);
+    m_cache->addRef();
+
+    const int element = 0;
+    TTPathObjectAndTexture theShown = renderSync(1);
+    m_cache->EndFrame();
+    TTPathObjectAndTexture theResult;
+    QVERIFY(m_cache->RenderTextAsync(&element, numberText(2), 1.0f,
+                                     theShown.second.second.mPtr, theResult));
+    QCOMPARE(shownNumber(theResult), 2);
+}
+
+QTEST_APPLESS_MAIN(tst_texttexturecache)
+
+#include "tst_texttexturecache.moc"
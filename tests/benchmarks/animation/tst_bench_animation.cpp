@@ -0,0 +1,195 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of Qt 3D Studio.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+#include <QtCore/qfile.h>
+#include <QtCore/qtemporarydir.h>
+#include <QtCore/qtextstream.h>
+#include <QtGui/qevent.h>
+#include <QtGui/qguiapplication.h>
+#include <QtGui/qsurfaceformat.h>
+#include "Qt3DSRuntimeView.h"
+#include "Qt3DSApplication.h"
+#include "Qt3DSPresentation.h"
+#include "Qt3DSAnimationSystem.h"
+#include "Qt3DSFNDTimer.h"
+#include "../../auto/runtime/Qt3DSRenderTestNullBackend.h"
+
+// Runs IAnimationSystem::Update of a loaded presentation with the tracks evaluated from the
+// key list (bezier) and from the baked sample tables. The runtime uses the NULL render backend,
+// so no GPU or window is needed.
+
+namespace {
+
+const int frameIntervalMs = 16;
+// Far enough into the animation that every track is between two keys
+const int warmupFrames = 60;
+const int tracksPerModel = 9;
+
+// A single layer presentation with models cubes, each animated by tracksPerModel looping
+// tracks with eight keys.
+QString writePresentation(const QString &path, int models)
+{
+    static const char *trackProperties[] = {
+        "position.x", "position.y", "position.z", "rotation.x", "rotation.y", "rotation.z",
+        "scale.x", "scale.y", "scale.z"
+    };
+
+    QString graph;
+    QString master;
+    QTextStream g(&graph);
+    QTextStream m(&master);
+    for (int i = 0; i < models; ++i) {
+        g << "\t\t\t\t\t<Model id=\"Model_" << i << "\" >\n"
+          << "\t\t\t\t\t\t<Material id=\"Material_" << i << "\" />\n"
+          << "\t\t\t\t\t</Model>\n";
+        m << "\t\t\t\t<Add ref=\"#Model_" << i << "\" name=\"Model_" << i
+          << "\" scale=\"0.2 0.2 0.2\" sourcepath=\"#Cube\" >\n";
+        for (int t = 0; t < tracksPerModel; ++t) {
+            m << "\t\t\t\t\t<AnimationTrack property=\"" << trackProperties[t]
+              << "\" type=\"EaseInOut\" >";
+            for (int k = 0; k < 8; ++k)
+                m << (k * 0.6f) << " " << ((i * 7 + k * 13 + t) % 100) << " 100 100 ";
+            m << "</AnimationTrack>\n";
+        }
+        m << "\t\t\t\t</Add>\n"
+          << "\t\t\t\t<Add ref=\"#Material_" << i << "\" />\n";
+    }
+    g.flush();
+    m.flush();
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+        return QString();
+    QTextStream out(&file);
+    out << "<?xml version=\"1.0\" encoding=\"UTF-8\" ?>\n"
+        << "<UIP version=\"6\" >\n"
+        << "\t<Project >\n"
+        << "\t\t<ProjectSettings presentationWidth=\"1280\" presentationHeight=\"720\" />\n"
+        << "\t\t<Graph >\n"
+        << "\t\t\t<Scene id=\"Scene\" >\n"
+        << "\t\t\t\t<Layer id=\"Layer\" >\n"
+        << "\t\t\t\t\t<Camera id=\"Camera\" />\n"
+        << "\t\t\t\t\t<Light id=\"Light\" />\n"
+        << graph
+        << "\t\t\t\t</Layer>\n"
+        << "\t\t\t</Scene>\n"
+        << "\t\t</Graph>\n"
+        << "\t\t<Logic >\n"
+        << "\t\t\t<State name=\"Master Slide\" component=\"#Scene\" >\n"
+        << "\t\t\t\t<Add ref=\"#Layer\" />\n"
+        << "\t\t\t\t<Add ref=\"#Camera\" />\n"
+        << "\t\t\t\t<Add ref=\"#Light\" />\n"
+        << master
+        << "\t\t\t\t<State id=\"Scene-Slide1\" name=\"Slide1\" playmode=\"Looping\" >\n"
+        << "\t\t\t\t\t<Set ref=\"#Layer\" endtime=\"5000\" />\n"
+        << "\t\t\t\t</State>\n"
+        << "\t\t\t</State>\n"
+        << "\t\t</Logic>\n"
+        << "\t</Project>\n"
+        << "</UIP>\n";
+    return path;
+}
+
+}
+
+class tst_bench_animation : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void update_data();
+    void update();
+
+private:
+    QTemporaryDir m_projectDir;
+};
+
+void tst_bench_animation::initTestCase()
+{
+    QVERIFY(m_projectDir.isValid());
+}
+
+void tst_bench_animation::update_data()
+{
+    QTest::addColumn<int>("models");
+    QTest::addColumn<bool>("baked");
+    QTest::newRow("900 tracks, bezier") << 100 << false;
+    QTest::newRow("900 tracks, baked") << 100 << true;
+    QTest::newRow("9000 tracks, bezier") << 1000 << false;
+    QTest::newRow("9000 tracks, baked") << 1000 << true;
+}
+
+void tst_bench_animation::update()
+{
+    QFETCH(int, models);
+    QFETCH(bool, baked);
+    const QString source = writePresentation(
+                m_projectDir.filePath(QStringLiteral("animation%1.uip").arg(models)), models);
+    QVERIFY(!source.isEmpty());
+
+    Q3DStudio::Qt3DSFNDTimer timeProvider;
+    qt3ds::render::SNullBackendWindowSystem windowSystem;
+    Q3DStudio::IRuntimeView *view = &Q3DStudio::IRuntimeView::Create(timeProvider, windowSystem);
+    QVERIFY(view->BeginLoad(source, QStringList()));
+    QString errors;
+    QVERIFY(view->InitializeGraphics(QSurfaceFormat::defaultFormat(), false, true, QByteArray(),
+                                     errors));
+    view->connectSignals();
+    QResizeEvent event(windowSystem.m_size, QSize());
+    view->HandleMessage(&event);
+    qt3ds::runtime::IApplication *application = view->GetApplication();
+    QVERIFY(application);
+    QVERIFY(application->GetPrimaryPresentation());
+
+    Q3DStudio::INT64 timeMs = 0;
+    for (int i = 0; i < warmupFrames; ++i) {
+        timeMs += frameIntervalMs;
+        application->SetTimeMilliSecs(timeMs);
+        view->Render();
+    }
+
+    qt3ds::runtime::IAnimationSystem &animationSystem =
+            application->GetPrimaryPresentation()->GetAnimationSystem();
+    animationSystem.SetBakedTracksEnabled(baked);
+    // Tracks are baked on their first baked evaluation
+    animationSystem.Update();
+
+    QBENCHMARK {
+        animationSystem.Update();
+    }
+
+    view->Cleanup();
+    view->release();
+}
+
+QT3DS_NULL_BACKEND_TEST_MAIN(tst_bench_animation)
+
+#include "tst_bench_animation.moc"
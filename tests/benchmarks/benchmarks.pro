@@ -0,0 +1,12 @@
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    animation \
+    binaryload \
+    commandqueue \
+    jobsystem \
+    meshload \
+    pickbvh \
+    rendersort \
+    runtimeframe \
+    shaderkeys
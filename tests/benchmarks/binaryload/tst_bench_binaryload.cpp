@@ -0,0 +1,292 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of Qt 3D Studio.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+#include <QtCore/qfile.h>
+#include <QtCore/qtemporarydir.h>
+#include <QtCore/qtextstream.h>
+#include <QtGui/qguiapplication.h>
+#include <QtGui/qsurfaceformat.h>
+#include "foundation/SerializationTypes.h"
+#include "Qt3DSRenderRuntimeBinding.h"
+#include "Qt3DSRenderContextCore.h"
+#include "Qt3DSRenderGraphObjectSerializer.h"
+#include "Qt3DSRenderBufferLoader.h"
+#include "Qt3DSRenderPresentation.h"
+#include "Qt3DSRenderScene.h"
+#include "Qt3DSRenderLayer.h"
+#include "Qt3DSRenderModel.h"
+#include "Qt3DSRenderDefaultMaterial.h"
+#include "Qt3DSRuntimeView.h"
+#include "Qt3DSWindowSystem.h"
+#include "Qt3DSTimer.h"
+#include "../../auto/runtime/Qt3DSRenderTestNullBackend.h"
+
+#include <vector>
+
+using namespace qt3ds;
+using namespace qt3ds::foundation;
+using namespace qt3ds::render;
+
+// Compares the ways a binary scene graph gets into memory: reading it into the heap with
+// ILoadedBuffer::CreateRead, or mapping it copy-on-write with ILoadedBuffer::CreateMapped.
+// Each iteration runs what the scene loader does in stage 1: validate the header, optionally
+// verify the checksum (QT3DS_VERIFY_BINARY_SCENES), and fix up the graph in place with
+// SGraphObjectSerializer::Load. The XML path loads the same scene as a .uip through
+// IRuntimeView, which parses it with IUIPParser and builds the element and scene graphs.
+
+class tst_bench_binaryload : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+    void readToHeap_data();
+    void readToHeap();
+    void mapPrivate_data();
+    void mapPrivate();
+    void loadUip_data();
+    void loadUip();
+
+private:
+    void addSceneSizes();
+    QString createBinary(int modelCount);
+    QString createUip(int modelCount);
+    bool loadScene(ILoadedBuffer *buffer, bool verifyChecksum);
+
+    SNullBackendTimeProvider m_timeProvider;
+    SNullBackendWindowSystem m_windowSystem;
+    NVScopedRefCounted<IQt3DSRenderFactoryCore> m_coreFactory;
+    IQt3DSRenderFactory *m_factory = nullptr;
+    QTemporaryDir m_dir;
+};
+
+void tst_bench_binaryload::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+    m_coreFactory = &IQt3DSRenderFactoryCore::CreateRenderFactoryCore("", m_windowSystem,
+                                                                      m_timeProvider);
+    m_factory = &m_coreFactory->CreateRenderFactory(QSurfaceFormat::defaultFormat(), false);
+}
+
+void tst_bench_binaryload::cleanupTestCase()
+{
+    m_factory = nullptr;
+    m_coreFactory = nullptr;
+}
+
+void tst_bench_binaryload::addSceneSizes()
+{
+    QTest::addColumn<int>("modelCount");
+    QTest::addColumn<bool>("verifyChecksum");
+    QTest::newRow("1k models, header") << 1000 << false;
+    QTest::newRow("1k models, checksum") << 1000 << true;
+    QTest::newRow("100k models, header") << 100000 << false;
+    QTest::newRow("100k models, checksum") << 100000 << true;
+}
+
+// One layer with modelCount models, each with its own default material.
+QString tst_bench_binaryload::createBinary(int modelCount)
+{
+    const QString path = m_dir.filePath(QStringLiteral("scene%1.uibsg").arg(modelCount));
+    if (QFile::exists(path))
+        return path;
+
+    IQt3DSRenderContext &context(m_factory->GetQt3DSRenderContext());
+    SPresentation presentation;
+    SScene scene;
+    SLayer layer;
+    std::vector<SModel> models(modelCount);
+    std::vector<SDefaultMaterial> materials(modelCount);
+    presentation.m_Scene = &scene;
+    scene.m_Presentation = &presentation;
+    scene.m_FirstChild = &layer;
+    layer.m_Scene = &scene;
+    layer.m_FirstChild = &models[0];
+    for (int i = 0; i < modelCount; ++i) {
+        models[i].m_Parent = &layer;
+        models[i].m_Position = QT3DSVec3(float(i), 0.0f, 0.0f);
+        models[i].m_FirstMaterial = &materials[i];
+        materials[i].m_Parent = &models[i];
+        if (i > 0)
+            models[i].m_PreviousSibling = &models[i - 1];
+        if (i + 1 < modelCount)
+            models[i].m_NextSibling = &models[i + 1];
+    }
+
+    SWriteBuffer buffer(context.GetAllocator(), "tst_bench_binaryload::buffer");
+    SPtrOffsetMap offsets(context.GetAllocator(), "tst_bench_binaryload::offsets");
+    buffer.writeZeros(sizeof(SBinarySceneHeader));
+    const QT3DSU32 dataSectionStart = buffer.size();
+    SGraphObjectSerializer::Save(context.GetFoundation(), presentation, buffer,
+                                 context.GetDynamicObjectSystem(), context.GetPathManager(),
+                                 offsets, context.GetStringTable());
+    buffer.align(sizeof(void *));
+    const QT3DSU32 translatorOffset = buffer.size() - dataSectionStart;
+    buffer.writeZeros(4); // translator count
+    reinterpret_cast<SBinarySceneHeader *>(buffer.begin())->Finalize(
+                toConstDataRef(buffer.begin() + dataSectionStart,
+                               buffer.size() - dataSectionStart),
+                translatorOffset);
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+        return QString();
+    file.write(reinterpret_cast<const char *>(buffer.begin()), buffer.size());
+    return path;
+}
+
+// The scene of createBinary as a presentation, each model a rectangle.
+QString tst_bench_binaryload::createUip(int modelCount)
+{
+    const QString path = m_dir.filePath(QStringLiteral("scene%1.uip").arg(modelCount));
+    if (QFile::exists(path))
+        return path;
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+        return QString();
+    QTextStream out(&file);
+    out << "<?xml version=\"1.0\" encoding=\"UTF-8\" ?>\n"
+        << "<UIP version=\"6\" >\n"
+        << "\t<Project >\n"
+        << "\t\t<ProjectSettings presentationWidth=\"640\" presentationHeight=\"480\" />\n"
+        << "\t\t<Graph >\n"
+        << "\t\t\t<Scene id=\"Scene\" >\n"
+        << "\t\t\t\t<Layer id=\"Layer\" >\n";
+    for (int i = 0; i < modelCount; ++i) {
+        out << "\t\t\t\t\t<Model id=\"Model" << i << "\" >\n"
+            << "\t\t\t\t\t\t<Material id=\"Material" << i << "\" />\n"
+            << "\t\t\t\t\t</Model>\n";
+    }
+    out << "\t\t\t\t</Layer>\n"
+        << "\t\t\t</Scene>\n"
+        << "\t\t</Graph>\n"
+        << "\t\t<Logic >\n"
+        << "\t\t\t<State name=\"Master Slide\" component=\"#Scene\" >\n"
+        << "\t\t\t\t<Add ref=\"#Layer\" name=\"Layer\" />\n";
+    for (int i = 0; i < modelCount; ++i) {
+        out << "\t\t\t\t<Add ref=\"#Model" << i << "\" name=\"Model" << i
+            << "\" sourcepath=\"#Rectangle\" position=\"" << i << " 0 0\" />\n"
+            << "\t\t\t\t<Add ref=\"#Material" << i << "\" name=\"Material" << i << "\" />\n";
+    }
+    out << "\t\t\t\t<State id=\"Scene-Slide1\" name=\"Slide1\" />\n"
+        << "\t\t\t</State>\n"
+        << "\t\t</Logic>\n"
+        << "\t</Project>\n"
+        << "</UIP>\n";
+    return path;
+}
+
+bool tst_bench_binaryload::loadScene(ILoadedBuffer *buffer, bool verifyChecksum)
+{
+    if (!buffer)
+        return false;
+    NVScopedRefCounted<ILoadedBuffer> scopedBuffer(buffer);
+    NVDataRef<QT3DSU8> file(buffer->Data());
+    const SBinarySceneHeader *header =
+            SBinarySceneHeader::Validate(file, verifyChecksum, buffer->Path().c_str());
+    if (!header)
+        return false;
+    IQt3DSRenderContext &context(m_factory->GetQt3DSRenderContext());
+    return SGraphObjectSerializer::Load(
+                toDataRef(file.begin() + sizeof(SBinarySceneHeader), header->m_TranslatorOffset),
+                NVDataRef<QT3DSU8>(), context.GetDynamicObjectSystem(), context.GetPathManager(),
+                context.GetAllocator(), "") != nullptr;
+}
+
+void tst_bench_binaryload::readToHeap_data()
+{
+    addSceneSizes();
+}
+
+void tst_bench_binaryload::readToHeap()
+{
+    QFETCH(int, modelCount);
+    QFETCH(bool, verifyChecksum);
+    const QString path = createBinary(modelCount);
+    QVERIFY(!path.isEmpty());
+    CRegisteredString registeredPath = m_factory->GetStringTable().RegisterStr(path);
+
+    QBENCHMARK {
+        QVERIFY(loadScene(ILoadedBuffer::CreateRead(m_factory->GetFoundation(), registeredPath),
+                          verifyChecksum));
+    }
+}
+
+void tst_bench_binaryload::mapPrivate_data()
+{
+    addSceneSizes();
+}
+
+void tst_bench_binaryload::mapPrivate()
+{
+    QFETCH(int, modelCount);
+    QFETCH(bool, verifyChecksum);
+    const QString path = createBinary(modelCount);
+    QVERIFY(!path.isEmpty());
+    CRegisteredString registeredPath = m_factory->GetStringTable().RegisterStr(path);
+
+    QBENCHMARK {
+        QVERIFY(loadScene(ILoadedBuffer::CreateMapped(m_factory->GetFoundation(),
+                                                      registeredPath),
+                          verifyChecksum));
+    }
+}
+
+void tst_bench_binaryload::loadUip_data()
+{
+    QTest::addColumn<int>("modelCount");
+    QTest::newRow("1k models") << 1000;
+    QTest::newRow("100k models") << 100000;
+}
+
+void tst_bench_binaryload::loadUip()
+{
+    QFETCH(int, modelCount);
+    const QString path = createUip(modelCount);
+    QVERIFY(!path.isEmpty());
+
+    QBENCHMARK {
+        Q3DStudio::IRuntimeView &view =
+                Q3DStudio::IRuntimeView::Create(m_timeProvider, m_windowSystem);
+        QVERIFY(view.BeginLoad(path, QStringList()));
+        QString errors;
+        const bool loaded = view.InitializeGraphics(QSurfaceFormat::defaultFormat(), false, true,
+                                                    QByteArray(), errors);
+        view.Cleanup();
+        view.release();
+        QVERIFY2(loaded, qPrintable(errors));
+    }
+}
+
+QT3DS_NULL_BACKEND_TEST_MAIN(tst_bench_binaryload)
+
+#include "tst_bench_binaryload.moc"
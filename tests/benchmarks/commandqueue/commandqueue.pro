@@ -0,0 +1,22 @@
+TEMPLATE = app
+CONFIG += benchmark
+include($$PWD/../../../commoninclude.pri)
+
+TARGET = tst_bench_commandqueue
+QT += testlib gui studio3d studio3d-private
+
+SOURCES += \
+    tst_bench_commandqueue.cpp
+
+LIBS += \
+    -lqt3dsopengl$$qtPlatformTargetSuffix()
+
+win32 {
+    LIBS += \
+        -lws2_32
+}
+
+linux {
+    LIBS += \
+        -ldl
+}
@@ -0,0 +1,340 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of Qt 3D Studio.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtCore/qfile.h>
+#include <QtCore/qtemporarydir.h>
+#include <QtCore/qtextstream.h>
+#include <QtCore/qvector.h>
+#include <QtGui/qoffscreensurface.h>
+#include <QtGui/qopenglcontext.h>
+#include <QtGui/qopenglframebufferobject.h>
+#include <QtStudio3D/q3dspresentation.h>
+#include <QtStudio3D/q3dssurfaceviewer.h>
+#include <QtStudio3D/private/q3dscommandqueue_p.h>
+#include "../../auto/runtime/Qt3DSRenderTestNullBackend.h"
+
+// Pushes a frame worth of attribute writes into a Q3DSSurfaceViewer running on the NULL render
+// backend. The baseline calls Q3DSPresentation::setAttribute directly, which is what the surface
+// viewer API does. The queued rows take the path of the Studio3D item instead: the API thread
+// queues into a pending queue, the render thread takes the commands over at synchronization and
+// applies them to the same presentation before rendering the frame.
+
+namespace {
+
+const int commandsPerFrame = 100000;
+// Ten attributes per model, so that every command of a frame can have a target of its own
+const int modelCount = commandsPerFrame / 10;
+const char *const attributeNames[] = {
+    "position.x", "position.y", "position.z",
+    "rotation.x", "rotation.y", "rotation.z",
+    "scale.x", "scale.y", "scale.z",
+    "opacity"
+};
+
+// Walks the render queue like Q3DSRenderer::processCommands without a runtime behind it
+float processCommands(CommandQueue &renderQueue)
+{
+    float sum = 0.0f;
+    for (int i = 0; i < renderQueue.size(); ++i) {
+        const ElementCommand &cmd = renderQueue.constCommandAt(i);
+        if (cmd.m_commandType == CommandType_SetAttribute) {
+            sum += cmd.m_floatValue;
+        } else if (cmd.m_commandType == CommandType_SetAttributeHandleValues) {
+            const AttributeHandleValues *data = static_cast<AttributeHandleValues *>(cmd.m_data);
+            for (float value : data->values)
+                sum += value;
+        }
+    }
+    renderQueue.clear(true);
+    return sum;
+}
+
+}
+
+class tst_bench_commandqueue : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+    void setAttribute_data();
+    void setAttribute();
+    void setAttributeSyncTwice();
+    void setAttributeAliasedPaths();
+    void attributeHandles_data();
+    void attributeHandles();
+
+private:
+    void createTargets(int targetCount);
+    QString createUip();
+    bool createViewer();
+
+    QVector<QString> m_elementPaths;
+    QVector<QString> m_attributeNames;
+    QTemporaryDir m_dir;
+    QOpenGLContext *m_context = nullptr;
+    QOffscreenSurface *m_surface = nullptr;
+    QOpenGLFramebufferObject *m_fbo = nullptr;
+    Q3DSSurfaceViewer *m_viewer = nullptr;
+};
+
+void tst_bench_commandqueue::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+}
+
+void tst_bench_commandqueue::cleanupTestCase()
+{
+    delete m_viewer;
+    m_viewer = nullptr;
+    delete m_fbo;
+    m_fbo = nullptr;
+    delete m_surface;
+    m_surface = nullptr;
+    delete m_context;
+    m_context = nullptr;
+}
+
+void tst_bench_commandqueue::createTargets(int targetCount)
+{
+    m_elementPaths.clear();
+    m_attributeNames.clear();
+    for (int i = 0; i < targetCount; ++i) {
+        m_elementPaths.append(QStringLiteral("Scene.Layer.Model%1").arg(i / 10));
+        m_attributeNames.append(QString::fromLatin1(attributeNames[i % 10]));
+    }
+}
+
+// One layer with modelCount rectangles, each with its own default material
+QString tst_bench_commandqueue::createUip()
+{
+    const QString path = m_dir.filePath(QStringLiteral("scene.uip"));
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+        return QString();
+    QTextStream out(&file);
+    out << "<?xml version=\"1.0\" encoding=\"UTF-8\" ?>\n"
+        << "<UIP version=\"6\" >\n"
+        << "\t<Project >\n"
+        << "\t\t<ProjectSettings presentationWidth=\"640\" presentationHeight=\"480\" />\n"
+        << "\t\t<Graph >\n"
+        << "\t\t\t<Scene id=\"Scene\" >\n"
+        << "\t\t\t\t<Layer id=\"Layer\" >\n";
+    for (int i = 0; i < modelCount; ++i) {
+        out << "\t\t\t\t\t<Model id=\"Model" << i << "\" >\n"
+            << "\t\t\t\t\t\t<Material id=\"Material" << i << "\" />\n"
+            << "\t\t\t\t\t</Model>\n";
+    }
+    out << "\t\t\t\t</Layer>\n"
+        << "\t\t\t</Scene>\n"
+        << "\t\t</Graph>\n"
+        << "\t\t<Logic >\n"
+        << "\t\t\t<State name=\"Master Slide\" component=\"#Scene\" >\n"
+        << "\t\t\t\t<Add ref=\"#Layer\" name=\"Layer\" />\n";
+    for (int i = 0; i < modelCount; ++i) {
+        out << "\t\t\t\t<Add ref=\"#Model" << i << "\" name=\"Model" << i
+            << "\" sourcepath=\"#Rectangle\" />\n"
+            << "\t\t\t\t<Add ref=\"#Material" << i << "\" name=\"Material" << i << "\" />\n";
+    }
+    out << "\t\t\t\t<State id=\"Scene-Slide1\" name=\"Slide1\" />\n"
+        << "\t\t\t</State>\n"
+        << "\t\t</Logic>\n"
+        << "\t</Project>\n"
+        << "</UIP>\n";
+    return path;
+}
+
+// The NULL backend renders nothing, but the viewer still needs a context to make current
+bool tst_bench_commandqueue::createViewer()
+{
+    if (m_viewer)
+        return true;
+
+    const QString path = createUip();
+    if (path.isEmpty())
+        return false;
+
+    m_context = new QOpenGLContext();
+    if (!m_context->create())
+        return false;
+    m_surface = new QOffscreenSurface();
+    m_surface->setFormat(m_context->format());
+    m_surface->create();
+    if (!m_context->makeCurrent(m_surface))
+        return false;
+    QOpenGLFramebufferObjectFormat fboFormat;
+    fboFormat.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
+    m_fbo = new QOpenGLFramebufferObject(QSize(640, 480), fboFormat);
+
+    m_viewer = new Q3DSSurfaceViewer();
+    m_viewer->presentation()->setSource(QUrl::fromLocalFile(path));
+    m_viewer->setAutoSize(false);
+    m_viewer->setSize(QSize(640, 480));
+    m_viewer->setUpdateInterval(-1);
+    return m_viewer->create(m_surface, m_context, m_fbo->handle());
+}
+
+void tst_bench_commandqueue::setAttribute_data()
+{
+    QTest::addColumn<bool>("queued");
+    QTest::addColumn<int>("targetCount");
+    // Every command writes a different attribute
+    QTest::newRow("baseline: direct setAttribute, unique targets")
+            << false << commandsPerFrame;
+    QTest::newRow("queued, unique targets") << true << commandsPerFrame;
+    // Telemetry like updates, each attribute is written many times per frame
+    QTest::newRow("baseline: direct setAttribute, 1000 targets") << false << 1000;
+    QTest::newRow("queued, 1000 targets") << true << 1000;
+}
+
+void tst_bench_commandqueue::setAttribute()
+{
+    QFETCH(bool, queued);
+    QFETCH(int, targetCount);
+    if (!createViewer())
+        QSKIP("Could not create the surface viewer");
+    createTargets(targetCount);
+    Q3DSPresentation *presentation = m_viewer->presentation();
+    CommandQueue pendingQueue;
+    CommandQueue renderQueue;
+
+    QBENCHMARK {
+        if (queued) {
+            for (int i = 0; i < commandsPerFrame; ++i) {
+                const int target = i % targetCount;
+                pendingQueue.queueCommand(m_elementPaths[target], CommandType_SetAttribute,
+                                          m_attributeNames[target], QVariant(float(i)));
+            }
+            renderQueue.copyCommands(pendingQueue);
+            pendingQueue.clear(false);
+            QCOMPARE(renderQueue.size(), targetCount);
+            for (int i = 0; i < renderQueue.size(); ++i) {
+                const ElementCommand &cmd = renderQueue.constCommandAt(i);
+                presentation->setAttribute(renderQueue.elementPath(cmd),
+                                           renderQueue.stringValue(cmd), renderQueue.value(cmd));
+            }
+            renderQueue.clear(true);
+        } else {
+            for (int i = 0; i < commandsPerFrame; ++i) {
+                const int target = i % targetCount;
+                presentation->setAttribute(m_elementPaths[target], m_attributeNames[target],
+                                           QVariant(float(i)));
+            }
+        }
+        m_viewer->update();
+    }
+}
+
+// The render thread has not processed the previous synchronization yet, so the commands are
+// appended to the render queue instead of taking over the pending queue.
+void tst_bench_commandqueue::setAttributeSyncTwice()
+{
+    createTargets(commandsPerFrame);
+    CommandQueue pendingQueue;
+    CommandQueue renderQueue;
+    float sum = 0.0f;
+
+    QBENCHMARK {
+        for (int sync = 0; sync < 2; ++sync) {
+            for (int i = sync; i < commandsPerFrame; i += 2) {
+                pendingQueue.queueCommand(m_elementPaths[i], CommandType_SetAttribute,
+                                          m_attributeNames[i], QVariant(float(i)));
+                pendingQueue.queueCommand(QString(), CommandType_MouseMove, i, i);
+            }
+            renderQueue.copyCommands(pendingQueue);
+            pendingQueue.clear(false);
+        }
+        QCOMPARE(renderQueue.size(), 2 * commandsPerFrame);
+        sum += processCommands(renderQueue);
+    }
+    QVERIFY(sum > 0.0f);
+}
+
+// Two paths naming the same element alternate. Merging either write into its earlier command
+// would apply the values out of order, so every write is queued.
+void tst_bench_commandqueue::setAttributeAliasedPaths()
+{
+    const QString paths[] = { QStringLiteral("Scene.Layer.Model0"),
+                              QStringLiteral("main:Scene.Layer.Model0") };
+    const QString attributeName = QStringLiteral("position.x");
+    CommandQueue pendingQueue;
+    CommandQueue renderQueue;
+    float sum = 0.0f;
+
+    QBENCHMARK {
+        for (int i = 0; i < commandsPerFrame; ++i) {
+            pendingQueue.queueCommand(paths[i % 2], CommandType_SetAttribute, attributeName,
+                                      QVariant(float(i)));
+        }
+        renderQueue.copyCommands(pendingQueue);
+        pendingQueue.clear(false);
+        QCOMPARE(renderQueue.size(), commandsPerFrame);
+        QCOMPARE(renderQueue.value(renderQueue.constCommandAt(commandsPerFrame - 1)).toFloat(),
+                 float(commandsPerFrame - 1));
+        sum += processCommands(renderQueue);
+    }
+    QVERIFY(sum > 0.0f);
+}
+
+void tst_bench_commandqueue::attributeHandles_data()
+{
+    QTest::addColumn<int>("batchSize");
+    QTest::newRow("single writes") << 1;
+    QTest::newRow("batches of 100") << 100;
+}
+
+void tst_bench_commandqueue::attributeHandles()
+{
+    QFETCH(int, batchSize);
+    QVector<int> handles(batchSize);
+    QVector<float> values(batchSize * 4);
+    for (int i = 0; i < batchSize; ++i)
+        handles[i] = i + 1;
+    CommandQueue pendingQueue;
+    CommandQueue renderQueue;
+    float sum = 0.0f;
+
+    QBENCHMARK {
+        for (int i = 0; i < commandsPerFrame; i += batchSize) {
+            values[0] = float(i);
+            pendingQueue.queueAttributeHandleValues(handles.constData(), values.constData(),
+                                                    batchSize);
+        }
+        renderQueue.copyCommands(pendingQueue);
+        pendingQueue.clear(false);
+        QCOMPARE(renderQueue.size(), 1);
+        sum += processCommands(renderQueue);
+    }
+    QVERIFY(sum > 0.0f);
+}
+
+QT3DS_NULL_BACKEND_TEST_MAIN(tst_bench_commandqueue)
+
+#include "tst_bench_commandqueue.moc"
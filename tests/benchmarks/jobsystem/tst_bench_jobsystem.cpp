@@ -0,0 +1,253 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of Qt 3D Studio.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+#include <QtCore/qatomic.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qqueue.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qwaitcondition.h>
+#include "foundation/TrackingAllocator.h"
+#include "foundation/Qt3DSFoundation.h"
+#include "Qt3DSRenderJobSystem.h"
+#include "Qt3DSRenderThreadPool.h"
+
+using namespace qt3ds;
+using namespace qt3ds::foundation;
+using namespace qt3ds::render;
+
+namespace {
+
+const int workerCount = 4;
+
+// Small fixed amount of work so the benchmark measures scheduling rather than payload.
+QAtomicInt s_completed;
+volatile quint32 s_sink;
+
+void payload(void *)
+{
+    quint32 value = 0;
+    for (quint32 i = 0; i < 256; ++i)
+        value = value * 1664525u + 1013904223u;
+    s_sink = value;
+    s_completed.fetchAndAddRelaxed(1);
+}
+
+void rangePayload(void *, QT3DSU32 begin, QT3DSU32 end)
+{
+    for (QT3DSU32 i = begin; i < end; ++i)
+        payload(nullptr);
+}
+
+// The scheduling model of the previous IThreadPool implementation: one mutex protected
+// FIFO shared by all threads and a single wake up event.
+class SingleQueuePool
+{
+public:
+    explicit SingleQueuePool(int threadCount)
+    {
+        for (int i = 0; i < threadCount; ++i) {
+            m_threads.append(QThread::create([this]() { run(); }));
+            m_threads.last()->start();
+        }
+    }
+    ~SingleQueuePool()
+    {
+        {
+            QMutexLocker locker(&m_mutex);
+            m_quit = true;
+            m_wake.wakeAll();
+        }
+        for (QThread *thread : qAsConst(m_threads)) {
+            thread->wait();
+            delete thread;
+        }
+    }
+    void addTask(void (*function)(void *))
+    {
+        QMutexLocker locker(&m_mutex);
+        m_tasks.enqueue(function);
+        m_wake.wakeOne();
+    }
+
+private:
+    void run()
+    {
+        QMutexLocker locker(&m_mutex);
+        while (!m_quit) {
+            if (m_tasks.isEmpty()) {
+                m_wake.wait(&m_mutex);
+                continue;
+            }
+            void (*function)(void *) = m_tasks.dequeue();
+            locker.unlock();
+            function(nullptr);
+            locker.relock();
+        }
+    }
+
+    QMutex m_mutex;
+    QWaitCondition m_wake;
+    QQueue<void (*)(void *)> m_tasks;
+    QVector<QThread *> m_threads;
+    bool m_quit = false;
+};
+
+void waitForCompletion(int taskCount)
+{
+    while (s_completed.loadAcquire() < taskCount)
+        QThread::yieldCurrentThread();
+}
+
+}
+
+class tst_bench_jobsystem : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+    void singleQueue_data();
+    void singleQueue();
+    void threadPoolShim_data();
+    void threadPoolShim();
+    void jobGroup_data();
+    void jobGroup();
+    void parallelFor_data();
+    void parallelFor();
+
+private:
+    void addTaskCounts();
+
+    CAllocator m_allocator;
+    NVFoundation *m_foundation = nullptr;
+    IJobSystem *m_jobSystem = nullptr;
+};
+
+void tst_bench_jobsystem::initTestCase()
+{
+    m_foundation = NVCreateFoundation(QT3DS_FOUNDATION_VERSION, m_allocator);
+    QVERIFY(m_foundation);
+    m_jobSystem = &IJobSystem::CreateJobSystem(*m_foundation, workerCount);
+    m_jobSystem->addRef();
+    QCOMPARE(m_jobSystem->GetWorkerCount(), QT3DSU32(workerCount));
+}
+
+void tst_bench_jobsystem::cleanupTestCase()
+{
+    m_jobSystem->release();
+    m_foundation->release();
+}
+
+void tst_bench_jobsystem::addTaskCounts()
+{
+    QTest::addColumn<int>("taskCount");
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("10000") << 10000;
+    QTest::newRow("100000") << 100000;
+}
+
+void tst_bench_jobsystem::singleQueue_data()
+{
+    addTaskCounts();
+}
+
+void tst_bench_jobsystem::singleQueue()
+{
+    QFETCH(int, taskCount);
+    SingleQueuePool pool(workerCount);
+
+    QBENCHMARK {
+        s_completed.storeRelease(0);
+        for (int i = 0; i < taskCount; ++i)
+            pool.addTask(payload);
+        waitForCompletion(taskCount);
+    }
+}
+
+void tst_bench_jobsystem::threadPoolShim_data()
+{
+    addTaskCounts();
+}
+
+void tst_bench_jobsystem::threadPoolShim()
+{
+    QFETCH(int, taskCount);
+    IThreadPool &pool = IThreadPool::CreateThreadPool(*m_foundation, *m_jobSystem);
+    pool.addRef();
+
+    QBENCHMARK {
+        s_completed.storeRelease(0);
+        for (int i = 0; i < taskCount; ++i)
+            pool.AddTask(nullptr, payload, nullptr);
+        waitForCompletion(taskCount);
+    }
+
+    pool.release();
+}
+
+void tst_bench_jobsystem::jobGroup_data()
+{
+    addTaskCounts();
+}
+
+void tst_bench_jobsystem::jobGroup()
+{
+    QFETCH(int, taskCount);
+
+    QBENCHMARK {
+        s_completed.storeRelease(0);
+        SJobGroup group;
+        for (int i = 0; i < taskCount; ++i)
+            m_jobSystem->Run(&group, nullptr, payload);
+        m_jobSystem->Wait(group);
+    }
+    QCOMPARE(s_completed.loadAcquire(), taskCount);
+}
+
+void tst_bench_jobsystem::parallelFor_data()
+{
+    addTaskCounts();
+}
+
+void tst_bench_jobsystem::parallelFor()
+{
+    QFETCH(int, taskCount);
+
+    QBENCHMARK {
+        s_completed.storeRelease(0);
+        m_jobSystem->ParallelFor(QT3DSU32(taskCount), 16, nullptr, rangePayload);
+    }
+    QCOMPARE(s_completed.loadAcquire(), taskCount);
+}
+
+QTEST_APPLESS_MAIN(tst_bench_jobsystem)
+
+#include "tst_bench_jobsystem.moc"
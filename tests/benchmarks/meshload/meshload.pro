@@ -0,0 +1,22 @@
+TEMPLATE = app
+CONFIG += benchmark
+include($$PWD/../../../commoninclude.pri)
+
+TARGET = tst_bench_meshload
+QT += testlib
+
+SOURCES += \
+    tst_bench_meshload.cpp
+
+LIBS += \
+    -lqt3dsopengl$$qtPlatformTargetSuffix()
+
+win32 {
+    LIBS += \
+        -lws2_32
+}
+
+linux {
+    LIBS += \
+        -ldl
+}
@@ -0,0 +1,195 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of Qt 3D Studio.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include "foundation/IOStreams.h"
+#include "foundation/TrackingAllocator.h"
+#include "Qt3DSImportMesh.h"
+
+using namespace qt3ds;
+using namespace qt3ds::foundation;
+using namespace qt3ds::render;
+
+namespace {
+
+// Interleaved position, normal and uv, the layout the importer writes for most models.
+struct BenchVertex
+{
+    float position[3];
+    float normal[3];
+    float uv[2];
+};
+
+}
+
+class tst_bench_meshload : public QObject
+{
+    Q_OBJECT
+
+public:
+    tst_bench_meshload();
+
+private Q_SLOTS:
+    void streamLoad_data();
+    void streamLoad();
+    void mappedLoad_data();
+    void mappedLoad();
+
+private:
+    void addMeshSizes();
+    void createMeshFiles(int gridSize);
+
+    CAllocator m_allocator;
+    CMemorySeekableIOStream m_meshFile;
+    CMemorySeekableIOStream m_mappableMeshFile;
+};
+
+tst_bench_meshload::tst_bench_meshload()
+    : m_meshFile(m_allocator, "tst_bench_meshload::m_meshFile")
+    , m_mappableMeshFile(m_allocator, "tst_bench_meshload::m_mappableMeshFile")
+{
+}
+
+void tst_bench_meshload::addMeshSizes()
+{
+    QTest::addColumn<int>("gridSize");
+    QTest::newRow("10k vertices") << 100;
+    QTest::newRow("1M vertices") << 1000;
+}
+
+// A square grid of gridSize * gridSize vertices saved both in the current format and in the
+// mappable one.
+void tst_bench_meshload::createMeshFiles(int gridSize)
+{
+    QVector<BenchVertex> vertices(gridSize * gridSize);
+    for (int y = 0; y < gridSize; ++y) {
+        for (int x = 0; x < gridSize; ++x) {
+            BenchVertex &vertex(vertices[y * gridSize + x]);
+            vertex.position[0] = float(x);
+            vertex.position[1] = float(y);
+            vertex.position[2] = 0.0f;
+            vertex.normal[0] = 0.0f;
+            vertex.normal[1] = 0.0f;
+            vertex.normal[2] = 1.0f;
+            vertex.uv[0] = float(x) / float(gridSize - 1);
+            vertex.uv[1] = float(y) / float(gridSize - 1);
+        }
+    }
+    QVector<QT3DSU32> indices;
+    indices.reserve((gridSize - 1) * (gridSize - 1) * 6);
+    for (int y = 0; y < gridSize - 1; ++y) {
+        for (int x = 0; x < gridSize - 1; ++x) {
+            QT3DSU32 corner = QT3DSU32(y * gridSize + x);
+            indices << corner << corner + 1 << corner + gridSize
+                    << corner + 1 << corner + gridSize + 1 << corner + gridSize;
+        }
+    }
+
+    NVRenderVertexBufferEntry entries[] = {
+        NVRenderVertexBufferEntry(qt3dsimp::Mesh::GetPositionAttrName(),
+                                  NVRenderComponentTypes::QT3DSF32, 3, 0),
+        NVRenderVertexBufferEntry(qt3dsimp::Mesh::GetNormalAttrName(),
+                                  NVRenderComponentTypes::QT3DSF32, 3, 12),
+        NVRenderVertexBufferEntry(qt3dsimp::Mesh::GetUVAttrName(),
+                                  NVRenderComponentTypes::QT3DSF32, 2, 24),
+    };
+    qt3dsimp::MeshBuilder &builder(qt3dsimp::MeshBuilder::CreateMeshBuilder());
+    builder.SetVertexBuffer(toConstDataRef(entries, 3), sizeof(BenchVertex),
+                            toU8ConstDataRef(vertices.constData(), QT3DSU32(vertices.size())));
+    builder.SetIndexBuffer(toU8ConstDataRef(indices.constData(), QT3DSU32(indices.size())),
+                           NVRenderComponentTypes::QT3DSU32);
+    builder.AddMeshSubset(L"grid", QT3DSU32(indices.size()), 0, 0);
+
+    m_meshFile.clear();
+    m_mappableMeshFile.clear();
+    QCOMPARE(builder.GetMesh().SaveMulti(m_allocator, m_meshFile, 1), QT3DSU32(1));
+    QCOMPARE(builder.GetMesh().SaveMulti(m_allocator, m_mappableMeshFile, 1, true), QT3DSU32(1));
+    builder.Release();
+}
+
+void tst_bench_meshload::streamLoad_data()
+{
+    addMeshSizes();
+}
+
+// What the buffer manager did for every mesh: read the file and fix up the offsets.
+void tst_bench_meshload::streamLoad()
+{
+    QFETCH(int, gridSize);
+    createMeshFiles(gridSize);
+
+    QBENCHMARK {
+        qt3dsimp::SMultiLoadResult result(qt3dsimp::Mesh::LoadMulti(m_allocator, m_meshFile, 1));
+        QVERIFY(result.m_Mesh);
+        m_allocator.deallocate(result.m_Mesh);
+    }
+}
+
+void tst_bench_meshload::mappedLoad_data()
+{
+    addMeshSizes();
+}
+
+// Finding and validating a mesh in a mapped mappable file.
+void tst_bench_meshload::mappedLoad()
+{
+    QFETCH(int, gridSize);
+    createMeshFiles(gridSize);
+    NVConstDataRef<QT3DSU8> fileData(m_mappableMeshFile.begin(), m_mappableMeshFile.size());
+    qt3dsimp::Mesh *mappedMesh = nullptr;
+
+    QBENCHMARK {
+        mappedMesh = qt3dsimp::Mesh::LoadMultiMapped(fileData, 1).m_Mesh;
+        QVERIFY(mappedMesh);
+    }
+
+    // Same contents as the mesh saved in the current format, and the mappable file still
+    // loads through a stream.
+    qt3dsimp::Mesh *streamMesh = qt3dsimp::Mesh::LoadMulti(m_allocator, m_meshFile, 1).m_Mesh;
+    qt3dsimp::Mesh *mappableStreamMesh =
+        qt3dsimp::Mesh::LoadMulti(m_allocator, m_mappableMeshFile, 1).m_Mesh;
+    QVERIFY(streamMesh);
+    QVERIFY(mappableStreamMesh);
+    const QT3DSU8 *mappedBase = mappedMesh->GetBaseAddress();
+    const QT3DSU8 *streamBase = streamMesh->GetBaseAddress();
+    QCOMPARE(quintptr(mappedMesh->m_VertexBuffer.m_Data.begin(mappedBase)) % 16, quintptr(0));
+    QCOMPARE(mappedMesh->m_VertexBuffer.m_Data.size(), streamMesh->m_VertexBuffer.m_Data.size());
+    QVERIFY(memcmp(mappedMesh->m_VertexBuffer.m_Data.begin(mappedBase),
+                   streamMesh->m_VertexBuffer.m_Data.begin(streamBase),
+                   streamMesh->m_VertexBuffer.m_Data.size()) == 0);
+    QCOMPARE(mappedMesh->m_IndexBuffer.m_Data.size(), streamMesh->m_IndexBuffer.m_Data.size());
+    QCOMPARE(mappedMesh->m_Subsets.size(), streamMesh->m_Subsets.size());
+    QCOMPARE(mappableStreamMesh->m_VertexBuffer.m_Data.size(),
+             streamMesh->m_VertexBuffer.m_Data.size());
+    m_allocator.deallocate(streamMesh);
+    m_allocator.deallocate(mappableStreamMesh);
+}
+
+QTEST_APPLESS_MAIN(tst_bench_meshload)
+
+#include "tst_bench_meshload.moc"
@@ -0,0 +1,252 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of Qt 3D Studio.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <QtCore/qvector.h>
+#include "foundation/TrackingAllocator.h"
+#include "Qt3DSRendererImplPickBvh.h"
+
+using namespace qt3ds;
+using namespace qt3ds::foundation;
+using namespace qt3ds::render;
+
+namespace {
+
+// Rays cast per benchmark iteration, standing in for a burst of mouse move events.
+const int raysPerIteration = 64;
+
+// Stand in for a pickable renderable: local bounds and the global transform placing them.
+struct BenchPickable
+{
+    NVBounds3 bounds;
+    QT3DSMat44 globalTransform;
+};
+
+float nextRandom(quint32 &seed)
+{
+    seed = seed * 1664525u + 1013904223u;
+    return float(seed >> 8) / float(1 << 24);
+}
+
+}
+
+class tst_bench_pickbvh : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void bruteForcePick_data();
+    void bruteForcePick();
+    void bvhPick_data();
+    void bvhPick();
+    void bvhBuild_data();
+    void bvhBuild();
+    void bvhRefit_data();
+    void bvhRefit();
+
+private:
+    void addSceneSizes();
+    void createScene(int pickableCount);
+    void moveScene(int frame);
+    void fillBvh(SPickBvh &bvh) const;
+    int exactPick(const SRay &ray, const QT3DSU32 *candidates, int candidateCount) const;
+
+    QVector<BenchPickable> m_pickables;
+    QVector<SRay> m_rays;
+    CAllocator m_allocator;
+};
+
+void tst_bench_pickbvh::addSceneSizes()
+{
+    QTest::addColumn<int>("pickableCount");
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("10000") << 10000;
+}
+
+// Small boxes scattered through a 1000 unit cube, looked at from a camera in front of it.
+void tst_bench_pickbvh::createScene(int pickableCount)
+{
+    m_pickables.resize(pickableCount);
+    quint32 seed = 12345;
+    for (BenchPickable &pickable : m_pickables) {
+        float halfSize = 1.0f + nextRandom(seed) * 4.0f;
+        pickable.bounds = NVBounds3(QT3DSVec3(-halfSize), QT3DSVec3(halfSize));
+        pickable.globalTransform = QT3DSMat44::createIdentity();
+        pickable.globalTransform.setPosition(QT3DSVec3(nextRandom(seed) * 1000.0f - 500.0f,
+                                                       nextRandom(seed) * 1000.0f - 500.0f,
+                                                       nextRandom(seed) * 1000.0f - 500.0f));
+    }
+
+    m_rays.resize(raysPerIteration);
+    const QT3DSVec3 cameraPosition(0.0f, 0.0f, 1000.0f);
+    for (SRay &ray : m_rays) {
+        QT3DSVec3 target(nextRandom(seed) * 1000.0f - 500.0f,
+                         nextRandom(seed) * 1000.0f - 500.0f, 0.0f);
+        QT3DSVec3 direction(target - cameraPosition);
+        direction.normalize();
+        ray = SRay(cameraPosition, direction);
+    }
+}
+
+// Moves every pickable a little, as an animation would between two frames.
+void tst_bench_pickbvh::moveScene(int frame)
+{
+    const float offset = (frame % 2) ? 0.5f : -0.5f;
+    for (BenchPickable &pickable : m_pickables) {
+        QT3DSVec3 position(pickable.globalTransform.getPosition());
+        position.x += offset;
+        pickable.globalTransform.setPosition(position);
+    }
+}
+
+void tst_bench_pickbvh::fillBvh(SPickBvh &bvh) const
+{
+    bvh.m_Bounds.clear();
+    bvh.m_Keys.clear();
+    for (const BenchPickable &pickable : m_pickables) {
+        NVBounds3 worldBounds(pickable.bounds);
+        worldBounds.transform(pickable.globalTransform);
+        bvh.m_Bounds.push_back(worldBounds);
+        bvh.m_Keys.push_back(&pickable);
+    }
+}
+
+int tst_bench_pickbvh::exactPick(const SRay &ray, const QT3DSU32 *candidates,
+                                 int candidateCount) const
+{
+    int hitCount = 0;
+    for (int i = 0; i < candidateCount; ++i) {
+        const BenchPickable &pickable = m_pickables[int(candidates[i])];
+        if (ray.IntersectWithAABB(pickable.globalTransform, pickable.bounds).hasValue())
+            ++hitCount;
+    }
+    return hitCount;
+}
+
+void tst_bench_pickbvh::bruteForcePick_data()
+{
+    addSceneSizes();
+}
+
+// What the renderer did before: the exact test against every pickable of the layer.
+void tst_bench_pickbvh::bruteForcePick()
+{
+    QFETCH(int, pickableCount);
+    createScene(pickableCount);
+    QVector<QT3DSU32> all(pickableCount);
+    for (int i = 0; i < pickableCount; ++i)
+        all[i] = QT3DSU32(i);
+    int hitCount = 0;
+
+    QBENCHMARK {
+        hitCount = 0;
+        for (const SRay &ray : qAsConst(m_rays))
+            hitCount += exactPick(ray, all.constData(), pickableCount);
+    }
+    QVERIFY(hitCount > 0);
+}
+
+void tst_bench_pickbvh::bvhPick_data()
+{
+    addSceneSizes();
+}
+
+void tst_bench_pickbvh::bvhPick()
+{
+    QFETCH(int, pickableCount);
+    createScene(pickableCount);
+    QVector<QT3DSU32> all(pickableCount);
+    for (int i = 0; i < pickableCount; ++i)
+        all[i] = QT3DSU32(i);
+    SPickBvh bvh(m_allocator);
+    fillBvh(bvh);
+    bvh.Update();
+    nvvector<QT3DSU32> hits(m_allocator, "tst_bench_pickbvh::hits");
+    int hitCount = 0;
+
+    QBENCHMARK {
+        hitCount = 0;
+        for (const SRay &ray : qAsConst(m_rays)) {
+            hits.clear();
+            bvh.Pick(ray, hits);
+            hitCount += exactPick(ray, hits.data(), int(hits.size()));
+        }
+    }
+
+    // Same hits as testing everything.
+    int expectedCount = 0;
+    for (const SRay &ray : qAsConst(m_rays))
+        expectedCount += exactPick(ray, all.constData(), pickableCount);
+    QCOMPARE(hitCount, expectedCount);
+}
+
+void tst_bench_pickbvh::bvhBuild_data()
+{
+    addSceneSizes();
+}
+
+// First pick after the set of pickables changed.
+void tst_bench_pickbvh::bvhBuild()
+{
+    QFETCH(int, pickableCount);
+    createScene(pickableCount);
+    SPickBvh bvh(m_allocator);
+
+    QBENCHMARK {
+        fillBvh(bvh);
+        bvh.Invalidate();
+        bvh.m_LastKeys.clear();
+        QVERIFY(!bvh.Update());
+    }
+}
+
+void tst_bench_pickbvh::bvhRefit_data()
+{
+    addSceneSizes();
+}
+
+// First pick after a frame in which the same pickables moved.
+void tst_bench_pickbvh::bvhRefit()
+{
+    QFETCH(int, pickableCount);
+    createScene(pickableCount);
+    SPickBvh bvh(m_allocator);
+    fillBvh(bvh);
+    bvh.Update();
+    int frame = 0;
+
+    QBENCHMARK {
+        moveScene(++frame);
+        fillBvh(bvh);
+        QVERIFY(bvh.Update());
+    }
+}
+
+QTEST_APPLESS_MAIN(tst_bench_pickbvh)
+
+#include "tst_bench_pickbvh.moc"
@@ -0,0 +1,232 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of Qt 3D Studio.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+#include <QtCore/qvector.h>
+#include <algorithm>
+#include <random>
+#include "foundation/TrackingAllocator.h"
+#include "Qt3DSRendererImplRenderableSort.h"
+
+using namespace qt3ds;
+using namespace qt3ds::foundation;
+using namespace qt3ds::render;
+
+namespace {
+
+// Stand in for SRenderableObject: the sort inputs live in separately allocated objects
+// that are reached through a pointer list, as they are in the renderer.
+struct BenchRenderable
+{
+    float worldCenter[3];
+    float cameraDistance;
+    quint32 shaderId;
+    quint32 materialId;
+    char payload[160];
+};
+
+bool distanceLessThan(const BenchRenderable *lhs, const BenchRenderable *rhs)
+{
+    const float diff = lhs->cameraDistance - rhs->cameraDistance;
+    if (qAbs(diff) < .001f)
+        return false;
+    return diff < 0.0f;
+}
+
+}
+
+class tst_bench_rendersort : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void cleanup();
+    void pointerMergeSort_data();
+    void pointerMergeSort();
+    void packedRadixSort_data();
+    void packedRadixSort();
+    void packedRadixSortUnchanged_data();
+    void packedRadixSortUnchanged();
+    void transparentKeys();
+
+private:
+    void addSceneSizes();
+    void createScene(int renderableCount);
+    void moveCamera(int frame);
+    void buildKeys(SRenderableSortCache &cache) const;
+
+    QVector<BenchRenderable *> m_renderables;
+    CAllocator m_allocator;
+};
+
+void tst_bench_rendersort::cleanup()
+{
+    qDeleteAll(m_renderables);
+    m_renderables.clear();
+}
+
+void tst_bench_rendersort::addSceneSizes()
+{
+    QTest::addColumn<int>("renderableCount");
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("10000") << 10000;
+    QTest::newRow("50000") << 50000;
+}
+
+void tst_bench_rendersort::createScene(int renderableCount)
+{
+    cleanup();
+    // Allocate in a shuffled order so neighbours in the list are not neighbours in memory.
+    QVector<BenchRenderable *> allocated;
+    for (int i = 0; i < renderableCount; ++i)
+        allocated.append(new BenchRenderable());
+    std::shuffle(allocated.begin(), allocated.end(), std::mt19937(42));
+    m_renderables = allocated;
+
+    quint32 seed = 12345;
+    for (BenchRenderable *renderable : qAsConst(m_renderables)) {
+        for (float &coordinate : renderable->worldCenter) {
+            seed = seed * 1664525u + 1013904223u;
+            coordinate = float(seed >> 8) / float(1 << 24) * 1000.0f - 500.0f;
+        }
+        seed = seed * 1664525u + 1013904223u;
+        renderable->shaderId = (seed >> 16) % 32;
+        renderable->materialId = (seed >> 8) % 256;
+    }
+    moveCamera(0);
+}
+
+void tst_bench_rendersort::moveCamera(int frame)
+{
+    const float cameraZ = 600.0f + float(frame % 16);
+    for (BenchRenderable *renderable : qAsConst(m_renderables))
+        renderable->cameraDistance = cameraZ - renderable->worldCenter[2];
+}
+
+void tst_bench_rendersort::buildKeys(SRenderableSortCache &cache) const
+{
+    const int count = m_renderables.size();
+    cache.m_Keys.resize(QT3DSU32(count));
+    for (int i = 0; i < count; ++i) {
+        const BenchRenderable &renderable = *m_renderables[i];
+        cache.m_Keys[QT3DSU32(i)] = MakeOpaqueSortKey(renderable.cameraDistance,
+                                                      renderable.shaderId,
+                                                      renderable.materialId);
+    }
+}
+
+void tst_bench_rendersort::pointerMergeSort_data()
+{
+    addSceneSizes();
+}
+
+// What the layer preparation did before: stable sort of the pointer list comparing
+// camera distances through the pointers.
+void tst_bench_rendersort::pointerMergeSort()
+{
+    QFETCH(int, renderableCount);
+    createScene(renderableCount);
+    QVector<BenchRenderable *> sorted;
+    int frame = 0;
+
+    QBENCHMARK {
+        moveCamera(++frame);
+        sorted = m_renderables;
+        std::stable_sort(sorted.begin(), sorted.end(), distanceLessThan);
+    }
+}
+
+void tst_bench_rendersort::packedRadixSort_data()
+{
+    addSceneSizes();
+}
+
+void tst_bench_rendersort::packedRadixSort()
+{
+    QFETCH(int, renderableCount);
+    createScene(renderableCount);
+    SRenderableSortCache cache(m_allocator);
+    QVector<BenchRenderable *> sorted(renderableCount);
+    int frame = 0;
+
+    QBENCHMARK {
+        moveCamera(++frame);
+        buildKeys(cache);
+        QVERIFY(!cache.Sort());
+        for (int i = 0; i < renderableCount; ++i)
+            sorted[i] = m_renderables[int(cache.m_Order[QT3DSU32(i)])];
+    }
+
+    for (int i = 1; i < renderableCount; ++i)
+        QVERIFY(sorted[i - 1]->cameraDistance <= sorted[i]->cameraDistance + 0.01f);
+}
+
+void tst_bench_rendersort::packedRadixSortUnchanged_data()
+{
+    addSceneSizes();
+}
+
+// A frame in which nothing moved reuses the previous order.
+void tst_bench_rendersort::packedRadixSortUnchanged()
+{
+    QFETCH(int, renderableCount);
+    createScene(renderableCount);
+    SRenderableSortCache cache(m_allocator);
+    buildKeys(cache);
+    cache.Sort();
+    QVector<BenchRenderable *> sorted(renderableCount);
+
+    QBENCHMARK {
+        buildKeys(cache);
+        QVERIFY(cache.Sort());
+        for (int i = 0; i < renderableCount; ++i)
+            sorted[i] = m_renderables[int(cache.m_Order[QT3DSU32(i)])];
+    }
+}
+
+// Transparent renderables are drawn back to front; close distances are not merged and equal
+// distances keep the list order, whatever shader or material they use.
+void tst_bench_rendersort::transparentKeys()
+{
+    const float distances[] = { 10.0f, 10.0001f, 5.0f, 10.0f, 10.0001f, 10.0f, -3.0f };
+    const int count = int(sizeof(distances) / sizeof(distances[0]));
+    SRenderableSortCache cache(m_allocator);
+    cache.m_Keys.resize(QT3DSU32(count));
+    for (int i = 0; i < count; ++i)
+        cache.m_Keys[QT3DSU32(i)] = MakeTransparentSortKey(distances[i]);
+    cache.Sort();
+
+    const QT3DSU32 expected[] = { 1, 4, 0, 3, 5, 2, 6 };
+    for (int i = 0; i < count; ++i)
+        QCOMPARE(cache.m_Order[QT3DSU32(i)], expected[i]);
+}
+
+QTEST_APPLESS_MAIN(tst_bench_rendersort)
+
+#include "tst_bench_rendersort.moc"
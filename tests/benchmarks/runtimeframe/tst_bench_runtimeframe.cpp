@@ -0,0 +1,311 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of Qt 3D Studio.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+#include <QtCore/qatomic.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qtemporarydir.h>
+#include <QtCore/qtextstream.h>
+#include <QtGui/qevent.h>
+#include <QtGui/qguiapplication.h>
+#include <QtGui/qsurfaceformat.h>
+#include "foundation/Qt3DSBroadcastingAllocator.h"
+#include "foundation/Qt3DSPerfTimer.h"
+#include "Qt3DSRuntimeView.h"
+#include "Qt3DSApplication.h"
+#include "Qt3DSRuntimeFactory.h"
+#include "Qt3DSRenderContextCore.h"
+#include "Qt3DSFNDTimer.h"
+#include "../../auto/runtime/Qt3DSRenderTestNullBackend.h"
+
+#include <cmath>
+
+// Runs whole frames of the runtime on the NULL render backend, so the numbers are the CPU side
+// of IApplication::UpdateAndRender without a GPU or a window. Each row reports the frame time,
+// the split over the frame phases recorded by the runtime perf timers and the number of
+// foundation allocations per frame. The benchmark enables the perf timer itself, so the phase
+// split works in any runtime build.
+//
+// Synthetic projects are generated into a temporary directory; set QT3DS_BENCH_PROJECT to a
+// .uia or .uip file to measure a real project as an additional row.
+
+namespace {
+
+// Animation time advances by a fixed step per frame so runs are reproducible
+const int frameIntervalMs = 16;
+const int warmupFrames = 10;
+
+struct SAllocationCounter : public qt3ds::NVAllocationListener
+{
+    QAtomicInt m_count;
+
+    void onAllocation(size_t, const char *, const char *, int, void *) override
+    {
+        m_count.fetchAndAddRelaxed(1);
+    }
+    void onDeallocation(void *) override {}
+};
+
+class FrameRunner
+{
+public:
+    ~FrameRunner()
+    {
+        if (!m_view)
+            return;
+        if (m_application) {
+            m_application->GetRuntimeFactory().GetQt3DSRenderContext().GetFoundation()
+                    .getAllocator().deregisterAllocationListener(m_allocations);
+        }
+        m_view->Cleanup();
+        m_view->release();
+    }
+
+    bool load(const QString &source)
+    {
+        m_view = &Q3DStudio::IRuntimeView::Create(m_timeProvider, m_windowSystem);
+        if (!m_view->BeginLoad(source, QStringList()))
+            return false;
+        QString errors;
+        if (!m_view->InitializeGraphics(QSurfaceFormat::defaultFormat(), false, true,
+                                        QByteArray(), errors)) {
+            return false;
+        }
+        m_view->connectSignals();
+        QResizeEvent event(m_windowSystem.m_size, QSize());
+        m_view->HandleMessage(&event);
+
+        m_application = m_view->GetApplication();
+        if (!m_application)
+            return false;
+        m_application->GetRuntimeFactory().GetQt3DSRenderContext().GetFoundation()
+                .getAllocator().registerAllocationListener(m_allocations);
+        m_application->GetRuntimeFactory().GetPerfTimer().SetEnabled(true);
+
+        for (int i = 0; i < warmupFrames; ++i)
+            renderFrame();
+        resetStatistics();
+        return true;
+    }
+
+    void renderFrame()
+    {
+        // Zero means the runtime clock, so manual time starts from the first interval
+        m_timeMs += frameIntervalMs;
+        m_application->SetTimeMilliSecs(m_timeMs);
+        m_view->Render();
+        ++m_frames;
+    }
+
+    void resetStatistics()
+    {
+        m_application->GetRuntimeFactory().GetPerfTimer().ResetTimerData();
+        m_allocations.m_count.store(0);
+        m_frames = 0;
+    }
+
+    void report(const char *name)
+    {
+        if (!m_frames)
+            return;
+        qt3ds::foundation::IPerfTimer &timer = m_application->GetRuntimeFactory().GetPerfTimer();
+        auto total = [&timer](const char *tag) { return timer.GetTotalDuration(tag); };
+
+        const double animation = total("Presentation: Animation");
+        const double prepare = total("LayerRenderData: PrepareForRender");
+        const double sorting = total("LayerRenderData: SortRenderableObjects");
+        // Sorting runs inside layer preparation and preparation inside the render call, so
+        // the nested timers are subtracted to get exclusive phase times.
+        const double phases[] = {
+            total("UpdatePresentations: Input"),
+            total("Application: Behaviors") + total("UpdatePresentations: PreUpdate")
+                    + total("UpdatePresentations: BeginUpdate")
+                    + total("UpdatePresentations: EndUpdate")
+                    + total("UpdatePresentations: PostUpdate") - animation,
+            animation,
+            total("Application: UpdateScenes"),
+            prepare - sorting,
+            sorting,
+            total("Application: Render") - prepare
+        };
+        const char *phaseNames[] = { "input", "logic/slides", "animation", "binding translation",
+                                     "layer preparation", "sorting", "submission" };
+
+        qInfo("%s: %d frames, %.1f foundation allocations/frame", name, m_frames,
+              double(m_allocations.m_count.load()) / m_frames);
+        for (int i = 0; i < int(sizeof(phases) / sizeof(phases[0])); ++i)
+            qInfo("    %-20s %8.4f ms/frame", phaseNames[i], phases[i] / m_frames);
+    }
+
+private:
+    Q3DStudio::Qt3DSFNDTimer m_timeProvider;
+    qt3ds::render::SNullBackendWindowSystem m_windowSystem;
+    SAllocationCounter m_allocations;
+    Q3DStudio::IRuntimeView *m_view = nullptr;
+    qt3ds::runtime::IApplication *m_application = nullptr;
+    Q3DStudio::INT64 m_timeMs = 0;
+    int m_frames = 0;
+};
+
+// Writes a single layer presentation. Each entry of models is a chain of nested groups
+// ending in a cube, animatedTracks puts that many looping tracks on every cube.
+QString writePresentation(const QString &path, int models, int depth, int animatedTracks)
+{
+    static const char *trackProperties[] = {
+        "position.x", "position.y", "position.z", "rotation.x", "rotation.y", "rotation.z",
+        "scale.x", "scale.y", "scale.z"
+    };
+    const int columns = qMax(1, int(std::ceil(std::sqrt(double(models)))));
+
+    QString graph;
+    QString master;
+    QTextStream g(&graph);
+    QTextStream m(&master);
+    for (int i = 0; i < models; ++i) {
+        QString indent = QStringLiteral("\t\t\t\t\t");
+        for (int d = 0; d < depth; ++d) {
+            g << indent << "<Group id=\"Group_" << i << "_" << d << "\" >\n";
+            m << "\t\t\t\t<Add ref=\"#Group_" << i << "_" << d << "\" rotation=\"0 0 "
+              << (d * 5) << "\" />\n";
+            indent += QLatin1Char('\t');
+        }
+        g << indent << "<Model id=\"Model_" << i << "\" >\n"
+          << indent << "\t<Material id=\"Material_" << i << "\" />\n"
+          << indent << "</Model>\n";
+        for (int d = depth - 1; d >= 0; --d) {
+            indent.chop(1);
+            g << indent << "</Group>\n";
+        }
+
+        const float x = (i % columns) * 600.0f / columns - 300.0f;
+        const float y = (i / columns) * 600.0f / columns - 300.0f;
+        m << "\t\t\t\t<Add ref=\"#Model_" << i << "\" name=\"Model_" << i << "\" position=\""
+          << x << " " << y << " 0\" scale=\"0.2 0.2 0.2\" sourcepath=\"#Cube\" >\n";
+        for (int t = 0; t < animatedTracks; ++t) {
+            m << "\t\t\t\t\t<AnimationTrack property=\"" << trackProperties[t % 9]
+              << "\" type=\"EaseInOut\" >0 0 100 100 " << (1 + t % 3)
+              << " 20 100 100 5 0 100 100</AnimationTrack>\n";
+        }
+        m << "\t\t\t\t</Add>\n"
+          << "\t\t\t\t<Add ref=\"#Material_" << i << "\" diffuse=\"" << ((i % 7) / 7.0f)
+          << " 0.5 1 1\" opacity=\"" << (i % 4 ? 100 : 50) << "\" />\n";
+    }
+
+    g.flush();
+    m.flush();
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+        return QString();
+    QTextStream out(&file);
+    out << "<?xml version=\"1.0\" encoding=\"UTF-8\" ?>\n"
+        << "<UIP version=\"6\" >\n"
+        << "\t<Project >\n"
+        << "\t\t<ProjectSettings presentationWidth=\"1280\" presentationHeight=\"720\" />\n"
+        << "\t\t<Graph >\n"
+        << "\t\t\t<Scene id=\"Scene\" >\n"
+        << "\t\t\t\t<Layer id=\"Layer\" >\n"
+        << "\t\t\t\t\t<Camera id=\"Camera\" />\n"
+        << "\t\t\t\t\t<Light id=\"Light\" />\n"
+        << graph
+        << "\t\t\t\t</Layer>\n"
+        << "\t\t\t</Scene>\n"
+        << "\t\t</Graph>\n"
+        << "\t\t<Logic >\n"
+        << "\t\t\t<State name=\"Master Slide\" component=\"#Scene\" >\n"
+        << "\t\t\t\t<Add ref=\"#Layer\" />\n"
+        << "\t\t\t\t<Add ref=\"#Camera\" />\n"
+        << "\t\t\t\t<Add ref=\"#Light\" />\n"
+        << master
+        << "\t\t\t\t<State id=\"Scene-Slide1\" name=\"Slide1\" playmode=\"Looping\" >\n"
+        << "\t\t\t\t\t<Set ref=\"#Layer\" endtime=\"5000\" />\n"
+        << "\t\t\t\t</State>\n"
+        << "\t\t\t</State>\n"
+        << "\t\t</Logic>\n"
+        << "\t</Project>\n"
+        << "</UIP>\n";
+    return path;
+}
+
+}
+
+class tst_bench_runtimeframe : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void frame_data();
+    void frame();
+
+private:
+    QTemporaryDir m_projectDir;
+};
+
+void tst_bench_runtimeframe::initTestCase()
+{
+    QVERIFY(m_projectDir.isValid());
+}
+
+void tst_bench_runtimeframe::frame_data()
+{
+    QTest::addColumn<QString>("source");
+
+    const QString dir = m_projectDir.path();
+    QTest::newRow("models-1000")
+            << writePresentation(dir + QStringLiteral("/models.uip"), 1000, 0, 0);
+    QTest::newRow("hierarchy-64x16")
+            << writePresentation(dir + QStringLiteral("/hierarchy.uip"), 64, 16, 0);
+    QTest::newRow("animation-200x9")
+            << writePresentation(dir + QStringLiteral("/animation.uip"), 200, 0, 9);
+    QTest::newRow("simple_cube_animation")
+            << QFINDTESTDATA("../../scenes/simple_cube_animation/simple_cube_animation.uia");
+
+    const QString project = qEnvironmentVariable("QT3DS_BENCH_PROJECT");
+    if (!project.isEmpty())
+        QTest::newRow("project") << project;
+}
+
+void tst_bench_runtimeframe::frame()
+{
+    QFETCH(QString, source);
+    QVERIFY(!source.isEmpty());
+
+    FrameRunner runner;
+    QVERIFY(runner.load(source));
+
+    QBENCHMARK {
+        runner.renderFrame();
+    }
+    runner.report(QTest::currentDataTag());
+}
+
+QT3DS_NULL_BACKEND_TEST_MAIN(tst_bench_runtimeframe)
+
+#include "tst_bench_runtimeframe.moc"
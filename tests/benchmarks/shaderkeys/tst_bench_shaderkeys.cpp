@@ -0,0 +1,253 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 The Qt Company Ltd.
+** Contact: http://www.qt.io/licensing/
+**
+** This file is part of Qt 3D Studio.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QtTest>
+#include <QtCore/qhash.h>
+#include <QtCore/qset.h>
+#include <QtCore/qvector.h>
+#include "foundation/TrackingAllocator.h"
+#include "Qt3DSRendererImplShaderProgramTable.h"
+
+using namespace qt3ds;
+using namespace qt3ds::foundation;
+using namespace qt3ds::render;
+
+namespace {
+
+// Shader lookups per benchmark iteration, roughly the subsets of a busy frame.
+const int lookupsPerIteration = 10000;
+
+// Stand in for a generated shader, only its address is stored.
+struct BenchProgram
+{
+    int id;
+};
+
+struct BenchLookup
+{
+    int keyIndex;
+    ShaderProgramPasses::Enum pass;
+};
+
+}
+
+class tst_bench_shaderkeys : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void stringKeyLookup_data();
+    void stringKeyLookup();
+    void hashMapLookup_data();
+    void hashMapLookup();
+    void programTableLookup_data();
+    void programTableLookup();
+
+private:
+    void addKeyCounts();
+    void createKeys(int keyCount);
+
+    SShaderDefaultMaterialKeyProperties m_properties;
+    QVector<SShaderDefaultMaterialKey> m_keys;
+    QVector<BenchLookup> m_lookups;
+    QVector<BenchProgram> m_programs;
+    CAllocator m_allocator;
+};
+
+void tst_bench_shaderkeys::addKeyCounts()
+{
+    QTest::addColumn<int>("keyCount");
+    QTest::newRow("64") << 64;
+    QTest::newRow("512") << 512;
+    QTest::newRow("4096") << 4096;
+}
+
+// Builds distinct material keys the way the material system sets them: a handful of sparse
+// flags and small counts spread over the key words, all sharing one feature set.
+void tst_bench_shaderkeys::createKeys(int keyCount)
+{
+    m_keys.clear();
+    quint32 seed = 12345;
+    QSet<QByteArray> seen;
+    while (m_keys.size() < keyCount) {
+        SShaderDefaultMaterialKey key(0x5bd1e995u);
+        NVDataRef<QT3DSU32> keyData(key);
+        seed = seed * 1664525u + 1013904223u;
+        m_properties.m_HasLighting.SetValue(keyData, (seed >> 4) & 1);
+        m_properties.m_LightCount.SetValue(keyData, (seed >> 5) % 7);
+        m_properties.m_SpecularEnabled.SetValue(keyData, (seed >> 8) & 1);
+        m_properties.m_VertexColorsEnabled.SetValue(keyData, (seed >> 9) & 1);
+        m_properties.m_SpecularModel.SetValue(keyData, (seed >> 10) % 3);
+        for (QT3DSU32 map = 0; map < SShaderDefaultMaterialKeyProperties::ImageMapCount; ++map) {
+            seed = seed * 1664525u + 1013904223u;
+            if ((seed >> 24) % 5 == 0)
+                m_properties.m_ImageMaps[map].SetEnabled(keyData, true);
+        }
+        const QByteArray bytes(reinterpret_cast<const char *>(key.m_DataBuffer),
+                               sizeof(key.m_DataBuffer));
+        if (!seen.contains(bytes)) {
+            seen.insert(bytes);
+            m_keys.append(key);
+        }
+    }
+
+    m_programs.resize(keyCount * 5);
+    for (int i = 0; i < m_programs.size(); ++i)
+        m_programs[i].id = i;
+
+    // Most lookups are for the main pass, alpha tested subsets add depth and shadow lookups.
+    m_lookups.resize(lookupsPerIteration);
+    for (BenchLookup &lookup : m_lookups) {
+        seed = seed * 1664525u + 1013904223u;
+        lookup.keyIndex = int((seed >> 8) % quint32(keyCount));
+        const quint32 passRoll = (seed >> 2) % 16;
+        lookup.pass = passRoll < 12 ? ShaderProgramPasses::Main
+                                    : ShaderProgramPasses::Enum(passRoll - 11);
+    }
+}
+
+void tst_bench_shaderkeys::stringKeyLookup_data()
+{
+    addKeyCounts();
+}
+
+// What every program lookup on the generation path costs: the key is printed into a string
+// that is then hashed and compared.
+void tst_bench_shaderkeys::stringKeyLookup()
+{
+    QFETCH(int, keyCount);
+    createKeys(keyCount);
+    static const char *passPrefixes[] = { "", "depth--", "instanced--", "shadowmap--",
+                                          "shadowcube--" };
+    eastl::string keyString;
+    QHash<QByteArray, BenchProgram *> programs;
+    for (int i = 0; i < keyCount; ++i) {
+        for (int pass = 0; pass < 5; ++pass) {
+            keyString.assign(passPrefixes[pass]);
+            m_keys[i].ToString(keyString, m_properties,
+                               pass == ShaderProgramPasses::Main
+                                       || pass == ShaderProgramPasses::Instanced
+                                   ? SShaderDefaultMaterialKeyProperties::DefaultKey
+                                   : SShaderDefaultMaterialKeyProperties::DepthKey);
+            programs.insert(QByteArray(keyString.c_str(), int(keyString.size())),
+                            &m_programs[i * 5 + pass]);
+        }
+    }
+
+    int found = 0;
+    QBENCHMARK {
+        found = 0;
+        for (const BenchLookup &lookup : qAsConst(m_lookups)) {
+            keyString.assign(passPrefixes[lookup.pass]);
+            m_keys[lookup.keyIndex].ToString(
+                        keyString, m_properties,
+                        lookup.pass == ShaderProgramPasses::Main
+                                || lookup.pass == ShaderProgramPasses::Instanced
+                            ? SShaderDefaultMaterialKeyProperties::DefaultKey
+                            : SShaderDefaultMaterialKeyProperties::DepthKey);
+            if (programs.value(QByteArray::fromRawData(keyString.c_str(),
+                                                       int(keyString.size()))))
+                ++found;
+        }
+    }
+    QCOMPARE(found, lookupsPerIteration);
+}
+
+void tst_bench_shaderkeys::hashMapLookup_data()
+{
+    addKeyCounts();
+}
+
+// The previous renderer tables: one chained hash map per pass keyed by the material key.
+void tst_bench_shaderkeys::hashMapLookup()
+{
+    QFETCH(int, keyCount);
+    createKeys(keyCount);
+    typedef nvhash_map<SShaderDefaultMaterialKey, BenchProgram *> TMap;
+    TMap main(m_allocator, "main");
+    TMap depth(m_allocator, "depth");
+    TMap instanced(m_allocator, "instanced");
+    TMap shadowMap(m_allocator, "shadowMap");
+    TMap shadowCube(m_allocator, "shadowCube");
+    TMap *maps[] = { &main, &depth, &instanced, &shadowMap, &shadowCube };
+    for (int i = 0; i < keyCount; ++i) {
+        for (int pass = 0; pass < 5; ++pass)
+            maps[pass]->insert(eastl::make_pair(m_keys[i], &m_programs[i * 5 + pass]));
+    }
+
+    int found = 0;
+    QBENCHMARK {
+        found = 0;
+        for (const BenchLookup &lookup : qAsConst(m_lookups)) {
+            TMap &map = *maps[lookup.pass];
+            TMap::iterator iter = map.find(m_keys[lookup.keyIndex]);
+            if (iter != map.end() && iter->second)
+                ++found;
+        }
+    }
+    QCOMPARE(found, lookupsPerIteration);
+}
+
+void tst_bench_shaderkeys::programTableLookup_data()
+{
+    addKeyCounts();
+}
+
+void tst_bench_shaderkeys::programTableLookup()
+{
+    QFETCH(int, keyCount);
+    createKeys(keyCount);
+    SShaderProgramTable<BenchProgram> table(m_allocator, "table");
+    for (int i = 0; i < keyCount; ++i) {
+        for (int pass = 0; pass < 5; ++pass) {
+            table.Insert(SShaderProgramKey(m_keys[i], ShaderProgramPasses::Enum(pass)),
+                         &m_programs[i * 5 + pass]);
+        }
+    }
+    QCOMPARE(int(table.size()), keyCount * 5);
+
+    int found = 0;
+    QBENCHMARK {
+        found = 0;
+        for (const BenchLookup &lookup : qAsConst(m_lookups)) {
+            // The renderer builds the key from the renderable's description for every lookup.
+            BenchProgram **program =
+                    table.Find(SShaderProgramKey(m_keys[lookup.keyIndex], lookup.pass));
+            if (program && *program
+                    && (*program)->id == lookup.keyIndex * 5 + int(lookup.pass)) {
+                ++found;
+            }
+        }
+    }
+    QCOMPARE(found, lookupsPerIteration);
+}
+
+QTEST_APPLESS_MAIN(tst_bench_shaderkeys)
+
+#include "tst_bench_shaderkeys.moc"
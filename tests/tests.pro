@@ -1,4 +1,5 @@
 TEMPLATE = subdirs
 
 !package: SUBDIRS += \
-    auto
+    auto \
+    benchmarks
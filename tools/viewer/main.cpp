@@ -227,6 +227,12 @@ int main(int argc, char *argv[])
                       QCoreApplication::translate("main",
                       "Convert base64 dump to shader cache file."),
                       QCoreApplication::translate("main", "fileName"), QString()});
+    parser.addOption({"generate-shader-cache",
+                      QCoreApplication::translate("main",
+                      "Loads the presentation, generates the shaders\n"
+                      "of all of its slides, writes them to the given\n"
+                      "shader cache file and exits."),
+                      QCoreApplication::translate("main", "fileName"), QString()});
     QCommandLineOption variantListOption({QStringLiteral("v"),
                                           QStringLiteral("variants")},
                                           QObject::tr("Gives list of variant groups and variants\n"
@@ -398,6 +404,15 @@ int main(int argc, char *argv[])
         appWindow->setProperty("stereoProgressiveEnabled", true);
 
     viewer.setVariantList(variantList);
+    if (parser.isSet(QStringLiteral("generate-shader-cache"))) {
+        if (files.count() != 1) {
+            qWarning() << "Presentation file is required for generating a shader cache.";
+            parser.showHelp(-1);
+        }
+        // Makes the runtime generate the shaders of every slide before the first frame
+        qputenv("QT3DS_PRECOMPILE_SHADERS", "1");
+        viewer.setShaderCacheFile(parser.value(QStringLiteral("generate-shader-cache")));
+    }
 
 #ifndef Q_OS_ANDROID
     if (generateSequence) {
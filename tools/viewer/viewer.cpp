@@ -136,11 +136,40 @@ void Viewer::loadFile(const QString &filename)
     setContentView(StudioView);
 
     if (qmlStudio()) {
+        if (!m_shaderCacheFile.isEmpty()) {
+            connect(qmlStudio(), &Q3DSStudio3D::presentationReady,
+                    this, &Viewer::exportShaderCache, Qt::UniqueConnection);
+            connect(qmlStudio()->presentation(), &Q3DSPresentation::shaderCacheExported,
+                    this, &Viewer::shaderCacheExported, Qt::UniqueConnection);
+        }
         qmlStudio()->presentation()->setVariantList(m_variantList);
         qmlStudio()->presentation()->setSource(sourceUrl);
     }
 }
 
+// When set, the viewer exports the shader cache of the loaded presentation and exits
+void Viewer::setShaderCacheFile(const QString &fileName)
+{
+    m_shaderCacheFile = fileName;
+}
+
+void Viewer::exportShaderCache()
+{
+    if (qmlStudio()) {
+        qmlStudio()->presentation()->exportShaderCache(QUrl::fromLocalFile(m_shaderCacheFile),
+                                                       false);
+    }
+}
+
+void Viewer::shaderCacheExported(bool success)
+{
+    if (success)
+        qInfo() << "Saved shader cache to file:" << m_shaderCacheFile;
+    else
+        qWarning() << "Failed to generate shader cache file" << m_shaderCacheFile;
+    QCoreApplication::exit(success ? 0 : 1);
+}
+
 QString Viewer::convertUrlListToFilename(const QList<QUrl> &list)
 {
     for (const QUrl &url : list) {
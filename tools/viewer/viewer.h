@@ -89,6 +89,7 @@ public:
     void loadProject(const QByteArray &data);
     void updateProgress(int percent);
     void setGeneratorDetails(const QString &filename);
+    void setShaderCacheFile(const QString &fileName);
 
 public Q_SLOTS:
     void generatorProgress(int totalFrames, int frameCount);
@@ -100,6 +101,8 @@ private Q_SLOTS:
     void remoteConnected();
     void remoteDisconnected();
     void resetConnectionInfoText();
+    void exportShaderCache();
+    void shaderCacheExported(bool success);
 
 Q_SIGNALS:
     void contentViewChanged();
@@ -123,6 +126,7 @@ private:
     QString m_connectText;
     Q3DSStudio3D *m_qmlStudio = nullptr;
     QTimer m_connectTextResetTimer;
+    QString m_shaderCacheFile;
 };
 
 #endif // VIEWER_H